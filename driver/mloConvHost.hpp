@@ -32,6 +32,7 @@
 #include <iostream>
 
 #include "calcerr.hpp"
+#include <../test/cpu_gemm.hpp>
 
 //#if 0 // disable functions
 #if 1
@@ -84,92 +85,24 @@ void ADNN_mm_cpu(const Dtype* a_ptr,
         return;
     }
 
-    size_t inner_loop = (!(a_flags & ADNN_MM_TRANSPOSE)) ? a_cols : a_rows;
-
-    if(!(a_flags & ADNN_MM_TRANSPOSE) && !(b_flags & ADNN_MM_TRANSPOSE))
-    {
-        for(size_t n = 0; n < c_rows; ++n)
-        {
-            for(size_t k = 0; k < c_cols; ++k)
-            {
-                Dtype mm_e = static_cast<Dtype>(0);
-                for(size_t m = 0; m < inner_loop; ++m)
-                {
-                    mm_e += a_ptr[n * a_stride + m] * b_ptr[m * b_stride + k];
-                }
-                c_ptr[n * c_stride + k] = beta * c_ptr[n * c_stride + k] + alpha * mm_e;
-            }
-        }
-    }
-    else if((a_flags & ADNN_MM_TRANSPOSE) && !(b_flags & ADNN_MM_TRANSPOSE))
-    {
-        for(size_t n = 0; n < c_rows; ++n)
-        {
-            for(size_t k = 0; k < c_cols; ++k)
-            {
-
-                Dtype mm_e = static_cast<Dtype>(0);
-                for(size_t m = 0; m < inner_loop; ++m)
-                {
-                    mm_e += a_ptr[m * a_stride + n] * b_ptr[m * b_stride + k];
-#if 0
-					if (
-						(n == 0 && k == 33
-						|| n == 1 && k == 32
-						|| n == 3 && k == 1
-						|| n == 4 && k == 0
-
-						)
-						&& a_ptr[m*a_stride + n] * b_ptr[m*b_stride + k] != 0
-						)
-					{
-						printf("C:mm:%d %d %d   %11.9f %11.9f %11.9f %11.9f\n",
-							n, k, m,
-							mm_e, a_ptr[m*a_stride + n], b_ptr[m*b_stride + k], a_ptr[m*a_stride + n] * b_ptr[m*b_stride + k]);
-					}
-#endif
-                }
-                c_ptr[n * c_stride + k] = beta * c_ptr[n * c_stride + k] + alpha * mm_e;
-            }
-        }
-    }
-    else if(!(a_flags & ADNN_MM_TRANSPOSE) && (b_flags & ADNN_MM_TRANSPOSE))
-    {
-        for(size_t n = 0; n < c_rows; ++n)
-        {
-            for(size_t k = 0; k < c_cols; ++k)
-            {
-                Dtype mm_e = static_cast<Dtype>(0);
-
-                for(size_t m = 0; m < inner_loop; ++m)
-                {
-                    mm_e += a_ptr[n * a_stride + m] * b_ptr[k * b_stride + m];
-#if 0
-					if (n == 0 && k == 6 && a_ptr[n*a_stride + m] * b_ptr[k*b_stride + m] != 0)
-					{
-						printf("%4d  %11.9f %11.9f %11.9f\n", m, mm_e, a_ptr[n*a_stride + m], b_ptr[k*b_stride + m]);
-					}
-#endif
-                }
-                c_ptr[n * c_stride + k] = beta * c_ptr[n * c_stride + k] + alpha * mm_e;
-            }
-        }
-    }
-    else
-    {
-        for(size_t n = 0; n < c_rows; ++n)
-        {
-            for(size_t k = 0; k < c_cols; ++k)
-            {
-                Dtype mm_e = static_cast<Dtype>(0);
-                for(size_t m = 0; m < inner_loop; ++m)
-                {
-                    c_ptr[n * c_stride + k] += a_ptr[m * a_stride + n] * b_ptr[k * b_stride + m];
-                }
-                c_ptr[n * c_stride + k] = beta * c_ptr[n * c_stride + k] + alpha * mm_e;
-            }
-        }
-    }
+    // The product is accumulated in Dtype, as it always was; the transposed-both case used to
+    // accumulate into c_ptr and discard the product.
+    const bool transpose_a = (a_flags & ADNN_MM_TRANSPOSE) != 0;
+    const bool transpose_b = (b_flags & ADNN_MM_TRANSPOSE) != 0;
+    const size_t inner     = transpose_a ? a_rows : a_cols;
+    cpu_gemm<Dtype>(transpose_a,
+                    transpose_b,
+                    c_rows,
+                    c_cols,
+                    inner,
+                    alpha,
+                    a_ptr,
+                    a_stride,
+                    b_ptr,
+                    b_stride,
+                    beta,
+                    c_ptr,
+                    c_stride);
 }
 
 template <typename Dtype>
@@ -190,8 +123,7 @@ void ADNN_im2col_cpu(const Dtype* data_im,
     width_col        = (width_col < 0) ? 1 : width_col;
     stride_col       = (stride_col == 0) ? height_col * width_col : stride_col;
     int channels_col = channels * ksize_h * ksize_w;
-    for(int c = 0; c < channels_col; ++c)
-    {
+    miopen::par_for(channels_col, miopen::min_grain{1}, [&](int c) {
         int w_offset = c % ksize_w;
         int h_offset = (c / ksize_w) % ksize_h;
         int c_im     = c / ksize_h / ksize_w;
@@ -212,7 +144,7 @@ void ADNN_im2col_cpu(const Dtype* data_im,
                 }
             }
         }
-    }
+    });
 }
 
 template <typename Dtype>
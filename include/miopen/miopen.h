@@ -1510,6 +1510,48 @@ miopenFindConvolutionForwardAlgorithm(miopenHandle_t handle,
                                       size_t workSpaceSize,
                                       bool exhaustiveSearch);
 
+/*! @brief Arguments of a single layer for miopenFindConvolutionForwardAlgorithmBatch()
+ *
+ * The fields have the meaning of the parameters of miopenFindConvolutionForwardAlgorithm()
+ * with the same names.
+ */
+typedef struct
+{
+    miopenTensorDescriptor_t xDesc;         /*!< Tensor descriptor for data input tensor x */
+    const void* x;                          /*!< Data tensor x */
+    miopenTensorDescriptor_t wDesc;         /*!< Tensor descriptor for weight tensor w */
+    const void* w;                          /*!< Weights tensor w */
+    miopenConvolutionDescriptor_t convDesc; /*!< Convolution layer descriptor */
+    miopenTensorDescriptor_t yDesc;         /*!< Tensor descriptor for output data tensor y */
+    void* y;                                /*!< Data tensor y */
+    void* workSpace;                        /*!< Pointer to workspace required for the search */
+    size_t workSpaceSize;                   /*!< Size in bytes of the workspace */
+    int requestAlgoCount;                   /*!< Number of algorithms to return kernel times */
+    int* returnedAlgoCount;                 /*!< Pointer to number of algorithms returned */
+    miopenConvAlgoPerf_t* perfResults;      /*!< Array of requestAlgoCount perf results */
+} miopenConvFwdFindProblem_t;
+
+/*! @brief Search the forward convolutional algorithms for all layers of a network at once.
+ *
+ * Equivalent to calling miopenFindConvolutionForwardAlgorithm() for each of the problems,
+ * but faster when many of them are missing from the find-db: problems which are the same
+ * convolution configuration are searched once, and the kernels of all the layers are
+ * compiled in parallel before any of them is benchmarked. Problems which can be served by
+ * the immediate mode (see the find modes) are found one by one as before.
+ *
+ * @param handle             MIOpen handle (input)
+ * @param problemCount       Number of the problems (input)
+ * @param problems           Array of problemCount problems (input)
+ * @param exhaustiveSearch   A boolean to toggle a full search of all algorithms and configurations
+ * (input)
+ * @return                   miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t
+miopenFindConvolutionForwardAlgorithmBatch(miopenHandle_t handle,
+                                           const int problemCount,
+                                           const miopenConvFwdFindProblem_t* problems,
+                                           bool exhaustiveSearch);
+
 /*! @brief Execute a forward convolution layer
  *
  * Runs the forward convolution layer based on the selected algorithm. The function
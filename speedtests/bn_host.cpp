@@ -0,0 +1,174 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <driver.hpp>
+#include <cpu_bn.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace miopen {
+namespace bn_host_speed {
+
+template <class F>
+double Seconds(F f)
+{
+    const auto start = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+struct SpeedTestDriver : public test_driver
+{
+    SpeedTestDriver()
+    {
+        add(batch, "batch");
+        add(channels, "channels");
+        add(size, "size");
+    }
+
+    void run()
+    {
+        const std::size_t spatial = size * size;
+        const std::size_t total   = batch * channels * spatial;
+        std::mt19937 rng{1}; // NOLINT (cert-msc32-c, cert-msc51-cpp)
+        std::uniform_real_distribution<float> dist{-1.0f, 1.0f};
+        std::vector<float> x(total);
+        std::vector<float> dy(total);
+        std::generate(x.begin(), x.end(), [&] { return dist(rng); });
+        std::generate(dy.begin(), dy.end(), [&] { return dist(rng); });
+        std::vector<double> y(total);
+
+        std::cout << "Input " << batch << "x" << channels << "x" << size << "x" << size
+                  << std::endl;
+
+        const auto report = [&](const char* name, double seconds) {
+            std::cout << std::setw(26) << name << ": " << std::fixed << std::setprecision(4)
+                      << seconds << " s, " << std::setprecision(1)
+                      << static_cast<double>(total * sizeof(float)) / 1e9 / seconds << " GB/s"
+                      << std::endl;
+        };
+
+        for(const auto per_activation : {false, true})
+        {
+            const std::size_t params = per_activation ? channels * spatial : channels;
+            std::vector<double> scale(params, 1.0);
+            std::vector<double> bias(params, 0.0);
+            std::vector<double> mean(params);
+            std::vector<double> inv_var(params);
+            std::vector<double> running_mean(params, 0.0);
+            std::vector<double> running_var(params, 1.0);
+            std::vector<double> dscale(params);
+            std::vector<double> dbias(params);
+
+            if(per_activation)
+            {
+                report("per-activation train",
+                       Seconds([&] {
+                           cpu_bn_per_activation_forward_train(batch,
+                                                               channels,
+                                                               spatial,
+                                                               x.data(),
+                                                               y.data(),
+                                                               scale.data(),
+                                                               bias.data(),
+                                                               1e-5,
+                                                               0.1,
+                                                               mean.data(),
+                                                               inv_var.data(),
+                                                               running_mean.data(),
+                                                               running_var.data());
+                       }));
+                report("per-activation backward",
+                       Seconds([&] {
+                           cpu_bn_per_activation_backward(batch,
+                                                          channels,
+                                                          spatial,
+                                                          x.data(),
+                                                          dy.data(),
+                                                          y.data(),
+                                                          scale.data(),
+                                                          dscale.data(),
+                                                          dbias.data(),
+                                                          1e-5,
+                                                          mean.data(),
+                                                          inv_var.data());
+                       }));
+            }
+            else
+            {
+                report("spatial train",
+                       Seconds([&] {
+                           cpu_bn_spatial_forward_train(batch,
+                                                        channels,
+                                                        spatial,
+                                                        x.data(),
+                                                        y.data(),
+                                                        scale.data(),
+                                                        bias.data(),
+                                                        1e-5,
+                                                        0.1,
+                                                        mean.data(),
+                                                        inv_var.data(),
+                                                        running_mean.data(),
+                                                        running_var.data());
+                       }));
+                report("spatial backward",
+                       Seconds([&] {
+                           cpu_bn_spatial_backward(batch,
+                                                   channels,
+                                                   spatial,
+                                                   x.data(),
+                                                   dy.data(),
+                                                   y.data(),
+                                                   scale.data(),
+                                                   dscale.data(),
+                                                   dbias.data(),
+                                                   1e-5,
+                                                   mean.data(),
+                                                   inv_var.data());
+                       }));
+            }
+        }
+    }
+
+    private:
+    std::size_t batch    = 32;
+    std::size_t channels = 64;
+    std::size_t size     = 56;
+};
+
+} // namespace bn_host_speed
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::bn_host_speed::SpeedTestDriver>(argc, argv);
+    return 0;
+}
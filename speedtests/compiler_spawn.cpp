@@ -0,0 +1,120 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/compiler_pool.hpp>
+#include <miopen/exec_utils.hpp>
+#include <miopen/tmp_dir.hpp>
+
+#include <driver.hpp>
+
+#include <boost/filesystem.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace miopen {
+namespace compiler_spawn_speed {
+
+/// Runs trivial "compiler" commands to compare the process start overhead of a kernel build:
+/// a shell per command, posix_spawn per command and the worker processes of CompilerPool.
+struct SpeedTestDriver : public test_driver
+{
+    SpeedTestDriver()
+    {
+        add(iterations, "iterations");
+        add(threads, "threads");
+    }
+
+    void run()
+    {
+        const TmpDir dir{"compiler_spawn"};
+        const auto self = boost::filesystem::read_symlink("/proc/self/exe").string();
+
+        auto command = exec::Command{};
+        command.dir  = dir.path.string();
+        command.args = {"true"};
+
+        Report("std::system, shell", Measure([&]() {
+                   if(std::system(("cd " + command.dir + "; true").c_str()) != 0)
+                       std::cerr << "Failed" << std::endl;
+               }));
+        Report("posix_spawn", Measure([&]() {
+                   if(exec::Spawn(command) != 0)
+                       std::cerr << "Failed" << std::endl;
+               }));
+
+        CompilerPool direct{threads};
+        Report("CompilerPool, posix_spawn", Measure([&]() { direct.Run(command); }));
+        CompilerPool workers{threads, {self, "--compiler-worker"}};
+        Report("CompilerPool, workers", Measure([&]() { workers.Run(command); }));
+        std::cout << "Workers: " << workers.GetWorkerCount()
+                  << ", max latency: " << workers.GetMaxTimeMs() << " ms" << std::endl;
+    }
+
+    private:
+    int iterations      = 200;
+    std::size_t threads = 4;
+
+    /// Runs `iterations` commands from `threads` threads, returns the time per command.
+    template <class F>
+    double Measure(F f) const
+    {
+        const auto start = std::chrono::steady_clock::now();
+        auto pool        = std::vector<std::thread>{};
+        for(std::size_t t = 0; t < threads; t++)
+        {
+            pool.emplace_back([&, t]() {
+                for(auto i = t; i < static_cast<std::size_t>(iterations); i += threads)
+                    f();
+            });
+        }
+        for(auto& thread : pool)
+            thread.join();
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now() - start)
+                   .count() *
+               .001 / iterations;
+    }
+
+    static void Report(const char* name, double us)
+    {
+        std::cout << name << ": " << us << " us" << std::endl;
+    }
+};
+} // namespace compiler_spawn_speed
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    if(argc > 1 && std::string{argv[1]} == "--compiler-worker")
+        return miopen::CompilerWorkerMain();
+    test_drive<miopen::compiler_spawn_speed::SpeedTestDriver>(argc, argv);
+    return 0;
+}
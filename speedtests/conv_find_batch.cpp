@@ -0,0 +1,189 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/conv/find_batch.hpp>
+#include <miopen/convolution.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/tensor.hpp>
+
+#include <driver.hpp>
+#include <get_handle.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <tuple>
+#include <vector>
+
+namespace miopen {
+namespace conv_find_batch_speed {
+
+struct Layer
+{
+    TensorDescriptor x_desc;
+    TensorDescriptor w_desc;
+    TensorDescriptor y_desc;
+    ConvolutionDescriptor conv;
+    Allocator::ManageDataPtr x;
+    Allocator::ManageDataPtr w;
+    Allocator::ManageDataPtr y;
+    int returned = 0;
+    std::vector<miopenConvAlgoPerf_t> perf;
+};
+
+struct SpeedTestDriver : public test_driver
+{
+    SpeedTestDriver()
+    {
+        add(batch_size, "batch-size");
+        add(batched, "batched");
+    }
+
+    // Reports the time until all convolutions of ResNet-50 are found. Run once with
+    // --batched 0 and once with --batched 1, each with MIOPEN_DEBUG_DISABLE_FIND_DB=1 and an
+    // empty MIOPEN_CUSTOM_CACHE_DIR to compare cold starts.
+    void run()
+    {
+        auto&& handle = get_handle();
+        auto layers   = MakeLayers(handle);
+
+        auto workspace_size = std::size_t{0};
+        for(const auto& layer : layers)
+        {
+            const auto size = layer.conv.ForwardGetWorkSpaceSize(
+                handle, layer.w_desc, layer.x_desc, layer.y_desc);
+            workspace_size = std::max(workspace_size, size);
+        }
+        auto workspace = handle.Create(std::max<std::size_t>(workspace_size, 1));
+
+        const auto start = std::chrono::steady_clock::now();
+        if(batched != 0)
+        {
+            auto requests = std::vector<ConvFwdFindRequest>{};
+            for(auto& layer : layers)
+            {
+                auto request              = ConvFwdFindRequest{};
+                request.conv              = &layer.conv;
+                request.xDesc             = &layer.x_desc;
+                request.x                 = layer.x.get();
+                request.wDesc             = &layer.w_desc;
+                request.w                 = layer.w.get();
+                request.yDesc             = &layer.y_desc;
+                request.y                 = layer.y.get();
+                request.workSpace         = workspace.get();
+                request.workSpaceSize     = workspace_size;
+                request.requestAlgoCount  = static_cast<int>(layer.perf.size());
+                request.returnedAlgoCount = &layer.returned;
+                request.perfResults       = layer.perf.data();
+                requests.push_back(request);
+            }
+            FindConvFwdAlgorithmBatch(handle, requests, false);
+        }
+        else
+        {
+            for(auto& layer : layers)
+                layer.conv.FindConvFwdAlgorithm(handle,
+                                                layer.x_desc,
+                                                layer.x.get(),
+                                                layer.w_desc,
+                                                layer.w.get(),
+                                                layer.y_desc,
+                                                layer.y.get(),
+                                                static_cast<int>(layer.perf.size()),
+                                                &layer.returned,
+                                                layer.perf.data(),
+                                                workspace.get(),
+                                                workspace_size,
+                                                false);
+        }
+        const auto time = std::chrono::duration<double, std::milli>(
+                              std::chrono::steady_clock::now() - start)
+                              .count();
+
+        std::cout << "Layers: " << layers.size() << std::endl;
+        std::cout << (batched != 0 ? "Batched" : "Serial") << " time to ready: " << time << " ms"
+                  << std::endl;
+    }
+
+    private:
+    int batch_size = 32;
+    int batched    = 1;
+
+    std::vector<Layer> MakeLayers(Handle& handle) const
+    {
+        // (bottleneck channels, output channels, spatial size, blocks) of a stage
+        const auto stages = std::vector<std::tuple<int, int, int, int>>{
+            {64, 256, 56, 3}, {128, 512, 28, 4}, {256, 1024, 14, 6}, {512, 2048, 7, 3}};
+
+        const auto n = static_cast<std::size_t>(batch_size);
+        std::vector<Layer> layers;
+        const auto add = [&](std::size_t c, std::size_t k, std::size_t hw, int fil, int stride) {
+            const auto pad = fil / 2;
+            const auto len = static_cast<std::size_t>(fil);
+            auto layer     = Layer{};
+            layer.x_desc   = TensorDescriptor{miopenFloat, {n, c, hw, hw}};
+            layer.w_desc   = TensorDescriptor{miopenFloat, {k, c, len, len}};
+            layer.conv     = ConvolutionDescriptor{{pad, pad}, {stride, stride}};
+            layer.y_desc   = layer.conv.GetForwardOutputTensor(layer.x_desc, layer.w_desc);
+            layer.x        = handle.Create<float>(layer.x_desc.GetElementSpace());
+            layer.w        = handle.Create<float>(layer.w_desc.GetElementSpace());
+            layer.y        = handle.Create<float>(layer.y_desc.GetElementSpace());
+            layer.perf.resize(5);
+            layers.push_back(std::move(layer));
+        };
+
+        add(3, 64, 224, 7, 2);
+        auto in_channels = 64;
+        auto in_hw       = 56;
+        for(const auto& stage : stages)
+        {
+            const auto mid    = std::get<0>(stage);
+            const auto out    = std::get<1>(stage);
+            const auto hw     = std::get<2>(stage);
+            const auto blocks = std::get<3>(stage);
+            const auto stride = in_hw / hw;
+            for(auto block = 0; block < blocks; ++block)
+            {
+                add(block == 0 ? in_channels : out, mid, block == 0 ? in_hw : hw, 1, 1);
+                add(mid, mid, block == 0 ? in_hw : hw, 3, block == 0 ? stride : 1);
+                add(mid, out, hw, 1, 1);
+                if(block == 0)
+                    add(in_channels, out, in_hw, 1, stride);
+            }
+            in_channels = out;
+            in_hw       = hw;
+        }
+        return layers;
+    }
+};
+
+} // namespace conv_find_batch_speed
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::conv_find_batch_speed::SpeedTestDriver>(argc, argv);
+    return 0;
+}
@@ -0,0 +1,133 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <driver.hpp>
+#include <cpu_conv.hpp>
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace miopen {
+namespace cpu_conv_speed {
+
+template <class F>
+double Seconds(F f)
+{
+    const auto start = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+struct SpeedTestDriver : public test_driver
+{
+    SpeedTestDriver()
+    {
+        add(batch, "batch");
+        add(channels, "channels");
+        add(size, "size");
+        add(filters, "filters");
+        add(filter_size, "filter-size");
+        add(naive, "naive");
+    }
+
+    void run()
+    {
+        const std::vector<int> pads{filter_size / 2, filter_size / 2};
+        const std::vector<int> strides{1, 1};
+        const std::vector<int> dilations{1, 1};
+
+        std::mt19937 rng{1}; // NOLINT (cert-msc32-c, cert-msc51-cpp)
+        std::uniform_real_distribution<float> dist{-1.0f, 1.0f};
+        auto gen = [&](auto...) { return dist(rng); };
+        const auto in  = tensor<float>(batch, channels, size, size).generate(gen);
+        const auto wei = tensor<float>(filters, channels, filter_size, filter_size).generate(gen);
+        const auto out = tensor<float>(batch, filters, size, size).generate(gen);
+
+        std::cout << "Input " << batch << "x" << channels << "x" << size << "x" << size
+                  << ", weights " << filters << "x" << channels << "x" << filter_size << "x"
+                  << filter_size << std::endl;
+
+        auto fwd = out;
+        auto bwd = in;
+        auto wrw = wei;
+        auto report = [](const char* direction, double naive_time, double gemm_time) {
+            std::cout << std::setw(16) << direction << ": " << std::fixed << std::setprecision(3);
+            if(naive_time > 0)
+                std::cout << "naive " << naive_time << " s, ";
+            std::cout << "gemm " << gemm_time << " s" << std::endl;
+        };
+
+        auto measure = [&](auto naive_impl, auto gemm_impl) {
+            return std::make_pair(naive ? Seconds(naive_impl) : 0.0, Seconds(gemm_impl));
+        };
+
+        const auto fwd_times = measure(
+            [&] { cpu_convolution_forward_impl<2>(in, wei, fwd, pads, strides, dilations, 1); },
+            [&] {
+                cpu_convolution_forward_gemm_impl<2>(in, wei, fwd, pads, strides, dilations, 1);
+            });
+        report("forward", fwd_times.first, fwd_times.second);
+
+        const auto bwd_times = measure(
+            [&] {
+                cpu_convolution_backward_data_impl<2>(bwd, wei, out, pads, strides, dilations, 1);
+            },
+            [&] {
+                cpu_convolution_backward_data_gemm_impl<2>(
+                    bwd, wei, out, pads, strides, dilations, 1);
+            });
+        report("backward data", bwd_times.first, bwd_times.second);
+
+        const auto wrw_times = measure(
+            [&] {
+                cpu_convolution_backward_weight_impl<2>(in, wrw, out, pads, strides, dilations, 1);
+            },
+            [&] {
+                cpu_convolution_backward_weight_gemm_impl<2>(
+                    in, wrw, out, pads, strides, dilations, 1);
+            });
+        report("backward weights", wrw_times.first, wrw_times.second);
+    }
+
+    private:
+    int batch       = 4;
+    int channels    = 64;
+    int size        = 56;
+    int filters     = 64;
+    int filter_size = 3;
+    bool naive      = true;
+};
+
+} // namespace cpu_conv_speed
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::cpu_conv_speed::SpeedTestDriver>(argc, argv);
+    return 0;
+}
@@ -0,0 +1,124 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <driver.hpp>
+#include <cpu_xorwow.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+namespace miopen {
+namespace dropout_init_speed {
+
+template <class F>
+double Seconds(F f)
+{
+    const auto start = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+/// Former emulator: one state at a time, each one skipped ahead from the seeded state.
+void SerialInitStates(prngStates* states, std::size_t states_num, unsigned long long seed)
+{
+    for(std::size_t gid = 0; gid < states_num; gid++)
+    {
+        auto state = cpu_xorwow_detail::seeded_state(seed);
+        auto* vec  = &(state.x);
+        auto skp   = static_cast<unsigned long long>(gid);
+        for(unsigned int mat_idx = 0; skp != 0; mat_idx++, skp >>= XORWOW_JUMP_LOG2)
+        {
+            for(unsigned int i = 0; i < (skp & XORWOW_JUMP_LOG2_MASK); i++)
+            {
+                unsigned int result[XORWOW_DIM] = {0};
+                const auto* matrix = precalc_xorwow_skipahead_sequence_matrices[mat_idx];
+                for(unsigned int w = 0; w < XORWOW_DIM; w++)
+                {
+                    for(unsigned int b = 0; b < XORWOW_BITS; b++)
+                    {
+                        if(!bool(vec[w] & (1U << b)))
+                            continue;
+                        for(unsigned int k = 0; k < XORWOW_DIM; k++)
+                            result[k] ^= matrix[XORWOW_DIM * (w * XORWOW_BITS + b) + k];
+                    }
+                }
+                std::copy(std::begin(result), std::end(result), vec);
+            }
+        }
+        states[gid] = state;
+    }
+}
+
+struct SpeedTestDriver : public test_driver
+{
+    SpeedTestDriver()
+    {
+        add(states_num, "states");
+        add(serial, "serial");
+    }
+
+    void run()
+    {
+        std::vector<prngStates> states(states_num);
+        const auto report = [&](const char* name, double seconds) {
+            std::cout << std::setw(8) << name << ": " << std::fixed << std::setprecision(4)
+                      << seconds << " s, " << std::setprecision(0)
+                      << static_cast<double>(states_num) / seconds << " states/s" << std::endl;
+        };
+
+        std::cout << "States: " << states_num << std::endl;
+        report("batched", Seconds([&] { cpu_xorwow_init_states(states.data(), states_num, 0); }));
+
+        if(serial)
+        {
+            std::vector<prngStates> expected(states_num);
+            report("serial", Seconds([&] { SerialInitStates(expected.data(), states_num, 0); }));
+            for(std::size_t gid = 0; gid < states_num; gid++)
+            {
+                if(std::memcmp(&states[gid], &expected[gid], sizeof(prngStates)) != 0)
+                {
+                    std::cout << "Mismatch at state " << gid << std::endl;
+                    break;
+                }
+            }
+        }
+    }
+
+    private:
+    std::size_t states_num = MAX_PRNG_STATE;
+    bool serial            = true;
+};
+} // namespace dropout_init_speed
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::dropout_init_speed::SpeedTestDriver>(argc, argv);
+    return 0;
+}
@@ -0,0 +1,220 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/handle.hpp>
+#include <miopen/invoker_cache.hpp>
+#include <miopen/solver_id.hpp>
+
+#include <driver.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace miopen {
+namespace invoker_cache_speed {
+
+std::atomic<std::size_t>& allocations()
+{
+    static std::atomic<std::size_t> counter{0};
+    return counter;
+}
+
+} // namespace invoker_cache_speed
+} // namespace miopen
+
+void* operator new(std::size_t size)
+{
+    ++miopen::invoker_cache_speed::allocations();
+    if(auto ptr = std::malloc(size == 0 ? 1 : size)) // NOLINT (cppcoreguidelines-no-malloc)
+        return ptr;
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); } // NOLINT (cppcoreguidelines-no-malloc)
+void operator delete(void* ptr, std::size_t) noexcept
+{
+    std::free(ptr); // NOLINT (cppcoreguidelines-no-malloc)
+}
+
+namespace miopen {
+namespace invoker_cache_speed {
+
+/// The cache as it was before the hashed keys: ordered maps keyed by the network config and
+/// the solver id strings. It had no locking; the mutex makes the comparison fair.
+class StringKeyedCache
+{
+    public:
+    void Register(const NetworkConfig& config, solver::Id solver, const Invoker& invoker)
+    {
+        std::lock_guard<std::mutex> lock{mutex};
+        invokers[config.ToString()].insert({solver.ToString(), invoker});
+    }
+
+    boost::optional<const Invoker&> Get(const NetworkConfig& config, solver::Id solver) const
+    {
+        std::lock_guard<std::mutex> lock{mutex};
+        const auto key  = std::make_pair(config.ToString(), solver.ToString());
+        const auto item = invokers.find(key.first);
+        if(item == invokers.end())
+            return boost::none;
+        const auto invoker = item->second.find(key.second);
+        if(invoker == item->second.end())
+            return boost::none;
+        return invoker->second;
+    }
+
+    private:
+    mutable std::mutex mutex;
+    std::map<std::string, std::map<std::string, Invoker>> invokers;
+};
+
+struct SpeedTestDriver : public test_driver
+{
+    SpeedTestDriver()
+    {
+        add(iterations, "iterations");
+        add(threads, "threads");
+        add(problems, "problems");
+    }
+
+    // Invokers are only looked up, not run, so the HIPNOGPU backend is enough to run this.
+    void run()
+    {
+        auto&& handle         = get_handle();
+        const auto& solvers   = solver::GetSolversByPrimitive(solver::Primitive::Convolution);
+        const auto solver     = solvers.front();
+        const auto algo       = AlgorithmName{solver.GetAlgo(conv::Direction::Forward)};
+        const Invoker invoker = [](const Handle&, const AnyInvokeParams&) {};
+
+        std::vector<NetworkConfig> configs;
+        StringKeyedCache string_keyed;
+        for(std::size_t i = 0; i < problems; ++i)
+        {
+            // Shaped like the convolution network configs.
+            configs.emplace_back(std::to_string(i % 64 + 1) + "x56x56-3x3x" + std::to_string(i) +
+                                 "-1x1-1x1-1x1-0-NCHW-FP32-F");
+            for(const auto& registered : solvers)
+            {
+                handle.RegisterInvoker(invoker, configs.back(), registered, algo);
+                string_keyed.Register(configs.back(), registered, invoker);
+            }
+        }
+
+        std::cout << "Threads: " << threads << ", lookups per thread: " << iterations
+                  << ", problems: " << problems << ", solvers: " << solvers.size() << std::endl;
+        Report("String keys", Measure(configs, [&](const NetworkConfig& config) {
+                   return string_keyed.Get(config, solver);
+               }));
+        Report("Hashed keys, by solver", Measure(configs, [&](const NetworkConfig& config) {
+                   return handle.GetInvoker(config, solver);
+               }));
+        const auto by_algo = Measure(configs, [&](const NetworkConfig& config) {
+            return handle.GetInvoker(config, boost::none, algo);
+        });
+        Report("Hashed keys, by algorithm", by_algo);
+
+        if(by_algo.allocations != 0)
+        {
+            std::cerr << "Invoker cache lookup allocates." << std::endl;
+            std::exit(-1); // NOLINT (concurrency-mt-unsafe)
+        }
+    }
+
+    private:
+    std::size_t iterations = 1000000;
+    std::size_t threads    = 4;
+    std::size_t problems   = 1000;
+
+    struct Result
+    {
+        double allocations;
+        double time;
+    };
+
+    static void Report(const std::string& name, const Result& result)
+    {
+        std::cout << name << ": " << result.time << " ns per lookup, " << result.allocations
+                  << " allocations per lookup" << std::endl;
+    }
+
+    template <class F>
+    Result Measure(const std::vector<NetworkConfig>& configs, F f) const
+    {
+        std::atomic<std::size_t> misses{0};
+        std::atomic<bool> go{false};
+        std::vector<std::thread> workers;
+        for(std::size_t t = 0; t < threads; ++t)
+        {
+            workers.emplace_back([&, t]() {
+                while(!go)
+                    std::this_thread::yield();
+                for(std::size_t i = 0; i < iterations; ++i)
+                {
+                    if(!f(configs[(i * 7919 + t) % configs.size()]))
+                        ++misses;
+                }
+            });
+        }
+
+        // Starting the threads allocates, so the counting starts when all of them are running.
+        const auto allocations_before = allocations().load();
+        const auto start              = std::chrono::steady_clock::now();
+        go                            = true;
+        for(auto& worker : workers)
+            worker.join();
+
+        const auto time = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                              std::chrono::steady_clock::now() - start)
+                              .count();
+        const auto allocated = allocations().load() - allocations_before;
+
+        if(misses != 0)
+        {
+            std::cerr << "Registered invokers were not found." << std::endl;
+            std::exit(-1); // NOLINT (concurrency-mt-unsafe)
+        }
+
+        // Each thread makes all its lookups in this time.
+        const auto calls = static_cast<double>(iterations);
+        return {allocated / (calls * threads), time / calls};
+    }
+};
+
+} // namespace invoker_cache_speed
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::invoker_cache_speed::SpeedTestDriver>(argc, argv);
+    return 0;
+}
@@ -0,0 +1,160 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/config.h>
+
+#if MIOPEN_ENABLE_SQLITE && MIOPEN_ENABLE_SQLITE_KERN_CACHE
+#include <miopen/kern_db.hpp>
+#include <miopen/temp_file.hpp>
+#endif
+
+#include <driver.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace miopen {
+namespace kern_db_codec_speed {
+
+#if MIOPEN_ENABLE_SQLITE && MIOPEN_ENABLE_SQLITE_KERN_CACHE
+// Mimics a code object: an instruction stream built from a small set of opcodes with varying
+// operands, a symbol table and textual metadata, padded with zeros between the sections.
+std::string MakeCodeObject(std::mt19937& rng, std::size_t size)
+{
+    static const std::uint32_t opcodes[] = {
+        0xbf8c0000, 0xd2850000, 0xd1fe0000, 0x7e020200, 0xe0541000, 0xbe8000ff, 0xd3d94000};
+    static const char* const words[] = {
+        "kernel", "args", ".vgpr_count", ".sgpr_count", "group_segment", "value_kind", "offset"};
+
+    std::string blob(256, '\0');
+    while(blob.size() < size * 3 / 4)
+    {
+        const std::uint32_t insn = opcodes[rng() % 7] | (rng() % 4096);
+        blob.append(reinterpret_cast<const char*>(&insn), sizeof(insn));
+    }
+    blob.append(64, '\0');
+    while(blob.size() < size)
+    {
+        blob += words[rng() % 7];
+        blob += ": " + std::to_string(rng() % 1024) + "\n";
+    }
+    blob.resize(size);
+    return blob;
+}
+
+struct Result
+{
+    double store_mbps;
+    double load_mbps;
+    double ratio;
+};
+
+Result Measure(const KernDbCodec& codec, const std::vector<KernelConfig>& corpus)
+{
+    std::size_t total = 0;
+    for(const auto& cfg : corpus)
+        total += cfg.kernel_blob.size();
+
+    TempFile temp_file("speedtest-kerndb");
+    KernDb db(std::string(temp_file), false, "gfx906", 60, codec);
+
+    const auto start = std::chrono::steady_clock::now();
+    for(const auto& cfg : corpus)
+        db.StoreRecordUnsafe(cfg);
+    const auto stored = std::chrono::steady_clock::now();
+    for(const auto& cfg : corpus)
+    {
+        if(!db.FindRecordUnsafe(cfg))
+            MIOPEN_THROW("Kernel " + cfg.kernel_name + " was not found");
+    }
+    const auto loaded = std::chrono::steady_clock::now();
+
+    const auto mbps = [&](auto from, auto to) {
+        return static_cast<double>(total) / 1e6 / std::chrono::duration<double>(to - from).count();
+    };
+    const auto stored_size =
+        db.sql.Exec("SELECT SUM(LENGTH(kernel_blob)) AS size FROM kern_db;").at(0).at("size");
+    return {mbps(start, stored),
+            mbps(stored, loaded),
+            std::stod(stored_size) / static_cast<double>(total)};
+}
+#endif
+
+struct SpeedTestDriver : public test_driver
+{
+    SpeedTestDriver()
+    {
+        add(kernels, "kernels");
+        add(max_size, "max-size");
+    }
+
+    void run()
+    {
+#if MIOPEN_ENABLE_SQLITE && MIOPEN_ENABLE_SQLITE_KERN_CACHE
+        std::mt19937 rng{1}; // NOLINT (cert-msc32-c, cert-msc51-cpp)
+        std::vector<KernelConfig> corpus;
+        std::size_t total = 0;
+        for(std::size_t i = 0; i < kernels; ++i)
+        {
+            const auto size = 4096 + rng() % max_size;
+            corpus.push_back({"kernel" + std::to_string(i) + ".o",
+                              "-DNUM=" + std::to_string(i),
+                              MakeCodeObject(rng, size)});
+            total += size;
+        }
+        std::cout << "Kernels: " << kernels << ", total size: " << total / 1024 << " KiB"
+                  << std::endl;
+
+        for(const auto name : {"none", "bz2:9", "bz2:1", "lz:1", "lz:4", "lz:9"})
+        {
+            const auto result = Measure(*KernDbCodec::Parse(name), corpus);
+            std::cout << std::setw(6) << name << ": store " << std::setw(8) << std::fixed
+                      << std::setprecision(1) << result.store_mbps << " MB/s, load "
+                      << std::setw(8) << result.load_mbps << " MB/s, size ratio "
+                      << std::setprecision(3) << result.ratio << std::endl;
+        }
+#else
+        std::cout << "The SQLite kernel cache is disabled in this build." << std::endl;
+#endif
+    }
+
+    private:
+    std::size_t kernels  = 200;
+    std::size_t max_size = 512 * 1024;
+};
+
+} // namespace kern_db_codec_speed
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::kern_db_codec_speed::SpeedTestDriver>(argc, argv);
+    return 0;
+}
@@ -0,0 +1,133 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/logger.hpp>
+
+#include <driver.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+namespace miopen {
+namespace logging_speed {
+
+void LogEnabled(std::size_t thread, std::size_t i)
+{
+    MIOPEN_LOG_I("Iteration " << i << " of thread " << thread << ", value " << 0.5 * i);
+}
+
+void LogDisabled(std::size_t thread, std::size_t i)
+{
+    MIOPEN_LOG_T("Iteration " << i << " of thread " << thread << ", value " << 0.5 * i);
+}
+
+// As if the library were built with MIOPEN_LOG_MAX_LEVEL=4 (Warning).
+#pragma push_macro("MIOPEN_LOG_MAX_LEVEL")
+#undef MIOPEN_LOG_MAX_LEVEL
+#define MIOPEN_LOG_MAX_LEVEL 4
+void LogCompiledOut(std::size_t thread, std::size_t i)
+{
+    MIOPEN_LOG_I("Iteration " << i << " of thread " << thread << ", value " << 0.5 * i);
+}
+#pragma pop_macro("MIOPEN_LOG_MAX_LEVEL")
+
+struct SpeedTestDriver : public test_driver
+{
+    SpeedTestDriver()
+    {
+        add(iterations, "iterations");
+        add(threads, "threads");
+        add(keep_stderr, "keep-stderr", flag());
+    }
+
+    void run()
+    {
+        // The log itself is not interesting here, and a terminal would be the bottleneck.
+        if(!keep_stderr && std::freopen("/dev/null", "w", stderr) == nullptr)
+        {
+            std::cout << "Unable to redirect stderr." << std::endl;
+            std::exit(-1); // NOLINT (concurrency-mt-unsafe)
+        }
+
+        std::cout << "Threads: " << threads << ", calls per thread: " << iterations << std::endl;
+
+        logger::SetAsync(false);
+        std::cout << "Compiled out: " << Measure(LogCompiledOut) << " ns/call" << std::endl;
+        std::cout << "Disabled level: " << Measure(LogDisabled) << " ns/call" << std::endl;
+        std::cout << "Synchronous: " << Measure(LogEnabled) << " ns/call" << std::endl;
+
+        logger::SetAsync(true);
+        const auto async_time = Measure(LogEnabled);
+        const auto start      = std::chrono::steady_clock::now();
+        LogFlush();
+        const auto flush_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                                  std::chrono::steady_clock::now() - start)
+                                  .count();
+        std::cout << "Asynchronous: " << async_time << " ns/call, flush: " << flush_ms
+                  << " ms, dropped: " << logger::GetDropped() << std::endl;
+    }
+
+    private:
+    std::size_t iterations = 100000;
+    std::size_t threads    = 4;
+    bool keep_stderr       = false;
+
+    template <class F>
+    double Measure(F f) const
+    {
+        const auto start = std::chrono::steady_clock::now();
+        std::vector<std::thread> workers;
+        for(std::size_t t = 0; t < threads; ++t)
+        {
+            workers.emplace_back([=]() {
+                for(std::size_t i = 0; i < iterations; ++i)
+                    f(t, i);
+            });
+        }
+        for(auto& worker : workers)
+            worker.join();
+
+        const auto time = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                              std::chrono::steady_clock::now() - start)
+                              .count();
+        // Each thread makes all its calls in this time.
+        return static_cast<double>(time) / static_cast<double>(iterations);
+    }
+};
+
+} // namespace logging_speed
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    // Info level, unless set by the user.
+    setenv("MIOPEN_LOG_LEVEL", "5", 0); // NOLINT (concurrency-mt-unsafe)
+    test_drive<miopen::logging_speed::SpeedTestDriver>(argc, argv);
+    return 0;
+}
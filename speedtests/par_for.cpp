@@ -0,0 +1,135 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/par_for.hpp>
+
+#include <driver.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+namespace miopen {
+namespace par_for_speed {
+
+/// Former par_for_impl: spawns and joins threads on every call, equal fixed grains.
+template <class F>
+void spawn_per_call(std::size_t n, std::size_t threadsize, F f)
+{
+    std::vector<std::thread> threads;
+    const std::size_t grainsize = (n + threadsize - 1) / threadsize;
+    for(std::size_t start = 0; start < n; start += grainsize)
+    {
+        threads.emplace_back([=]() {
+            for(std::size_t i = start; i < std::min(n, start + grainsize); i++)
+                f(i);
+        });
+    }
+    for(auto& thread : threads)
+        thread.join();
+}
+
+/// Burns roughly the given amount of microseconds of CPU time.
+inline double spin(std::size_t us)
+{
+    const auto until = std::chrono::steady_clock::now() + std::chrono::microseconds(us);
+    auto x           = 1.0;
+    while(std::chrono::steady_clock::now() < until)
+        x = std::sqrt(x + 1.0);
+    return x;
+}
+
+struct SpeedTestDriver : public test_driver
+{
+    SpeedTestDriver()
+    {
+        add(iterations, "iterations");
+        add(threads, "threads");
+        add(items, "items");
+    }
+
+    void run()
+    {
+        std::cout << "Threads: " << threads << std::endl;
+
+        // Per-call overhead: near empty bodies, the cost is dominated by the thread management.
+        std::atomic<std::size_t> sink{0};
+        const auto empty = [&](std::size_t i) { sink += i; };
+        Report("Overhead, spawn per call",
+               Measure([&]() { spawn_per_call(threads, threads, empty); }) / iterations);
+        Report("Overhead, pool",
+               Measure([&]() { par_for_impl(threads, threads, 1, empty); }) / iterations);
+
+        // Uneven workload like compiling kernels of very different sizes: a few items are
+        // much more expensive than the rest and happen to be adjacent.
+        auto costs = std::vector<std::size_t>(items, 200);
+        for(std::size_t i = 0; i < std::min<std::size_t>(items, threads); i++)
+            costs[i] = 5000;
+        const auto uneven = [&](std::size_t i) { sink += spin(costs[i]) > 0 ? 1 : 0; };
+
+        Report("Uneven, spawn per call",
+               Measure([&]() { spawn_per_call(items, threads, uneven); }, 1));
+        Report("Uneven, pool", Measure([&]() { par_for_impl(items, threads, 1, uneven); }, 1));
+
+        if(sink == 0)
+            std::cout << std::endl; // required in release builds
+    }
+
+    private:
+    int iterations      = 10000;
+    std::size_t threads = hardware_threads();
+    std::size_t items   = 256;
+
+    template <class F>
+    double Measure(F f, int times = -1) const
+    {
+        if(times < 0)
+            times = iterations;
+        const auto start = std::chrono::steady_clock::now();
+        for(auto i = 0; i < times; i++)
+            f();
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now() - start)
+                   .count() *
+               .001;
+    }
+
+    static void Report(const char* name, double us)
+    {
+        std::cout << name << ": " << us << " us" << std::endl;
+    }
+};
+} // namespace par_for_speed
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::par_for_speed::SpeedTestDriver>(argc, argv);
+    return 0;
+}
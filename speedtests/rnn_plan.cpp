@@ -0,0 +1,163 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/handle.hpp>
+#include <miopen/rnn.hpp>
+#include <miopen/tensor.hpp>
+
+#include <driver.hpp>
+#include <get_handle.hpp>
+
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+namespace miopen {
+namespace rnn_plan_speed {
+
+struct SpeedTestDriver : public test_driver
+{
+    SpeedTestDriver()
+    {
+        add(hidden_size, "hidden-size");
+        add(num_layers, "num-layers");
+        add(seq_len, "seq-len");
+        add(batch_size, "batch-size");
+        add(iterations, "iterations");
+    }
+
+    // Compares the calls recording a plan to the ones replaying it. Run with
+    // MIOPEN_DEBUG_RNN_PLAN_CACHE=0 to see both without the plans.
+    void run()
+    {
+        auto&& handle  = get_handle();
+        const auto rnn = RNNDescriptor{hidden_size,
+                                       num_layers,
+                                       miopenLSTM,
+                                       miopenRNNlinear,
+                                       miopenRNNunidirection,
+                                       miopenRNNwithBias,
+                                       miopenRNNdefault,
+                                       miopenFloat};
+
+        auto x_descs = std::vector<TensorDescriptor>{};
+        auto y_descs = std::vector<TensorDescriptor>{};
+        auto x_ptrs  = std::vector<miopenTensorDescriptor_t>{};
+        auto y_ptrs  = std::vector<miopenTensorDescriptor_t>{};
+        for(auto i = 0; i < seq_len; i++)
+        {
+            x_descs.emplace_back(miopenFloat, std::vector<int>{batch_size, hidden_size});
+            y_descs.emplace_back(miopenFloat, std::vector<int>{batch_size, hidden_size});
+        }
+        for(auto i = 0; i < seq_len; i++)
+        {
+            x_ptrs.push_back(&x_descs[i]);
+            y_ptrs.push_back(&y_descs[i]);
+        }
+        const auto xs = c_array_view<const miopenTensorDescriptor_t>{x_ptrs.data(), x_ptrs.size()};
+        const auto ys = c_array_view<const miopenTensorDescriptor_t>{y_ptrs.data(), y_ptrs.size()};
+
+        const auto h_desc =
+            TensorDescriptor{miopenFloat, std::vector<int>{num_layers, batch_size, hidden_size}};
+        const auto w_size = rnn.GetParamsSize(handle, x_descs[0], miopenFloat);
+        const auto w_desc =
+            TensorDescriptor{miopenFloat, std::vector<int>{static_cast<int>(w_size / 4)}};
+        const auto ws_size = rnn.GetWorkspaceSize(handle, seq_len, xs);
+        const auto rs_size = rnn.GetReserveSize(handle, seq_len, xs);
+
+        const auto io_size = seq_len * batch_size * hidden_size;
+        auto x             = handle.Create<float>(io_size);
+        auto y             = handle.Create<float>(io_size);
+        auto hx            = handle.Create<float>(h_desc.GetElementSize());
+        auto cx            = handle.Create<float>(h_desc.GetElementSize());
+        auto hy            = handle.Create<float>(h_desc.GetElementSize());
+        auto cy            = handle.Create<float>(h_desc.GetElementSize());
+        auto w             = handle.Create(w_size);
+        auto workspace     = handle.Create(ws_size + iterations);
+        auto reserve       = handle.Create(rs_size);
+
+        const auto forward = [&](std::size_t workspace_size) {
+            rnn.RNNForwardTraining(handle,
+                                   seq_len,
+                                   xs,
+                                   x.get(),
+                                   h_desc,
+                                   hx.get(),
+                                   h_desc,
+                                   cx.get(),
+                                   w_desc,
+                                   w.get(),
+                                   ys,
+                                   y.get(),
+                                   h_desc,
+                                   hy.get(),
+                                   h_desc,
+                                   cy.get(),
+                                   workspace.get(),
+                                   workspace_size,
+                                   reserve.get(),
+                                   rs_size);
+        };
+
+        // Builds the kernels.
+        forward(ws_size);
+
+        // Each workspace size keys a plan of its own, so all of these calls record one.
+        const auto build  = Measure([&](int i) { forward(ws_size + i + 1); });
+        const auto replay = Measure([&](int) { forward(ws_size); });
+
+        std::cout << "Calls: " << iterations << std::endl;
+        std::cout << "Build: " << build << " us per call" << std::endl;
+        std::cout << "Replay: " << replay << " us per call" << std::endl;
+    }
+
+    private:
+    int hidden_size = 16;
+    int num_layers  = 2;
+    int seq_len     = 32;
+    int batch_size  = 4;
+    int iterations  = 100;
+
+    template <class F>
+    double Measure(F f) const
+    {
+        const auto start = std::chrono::steady_clock::now();
+        for(auto i = 0; i < iterations; i++)
+            f(i);
+        const auto time = std::chrono::duration<double, std::micro>(
+                              std::chrono::steady_clock::now() - start)
+                              .count();
+        return time / iterations;
+    }
+};
+
+} // namespace rnn_plan_speed
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::rnn_plan_speed::SpeedTestDriver>(argc, argv);
+    return 0;
+}
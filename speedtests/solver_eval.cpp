@@ -0,0 +1,225 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/convolution.hpp>
+#include <miopen/find_solution.hpp>
+#include <miopen/invoke_params.hpp>
+#include <miopen/mlo_internal.hpp>
+#include <miopen/solver.hpp>
+
+#include <driver.hpp>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+
+namespace miopen {
+namespace solver_eval {
+
+/// Mimics host-side costs of implicit GEMM solvers, which sweep the space of
+/// tuning parameters looking for a config valid for the problem.
+template <int variant>
+struct HeavySolver : solver::SolverBase<ConvolutionContext>
+{
+    static int CountValidConfigs(const ConvolutionContext& ctx, bool first_only)
+    {
+        const auto gemm_m = ctx.n_outputs;
+        const auto gemm_n = ctx.batch_sz * ctx.out_height * ctx.out_width;
+        const auto gemm_k = ctx.n_inputs * ctx.kernel_size_h * ctx.kernel_size_w;
+
+        auto valid = 0;
+        for(auto block_size = 64; block_size <= 256; block_size *= 2)
+            for(auto m_per_block = 16; m_per_block <= 256; m_per_block *= 2)
+                for(auto n_per_block = 16; n_per_block <= 256; n_per_block *= 2)
+                    for(auto k_per_block = 4; k_per_block <= 32; k_per_block *= 2)
+                        for(auto m_per_thread = 1; m_per_thread <= 8; ++m_per_thread)
+                            for(auto n_per_thread = 1; n_per_thread <= 8; ++n_per_thread)
+                            {
+                                if(gemm_m % m_per_block != 0 || gemm_n % n_per_block != 0 ||
+                                   gemm_k % k_per_block != 0)
+                                    continue;
+                                const auto threads = (m_per_block / m_per_thread) *
+                                                     (n_per_block / n_per_thread);
+                                if(threads != block_size + variant % 2)
+                                    continue;
+                                if((m_per_block * k_per_block + n_per_block * k_per_block) *
+                                       (4 + variant % 3) >
+                                   65536)
+                                    continue;
+                                ++valid;
+                                if(first_only)
+                                    return valid;
+                            }
+        return valid;
+    }
+
+    bool IsApplicable(const ConvolutionContext& ctx) const
+    {
+        return CountValidConfigs(ctx, false) > 0;
+    }
+
+    solver::ConvSolution GetSolution(const ConvolutionContext& ctx) const
+    {
+        solver::ConvSolution ret;
+        solver::KernelInfo kernel;
+
+        kernel.kernel_file  = "HeavySolver";
+        kernel.comp_options = " -DVALID_CONFIGS=" + std::to_string(CountValidConfigs(ctx, true));
+        ret.construction_params.push_back(kernel);
+
+        return ret;
+    }
+};
+
+struct NullDb
+{
+};
+
+using Solvers = solver::SolverContainer<HeavySolver<0>,
+                                        HeavySolver<1>,
+                                        HeavySolver<2>,
+                                        HeavySolver<3>,
+                                        HeavySolver<4>,
+                                        HeavySolver<5>,
+                                        HeavySolver<6>,
+                                        HeavySolver<7>,
+                                        HeavySolver<8>,
+                                        HeavySolver<9>,
+                                        HeavySolver<10>,
+                                        HeavySolver<11>,
+                                        HeavySolver<12>,
+                                        HeavySolver<13>,
+                                        HeavySolver<14>,
+                                        HeavySolver<15>>;
+
+struct SpeedTestDriver : public test_driver
+{
+    SpeedTestDriver()
+    {
+        add(iterations, "iterations");
+        add(threads, "threads");
+    }
+
+    void run()
+    {
+        const auto corpus = MakeCorpus();
+
+        auto solvers         = Solvers{};
+        solvers.eval_threads = 1;
+        const auto seq_time  = Measure(solvers, corpus);
+
+        solvers.eval_threads = threads;
+        const auto par_time  = Measure(solvers, corpus);
+
+        for(const auto& ctx : corpus)
+        {
+            solvers.eval_threads = 1;
+            const auto expected  = solvers.SearchForAllSolutions(ctx, NullDb{}, {});
+            solvers.eval_threads = threads;
+            const auto actual    = solvers.SearchForAllSolutions(ctx, NullDb{}, {});
+            if(!std::equal(expected.begin(),
+                           expected.end(),
+                           actual.begin(),
+                           actual.end(),
+                           [](const auto& left, const auto& right) {
+                               return left.solver_id == right.solver_id &&
+                                      left.construction_params[0].comp_options ==
+                                          right.construction_params[0].comp_options;
+                           }))
+            {
+                std::cerr << "Concurrent evaluation changed the result." << std::endl;
+                std::exit(-1); // NOLINT (concurrency-mt-unsafe)
+            }
+        }
+
+        std::cout << "Problems: " << corpus.size() << ", iterations: " << iterations << std::endl;
+        std::cout << "Sequential: " << seq_time << " ms" << std::endl;
+        std::cout << "Concurrent (" << threads << " threads): " << par_time << " ms" << std::endl;
+        std::cout << "Speedup: " << seq_time / par_time << std::endl;
+    }
+
+    private:
+    int iterations      = 3;
+    std::size_t threads = 8;
+
+    static std::vector<ConvolutionContext> MakeCorpus()
+    {
+        // n, c, h, w, k, filter, pad, stride
+        const auto shapes = std::vector<std::array<std::size_t, 8>>{
+            {64, 64, 56, 56, 64, 1, 0, 1},    {64, 64, 56, 56, 64, 3, 1, 1},
+            {64, 64, 56, 56, 256, 1, 0, 1},   {64, 256, 56, 56, 128, 1, 0, 2},
+            {64, 128, 28, 28, 128, 3, 1, 1},  {64, 128, 28, 28, 512, 1, 0, 1},
+            {64, 512, 28, 28, 256, 1, 0, 2},  {64, 256, 14, 14, 256, 3, 1, 1},
+            {64, 256, 14, 14, 1024, 1, 0, 1}, {64, 1024, 14, 14, 512, 1, 0, 2},
+            {64, 512, 7, 7, 512, 3, 1, 1},    {64, 512, 7, 7, 2048, 1, 0, 1},
+            {32, 3, 224, 224, 64, 7, 3, 2},   {128, 96, 27, 27, 256, 5, 2, 1},
+            {16, 192, 35, 35, 32, 1, 0, 1},   {16, 48, 35, 35, 64, 5, 2, 1},
+        };
+
+        std::vector<ConvolutionContext> corpus;
+        for(const auto& s : shapes)
+        {
+            const auto pad    = static_cast<int>(s[6]);
+            const auto stride = static_cast<int>(s[7]);
+            const auto in     = TensorDescriptor{miopenFloat, {s[0], s[1], s[2], s[3]}};
+            const auto wei    = TensorDescriptor{miopenFloat, {s[4], s[1], s[5], s[5]}};
+            const auto conv   = ConvolutionDescriptor{{pad, pad}, {stride, stride}, {1, 1}};
+            const auto out    = conv.GetForwardOutputTensor(in, wei);
+            corpus.emplace_back(in, wei, out, conv, conv::Direction::Forward);
+            corpus.back().disable_perfdb_access = true;
+        }
+        return corpus;
+    }
+
+    double Measure(const Solvers& solvers, const std::vector<ConvolutionContext>& corpus) const
+    {
+        auto db        = NullDb{};
+        auto solutions = std::size_t{0};
+
+        const auto start = std::chrono::steady_clock::now();
+        for(auto i = 0; i < iterations; i++)
+            for(const auto& ctx : corpus)
+                solutions += solvers.SearchForAllSolutions(ctx, db, {}).size();
+
+        const auto time = std::chrono::duration_cast<std::chrono::microseconds>(
+                              std::chrono::steady_clock::now() - start)
+                              .count() *
+                          .001;
+
+        std::cout << "Solutions found: " << solutions << std::endl;
+        return time / iterations;
+    }
+};
+} // namespace solver_eval
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::solver_eval::SpeedTestDriver>(argc, argv);
+    return 0;
+}
@@ -0,0 +1,190 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/handle.hpp>
+#include <miopen/tensor.hpp>
+#include <miopen/tensor_op_key.hpp>
+#include <miopen/tensor_ops.hpp>
+#include <miopen/datatype.hpp>
+
+#include <driver.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+
+namespace miopen {
+namespace tensor_op_alloc {
+
+std::atomic<std::size_t>& allocations()
+{
+    static std::atomic<std::size_t> counter{0};
+    return counter;
+}
+
+} // namespace tensor_op_alloc
+} // namespace miopen
+
+void* operator new(std::size_t size)
+{
+    ++miopen::tensor_op_alloc::allocations();
+    if(auto ptr = std::malloc(size == 0 ? 1 : size)) // NOLINT (cppcoreguidelines-no-malloc)
+        return ptr;
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); } // NOLINT (cppcoreguidelines-no-malloc)
+void operator delete(void* ptr, std::size_t) noexcept
+{
+    std::free(ptr); // NOLINT (cppcoreguidelines-no-malloc)
+}
+
+namespace miopen {
+namespace tensor_op_alloc {
+
+/// Resolves the kernel of SetTensor() the way it did before the typed keys: flattening into
+/// a TensorDescriptor, building the network config string and copying the invoke out of the
+/// string-keyed cache.
+KernelInvoke ResolveByString(const Handle& handle, const TensorDescriptor& desc)
+{
+    const auto flat      = GetFlatTensor(desc);
+    const auto lens      = flat.GetLengths();
+    const auto strides   = flat.GetStrides();
+    const auto flat_desc =
+        TensorDescriptor{flat.GetType(),
+                         std::vector<std::size_t>(lens.begin(), lens.end()),
+                         std::vector<std::size_t>(strides.begin(), strides.end())};
+
+    const auto kernel_name = "SubTensorOpWithScalar" + std::to_string(flat_desc.GetSize()) + "d";
+    std::string network_config = "set " + std::to_string(flat_desc.GetType());
+    for(auto& len : flat_desc.GetLengths())
+        network_config += " " + std::to_string(len);
+
+    auto&& kernels = handle.GetKernels(kernel_name, network_config);
+    if(kernels.empty())
+        MIOPEN_THROW("The kernel has not been built.");
+    return kernels.front();
+}
+
+/// Resolves the kernel of SetTensor() the way it does now.
+const KernelInvoke* ResolveByKey(const Handle& handle, const TensorDescriptor& desc)
+{
+    const auto flat = GetFlatTensor(desc);
+    auto key        = TensorOpKey{"set"};
+    key.Add(flat.GetType()).AddRange(flat.GetLengths());
+    return handle.GetKernelInvoke(key);
+}
+
+struct SpeedTestDriver : public test_driver
+{
+    SpeedTestDriver() { add(iterations, "iterations"); }
+
+    // Kernels are only resolved, not launched, so the HIPNOGPU backend is enough to run this.
+    void run()
+    {
+        auto&& handle = get_handle();
+
+        // Not packed: each row has one element of padding.
+        const auto desc = TensorDescriptor{
+            miopenFloat, {16, 3, 224, 224}, {3 * 224 * 225, 224 * 225, 225, 1}};
+
+        if(ResolveByKey(handle, desc) == nullptr)
+            Build(handle, desc);
+
+        const auto by_string = Measure([&] { return ResolveByString(handle, desc); });
+        const auto by_key    = Measure([&] { return ResolveByKey(handle, desc); });
+
+        std::cout << "Calls: " << iterations << std::endl;
+        std::cout << "String key: " << by_string.allocations << " allocations, "
+                  << by_string.time << " ns per call" << std::endl;
+        std::cout << "Typed key: " << by_key.allocations << " allocations, " << by_key.time
+                  << " ns per call" << std::endl;
+
+        if(by_key.allocations != 0)
+        {
+            std::cerr << "Kernel cache hit allocates." << std::endl;
+            std::exit(-1); // NOLINT (concurrency-mt-unsafe)
+        }
+    }
+
+    private:
+    int iterations = 100000;
+
+    struct Result
+    {
+        double allocations;
+        double time;
+    };
+
+    static void Build(const Handle& handle, const TensorDescriptor& desc)
+    {
+        const auto flat = GetFlatTensor(desc);
+        auto key        = TensorOpKey{"set"};
+        key.Add(flat.GetType()).AddRange(flat.GetLengths());
+
+        std::string params = "-DSUBTENSOR_OP_WITH_SCALAR=SUBTENSOR_OP_WITH_SCALAR_SET" +
+                             GetDataTypeKernelParams(flat.GetType());
+        for(std::size_t i = 0; i < flat.GetSize(); ++i)
+            params += " -DWORK_LENGTH_" + std::to_string(i) + "=64";
+
+        handle.AddKernel(key,
+                         "MIOpenSubTensorOpWithScalarKernel.cl",
+                         "SubTensorOpWithScalar" + std::to_string(flat.GetSize()) + "d",
+                         {256, 1, 1},
+                         {4096, 1, 1},
+                         params);
+    }
+
+    template <class F>
+    Result Measure(F f) const
+    {
+        const auto allocations_before = allocations().load();
+        const auto start              = std::chrono::steady_clock::now();
+
+        for(auto i = 0; i < iterations; i++)
+            f();
+
+        const auto time = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                              std::chrono::steady_clock::now() - start)
+                              .count();
+        const auto allocated = allocations().load() - allocations_before;
+
+        const auto calls = static_cast<double>(iterations);
+        return {allocated / calls, time / calls};
+    }
+};
+
+} // namespace tensor_op_alloc
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::tensor_op_alloc::SpeedTestDriver>(argc, argv);
+    return 0;
+}
@@ -39,8 +39,11 @@
 #include <miopen/db_path.hpp>
 #include <miopen/target_properties.hpp>
 #include <boost/filesystem.hpp>
+#include <algorithm>
 #include <fstream>
 #include <iostream>
+#include <mutex>
+#include <vector>
 
 namespace miopen {
 
@@ -129,6 +132,88 @@ KDb GetDb(const TargetProperties& target, size_t num_cu)
 }
 #endif
 
+class BinaryCacheBatch::impl
+{
+    public:
+#if MIOPEN_ENABLE_SQLITE_KERN_CACHE
+    void Add(const TargetProperties& target, std::size_t num_cu, KernelConfig cfg)
+    {
+        std::lock_guard<std::mutex> lock{mutex};
+        entries.push_back({target, num_cu, std::move(cfg)});
+    }
+#endif
+
+    void Store()
+    {
+#if MIOPEN_ENABLE_SQLITE_KERN_CACHE
+        std::vector<Entry> pending;
+        {
+            std::lock_guard<std::mutex> lock{mutex};
+            pending.swap(entries);
+        }
+
+        // Binaries of a batch usually share the target, so the consecutive ones which go to the
+        // same database are stored together.
+        auto first = pending.begin();
+        while(first != pending.end())
+        {
+            const auto last = std::find_if(first, pending.end(), [&](const Entry& entry) {
+                return entry.num_cu != first->num_cu || entry.target.DbId() != first->target.DbId();
+            });
+            MIOPEN_LOG_I2("Saving " << std::distance(first, last) << " binaries");
+            auto db = GetDb(first->target, first->num_cu);
+            db.Batch([&]() {
+                for(auto entry = first; entry != last; ++entry)
+                    db.StoreRecord(entry->cfg);
+            });
+            first = last;
+        }
+#endif
+    }
+
+#if MIOPEN_ENABLE_SQLITE_KERN_CACHE
+    private:
+    struct Entry
+    {
+        TargetProperties target;
+        std::size_t num_cu;
+        KernelConfig cfg;
+    };
+
+    std::mutex mutex;
+    std::vector<Entry> entries;
+#endif
+};
+
+BinaryCacheBatch*& BinaryCacheBatch::Current()
+{
+    static thread_local BinaryCacheBatch* current = nullptr;
+    return current;
+}
+
+BinaryCacheBatch::Scope::Scope(BinaryCacheBatch& batch) : previous(Current())
+{
+    Current() = &batch;
+}
+
+BinaryCacheBatch::Scope::~Scope() { Current() = previous; }
+
+BinaryCacheBatch::BinaryCacheBatch() : pImpl(std::make_unique<impl>()) {}
+
+BinaryCacheBatch::~BinaryCacheBatch()
+{
+    try
+    {
+        Store();
+    }
+    catch(const std::exception& ex)
+    {
+        MIOPEN_LOG_E("Failed to save binaries into the kernel cache: " << ex.what());
+    }
+}
+
+void BinaryCacheBatch::Store() { pImpl->Store(); }
+
 boost::filesystem::path GetCacheFile(const std::string& device,
                                      const std::string& name,
                                      const std::string& args,
@@ -189,13 +274,19 @@ void SaveBinary(const std::string& hsaco,
     if(miopen::IsCacheDisabled())
         return;
 
-    auto db = GetDb(target, num_cu);
-
     std::string filename = (is_kernel_str ? miopen::md5(name) : name) + ".o";
     KernelConfig cfg{filename, args, hsaco};
 
     const auto verbose_name = GetFilenameForInfo2Logging(is_kernel_str, filename, name);
+    if(const auto batch = BinaryCacheBatch::Current())
+    {
+        MIOPEN_LOG_I2("Queueing binary for: " << verbose_name << "; args: " << args);
+        batch->pImpl->Add(target, num_cu, std::move(cfg));
+        return;
+    }
+
     MIOPEN_LOG_I2("Saving binary for: " << verbose_name << "; args: " << args);
+    auto db = GetDb(target, num_cu);
     db.StoreRecord(cfg);
 }
 #else
@@ -0,0 +1,340 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/binary_db.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/logger.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <istream>
+#include <limits>
+#include <map>
+#include <ostream>
+#include <unordered_map>
+
+namespace miopen {
+namespace binary_db {
+
+namespace {
+
+constexpr char Magic[]           = {'M', 'I', 'O', 'P', 'E', 'N', 'D', 'B'};
+constexpr std::size_t HeaderSize = sizeof(Magic) + 4 * sizeof(std::uint32_t);
+
+template <class T>
+void Put(std::ostream& stream, T value)
+{
+    for(std::size_t i = 0; i < sizeof(T); ++i)
+        stream.put(static_cast<char>((value >> (8 * i)) & 0xff));
+}
+
+template <class T>
+T Get(const char* data)
+{
+    auto value = T{0};
+    for(std::size_t i = 0; i < sizeof(T); ++i)
+        value |= static_cast<T>(static_cast<unsigned char>(data[i])) << (8 * i);
+    return value;
+}
+
+template <class T>
+T Checked(std::size_t value, const char* what)
+{
+    if(value > std::numeric_limits<T>::max())
+        MIOPEN_THROW(miopenStatusInternalError,
+                     std::string("Binary db limit exceeded: too many ") + what);
+    return static_cast<T>(value);
+}
+
+using Record = std::vector<std::pair<std::uint16_t, std::string>>;
+
+Record ParseContents(const std::string& contents,
+                     std::unordered_map<std::string, std::uint16_t>& ids,
+                     std::vector<std::string>& ids_order,
+                     const std::string& key)
+{
+    auto record = Record{};
+    auto begin  = std::size_t{0};
+
+    while(begin < contents.size())
+    {
+        auto end = contents.find(';', begin);
+        if(end == std::string::npos)
+            end = contents.size();
+
+        const auto id_and_values = contents.substr(begin, end - begin);
+        begin                    = end + 1;
+        const auto id_size       = id_and_values.find(':');
+
+        if(id_size == std::string::npos)
+        {
+            MIOPEN_LOG_E("Ill-formed file: ID not found; skipped; key: " << key);
+            continue;
+        }
+
+        const auto id = id_and_values.substr(0, id_size);
+        auto id_it    = ids.find(id);
+
+        if(id_it == ids.end())
+        {
+            id_it = ids.emplace(id, Checked<std::uint16_t>(ids_order.size(), "IDs")).first;
+            ids_order.push_back(id);
+        }
+
+        const auto is_duplicate =
+            std::any_of(record.begin(), record.end(), [&](const auto& value) {
+                return value.first == id_it->second;
+            });
+
+        if(is_duplicate)
+        {
+            MIOPEN_LOG_E("Duplicate ID (ignored): " << id << "; key: " << key);
+            continue;
+        }
+
+        record.emplace_back(id_it->second, id_and_values.substr(id_size + 1));
+    }
+
+    return record;
+}
+
+} // namespace
+
+bool IsBinary(boost::string_view data)
+{
+    return data.size() >= HeaderSize && std::memcmp(data.data(), Magic, sizeof(Magic)) == 0;
+}
+
+std::size_t TextToBinary(std::istream& text, std::ostream& binary, const std::string& source_name)
+{
+    auto records   = std::map<std::string, Record>{};
+    auto ids       = std::unordered_map<std::string, std::uint16_t>{};
+    auto ids_order = std::vector<std::string>{};
+    auto line      = std::string{};
+    auto n_line    = 0;
+
+    while(std::getline(text, line))
+    {
+        ++n_line;
+
+        if(line.empty())
+            continue;
+
+        const auto key_size = line.find('=');
+        const bool is_key   = (key_size != std::string::npos && key_size != 0);
+
+        if(!is_key)
+        {
+            MIOPEN_LOG_E("Ill-formed record: key not found: " << source_name << "#" << n_line);
+            continue;
+        }
+
+        auto key = line.substr(0, key_size);
+        if(records.find(key) != records.end())
+            continue;
+
+        auto record = ParseContents(line.substr(key_size + 1), ids, ids_order, key);
+        records.emplace(std::move(key), std::move(record));
+    }
+
+    // Sorted IDs keep the output independent of the order of records in the text.
+    auto sorted_ids = ids_order;
+    std::sort(sorted_ids.begin(), sorted_ids.end());
+    for(std::size_t i = 0; i < sorted_ids.size(); ++i)
+        ids[sorted_ids[i]] = static_cast<std::uint16_t>(i);
+
+    auto key_width = std::size_t{0};
+    for(auto& record : records)
+    {
+        key_width = std::max(key_width, record.first.size());
+        for(auto& value : record.second)
+            value.first = ids[ids_order[value.first]];
+    }
+
+    binary.write(Magic, sizeof(Magic));
+    Put<std::uint32_t>(binary, Version);
+    Put(binary, Checked<std::uint32_t>(key_width, "key characters"));
+    Put(binary, Checked<std::uint32_t>(records.size(), "records"));
+    Put(binary, Checked<std::uint32_t>(ids_order.size(), "IDs"));
+
+    for(const auto& id : sorted_ids)
+    {
+        Put(binary, Checked<std::uint16_t>(id.size(), "ID characters"));
+        binary.write(id.data(), id.size());
+    }
+
+    auto offset = std::size_t{0};
+    for(const auto& record : records)
+    {
+        binary.write(record.first.data(), record.first.size());
+        for(auto i = record.first.size(); i < key_width; ++i)
+            binary.put('\0');
+        Put(binary, Checked<std::uint32_t>(offset, "payload bytes"));
+
+        offset += sizeof(std::uint16_t);
+        for(const auto& value : record.second)
+            offset += sizeof(std::uint16_t) + sizeof(std::uint32_t) + value.second.size();
+    }
+
+    for(const auto& record : records)
+    {
+        Put(binary, Checked<std::uint16_t>(record.second.size(), "values in a record"));
+        for(const auto& value : record.second)
+        {
+            Put(binary, value.first);
+            Put(binary, Checked<std::uint32_t>(value.second.size(), "value characters"));
+            binary.write(value.second.data(), value.second.size());
+        }
+    }
+
+    if(!binary)
+        MIOPEN_THROW("Failed to write binary db converted from " + source_name);
+
+    return records.size();
+}
+
+void BinaryToText(boost::string_view binary, std::ostream& text)
+{
+    const auto reader = Reader{binary};
+    auto values       = Reader::Values{};
+
+    for(std::size_t i = 0; i < reader.Size(); ++i)
+    {
+        text << reader.Key(i) << '=';
+        if(reader.Read(i, values))
+        {
+            auto first = true;
+            for(const auto& value : values)
+            {
+                if(!first)
+                    text << ';';
+                first = false;
+                text << value.first << ':' << value.second;
+            }
+        }
+        text << '\n';
+    }
+}
+
+Reader::Reader(boost::string_view data_) : data(data_)
+{
+    if(!IsBinary(data))
+        MIOPEN_THROW("Not a binary db");
+
+    auto pos           = sizeof(Magic);
+    const auto version = Get<std::uint32_t>(data.data() + pos);
+    if(version != Version)
+        MIOPEN_THROW("Unsupported binary db version: " + std::to_string(version));
+
+    key_width        = Get<std::uint32_t>(data.data() + pos + 4);
+    records_count    = Get<std::uint32_t>(data.data() + pos + 8);
+    const auto n_ids = Get<std::uint32_t>(data.data() + pos + 12);
+    pos              = HeaderSize;
+
+    ids.reserve(n_ids);
+    for(std::size_t i = 0; i < n_ids; ++i)
+    {
+        if(pos + sizeof(std::uint16_t) > data.size())
+            MIOPEN_THROW("Binary db is truncated");
+        const auto size = Get<std::uint16_t>(data.data() + pos);
+        pos += sizeof(std::uint16_t);
+        if(pos + size > data.size())
+            MIOPEN_THROW("Binary db is truncated");
+        ids.push_back(data.substr(pos, size));
+        pos += size;
+    }
+
+    index_offset = pos;
+    payloads     = index_offset + records_count * EntrySize();
+    if(payloads > data.size())
+        MIOPEN_THROW("Binary db is truncated");
+}
+
+boost::string_view Reader::Key(std::size_t record) const
+{
+    const auto entry = data.data() + index_offset + record * EntrySize();
+    const auto end   = static_cast<const char*>(std::memchr(entry, '\0', key_width));
+    return {entry, end == nullptr ? key_width : static_cast<std::size_t>(end - entry)};
+}
+
+boost::optional<std::size_t> Reader::Find(boost::string_view key) const
+{
+    if(key.empty() || key.size() > key_width)
+        return boost::none;
+
+    auto first = std::size_t{0};
+    auto last  = records_count;
+
+    while(first < last)
+    {
+        const auto middle = first + (last - first) / 2;
+        const auto cmp    = Key(middle).compare(key);
+
+        if(cmp == 0)
+            return middle;
+        if(cmp < 0)
+            first = middle + 1;
+        else
+            last = middle;
+    }
+
+    return boost::none;
+}
+
+bool Reader::Read(std::size_t record, Values& values) const
+{
+    values.clear();
+
+    const auto entry = data.data() + index_offset + record * EntrySize();
+    auto pos         = payloads + Get<std::uint32_t>(entry + key_width);
+
+    if(pos + sizeof(std::uint16_t) > data.size())
+        return false;
+
+    const auto count = Get<std::uint16_t>(data.data() + pos);
+    pos += sizeof(std::uint16_t);
+    values.reserve(count);
+
+    for(std::size_t i = 0; i < count; ++i)
+    {
+        if(pos + sizeof(std::uint16_t) + sizeof(std::uint32_t) > data.size())
+            return false;
+
+        const auto id   = Get<std::uint16_t>(data.data() + pos);
+        const auto size = Get<std::uint32_t>(data.data() + pos + sizeof(std::uint16_t));
+        pos += sizeof(std::uint16_t) + sizeof(std::uint32_t);
+
+        if(id >= ids.size() || pos + size > data.size())
+            return false;
+
+        values.emplace_back(ids[id], data.substr(pos, size));
+        pos += size;
+    }
+
+    return true;
+}
+
+} // namespace binary_db
+} // namespace miopen
@@ -49,11 +49,17 @@ void check_bz2_error(int e, const std::string& name)
     throw std::runtime_error(name + " failed: unknown error!");
 }
 
-std::string compress(std::string s, bool* compressed)
+std::string compress(std::string s, bool* compressed, int block_size)
 {
     std::string result = s;
     unsigned int len   = result.size();
-    auto e             = BZ2_bzBuffToBuffCompress(&result[0], &len, &s[0], s.size(), 9, 0, 30);
+    auto e             = BZ2_bzBuffToBuffCompress(&result[0],
+                                                  &len,
+                                                  &s[0],
+                                                  s.size(),
+                                                  block_size,
+                                                  0,
+                                                  30);
     if(compressed != nullptr and e == BZ_OUTBUFF_FULL)
     {
         *compressed = false;
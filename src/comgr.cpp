@@ -27,6 +27,7 @@
 #include <miopen/config.h>
 
 #include <miopen/comgr.hpp>
+#include <miopen/comgr_input_cache.hpp>
 #include <miopen/algorithm.hpp>
 #include <miopen/env.hpp>
 #include <miopen/errors.hpp>
@@ -522,12 +523,6 @@ class Data : ComgrOwner
     {
         ECI_THROW(amd_comgr_set_data(handle, bytes.size(), bytes.data()), bytes.size());
     }
-#if COMGR_SUPPORTS_PCH
-    void SetFromBuffer(const char* const buffer, const size_t size) const
-    {
-        ECI_THROW(amd_comgr_set_data(handle, size, buffer), size);
-    }
-#endif
 
     private:
     std::size_t GetSize() const
@@ -564,6 +559,10 @@ class Dataset : ComgrOwner
     ~Dataset() { EC(amd_comgr_destroy_data_set(handle)); }
     auto GetHandle() const { return handle; }
     void AddData(const Data& d) const { EC_THROW(amd_comgr_data_set_add(handle, d.GetHandle())); }
+    void AddSharedData(const InputBackend::Handle h) const
+    {
+        EC_THROW(amd_comgr_data_set_add(handle, amd_comgr_data_t{h}));
+    }
     void AddData(const std::string& name,
                  const std::string& content,
                  const amd_comgr_data_kind_t type) const
@@ -583,19 +582,6 @@ class Dataset : ComgrOwner
             MIOPEN_LOG_I(text);
         }
     }
-#if COMGR_SUPPORTS_PCH
-    void AddDataHipPch(const char* const content, const size_t size) const
-    {
-        const char name[] = "hip.pch";
-        const Data d(AMD_COMGR_DATA_KIND_PRECOMPILED_HEADER);
-        if(miopen::IsEnabled(MIOPEN_DEBUG_COMGR_LOG_SOURCE_NAMES{}))
-            MIOPEN_LOG_I(
-                name << ' ' << size << " bytes,  ptr = " << static_cast<const void*>(content));
-        d.SetName(name);
-        d.SetFromBuffer(content, size);
-        AddData(d);
-    }
-#endif
     size_t GetDataCount(const amd_comgr_data_kind_t kind) const
     {
         std::size_t count = 0;
@@ -713,6 +699,76 @@ static std::string GetDebugCompilerOptionsInsert()
     return {p};
 }
 
+/// Creates the shared inputs of the HIP builds with comgr.
+class ComgrInputBackend : public InputBackend
+{
+    public:
+    Handle Create(const Kind kind,
+                  const std::string& name,
+                  const char* const content,
+                  const std::size_t size) override
+    {
+        auto data_kind = AMD_COMGR_DATA_KIND_INCLUDE;
+#if COMGR_SUPPORTS_PCH
+        if(kind == Kind::PrecompiledHeader)
+            data_kind = AMD_COMGR_DATA_KIND_PRECOMPILED_HEADER;
+#endif
+        if(miopen::IsEnabled(MIOPEN_DEBUG_COMGR_LOG_SOURCE_NAMES{}))
+            MIOPEN_LOG_I(name << ' ' << size << " bytes, shared");
+        const auto show_first = miopen::Value(MIOPEN_DEBUG_COMGR_LOG_SOURCE_TEXT{}, 0);
+        if(show_first > 0 && miopen::IsLogging(miopen::LoggingLevel::Info) &&
+           kind == Kind::Include)
+            MIOPEN_LOG_I(std::string(content, std::min<std::size_t>(size, show_first)));
+
+        amd_comgr_data_t data = {0};
+        ECI_THROW(amd_comgr_create_data(data_kind, &data), data_kind);
+        try
+        {
+            ECI_THROW(amd_comgr_set_data_name(data, name.c_str()), name);
+            ECI_THROW(amd_comgr_set_data(data, size, content), size);
+        }
+        catch(ComgrError&)
+        {
+            EC(amd_comgr_release_data(data));
+            throw;
+        }
+        return data.handle;
+    }
+
+    void Release(const Handle handle) override { EC(amd_comgr_release_data({handle})); }
+};
+
+/// The include files and the PCH are the same for all the HIP builds, so the data objects are
+/// created once per process and added to the inputs of each build.
+static std::shared_ptr<const InputSet> GetHipSharedInputs()
+{
+    static InputCache cache{std::make_shared<ComgrInputBackend>()};
+
+    auto pch = false;
+#if COMGR_SUPPORTS_PCH
+    pch = compiler::lc::hip::IsPchEnabled();
+#endif
+    return cache.Get(pch ? "hip+pch" : "hip", [&]() {
+        auto files = InputCache::Files{};
+        // Note that we do not need any "subdirs" in the include "pathnames" so far.
+        for(const auto& inc : miopen::GetHipKernelIncList())
+        {
+            const auto& content = miopen::GetKernelInc(inc);
+            files.push_back({InputBackend::Kind::Include, inc, content.data(), content.size()});
+        }
+#if COMGR_SUPPORTS_PCH
+        if(pch)
+        {
+            const char* content = nullptr;
+            unsigned int size   = 0;
+            __hipGetPCH(&content, &size);
+            files.push_back({InputBackend::Kind::PrecompiledHeader, "hip.pch", content, size});
+        }
+#endif
+        return files;
+    });
+}
+
 void BuildHip(const std::string& name,
               const std::string& text,
               const std::string& options,
@@ -729,20 +785,9 @@ void BuildHip(const std::string& name,
         // files directly into the source text during library build phase by means
         // of the addkernels tool. We don't do that for HIP sources, and, therefore
         // have to export include files prior compilation.
-        // Note that we do not need any "subdirs" in the include "pathnames" so far.
-        const auto incNames = miopen::GetHipKernelIncList();
-        for(const auto& inc : incNames)
-            inputs.AddData(inc, miopen::GetKernelInc(inc), AMD_COMGR_DATA_KIND_INCLUDE);
-
-#if COMGR_SUPPORTS_PCH
-        if(compiler::lc::hip::IsPchEnabled())
-        {
-            const char* pch       = nullptr;
-            unsigned int pch_size = 0;
-            __hipGetPCH(&pch, &pch_size);
-            inputs.AddDataHipPch(pch, pch_size);
-        }
-#endif
+        const auto shared = GetHipSharedInputs();
+        for(const auto handle : shared->GetHandles())
+            inputs.AddSharedData(handle);
 
         const ActionInfo action;
         action.SetLanguage(AMD_COMGR_LANGUAGE_HIP);
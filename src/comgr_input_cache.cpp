@@ -0,0 +1,148 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/comgr_input_cache.hpp>
+
+#include <miopen/logger.hpp>
+
+#include <chrono>
+#include <exception>
+#include <utility>
+
+namespace miopen {
+namespace comgr {
+
+InputSet::InputSet(std::shared_ptr<InputBackend> backend_,
+                   std::vector<InputBackend::Handle> handles_)
+    : backend(std::move(backend_)), handles(std::move(handles_))
+{
+}
+
+InputSet::~InputSet()
+{
+    for(const auto handle : handles)
+        backend->Release(handle);
+}
+
+InputCache::InputCache(std::shared_ptr<InputBackend> backend_) : backend(std::move(backend_)) {}
+
+std::shared_ptr<const InputSet> InputCache::Get(const std::string& key,
+                                                const std::function<Files()>& list)
+{
+    const auto start      = std::chrono::steady_clock::now();
+    const auto elapsed_ms = [&]() {
+        return std::chrono::duration_cast<std::chrono::duration<float, std::milli>>(
+                   std::chrono::steady_clock::now() - start)
+            .count();
+    };
+
+    auto promise = std::promise<std::shared_ptr<const InputSet>>{};
+    auto entry   = Entry{};
+    auto hit     = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        const auto found = entries.find(key);
+        hit              = found != entries.end();
+        if(hit)
+        {
+            entry = found->second;
+            ++stats.hits;
+        }
+        else
+        {
+            entry = promise.get_future().share();
+            entries.emplace(key, entry);
+            ++stats.misses;
+        }
+    }
+
+    if(!hit)
+    {
+        try
+        {
+            promise.set_value(Create(list()));
+        }
+        catch(...)
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                entries.erase(key);
+            }
+            promise.set_exception(std::current_exception());
+        }
+    }
+
+    auto inputs = std::shared_ptr<const InputSet>{};
+    try
+    {
+        inputs = entry.get();
+    }
+    catch(...)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stats.prepare_ms += elapsed_ms();
+        throw;
+    }
+
+    const auto ms = elapsed_ms();
+    MIOPEN_LOG_I2(key << (hit ? ": hit, " : ": miss, ") << inputs->GetHandles().size()
+                      << " inputs, " << ms << " ms");
+    std::lock_guard<std::mutex> lock(mutex);
+    stats.prepare_ms += ms;
+    return inputs;
+}
+
+void InputCache::Clear()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    entries.clear();
+}
+
+InputCacheStats InputCache::GetStats() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return stats;
+}
+
+std::shared_ptr<const InputSet> InputCache::Create(const Files& files) const
+{
+    auto handles = std::vector<InputBackend::Handle>{};
+    handles.reserve(files.size());
+    try
+    {
+        for(const auto& file : files)
+            handles.push_back(backend->Create(file.kind, file.name, file.content, file.size));
+    }
+    catch(...)
+    {
+        for(const auto handle : handles)
+            backend->Release(handle);
+        throw;
+    }
+    return std::make_shared<const InputSet>(backend, std::move(handles));
+}
+
+} // namespace comgr
+} // namespace miopen
@@ -0,0 +1,224 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/compile_pipeline.hpp>
+
+#include <miopen/env.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <utility>
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_COMPILE_PARALLEL_LEVEL)
+
+namespace miopen {
+
+CompilePipeline::CompilePipeline(Build build_, std::size_t threads_, std::size_t window_)
+    : build(std::move(build_)), max_threads(threads_), window(std::max<std::size_t>(window_, 1))
+{
+}
+
+CompilePipeline::~CompilePipeline()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    has_work.notify_all();
+    for(auto& worker : workers)
+        worker.join();
+}
+
+std::size_t CompilePipeline::GetDefaultThreads()
+{
+    return Value(MIOPEN_COMPILE_PARALLEL_LEVEL{}, 20);
+}
+
+void CompilePipeline::Schedule(const std::vector<std::size_t>& indices)
+{
+    if(max_threads == 0)
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        DropQueued();
+        for(auto it = entries.begin(); it != entries.end();)
+        {
+            // Configs being built or ready from the previous schedule are kept if needed again.
+            if(it->second.state == State::Ready &&
+               std::find(indices.begin(), indices.end(), it->first) == indices.end())
+                it = entries.erase(it);
+            else
+                ++it;
+        }
+
+        order    = indices;
+        next     = 0;
+        consumed = 0;
+        for(std::size_t i = 0; i < order.size(); ++i)
+        {
+            const auto inserted = entries.emplace(order[i], Entry{State::Queued, i, {}, {}});
+            if(!inserted.second)
+                inserted.first->second.position = i;
+        }
+
+        const auto threads = std::min(max_threads, order.size());
+        while(workers.size() < threads)
+            workers.emplace_back([this]() { WorkerLoop(); });
+    }
+    has_work.notify_all();
+}
+
+bool CompilePipeline::Wait(std::size_t index)
+{
+    const auto start = std::chrono::steady_clock::now();
+    std::unique_lock<std::mutex> lock(mutex);
+
+    auto it = entries.find(index);
+    if(it == entries.end())
+        return false;
+
+    consumed = std::max(consumed, it->second.position + 1);
+    has_work.notify_all();
+
+    if(it->second.state == State::Queued)
+        BuildEntry(lock, index);
+    else
+        has_built.wait(lock, [&]() { return entries.at(index).state == State::Ready; });
+
+    it          = entries.find(index);
+    auto finish = std::move(it->second.finish);
+    auto error  = it->second.error;
+    entries.erase(it);
+    wait_ms += std::chrono::duration_cast<std::chrono::duration<float, std::milli>>(
+                   std::chrono::steady_clock::now() - start)
+                   .count();
+    lock.unlock();
+
+    if(error)
+        std::rethrow_exception(error);
+    if(finish)
+        finish();
+    return true;
+}
+
+void CompilePipeline::Drain()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    consumed = order.size();
+    has_work.notify_all();
+    has_built.wait(lock, [&]() { return next >= order.size() && building == 0; });
+    entries.clear();
+}
+
+void CompilePipeline::Cancel()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    DropQueued();
+    next = order.size();
+}
+
+std::size_t CompilePipeline::GetBuilt() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return built;
+}
+
+std::size_t CompilePipeline::GetCancelled() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return dropped;
+}
+
+float CompilePipeline::GetWaitTimeMs() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return wait_ms;
+}
+
+void CompilePipeline::WorkerLoop()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    for(;;)
+    {
+        has_work.wait(lock, [&]() {
+            return stopping || (next < order.size() && next < consumed + window);
+        });
+        if(stopping)
+            return;
+
+        const auto index = order[next++];
+        const auto it    = entries.find(index);
+        if(it != entries.end() && it->second.state == State::Queued)
+            BuildEntry(lock, index);
+        else if(next >= order.size())
+            has_built.notify_all();
+    }
+}
+
+void CompilePipeline::BuildEntry(std::unique_lock<std::mutex>& lock, std::size_t index)
+{
+    entries.at(index).state = State::Building;
+    ++building;
+    lock.unlock();
+
+    auto finish = Finish{};
+    auto error  = std::exception_ptr{};
+    try
+    {
+        finish = build(index);
+    }
+    catch(...)
+    {
+        error = std::current_exception();
+    }
+
+    lock.lock();
+    auto& entry  = entries.at(index);
+    entry.state  = State::Ready;
+    entry.finish = std::move(finish);
+    entry.error  = error;
+    --building;
+    ++built;
+    has_built.notify_all();
+}
+
+void CompilePipeline::DropQueued()
+{
+    for(auto it = entries.begin(); it != entries.end();)
+    {
+        if(it->second.state == State::Queued)
+        {
+            it = entries.erase(it);
+            ++dropped;
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+} // namespace miopen
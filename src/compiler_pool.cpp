@@ -0,0 +1,363 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/compiler_pool.hpp>
+
+#include <miopen/compile_pipeline.hpp>
+#include <miopen/env.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/logger.hpp>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <sstream>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif // __linux__
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_COMPILER_WORKER)
+
+namespace miopen {
+
+// Messages are the size of the payload in decimal, '\n' and the payload.
+
+#ifdef __linux__
+static bool SendMessage(int fd, const std::string& payload)
+{
+    const auto message = std::to_string(payload.size()) + '\n' + payload;
+    for(std::size_t sent = 0; sent < message.size();)
+    {
+        const auto n = send(fd, message.data() + sent, message.size() - sent, MSG_NOSIGNAL);
+        if(n < 0 && errno == EINTR)
+            continue;
+        if(n <= 0)
+            return false;
+        sent += n;
+    }
+    return true;
+}
+
+static bool ReceiveBytes(int fd, char* data, std::size_t size)
+{
+    for(std::size_t received = 0; received < size;)
+    {
+        const auto n = recv(fd, data + received, size - received, 0);
+        if(n < 0 && errno == EINTR)
+            continue;
+        if(n <= 0)
+            return false;
+        received += n;
+    }
+    return true;
+}
+
+static bool ReceiveMessage(int fd, std::string& payload)
+{
+    auto size = std::size_t{0};
+    for(auto c = '\0';;)
+    {
+        if(!ReceiveBytes(fd, &c, 1))
+            return false;
+        if(c == '\n')
+            break;
+        if(c < '0' || c > '9')
+            return false;
+        size = size * 10 + (c - '0');
+    }
+    payload.resize(size);
+    return size == 0 || ReceiveBytes(fd, &payload[0], size);
+}
+#endif // __linux__
+
+static void Put(std::ostream& os, const std::string& str) { os << str.size() << ' ' << str; }
+
+static bool Get(std::istream& is, std::string& str)
+{
+    auto size = std::size_t{0};
+    if(!(is >> size) || is.get() != ' ')
+        return false;
+    str.resize(size);
+    return size == 0 || is.read(&str[0], size);
+}
+
+static void Put(std::ostream& os, const std::vector<std::string>& strs)
+{
+    os << strs.size() << ' ';
+    for(const auto& str : strs)
+        Put(os, str);
+}
+
+static bool Get(std::istream& is, std::vector<std::string>& strs)
+{
+    auto size = std::size_t{0};
+    if(!(is >> size))
+        return false;
+    strs.resize(size);
+    return std::all_of(strs.begin(), strs.end(), [&](std::string& str) { return Get(is, str); });
+}
+
+static std::string Serialize(const exec::Command& command)
+{
+    std::ostringstream os;
+    Put(os, command.dir);
+    Put(os, command.env);
+    Put(os, command.args);
+    os << command.redirects.size() << ' ';
+    for(const auto& redirect : command.redirects)
+    {
+        os << redirect.fd << ' ' << redirect.target_fd << ' ';
+        Put(os, redirect.path);
+    }
+    return os.str();
+}
+
+static bool Deserialize(const std::string& str, exec::Command& command)
+{
+    std::istringstream is(str);
+    auto redirects = std::size_t{0};
+    if(!Get(is, command.dir) || !Get(is, command.env) || !Get(is, command.args) ||
+       command.args.empty() || !(is >> redirects))
+        return false;
+    command.redirects.resize(redirects);
+    for(auto& redirect : command.redirects)
+    {
+        if(!(is >> redirect.fd >> redirect.target_fd) || !Get(is, redirect.path))
+            return false;
+    }
+    return true;
+}
+
+/// Runs the command on the worker behind the socket. Returns false if the worker has failed.
+static bool Request(int fd, const exec::Command& command, int& status)
+{
+#ifdef __linux__
+    auto response = std::string{};
+    if(!SendMessage(fd, Serialize(command)) || !ReceiveMessage(fd, response))
+        return false;
+    // A malformed reply means the worker is broken: report failure so that it gets stopped.
+    std::istringstream ss(response);
+    return (ss >> status) && ss.eof();
+#else
+    (void)fd;
+    (void)command;
+    (void)status;
+    return false;
+#endif // __linux__
+}
+
+static std::vector<std::string> GetDefaultWorker()
+{
+    const auto path = GetStringEnv(MIOPEN_COMPILER_WORKER{});
+    if(path == nullptr || *path == '\0')
+        return {};
+    return {path};
+}
+
+CompilerPool::CompilerPool(std::size_t max_jobs_, std::vector<std::string> worker_)
+    : max_jobs(std::max<std::size_t>(max_jobs_, 1)), worker(std::move(worker_))
+{
+}
+
+CompilerPool::~CompilerPool()
+{
+    for(const auto& stopped : idle)
+        StopWorker(stopped);
+}
+
+CompilerPool& CompilerPool::GetDefault()
+{
+    static CompilerPool pool{CompilePipeline::GetDefaultThreads(), GetDefaultWorker()};
+    return pool;
+}
+
+int CompilerPool::Run(const exec::Command& command)
+{
+    const auto start = std::chrono::steady_clock::now();
+    auto used        = Worker{-1, -1};
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        has_job.wait(lock, [&]() { return running < max_jobs; });
+        ++running;
+        if(!idle.empty())
+        {
+            used = idle.back();
+            idle.pop_back();
+        }
+    }
+
+    auto status = -1;
+    try
+    {
+        if(used.pid < 0 && !worker.empty() && StartWorker(used))
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            ++workers;
+        }
+
+        if(used.pid >= 0 && !Request(used.fd, command, status))
+        {
+            MIOPEN_LOG_W("Compiler worker " << used.pid << " has failed, it is stopped");
+            StopWorker(used);
+            used = Worker{-1, -1};
+            std::lock_guard<std::mutex> lock(mutex);
+            --workers;
+        }
+        if(used.pid < 0)
+            status = exec::Spawn(command);
+    }
+    catch(...)
+    {
+        // The worker may be in the middle of a request, so it can't be reused.
+        if(used.pid >= 0)
+            StopWorker(used);
+        std::lock_guard<std::mutex> lock(mutex);
+        --running;
+        if(used.pid >= 0)
+            --workers;
+        has_job.notify_one();
+        throw;
+    }
+
+    const auto ms = std::chrono::duration_cast<std::chrono::duration<float, std::milli>>(
+                        std::chrono::steady_clock::now() - start)
+                        .count();
+    MIOPEN_LOG_I2(command.args.front() << ": status " << status << ", " << ms << " ms");
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        --running;
+        ++builds;
+        total_ms += ms;
+        max_ms = std::max(max_ms, ms);
+        if(used.pid >= 0)
+            idle.push_back(used);
+    }
+    has_job.notify_one();
+    return status;
+}
+
+std::size_t CompilerPool::GetBuildCount() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return builds;
+}
+
+std::size_t CompilerPool::GetWorkerCount() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return workers;
+}
+
+float CompilerPool::GetTotalTimeMs() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return total_ms;
+}
+
+float CompilerPool::GetMaxTimeMs() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return max_ms;
+}
+
+bool CompilerPool::StartWorker(Worker& started) const
+{
+#ifdef __linux__
+    std::array<int, 2> fds{};
+    if(socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, fds.data()) != 0)
+        return false;
+
+    auto command = exec::Command{};
+    command.args = worker;
+    command.redirects.push_back({STDIN_FILENO, {}, fds[1]});
+    const auto pid = exec::StartProcess(command);
+    close(fds[1]);
+    if(pid < 0)
+    {
+        close(fds[0]);
+        return false;
+    }
+    MIOPEN_LOG_I2("Started compiler worker " << pid);
+    started = Worker{pid, fds[0]};
+    return true;
+#else
+    (void)started;
+    return false;
+#endif // __linux__
+}
+
+void CompilerPool::StopWorker(const Worker& stopped)
+{
+#ifdef __linux__
+    // The worker exits when the socket is closed.
+    close(stopped.fd);
+    exec::WaitProcess(stopped.pid);
+#else
+    (void)stopped;
+#endif // __linux__
+}
+
+int CompilerWorkerMain()
+{
+#ifdef __linux__
+    // The commands must not read the requests from stdin.
+    const auto fd = fcntl(STDIN_FILENO, F_DUPFD_CLOEXEC, 3);
+    if(fd < 0)
+        return 1;
+    const auto null = open("/dev/null", O_RDONLY);
+    if(null >= 0)
+    {
+        dup2(null, STDIN_FILENO);
+        close(null);
+    }
+
+    auto request = std::string{};
+    while(ReceiveMessage(fd, request))
+    {
+        auto command = exec::Command{};
+        auto status  = 127;
+        try
+        {
+            if(Deserialize(request, command))
+                status = exec::Spawn(command);
+        }
+        catch(const Exception& ex)
+        {
+            MIOPEN_LOG_E(ex.what());
+        }
+        if(!SendMessage(fd, std::to_string(status)))
+            break;
+    }
+    close(fd);
+    return 0;
+#else
+    return 1;
+#endif // __linux__
+}
+
+} // namespace miopen
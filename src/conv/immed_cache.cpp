@@ -0,0 +1,246 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/conv/immed_cache.hpp>
+#include <miopen/conv/context.hpp>
+#include <miopen/db.hpp>
+#include <miopen/db_record.hpp>
+#include <miopen/md5.hpp>
+#include <miopen/serializable.hpp>
+#include <miopen/solver_id.hpp>
+#include <miopen/stringutils.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+#include <sstream>
+#include <tuple>
+#include <unistd.h>
+
+namespace miopen {
+namespace conv {
+
+ImmedSolutionsCache::ImmedSolutionsCache(std::size_t max_entries_)
+    : max_entries(std::max<std::size_t>(max_entries_, 1))
+{
+}
+
+ImmedSolutionsCache& ImmedSolutionsCache::Instance()
+{
+    // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+    static ImmedSolutionsCache instance;
+    return instance;
+}
+
+bool ImmedSolutionsCache::Find(const std::string& key, Solutions& solutions) const
+{
+    const std::shared_lock<std::shared_timed_mutex> lock{mutex};
+    const auto it = entries.find(key);
+    if(it == entries.end())
+    {
+        ++misses;
+        return false;
+    }
+    it->second.last_used = ++clock;
+    solutions            = it->second.solutions;
+    ++hits;
+    return true;
+}
+
+void ImmedSolutionsCache::Store(const std::string& key, const Solutions& solutions)
+{
+    const std::unique_lock<std::shared_timed_mutex> lock{mutex};
+    auto it = entries.find(key);
+    if(it == entries.end())
+    {
+        // Bounds memory consumption of long-running processes which see many shapes.
+        if(entries.size() >= max_entries)
+            Evict();
+        it = entries.emplace(std::piecewise_construct, std::forward_as_tuple(key), std::tuple<>{})
+                 .first;
+    }
+    it->second.solutions = solutions;
+    it->second.last_used = ++clock;
+}
+
+void ImmedSolutionsCache::Evict()
+{
+    // Dropping a batch at once keeps the cost of the scan amortized over many stores.
+    const auto count = std::max<std::size_t>(entries.size() / 8, 1);
+    auto ages        = std::vector<std::uint64_t>{};
+    ages.reserve(entries.size());
+    for(const auto& entry : entries)
+        ages.push_back(entry.second.last_used);
+    std::nth_element(ages.begin(), ages.begin() + (count - 1), ages.end());
+    const auto threshold = ages[count - 1];
+
+    auto removed = std::size_t{0};
+    for(auto it = entries.begin(); it != entries.end() && removed < count;)
+    {
+        if(it->second.last_used <= threshold)
+        {
+            it = entries.erase(it);
+            ++removed;
+        }
+        else
+        {
+            ++it;
+        }
+    }
+    evictions += removed;
+}
+
+void ImmedSolutionsCache::Clear()
+{
+    const std::unique_lock<std::shared_timed_mutex> lock{mutex};
+    entries.clear();
+    hits      = 0;
+    misses    = 0;
+    evictions = 0;
+}
+
+std::size_t ImmedSolutionsCache::Size() const
+{
+    const std::shared_lock<std::shared_timed_mutex> lock{mutex};
+    return entries.size();
+}
+
+ImmedCacheStats ImmedSolutionsCache::GetStats() const
+{
+    const std::shared_lock<std::shared_timed_mutex> lock{mutex};
+    auto stats      = ImmedCacheStats{};
+    stats.hits      = hits;
+    stats.misses    = misses;
+    stats.evictions = evictions;
+    return stats;
+}
+
+/// Digest of MIOPEN_* environment variables, as they enable and disable solvers.
+static const std::string& GetEnvFingerprint()
+{
+    static const auto fingerprint = []() {
+        auto vars = std::vector<std::string>{};
+        for(auto env = environ; env != nullptr && *env != nullptr; ++env)
+        {
+            if(std::strncmp(*env, "MIOPEN_", 7) == 0)
+                vars.emplace_back(*env);
+        }
+        std::sort(vars.begin(), vars.end());
+        return md5(JoinStrings(vars, "\n"));
+    }();
+    return fingerprint;
+}
+
+std::string GetImmedCacheKey(const ConvolutionContext& ctx,
+                             const miopen::ProblemDescription& problem,
+                             const char kind,
+                             const std::string& device,
+                             const unsigned algorithms)
+{
+    std::ostringstream ss;
+    ss << kind << '-' << device << '-' << ctx.rmv.getValue() << ctx.use_asm_kernels
+       << ctx.use_hip_kernels << ctx.use_opencl_convolutions << ctx.use_binaries
+       << ctx.disable_perfdb_access
+       << ctx.skip_solutions_that_take_long_time_to_build_and_have_narrow_coverage
+       << ctx.use_dynamic_solutions_only << '-' << algorithms << '-' << GetEnvFingerprint() << '-'
+       << problem.BuildConfKey().ToString();
+    return ss.str();
+}
+
+/// Value of a fallback solution stored on disk. Rank keeps the order of solutions
+/// with equal estimated time.
+struct ImmedCachedSolution : solver::Serializable<ImmedCachedSolution>
+{
+    std::size_t rank      = 0;
+    float time            = 0.0f;
+    std::size_t workspace = 0;
+
+    template <class Self, class F>
+    static void Visit(Self&& self, F f)
+    {
+        f(self.rank, "rank");
+        f(self.time, "time");
+        f(self.workspace, "workspace");
+    }
+};
+
+struct ImmedCacheKey
+{
+    std::string key;
+    void Serialize(std::ostream& stream) const { stream << key; }
+};
+
+bool LoadImmedSolutions(const std::string& path,
+                        const std::string& key,
+                        ImmedSolutionsCache::Solutions& solutions)
+{
+    PlainTextDb db{path};
+    const auto record = db.FindRecord(ImmedCacheKey{key});
+    if(!record)
+        return false;
+
+    using Ranked = std::pair<std::size_t, miopenConvSolution_t>;
+    auto ranked  = std::vector<Ranked>{};
+    for(const auto& pair : record->As<ImmedCachedSolution>())
+    {
+        const auto solver_id = solver::Id{pair.first};
+        if(!solver_id.IsValid())
+            return false;
+        ranked.emplace_back(pair.second.rank,
+                            miopenConvSolution_t{pair.second.time,
+                                                 pair.second.workspace,
+                                                 solver_id.Value(),
+                                                 solver_id.GetAlgo()});
+    }
+
+    std::sort(ranked.begin(), ranked.end(), [](const Ranked& left, const Ranked& right) {
+        return left.first < right.first;
+    });
+    solutions.clear();
+    for(const auto& entry : ranked)
+        solutions.push_back(entry.second);
+    return true;
+}
+
+bool StoreImmedSolutions(const std::string& path,
+                         const std::string& key,
+                         const ImmedSolutionsCache::Solutions& solutions)
+{
+    auto record = DbRecord{ImmedCacheKey{key}};
+    for(std::size_t i = 0; i < solutions.size(); ++i)
+    {
+        auto value      = ImmedCachedSolution{};
+        value.rank      = i;
+        value.time      = solutions[i].time;
+        value.workspace = solutions[i].workspace_size;
+        record.SetValues(solver::Id{solutions[i].solution_id}.ToString(), value);
+    }
+
+    PlainTextDb db{path};
+    return db.StoreRecord(record);
+}
+
+} // namespace conv
+} // namespace miopen
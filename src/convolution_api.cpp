@@ -26,6 +26,7 @@
 #include <miopen/miopen.h>
 #include <miopen/miopen_internal.h>
 
+#include <miopen/conv/find_batch.hpp>
 #include <miopen/convolution.hpp>
 #include <miopen/errors.hpp>
 #include <miopen/find_controls.hpp>
@@ -33,9 +34,12 @@
 #include <miopen/logger.hpp>
 #include <miopen/tensor_ops.hpp>
 #include <algorithm>
+#include <string>
+#include <vector>
 
-// TODO: Make miopenConvAlgoPerf_t loggable
+// TODO: Make miopenConvAlgoPerf_t and miopenConvFwdFindProblem_t loggable
 inline std::ostream& operator<<(std::ostream& os, miopenConvAlgoPerf_t) { return os; }
+inline std::ostream& operator<<(std::ostream& os, miopenConvFwdFindProblem_t) { return os; }
 
 extern "C" miopenStatus_t miopenCreateConvolutionDescriptor(miopenConvolutionDescriptor_t* convDesc)
 {
@@ -471,6 +475,66 @@ miopenFindConvolutionForwardAlgorithm(miopenHandle_t handle,
     });
 }
 
+extern "C" miopenStatus_t
+miopenFindConvolutionForwardAlgorithmBatch(miopenHandle_t handle,
+                                           const int problemCount,
+                                           const miopenConvFwdFindProblem_t* problems,
+                                           bool exhaustiveSearch)
+{
+
+    MIOPEN_LOG_FUNCTION(handle, problemCount, problems, exhaustiveSearch);
+
+    return miopen::try_([&] {
+        if(problemCount < 0 || (problemCount > 0 && problems == nullptr))
+            MIOPEN_THROW(miopenStatusBadParm, "Invalid problems");
+
+        auto requests = std::vector<miopen::ConvFwdFindRequest>{};
+        for(int i = 0; i < problemCount; ++i)
+        {
+            const auto& p = problems[i];
+
+            /// workaround for previous trans conv logic
+            if(miopen::deref(p.convDesc).mode == miopenTranspose)
+            {
+                const auto status = miopenFindConvolutionForwardAlgorithm(handle,
+                                                                          p.xDesc,
+                                                                          p.x,
+                                                                          p.wDesc,
+                                                                          p.w,
+                                                                          p.convDesc,
+                                                                          p.yDesc,
+                                                                          p.y,
+                                                                          p.requestAlgoCount,
+                                                                          p.returnedAlgoCount,
+                                                                          p.perfResults,
+                                                                          p.workSpace,
+                                                                          p.workSpaceSize,
+                                                                          exhaustiveSearch);
+                if(status != miopenStatusSuccess)
+                    MIOPEN_THROW(status, "Find failed for problem " + std::to_string(i));
+                continue;
+            }
+
+            auto request              = miopen::ConvFwdFindRequest{};
+            request.conv              = &miopen::deref(p.convDesc);
+            request.xDesc             = &miopen::deref(p.xDesc);
+            request.x                 = DataCast(p.x);
+            request.wDesc             = &miopen::deref(p.wDesc);
+            request.w                 = DataCast(p.w);
+            request.yDesc             = &miopen::deref(p.yDesc);
+            request.y                 = DataCast(p.y);
+            request.workSpace         = DataCast(p.workSpace);
+            request.workSpaceSize     = p.workSpaceSize;
+            request.requestAlgoCount  = p.requestAlgoCount;
+            request.returnedAlgoCount = p.returnedAlgoCount;
+            request.perfResults       = p.perfResults;
+            requests.push_back(request);
+        }
+
+        miopen::FindConvFwdAlgorithmBatch(miopen::deref(handle), requests, exhaustiveSearch);
+    });
+}
+
 extern "C" miopenStatus_t miopenConvolutionForward(miopenHandle_t handle,
                                                    const void* alpha,
                                                    const miopenTensorDescriptor_t xDesc,
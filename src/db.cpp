@@ -25,6 +25,7 @@
  *******************************************************************************/
 #include <miopen/db.hpp>
 #include <miopen/db_record.hpp>
+#include <miopen/env.hpp>
 #include <miopen/errors.hpp>
 #include <miopen/lock_file.hpp>
 #include <miopen/logger.hpp>
@@ -33,6 +34,8 @@
 #include <boost/date_time/posix_time/posix_time_types.hpp>
 #include <boost/filesystem.hpp>
 #include <boost/filesystem/path.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
 #include <boost/none.hpp>
 #include <boost/optional.hpp>
 
@@ -40,20 +43,279 @@
 #include <cassert>
 #include <chrono>
 #include <cstdio>
+#include <cstring>
+#include <ctime>
 #include <fstream>
 #include <ios>
+#include <list>
+#include <memory>
 #include <mutex>
 #include <shared_mutex>
+#include <sstream>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
+#include <sys/stat.h>
+#include <sys/types.h>
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_TEXT_DB_INDEX)
+
 namespace miopen {
 
 struct RecordPositions
 {
     std::streamoff begin = -1;
     std::streamoff end   = -1;
+    bool indexed_format  = false;
 };
+
+namespace {
+
+/// First line of text db files written in the indexed format. It contains '=' so that readers
+/// unaware of it take it for a record which never matches a real key.
+constexpr const char IndexedFormatMarker[] = "#miopen-text-db=indexed";
+
+bool IsIndexedFormatMarker(const char* begin, const char* end)
+{
+    const auto length = sizeof(IndexedFormatMarker) - 1;
+    return static_cast<std::size_t>(end - begin) == length &&
+           std::equal(begin, end, IndexedFormatMarker);
+}
+
+/// Process-wide index of a text db file. Maps each key to the position of its last occurrence
+/// in the file. Shared by all PlainTextDb instances which refer to the same file.
+struct TextDbIndex
+{
+    std::mutex mutex;
+    bool valid        = false;
+    ino_t inode       = 0;
+    off_t size        = 0;
+    std::time_t mtime = 0;
+    off_t stale_bytes = 0;
+    bool marked       = false;
+    boost::interprocess::mapped_region region;
+    std::unordered_map<std::string, RecordPositions> records;
+
+    const char* Data() const { return static_cast<const char*>(region.get_address()); }
+
+    /// Brings index in sync with the file. Returns false if the file can't be read.
+    bool Refresh(const std::string& filename)
+    {
+        struct stat st = {};
+        if(stat(filename.c_str(), &st) != 0)
+        {
+            Reset();
+            return false;
+        }
+
+        if(valid && st.st_ino == inode && st.st_size == size && st.st_mtime == mtime)
+            return true;
+
+        MIOPEN_LOG_I2("Building index of " << filename);
+        Reset();
+        if(!Map(filename, st))
+            return false;
+        Scan(filename);
+        return true;
+    }
+
+    /// Remaps the file after it has been appended by this process. Index entries are expected
+    /// to be already updated by the caller.
+    bool Reload(const std::string& filename)
+    {
+        struct stat st = {};
+        if(stat(filename.c_str(), &st) != 0)
+        {
+            Reset();
+            return false;
+        }
+        return Map(filename, st);
+    }
+
+    void Invalidate() { Reset(); }
+
+    bool NeedsCompaction() const
+    {
+        constexpr off_t min_compaction_size = 16 * 1024;
+        return size >= min_compaction_size && stale_bytes * 2 > size;
+    }
+
+    /// Rewrites the file with the marker line followed by live records only.
+    bool Compact(const std::string& filename)
+    {
+        MIOPEN_LOG_I2("Compacting " << filename << ", stale bytes: " << stale_bytes << ", total: "
+                                    << size);
+
+        auto live = std::vector<const RecordPositions*>{};
+        live.reserve(records.size());
+        for(const auto& item : records)
+            live.push_back(&item.second);
+        std::sort(live.begin(), live.end(), [](auto left, auto right) {
+            return left->begin < right->begin;
+        });
+
+        const auto temp_name = filename + ".temp";
+        {
+            std::ofstream to(temp_name, std::ios::binary);
+
+            if(!to)
+            {
+                MIOPEN_LOG_E("Temp file is unwritable: " << temp_name);
+                return false;
+            }
+
+            to << IndexedFormatMarker << '\n';
+            for(const auto record_pos : live)
+                to.write(Data() + record_pos->begin, record_pos->end - record_pos->begin);
+
+            if(!to)
+            {
+                MIOPEN_LOG_E("Unable to write temp file: " << temp_name);
+                to.close();
+                std::remove(temp_name.c_str());
+                return false;
+            }
+        }
+
+        std::remove(filename.c_str());
+        std::rename(temp_name.c_str(), filename.c_str());
+        boost::filesystem::permissions(filename, boost::filesystem::all_all);
+
+        Reset();
+        return Refresh(filename);
+    }
+
+    private:
+    void Reset()
+    {
+        valid       = false;
+        inode       = 0;
+        size        = 0;
+        mtime       = 0;
+        stale_bytes = 0;
+        marked      = false;
+        region      = {};
+        records.clear();
+    }
+
+    bool Map(const std::string& filename, const struct stat& st)
+    {
+        valid  = false;
+        region = {};
+
+        try
+        {
+            if(st.st_size > 0)
+            {
+                using namespace boost::interprocess;
+                const file_mapping mapping(filename.c_str(), read_only);
+                region = mapped_region(mapping, read_only, 0, static_cast<std::size_t>(st.st_size));
+            }
+        }
+        catch(const boost::interprocess::interprocess_exception& ex)
+        {
+            MIOPEN_LOG_E("Unable to map " << filename << ": " << ex.what());
+            Reset();
+            return false;
+        }
+
+        valid = true;
+        inode = st.st_ino;
+        size  = st.st_size;
+        mtime = st.st_mtime;
+        return true;
+    }
+
+    void Scan(const std::string& filename)
+    {
+        const auto data = Data();
+        auto n_line     = 0;
+        off_t begin     = 0;
+
+        while(begin < size)
+        {
+            const auto eol =
+                static_cast<const char*>(std::memchr(data + begin, '\n', size - begin));
+            const off_t end      = eol == nullptr ? size : (eol - data) + 1;
+            const off_t line_end = eol == nullptr ? size : (eol - data);
+            ++n_line;
+
+            if(begin == 0 && IsIndexedFormatMarker(data, data + line_end))
+            {
+                marked = true;
+                begin  = end;
+                continue;
+            }
+
+            const auto eq =
+                static_cast<const char*>(std::memchr(data + begin, '=', line_end - begin));
+            if(eq == nullptr || eq == data + begin)
+            {
+                if(line_end != begin) // Do not blame empty lines.
+                    MIOPEN_LOG_E("Ill-formed record: key not found: " << filename << "#" << n_line);
+                stale_bytes += end - begin;
+                begin = end;
+                continue;
+            }
+
+            auto key       = std::string(data + begin, eq);
+            const auto old = records.find(key);
+            if(old != records.end())
+                stale_bytes += old->second.end - old->second.begin;
+
+            if(eq + 1 == data + line_end)
+            {
+                // Empty payload: the record has been removed.
+                if(old != records.end())
+                    records.erase(old);
+                stale_bytes += end - begin;
+            }
+            else if(old != records.end())
+            {
+                old->second.begin = begin;
+                old->second.end   = end;
+            }
+            else
+            {
+                auto& pos = records[std::move(key)];
+                pos.begin = begin;
+                pos.end   = end;
+            }
+
+            begin = end;
+        }
+    }
+};
+
+/// Indices are kept for a few most recently used files only. An evicted index stays alive while
+/// it is in use and is rebuilt on the next access to its file.
+std::shared_ptr<TextDbIndex> GetTextDbIndex(const std::string& filename)
+{
+    constexpr std::size_t max_indices = 16;
+
+    // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+    static std::mutex mutex;
+    // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+    static std::list<std::pair<std::string, std::shared_ptr<TextDbIndex>>> indices;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    const auto it = std::find_if(
+        indices.begin(), indices.end(), [&](const auto& item) { return item.first == filename; });
+
+    if(it != indices.end())
+    {
+        indices.splice(indices.begin(), indices, it);
+        return indices.front().second;
+    }
+
+    indices.emplace_front(filename, std::make_shared<TextDbIndex>());
+    if(indices.size() > max_indices)
+        indices.pop_back();
+    return indices.front().second;
+}
+
+} // namespace
 /// This makes the interface for the MultiFileDb uniform and
 /// allows reusing it for the SQLite perfdb and the kernel cache.
 PlainTextDb::PlainTextDb(const std::string& filename_,
@@ -65,9 +327,15 @@ PlainTextDb::PlainTextDb(const std::string& filename_,
 }
 
 PlainTextDb::PlainTextDb(const std::string& filename_, bool is_system)
+    : PlainTextDb(filename_, is_system, miopen::IsEnabled(MIOPEN_DEBUG_TEXT_DB_INDEX{}))
+{
+}
+
+PlainTextDb::PlainTextDb(const std::string& filename_, bool is_system, bool indexed_)
     : filename(filename_),
       lock_file(LockFile::Get(LockFilePath(filename_).c_str())),
-      warn_if_unreadable(is_system)
+      warn_if_unreadable(is_system),
+      indexed(indexed_)
 {
     if(!is_system)
     {
@@ -142,12 +410,16 @@ boost::optional<DbRecord> PlainTextDb::FindRecordUnsafe(const std::string& key,
 {
     if(pos != nullptr)
     {
-        pos->begin = -1;
-        pos->end   = -1;
+        pos->begin          = -1;
+        pos->end            = -1;
+        pos->indexed_format = false;
     }
 
     MIOPEN_LOG_I2("Looking for key " << key << " in file " << filename);
 
+    if(indexed)
+        return FindRecordIndexedUnsafe(key, pos);
+
     std::ifstream file(filename);
 
     if(!file)
@@ -160,7 +432,11 @@ boost::optional<DbRecord> PlainTextDb::FindRecordUnsafe(const std::string& key,
         return boost::none;
     }
 
-    int n_line = 0;
+    // In files written by the indexed mode the last occurrence of a key wins and an empty payload
+    // marks the key as removed.
+    auto marked = false;
+    auto found  = boost::optional<DbRecord>{};
+    int n_line  = 0;
     while(true)
     {
         std::string line;
@@ -170,6 +446,14 @@ boost::optional<DbRecord> PlainTextDb::FindRecordUnsafe(const std::string& key,
         ++n_line;
         const auto next_line_begin = file.tellg();
 
+        if(n_line == 1 && IsIndexedFormatMarker(line.data(), line.data() + line.size()))
+        {
+            marked = true;
+            if(pos != nullptr)
+                pos->indexed_format = true;
+            continue;
+        }
+
         const auto key_size = line.find('=');
         const bool is_key   = (key_size != std::string::npos && key_size != 0);
         if(!is_key)
@@ -191,6 +475,17 @@ boost::optional<DbRecord> PlainTextDb::FindRecordUnsafe(const std::string& key,
 
         if(contents.empty())
         {
+            if(marked)
+            {
+                found = boost::none;
+                if(pos != nullptr)
+                {
+                    pos->begin = -1;
+                    pos->end   = -1;
+                }
+                continue;
+            }
+
             MIOPEN_LOG_E("None contents under the key: " << current_key << " form file " << filename
                                                          << "#"
                                                          << n_line);
@@ -215,10 +510,51 @@ boost::optional<DbRecord> PlainTextDb::FindRecordUnsafe(const std::string& key,
             pos->begin = line_begin;
             pos->end   = next_line_begin;
         }
-        return record;
+
+        if(!marked)
+            return record;
+        found = std::move(record);
     }
-    // Record was not found
-    return boost::none;
+    return found;
+}
+
+boost::optional<DbRecord> PlainTextDb::FindRecordIndexedUnsafe(const std::string& key,
+                                                               RecordPositions* pos)
+{
+    const auto index = GetTextDbIndex(filename);
+    std::lock_guard<std::mutex> lock(index->mutex);
+
+    if(!index->Refresh(filename))
+    {
+        if(warn_if_unreadable && !MIOPEN_DISABLE_SYSDB)
+            MIOPEN_LOG_W("File is unreadable: " << filename);
+        else
+            MIOPEN_LOG_I2("File is unreadable: " << filename);
+
+        return boost::none;
+    }
+
+    const auto it = index->records.find(key);
+    if(it == index->records.end())
+        return boost::none;
+
+    const auto line_begin = index->Data() + it->second.begin;
+    auto line_end         = index->Data() + it->second.end;
+    if(line_end[-1] == '\n')
+        --line_end;
+    const auto contents = std::string(line_begin + key.size() + 1, line_end);
+    MIOPEN_LOG_I2("Contents found: " << contents);
+
+    DbRecord record(key);
+    if(!record.ParseContents(contents))
+    {
+        MIOPEN_LOG_E("Error parsing payload under the key: " << key << " form file " << filename);
+        MIOPEN_LOG_E("Contents: " << contents);
+    }
+
+    if(pos != nullptr)
+        *pos = it->second;
+    return record;
 }
 
 static void Copy(std::istream& from, std::ostream& to, std::streamoff count)
@@ -242,6 +578,11 @@ bool PlainTextDb::FlushUnsafe(const DbRecord& record, const RecordPositions* pos
 {
     assert(pos);
 
+    // Files in the indexed format may contain several lines per key, so they are never updated in
+    // place.
+    if(indexed || pos->indexed_format)
+        return FlushIndexedUnsafe(record);
+
     if(pos->begin < 0 || pos->end < 0)
     {
         {
@@ -297,6 +638,80 @@ bool PlainTextDb::FlushUnsafe(const DbRecord& record, const RecordPositions* pos
     return true;
 }
 
+bool PlainTextDb::FlushIndexedUnsafe(const DbRecord& record)
+{
+    const auto index = GetTextDbIndex(filename);
+    std::lock_guard<std::mutex> lock(index->mutex);
+
+    // Also called for marked files from the default mode, so the index may be out of date.
+    if(!index->Refresh(filename) && boost::filesystem::exists(filename))
+        return false;
+
+    // Files written by the default mode are converted before anything is appended to them, so
+    // that no reader ever sees a duplicate key in an unmarked file.
+    if(index->size > 0 && !index->marked && !index->Compact(filename))
+        return false;
+
+    const auto old        = index->records.find(record.key);
+    const auto is_removal = record.map.empty();
+    if(is_removal && old == index->records.end())
+        return true;
+
+    const auto is_new_file = index->size == 0;
+
+    std::ostringstream ss;
+    if(is_new_file)
+        ss << IndexedFormatMarker << '\n';
+    if(is_removal)
+        ss << record.key << '=' << std::endl;
+    else
+        record.WriteContents(ss);
+    const auto line = ss.str();
+
+    {
+        std::ofstream file(filename, std::ios::app | std::ios::binary);
+
+        if(!file)
+        {
+            MIOPEN_LOG_E("File is unwritable: " << filename);
+            return false;
+        }
+
+        file.write(line.data(), line.size());
+    }
+
+    boost::filesystem::permissions(filename, boost::filesystem::all_all);
+
+    if(is_new_file)
+    {
+        index->Invalidate();
+        index->Refresh(filename);
+        return true;
+    }
+
+    const auto line_begin  = static_cast<std::streamoff>(index->size);
+    const auto line_length = static_cast<std::streamoff>(line.size());
+
+    if(old != index->records.end())
+        index->stale_bytes += old->second.end - old->second.begin;
+
+    if(is_removal)
+    {
+        index->records.erase(old);
+        index->stale_bytes += line_length;
+    }
+    else
+    {
+        auto& record_pos = index->records[record.key];
+        record_pos.begin = line_begin;
+        record_pos.end   = line_begin + line_length;
+    }
+
+    if(index->Reload(filename) && index->NeedsCompaction())
+        index->Compact(filename);
+    return true;
+}
+
 bool PlainTextDb::StoreRecordUnsafe(const DbRecord& record)
 {
     MIOPEN_LOG_I2("Storing record: " << record.key);
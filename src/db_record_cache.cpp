@@ -0,0 +1,205 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/db_record_cache.hpp>
+#include <miopen/env.hpp>
+
+#include <algorithm>
+#include <functional>
+#include <mutex>
+#include <shared_mutex>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <sys/stat.h>
+#include <sys/types.h>
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_DB_CACHE_SIZE)
+
+namespace miopen {
+
+namespace {
+constexpr std::size_t ShardsCount         = 16;
+constexpr std::size_t DefaultCacheRecords = 4096;
+} // namespace
+
+struct DbRecordCache::Shard
+{
+    struct Entry
+    {
+        Entry(const boost::optional<DbRecord>& record_, const Stamp& stamp_, std::uint64_t used)
+            : record(record_), stamp(stamp_), last_used(used)
+        {
+        }
+
+        boost::optional<DbRecord> record;
+        Stamp stamp;
+        std::atomic<std::uint64_t> last_used;
+    };
+
+    std::shared_timed_mutex mutex;
+    std::unordered_map<std::string, Entry> entries;
+
+    /// Removes count of the least recently used entries.
+    void Evict(std::size_t count)
+    {
+        auto ticks = std::vector<std::uint64_t>{};
+        ticks.reserve(entries.size());
+        for(const auto& entry : entries)
+            ticks.push_back(entry.second.last_used);
+
+        count = std::min(count, ticks.size());
+        if(count == 0)
+            return;
+
+        std::nth_element(ticks.begin(), ticks.begin() + (count - 1), ticks.end());
+        const auto threshold = ticks[count - 1];
+
+        for(auto it = entries.begin(); it != entries.end();)
+        {
+            if(it->second.last_used <= threshold)
+                it = entries.erase(it);
+            else
+                ++it;
+        }
+    }
+};
+
+DbRecordCache::DbRecordCache(std::size_t capacity_)
+    : capacity(capacity_), shards(new Shard[ShardsCount])
+{
+}
+
+DbRecordCache::~DbRecordCache() = default;
+
+DbRecordCache& DbRecordCache::Instance()
+{
+    // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+    static DbRecordCache instance{
+        static_cast<std::size_t>(Value(MIOPEN_DEBUG_DB_CACHE_SIZE{}, DefaultCacheRecords))};
+    return instance;
+}
+
+static DbRecordCache::FileStamp GetFileStamp(const std::string& path)
+{
+    auto stamp     = DbRecordCache::FileStamp{};
+    struct stat st = {};
+
+    if(path.empty() || stat(path.c_str(), &st) != 0)
+        return stamp;
+
+    stamp.inode = st.st_ino;
+    stamp.mtime = static_cast<std::int64_t>(st.st_mtim.tv_sec) * 1000000000 + st.st_mtim.tv_nsec;
+    stamp.size  = st.st_size;
+    return stamp;
+}
+
+DbRecordCache::Stamp DbRecordCache::GetStamp(const std::string& installed_path,
+                                             const std::string& user_path) const
+{
+    auto stamp       = Stamp{};
+    stamp.generation = generation;
+    stamp.installed  = GetFileStamp(installed_path);
+    stamp.user       = GetFileStamp(user_path);
+    // SQLite dbs in the WAL mode are modified through the write-ahead log first.
+    if(!user_path.empty())
+        stamp.user_wal = GetFileStamp(user_path + "-wal");
+    return stamp;
+}
+
+DbRecordCache::Shard& DbRecordCache::GetShard(const std::string& key) const
+{
+    return shards[std::hash<std::string>{}(key) % ShardsCount];
+}
+
+boost::optional<boost::optional<DbRecord>> DbRecordCache::Find(const std::string& key,
+                                                               const Stamp& stamp)
+{
+    auto& shard = GetShard(key);
+
+    {
+        const std::shared_lock<std::shared_timed_mutex> lock{shard.mutex};
+        const auto it = shard.entries.find(key);
+
+        if(it != shard.entries.end() && it->second.stamp == stamp)
+        {
+            it->second.last_used = ++tick;
+            ++hits;
+            return boost::make_optional(it->second.record);
+        }
+    }
+
+    ++misses;
+    return boost::none;
+}
+
+void DbRecordCache::Insert(const std::string& key,
+                           const Stamp& stamp,
+                           const boost::optional<DbRecord>& record)
+{
+    auto& shard = GetShard(key);
+    const std::unique_lock<std::shared_timed_mutex> lock{shard.mutex};
+    const auto it = shard.entries.find(key);
+
+    if(it != shard.entries.end())
+    {
+        it->second.record    = record;
+        it->second.stamp     = stamp;
+        it->second.last_used = ++tick;
+        return;
+    }
+
+    const auto shard_capacity = std::max<std::size_t>(capacity / ShardsCount, 1);
+    if(shard.entries.size() >= shard_capacity)
+        shard.Evict(std::max<std::size_t>(shard_capacity / 4, 1));
+
+    shard.entries.emplace(std::piecewise_construct,
+                          std::forward_as_tuple(key),
+                          std::forward_as_tuple(record, stamp, ++tick));
+}
+
+void DbRecordCache::Clear()
+{
+    for(std::size_t i = 0; i < ShardsCount; ++i)
+    {
+        const std::unique_lock<std::shared_timed_mutex> lock{shards[i].mutex};
+        shards[i].entries.clear();
+    }
+
+    hits   = 0;
+    misses = 0;
+}
+
+DbRecordCache::Stats DbRecordCache::GetStats() const
+{
+    auto stats   = Stats{};
+    stats.hits   = hits;
+    stats.misses = misses;
+    return stats;
+}
+
+} // namespace miopen
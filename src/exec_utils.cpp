@@ -23,6 +23,7 @@
  * SOFTWARE.
  *
  *******************************************************************************/
+#include <miopen/config.h>
 #include <miopen/exec_utils.hpp>
 #include <miopen/logger.hpp>
 #include <miopen/manage_ptr.hpp>
@@ -33,16 +34,381 @@
 #include <cstdio>
 #include <array>
 #include <cassert>
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
 
 #ifdef __linux__
 #include <unistd.h>
 #include <cstdio>
+#include <cerrno>
+#include <fcntl.h>
+#include <spawn.h>
 #include <sys/wait.h>
+
+extern char** environ; // NOLINT
 #endif // __linux__
 
 namespace miopen {
 namespace exec {
 
+static bool IsVariableName(const std::string& name)
+{
+    return !name.empty() && std::isdigit(name[0]) == 0 &&
+           std::all_of(name.begin(), name.end(), [](char c) {
+               return std::isalnum(static_cast<unsigned char>(c)) != 0 || c == '_';
+           });
+}
+
+bool ParseCommand(const std::string& line, Command& command)
+{
+    auto result = Command{};
+    auto word   = std::string{};
+    // A quoted empty string is a word too.
+    auto in_word = false;
+    auto quoted  = false;
+    // Position of the first unquoted '=' in the word.
+    auto assignment = std::string::npos;
+    // The redirection waiting for its file name.
+    auto redirect_fd = -1;
+
+    const auto finish_word = [&]() {
+        if(!in_word)
+            return;
+        if(redirect_fd >= 0)
+            result.redirects.push_back({redirect_fd, word});
+        else if(result.args.empty() && assignment != std::string::npos &&
+                IsVariableName(word.substr(0, assignment)))
+            result.env.push_back(word);
+        else
+            result.args.push_back(word);
+        word.clear();
+        in_word     = false;
+        quoted      = false;
+        assignment  = std::string::npos;
+        redirect_fd = -1;
+    };
+
+    for(std::size_t i = 0; i < line.size(); ++i)
+    {
+        const auto c = line[i];
+        if(c == ' ' || c == '\t' || c == '\n')
+        {
+            finish_word();
+        }
+        else if(c == '\'')
+        {
+            const auto end = line.find('\'', i + 1);
+            if(end == std::string::npos)
+                return false;
+            word.append(line, i + 1, end - i - 1);
+            i       = end;
+            in_word = quoted = true;
+        }
+        else if(c == '"')
+        {
+            for(++i; i < line.size() && line[i] != '"'; ++i)
+            {
+                if(line[i] == '$' || line[i] == '`')
+                    return false;
+                if(line[i] == '\\' && i + 1 < line.size() &&
+                   std::strchr("\"\\", line[i + 1]) != nullptr)
+                    ++i;
+                word += line[i];
+            }
+            if(i == line.size())
+                return false;
+            in_word = quoted = true;
+        }
+        else if(c == '\\')
+        {
+            if(++i == line.size())
+                return false;
+            word += line[i];
+            in_word = quoted = true;
+        }
+        else if(c == '>')
+        {
+            // The descriptor is a single unquoted digit right before '>'.
+            auto fd = 1;
+            if(in_word)
+            {
+                if(quoted || word.size() != 1 || std::isdigit(word[0]) == 0)
+                    return false;
+                fd = word[0] - '0';
+                word.clear();
+                in_word = false;
+            }
+            if(redirect_fd >= 0 || (i + 1 < line.size() && line[i + 1] == '>'))
+                return false;
+            if(i + 1 < line.size() && line[i + 1] == '&')
+            {
+                if(i + 2 >= line.size() || std::isdigit(line[i + 2]) == 0 ||
+                   (i + 3 < line.size() && std::isspace(line[i + 3]) == 0))
+                    return false;
+                result.redirects.push_back({fd, {}, line[i + 2] - '0'});
+                i += 2;
+            }
+            else
+            {
+                redirect_fd = fd;
+            }
+        }
+        else if(std::strchr("|&;<()$`*?[]{}~#!", c) != nullptr)
+        {
+            return false;
+        }
+        else
+        {
+            if(c == '=' && !quoted && assignment == std::string::npos)
+                assignment = word.size();
+            word += c;
+            in_word = true;
+        }
+    }
+    finish_word();
+
+    if(redirect_fd >= 0 || result.args.empty())
+        return false;
+    command = std::move(result);
+    return true;
+}
+
+#ifdef __linux__
+static std::vector<char*> MakeArgv(std::vector<std::string>& strings)
+{
+    auto argv = std::vector<char*>{};
+    for(auto& str : strings)
+        argv.push_back(&str[0]);
+    argv.push_back(nullptr);
+    return argv;
+}
+
+/// The environment of the process with the variables of the command replaced.
+static std::vector<std::string> MakeEnvironment(const std::vector<std::string>& vars)
+{
+    auto env = std::vector<std::string>{};
+    for(auto var = environ; *var != nullptr; ++var)
+    {
+        const auto entry = std::string{*var};
+        const auto name  = entry.substr(0, entry.find('=') + 1);
+        if(std::none_of(vars.begin(), vars.end(), [&](const std::string& v) {
+               return v.compare(0, name.size(), name) == 0;
+           }))
+            env.push_back(entry);
+    }
+    env.insert(env.end(), vars.begin(), vars.end());
+    return env;
+}
+
+#if !MIOPEN_HAVE_SPAWN_ADDCHDIR
+/// The files execvp() would try to run the program from, in the same order.
+static std::vector<std::string> GetProgramFiles(const std::string& program)
+{
+    if(program.find('/') != std::string::npos)
+        return {program};
+
+    const auto path = std::getenv("PATH");
+    const auto dirs = std::string{path != nullptr ? path : "/bin:/usr/bin"};
+    auto files      = std::vector<std::string>{};
+    for(std::size_t begin = 0;;)
+    {
+        const auto end = dirs.find(':', begin);
+        const auto dir = dirs.substr(begin, end - begin);
+        files.push_back((dir.empty() ? "." : dir) + "/" + program);
+        if(end == std::string::npos)
+            break;
+        begin = end + 1;
+    }
+    return files;
+}
+
+/// Without posix_spawn_file_actions_addchdir_np() the child is forked and changes the
+/// working directory itself. The library may have other threads, so the child only calls
+/// async-signal-safe functions and everything it needs is prepared beforehand.
+static int ForkProcess(const Command& command, char* const* argv, char* const* envp)
+{
+    const auto files = GetProgramFiles(command.args.front());
+
+    // The child reports the error of exec through the pipe, which is closed by a successful one.
+    std::array<int, 2> fds{};
+    if(pipe2(fds.data(), O_CLOEXEC) != 0)
+        return -1;
+
+    const auto pid = fork();
+    if(pid == 0)
+    {
+        const auto error = [&]() {
+            if(chdir(command.dir.c_str()) != 0)
+                return errno;
+            for(const auto& redirect : command.redirects)
+            {
+                if(redirect.path.empty())
+                {
+                    if(dup2(redirect.target_fd, redirect.fd) < 0)
+                        return errno;
+                    continue;
+                }
+                const auto fd = open(redirect.path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0666);
+                if(fd < 0)
+                    return errno;
+                if(fd != redirect.fd)
+                {
+                    if(dup2(fd, redirect.fd) < 0)
+                        return errno;
+                    close(fd);
+                }
+            }
+            // As execvp(), skip the files which are missing or can't be run.
+            auto denied = false;
+            for(const auto& file : files)
+            {
+                execve(file.c_str(), argv, envp);
+                if(errno == EACCES)
+                    denied = true;
+                else if(errno != ENOENT && errno != ENOTDIR)
+                    return errno;
+            }
+            return denied ? EACCES : ENOENT;
+        }();
+        const auto written = write(fds[1], &error, sizeof(error));
+        (void)written;
+        _exit(127);
+    }
+
+    const auto fork_error = errno;
+    close(fds[1]);
+    if(pid < 0)
+    {
+        close(fds[0]);
+        MIOPEN_LOG_I("Can't start " << command.args.front() << ": " << std::strerror(fork_error));
+        return -1;
+    }
+
+    auto error     = 0;
+    auto read_size = ssize_t{0};
+    while((read_size = read(fds[0], &error, sizeof(error))) < 0 && errno == EINTR)
+    {
+    }
+    close(fds[0]);
+    if(read_size > 0)
+    {
+        WaitProcess(pid);
+        MIOPEN_LOG_I("Can't start " << command.args.front() << ": " << std::strerror(error));
+        return -1;
+    }
+    return pid;
+}
+#endif
+
+int StartProcess(const Command& command)
+{
+    if(command.args.empty())
+        MIOPEN_THROW("miopen::exec: empty command");
+
+    auto args = command.args;
+    auto env  = MakeEnvironment(command.env);
+    auto argv = MakeArgv(args);
+    auto envp = MakeArgv(env);
+
+#if !MIOPEN_HAVE_SPAWN_ADDCHDIR
+    if(!command.dir.empty())
+        return ForkProcess(command, argv.data(), envp.data());
+#endif
+
+    posix_spawn_file_actions_t actions;
+    auto error = posix_spawn_file_actions_init(&actions);
+    if(error != 0)
+        return -1;
+
+#if MIOPEN_HAVE_SPAWN_ADDCHDIR
+    if(!command.dir.empty())
+        error = posix_spawn_file_actions_addchdir_np(&actions, command.dir.c_str());
+#endif
+    for(const auto& redirect : command.redirects)
+    {
+        if(error != 0)
+            break;
+        if(redirect.path.empty())
+            error = posix_spawn_file_actions_adddup2(&actions, redirect.target_fd, redirect.fd);
+        else
+            error = posix_spawn_file_actions_addopen(&actions,
+                                                     redirect.fd,
+                                                     redirect.path.c_str(),
+                                                     O_WRONLY | O_CREAT | O_TRUNC,
+                                                     0666);
+    }
+    auto pid = pid_t{};
+    if(error == 0)
+        error = posix_spawnp(&pid, argv[0], &actions, nullptr, argv.data(), envp.data());
+
+    posix_spawn_file_actions_destroy(&actions);
+    if(error != 0)
+    {
+        MIOPEN_LOG_I("Can't start " << command.args.front() << ": " << std::strerror(error));
+        return -1;
+    }
+    return pid;
+}
+
+int WaitProcess(int pid)
+{
+    auto status = 0;
+    while(waitpid(pid, &status, 0) < 0)
+    {
+        if(errno != EINTR)
+            MIOPEN_THROW("miopen::exec: waitpid() failed: " + std::string{std::strerror(errno)});
+    }
+    if(WIFSIGNALED(status))
+        return 128 + WTERMSIG(status);
+    return WEXITSTATUS(status);
+}
+#else
+int StartProcess(const Command& command)
+{
+    (void)command;
+    return -1;
+}
+
+int WaitProcess(int pid)
+{
+    (void)pid;
+    return -1;
+}
+#endif // __linux__
+
+int Spawn(const Command& command)
+{
+    const auto pid = StartProcess(command);
+    return pid < 0 ? 127 : WaitProcess(pid);
+}
+
+#ifdef __linux__
+static void Transfer(FILE* pipe, std::istream* in, std::ostream* out)
+{
+    std::array<char, 1024> buffer{};
+
+    if(out != nullptr)
+    {
+        while(feof(pipe) == 0)
+            if(fgets(buffer.data(), buffer.size(), pipe) != nullptr)
+                *out << buffer.data();
+    }
+    else if(in != nullptr)
+    {
+        while(!in->eof())
+        {
+            in->read(buffer.data(), buffer.size() - 1);
+            buffer[in->gcount()] = 0;
+
+            if(fputs(buffer.data(), pipe) == EOF)
+                MIOPEN_THROW("miopen::exec::Run(): fputs() failed");
+        }
+    }
+}
+#endif // __linux__
+
 int Run(const std::string& p, std::istream* in, std::ostream* out)
 {
 #ifdef __linux__
@@ -52,34 +418,58 @@ int Run(const std::string& p, std::istream* in, std::ostream* out)
     assert(!(redirect_stdin && redirect_stdout));
 
     const auto file_mode = redirect_stdout ? "r" : "w";
-    MIOPEN_MANAGE_PTR(FILE*, pclose) pipe{popen(p.c_str(), file_mode)};
 
-    if(!pipe)
-        MIOPEN_THROW("miopen::exec::Run(): popen(" + p + ", " + file_mode + ") failed");
-
-    if(redirect_stdin || redirect_stdout)
+    auto command = Command{};
+    if(ParseCommand(p, command))
     {
-        std::array<char, 1024> buffer{};
+        if(!redirect_stdin && !redirect_stdout)
+            return Spawn(command);
 
-        if(redirect_stdout)
+        std::array<int, 2> fds{};
+        if(pipe2(fds.data(), O_CLOEXEC) != 0)
+            MIOPEN_THROW("miopen::exec::Run(): pipe2() failed");
+        const auto child  = redirect_stdout ? fds[1] : fds[0];
+        const auto parent = redirect_stdout ? fds[0] : fds[1];
+        const auto fd     = redirect_stdout ? STDOUT_FILENO : STDIN_FILENO;
+        command.redirects.insert(command.redirects.begin(), Redirect{fd, {}, child});
+
+        const auto pid = StartProcess(command);
+        close(child);
+        if(pid < 0)
         {
-            while(feof(pipe.get()) == 0)
-                if(fgets(buffer.data(), buffer.size(), pipe.get()) != nullptr)
-                    *out << buffer.data();
+            close(parent);
+            return 127;
         }
-        else
+
         {
-            while(!in->eof())
+            MIOPEN_MANAGE_PTR(FILE*, fclose) pipe{fdopen(parent, file_mode)};
+            if(!pipe)
             {
-                in->read(buffer.data(), buffer.size() - 1);
-                buffer[in->gcount()] = 0;
-
-                if(fputs(buffer.data(), pipe.get()) == EOF)
-                    MIOPEN_THROW("miopen::exec::Run(): fputs() failed");
+                close(parent);
+                WaitProcess(pid);
+                MIOPEN_THROW("miopen::exec::Run(): fdopen() failed");
+            }
+            try
+            {
+                Transfer(pipe.get(), in, out);
+            }
+            catch(...)
+            {
+                pipe.reset();
+                WaitProcess(pid);
+                throw;
             }
         }
+        return WaitProcess(pid);
     }
 
+    MIOPEN_MANAGE_PTR(FILE*, pclose) pipe{popen(p.c_str(), file_mode)};
+
+    if(!pipe)
+        MIOPEN_THROW("miopen::exec::Run(): popen(" + p + ", " + file_mode + ") failed");
+
+    Transfer(pipe.get(), in, out);
+
     auto status = pclose(pipe.release());
     return WEXITSTATUS(status);
 #else
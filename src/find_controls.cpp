@@ -38,6 +38,7 @@
 
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_FIND_ENFORCE)
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_FIND_ONLY_SOLVER)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_SOLVER_EVAL_THREADS)
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_FIND_MODE)
 
 namespace miopen {
@@ -137,6 +138,11 @@ solver::Id GetEnvFindOnlySolver()
     return once;
 }
 
+std::size_t GetSolverEvaluationThreads()
+{
+    return miopen::Value(MIOPEN_DEBUG_SOLVER_EVAL_THREADS{});
+}
+
 namespace {
 
 const char* ToCString(const FindMode::Values mode)
@@ -31,6 +31,8 @@
 #include <miopen/logger.hpp>
 #include <miopen/perf_field.hpp>
 
+#include <boost/filesystem/operations.hpp>
+
 #include <string>
 #include <vector>
 
@@ -49,8 +51,15 @@ template <class TDb>
 std::string FindDbRecord_t<TDb>::GetInstalledPath(Handle& handle)
 {
 #if !MIOPEN_DISABLE_SYSDB
-    return GetSystemDbPath() + "/" + handle.GetDbBasename() + "." + GetSystemFindDbSuffix() +
-           ".fdb.txt";
+    const auto base_path =
+        GetSystemDbPath() + "/" + handle.GetDbBasename() + "." + GetSystemFindDbSuffix();
+#if MIOPEN_DEBUG_FIND_DB_CACHING
+    // The binary form of the db is used when installed; it is produced by MIOpenDbConvert.
+    const auto binary_path = base_path + ".fdb.bin";
+    if(!MIOPEN_EMBED_DB && boost::filesystem::exists(binary_path))
+        return binary_path;
+#endif
+    return base_path + ".fdb.txt";
 #else
     (void)(handle);
     return "";
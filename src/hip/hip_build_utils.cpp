@@ -30,6 +30,7 @@
 #include <miopen/exec_utils.hpp>
 #include <miopen/logger.hpp>
 #include <miopen/env.hpp>
+#include <miopen/md5.hpp>
 #include <miopen/rocm_features.hpp>
 #include <miopen/solver/implicitgemm_util.hpp>
 #include <miopen/target_properties.hpp>
@@ -40,18 +41,27 @@
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_HIP_ENFORCE_COV3)
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_HIP_VERBOSE)
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_HIP_DUMP)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_HIP_COMPILER)
 
 namespace miopen {
 
+/// Command which compiles HIP kernels. It can be replaced, e.g. by a stub in tests that
+/// measure the overhead of builds.
+static std::string GetHipCompilerCommand()
+{
+    const auto command = GetStringEnv(MIOPEN_DEBUG_HIP_COMPILER{});
+    return command != nullptr ? command : MIOPEN_HIP_COMPILER;
+}
+
 bool IsHccCompiler()
 {
-    static const auto isHcc = EndsWith(MIOPEN_HIP_COMPILER, "hcc");
+    static const auto isHcc = EndsWith(GetHipCompilerCommand(), "hcc");
     return isHcc;
 }
 
 bool IsHipClangCompiler()
 {
-    static const auto isClangXX = EndsWith(MIOPEN_HIP_COMPILER, "clang++");
+    static const auto isClangXX = EndsWith(GetHipCompilerCommand(), "clang++");
     return isClangXX;
 }
 
@@ -84,8 +94,38 @@ inline const std::string& GetCoV3Option(const bool enable)
     else
         return no_option;
 }
+
+struct HipKernelIncDir
+{
+    HipKernelIncDir() : dir("hip-inc-" + GetContentHash())
+    {
+        for(const auto& inc_file : GetHipKernelIncList())
+            WriteFile(GetKernelInc(inc_file), dir.path / inc_file);
+        MIOPEN_LOG_I2("HIP kernel includes written to " << dir.path.string());
+    }
+
+    TmpDir dir;
+
+    private:
+    static std::string GetContentHash()
+    {
+        std::string content;
+        for(const auto& inc_file : GetHipKernelIncList())
+            content += inc_file + '\0' + GetKernelInc(inc_file) + '\0';
+        return md5(content).substr(0, 16);
+    }
+};
 } // namespace
 
+const boost::filesystem::path& GetHipKernelIncDir()
+{
+    // The includes are embedded into the library, so they are written once and shared by all the
+    // builds of the process. Tmp dirs of builds from different library versions, e.g. kept by
+    // MIOPEN_DEBUG_SAVE_TEMP_DIR, can be told apart by the content hash.
+    static const HipKernelIncDir inc_dir;
+    return inc_dir.dir.path;
+}
+
 static boost::filesystem::path HipBuildImpl(boost::optional<TmpDir>& tmp_dir,
                                             const std::string& filename,
                                             std::string src,
@@ -95,19 +135,9 @@ static boost::filesystem::path HipBuildImpl(boost::optional<TmpDir>& tmp_dir,
                                             const bool sources_already_reside_on_filesystem)
 {
 #ifdef __linux__
-    // Write out the include files
     // Let's assume includes are overkill for feature tests & optimize'em out.
-    if(!testing_mode)
-    {
-        auto inc_list = GetHipKernelIncList();
-        auto inc_path = tmp_dir->path;
-        boost::filesystem::create_directories(inc_path);
-        for(auto inc_file : inc_list)
-        {
-            auto inc_src = GetKernelInc(inc_file);
-            WriteFile(inc_src, inc_path / inc_file);
-        }
-    }
+    const auto inc_option =
+        testing_mode ? std::string{} : std::string{" -I"} + GetHipKernelIncDir().string() + " ";
 
     // Sources produced by MLIR-cpp already reside in tmp dir.
     if(!sources_already_reside_on_filesystem)
@@ -141,6 +171,7 @@ static boost::filesystem::path HipBuildImpl(boost::optional<TmpDir>& tmp_dir,
     }
 
     params += " -Wno-unused-command-line-argument -I. ";
+    params += inc_option;
     params += MIOPEN_STRINGIZE(HIP_COMPILER_FLAGS);
     if(IsHccCompiler())
     {
@@ -185,7 +216,7 @@ static boost::filesystem::path HipBuildImpl(boost::optional<TmpDir>& tmp_dir,
 
     // compile
     const std::string redirector = testing_mode ? " 1>/dev/null 2>&1" : "";
-    tmp_dir->Execute(env + std::string(" ") + MIOPEN_HIP_COMPILER,
+    tmp_dir->Execute(env + std::string(" ") + GetHipCompilerCommand(),
                      params + filename + " -o " + bin_file.string() + redirector);
     if(!boost::filesystem::exists(bin_file))
         MIOPEN_THROW(filename + " failed to compile");
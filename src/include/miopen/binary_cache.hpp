@@ -30,6 +30,7 @@
 #include <miopen/config.h>
 #include <miopen/target_properties.hpp>
 #include <boost/filesystem/path.hpp>
+#include <memory>
 #include <string>
 
 namespace miopen {
@@ -67,6 +68,46 @@ void SaveBinary(const std::string& hsaco,
                 bool is_kernel_str = false);
 #endif
 
+/// Queues the binaries which are saved by the threads that have entered the batch (see Scope)
+/// and stores them at once, in a single transaction per kernel cache database, by Store() or upon
+/// destruction. Only the SQLite kernel cache is batched, other caches are written immediately.
+class BinaryCacheBatch
+{
+    public:
+    /// While alive, SaveBinary() calls made by the constructing thread go to the batch.
+    class Scope
+    {
+        public:
+        Scope(BinaryCacheBatch& batch);
+        ~Scope();
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+        private:
+        BinaryCacheBatch* previous;
+    };
+
+    BinaryCacheBatch();
+    ~BinaryCacheBatch();
+    BinaryCacheBatch(const BinaryCacheBatch&) = delete;
+    BinaryCacheBatch& operator=(const BinaryCacheBatch&) = delete;
+    void Store();
+
+    private:
+    class impl;
+    std::unique_ptr<impl> pImpl;
+
+    static BinaryCacheBatch*& Current();
+#if MIOPEN_ENABLE_SQLITE_KERN_CACHE
+    friend void SaveBinary(const std::string& hsaco,
+                           const TargetProperties& target,
+                           std::size_t num_cu,
+                           const std::string& name,
+                           const std::string& args,
+                           bool is_kernel_str);
+#endif
+};
+
 } // namespace miopen
 
 #endif
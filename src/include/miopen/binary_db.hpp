@@ -0,0 +1,97 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_BINARY_DB_HPP_
+#define GUARD_MIOPEN_BINARY_DB_HPP_
+
+#include <boost/optional.hpp>
+#include <boost/utility/string_view.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace miopen {
+namespace binary_db {
+
+/// Binary form of a text find-db or perf-db. All integers are little-endian.
+///
+///   header:   "MIOPENDB", u32 version, u32 key width, u32 records count, u32 ids count
+///   ids:      ids count x (u16 size, chars), i.e. the interned IDs of all records
+///   index:    records count x (key padded with '\0' to key width, u32 payload offset),
+///             sorted by key
+///   payloads: per record u16 values count, then values count x (u16 id, u32 size, chars)
+///
+/// Payload offsets are relative to the beginning of the payloads section.
+///
+/// MIOpen loads only find-db files in this form (see FindDbRecord_t). Perf-db files can be
+/// converted too, but nothing reads a binary perf-db at run time.
+constexpr std::uint32_t Version = 1;
+
+bool IsBinary(boost::string_view data);
+
+/// Converts a text db to the binary form. As the text readers do, keeps the first occurrence
+/// of a key and ignores duplicated IDs within a record. Returns the number of records written.
+std::size_t
+TextToBinary(std::istream& text, std::ostream& binary, const std::string& source_name = "");
+
+/// Converts a binary db back to the text form. Records are written in the order of keys.
+void BinaryToText(boost::string_view binary, std::ostream& text);
+
+class Reader
+{
+    public:
+    using Values = std::vector<std::pair<boost::string_view, boost::string_view>>;
+
+    /// Does not copy the data, which has to outlive the reader.
+    /// Throws if the header or the tables are malformed.
+    Reader(boost::string_view data_);
+
+    std::size_t Size() const { return records_count; }
+    boost::string_view Key(std::size_t record) const;
+    boost::optional<std::size_t> Find(boost::string_view key) const;
+
+    /// Returns false if the payload is malformed. A record without values ("KEY=" in the text
+    /// form) is valid and gives no values.
+    bool Read(std::size_t record, Values& values) const;
+
+    private:
+    boost::string_view data;
+    std::size_t key_width     = 0;
+    std::size_t records_count = 0;
+    std::size_t index_offset  = 0;
+    std::size_t payloads      = 0;
+    std::vector<boost::string_view> ids;
+
+    std::size_t EntrySize() const { return key_width + sizeof(std::uint32_t); }
+};
+
+} // namespace binary_db
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_BINARY_DB_HPP_
@@ -32,7 +32,7 @@
 
 namespace miopen {
 void check_bz2_error(int e, const std::string& name);
-std::string compress(std::string s, bool* compressed = nullptr);
+std::string compress(std::string s, bool* compressed = nullptr, int block_size = 9);
 std::string decompress(std::string s, unsigned int size);
 
 } // namespace miopen
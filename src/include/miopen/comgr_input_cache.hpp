@@ -0,0 +1,132 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_COMGR_INPUT_CACHE_HPP_
+#define GUARD_MIOPEN_COMGR_INPUT_CACHE_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace miopen {
+namespace comgr {
+
+/// The comgr calls of InputCache. Abstracted so that the cache can be tested without comgr.
+class InputBackend
+{
+    public:
+    enum class Kind
+    {
+        Include,
+        PrecompiledHeader,
+    };
+
+    /// amd_comgr_data_t::handle
+    using Handle = std::uint64_t;
+
+    virtual ~InputBackend() = default;
+
+    /// Creates a named data object holding a copy of the content.
+    virtual Handle
+    Create(Kind kind, const std::string& name, const char* content, std::size_t size) = 0;
+    /// Drops the reference of the cache. The data sets the object has been added to hold their
+    /// own references.
+    virtual void Release(Handle handle) = 0;
+};
+
+struct InputFile
+{
+    InputBackend::Kind kind;
+    std::string name;
+    /// Must stay valid until InputCache::Get() returns.
+    const char* content;
+    std::size_t size;
+};
+
+/// Data objects shared by the builds. Released when the cache and the last build drop them.
+class InputSet
+{
+    public:
+    InputSet(std::shared_ptr<InputBackend> backend_, std::vector<InputBackend::Handle> handles_);
+    ~InputSet();
+
+    InputSet(const InputSet&) = delete;
+    InputSet& operator=(const InputSet&) = delete;
+
+    const std::vector<InputBackend::Handle>& GetHandles() const { return handles; }
+
+    private:
+    std::shared_ptr<InputBackend> backend;
+    std::vector<InputBackend::Handle> handles;
+};
+
+struct InputCacheStats
+{
+    std::size_t hits   = 0;
+    std::size_t misses = 0;
+    /// Time the callers of Get() have spent creating the inputs or waiting for them.
+    float prepare_ms = 0.0f;
+};
+
+/// Creates the inputs which are the same for many builds, e.g. the include files and the
+/// precompiled header of HIP, once per key instead of once per build.
+class InputCache
+{
+    public:
+    using Files = std::vector<InputFile>;
+
+    InputCache(std::shared_ptr<InputBackend> backend_);
+
+    /// Returns the inputs of the key, `list` gives their files on the first request. Concurrent
+    /// first requests create the inputs once, the others wait. If creating throws, the waiting
+    /// requests rethrow and the next one tries again.
+    std::shared_ptr<const InputSet> Get(const std::string& key, const std::function<Files()>& list);
+
+    /// Drops all the inputs. The builds which use them keep them until they are done.
+    void Clear();
+
+    InputCacheStats GetStats() const;
+
+    private:
+    using Entry = std::shared_future<std::shared_ptr<const InputSet>>;
+
+    std::shared_ptr<InputBackend> backend;
+    mutable std::mutex mutex;
+    std::unordered_map<std::string, Entry> entries;
+    InputCacheStats stats;
+
+    std::shared_ptr<const InputSet> Create(const Files& files) const;
+};
+
+} // namespace comgr
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_COMGR_INPUT_CACHE_HPP_
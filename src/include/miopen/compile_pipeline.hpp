@@ -0,0 +1,130 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_COMPILE_PIPELINE_HPP_
+#define GUARD_MIOPEN_COMPILE_PIPELINE_HPP_
+
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#ifdef __MINGW32__
+#include <mingw.thread.h>
+#else
+#include <thread>
+#endif
+
+namespace miopen {
+
+/// Builds the kernels of tuning configs on background threads while the configs built earlier
+/// are being measured.
+///
+/// The configs are built in the order they are scheduled, at most `window` configs ahead of
+/// the last one waited for, so the configs a search does not get to because of its budget are
+/// mostly not built at all. The build function runs on a worker and returns the step which
+/// completes the config (e.g. adds the programs to the handle); that step runs on the thread
+/// which waits for the config.
+class CompilePipeline
+{
+    public:
+    using Finish = std::function<void()>;
+    using Build  = std::function<Finish(std::size_t)>;
+
+    /// Zero threads disables the pipeline: nothing is scheduled and Wait() returns false.
+    CompilePipeline(Build build_, std::size_t threads_, std::size_t window_);
+    ~CompilePipeline();
+
+    CompilePipeline(const CompilePipeline&) = delete;
+    CompilePipeline& operator=(const CompilePipeline&) = delete;
+
+    /// Number of workers from MIOPEN_COMPILE_PARALLEL_LEVEL.
+    static std::size_t GetDefaultThreads();
+
+    /// Replaces the configs to build. The configs scheduled before and not started yet are
+    /// dropped.
+    void Schedule(const std::vector<std::size_t>& indices);
+
+    /// Blocks until the config is built and completes it. A config which is scheduled but not
+    /// started yet is built by the calling thread. Rethrows the exception thrown by the build.
+    /// Returns false if the config is not scheduled.
+    bool Wait(std::size_t index);
+
+    /// Blocks until all the scheduled configs are built, and drops them without completing.
+    void Drain();
+
+    /// Drops the configs which are not started yet.
+    void Cancel();
+
+    std::size_t GetBuilt() const;
+    std::size_t GetCancelled() const;
+    /// Time the callers of Wait() have been blocked or building configs themselves.
+    float GetWaitTimeMs() const;
+
+    private:
+    enum class State
+    {
+        Queued,
+        Building,
+        Ready,
+    };
+
+    struct Entry
+    {
+        State state;
+        std::size_t position;
+        Finish finish;
+        std::exception_ptr error;
+    };
+
+    Build build;
+    const std::size_t max_threads;
+    const std::size_t window;
+
+    mutable std::mutex mutex;
+    std::condition_variable has_work;
+    std::condition_variable has_built;
+    std::vector<std::thread> workers;
+    std::unordered_map<std::size_t, Entry> entries;
+    std::vector<std::size_t> order;
+    std::size_t next     = 0;
+    std::size_t consumed = 0;
+    std::size_t built    = 0;
+    std::size_t dropped  = 0;
+    std::size_t building = 0;
+    float wait_ms        = 0.0f;
+    bool stopping        = false;
+
+    void WorkerLoop();
+    void BuildEntry(std::unique_lock<std::mutex>& lock, std::size_t index);
+    void DropQueued();
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_COMPILE_PIPELINE_HPP_
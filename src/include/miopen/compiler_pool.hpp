@@ -0,0 +1,97 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_COMPILER_POOL_HPP_
+#define GUARD_MIOPEN_COMPILER_POOL_HPP_
+
+#include <miopen/exec_utils.hpp>
+
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace miopen {
+
+/// Runs the compiler command lines of the kernel builds.
+///
+/// At most `max_jobs` commands run at once, the callers above the limit block. If a worker
+/// command is set, the commands are sent over a socket to long-lived worker processes which
+/// serve CompilerWorkerMain(), one command at a time per worker, and spawn them from there.
+/// Otherwise the calling thread spawns the command itself. Neither way uses a shell.
+class CompilerPool
+{
+    public:
+    CompilerPool(std::size_t max_jobs_, std::vector<std::string> worker_ = {});
+    ~CompilerPool();
+
+    CompilerPool(const CompilerPool&) = delete;
+    CompilerPool& operator=(const CompilerPool&) = delete;
+
+    /// MIOPEN_COMPILE_PARALLEL_LEVEL jobs, workers started from the executable in
+    /// MIOPEN_COMPILER_WORKER, e.g. MIOpenCompilerWorker.
+    static CompilerPool& GetDefault();
+
+    /// Returns the exit status of the command. A worker which fails is stopped and the command
+    /// is spawned by the calling thread.
+    int Run(const exec::Command& command);
+
+    std::size_t GetBuildCount() const;
+    /// Workers which are running.
+    std::size_t GetWorkerCount() const;
+    /// Latency of the builds, including the wait for a free job.
+    float GetTotalTimeMs() const;
+    float GetMaxTimeMs() const;
+
+    private:
+    struct Worker
+    {
+        int pid;
+        int fd;
+    };
+
+    const std::size_t max_jobs;
+    const std::vector<std::string> worker;
+
+    mutable std::mutex mutex;
+    std::condition_variable has_job;
+    std::vector<Worker> idle;
+    std::size_t running = 0;
+    std::size_t workers = 0;
+    std::size_t builds  = 0;
+    float total_ms      = 0.0f;
+    float max_ms        = 0.0f;
+
+    bool StartWorker(Worker& started) const;
+    static void StopWorker(const Worker& stopped);
+};
+
+/// Serves the commands of a CompilerPool sent over the socket on stdin, until it is closed.
+int CompilerWorkerMain();
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_COMPILER_POOL_HPP_
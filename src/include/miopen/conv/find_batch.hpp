@@ -0,0 +1,71 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#pragma once
+
+#include <miopen/common.hpp>
+#include <miopen/miopen.h>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace miopen {
+
+struct ConvolutionDescriptor;
+struct Handle;
+struct TensorDescriptor;
+
+/// One layer of a batched forward Find. The fields are the arguments of
+/// ConvolutionDescriptor::FindConvFwdAlgorithm.
+struct ConvFwdFindRequest
+{
+    const ConvolutionDescriptor* conv = nullptr;
+    const TensorDescriptor* xDesc     = nullptr;
+    ConstData_t x                     = nullptr;
+    const TensorDescriptor* wDesc     = nullptr;
+    ConstData_t w                     = nullptr;
+    const TensorDescriptor* yDesc     = nullptr;
+    Data_t y                          = nullptr;
+    Data_t workSpace                  = nullptr;
+    std::size_t workSpaceSize         = 0;
+    int requestAlgoCount              = 0;
+    int* returnedAlgoCount            = nullptr;
+    miopenConvAlgoPerf_t* perfResults = nullptr;
+};
+
+/// Groups the requests by their network configs. Groups are ordered by the first appearance
+/// of the config, indices within a group are ascending. Only the first request of a group
+/// is searched, the rest get a copy of its results.
+std::vector<std::vector<std::size_t>> GroupFindRequests(const std::vector<std::string>& keys);
+
+/// Finds forward convolution algorithms for a whole network at once. Identical problems are
+/// searched once, and the kernels of all the candidates of all the layers are compiled in a
+/// single parallel batch before any of them is benchmarked.
+void FindConvFwdAlgorithmBatch(Handle& handle,
+                               const std::vector<ConvFwdFindRequest>& requests,
+                               bool exhaustiveSearch);
+
+} // namespace miopen
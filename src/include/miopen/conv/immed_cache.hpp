@@ -0,0 +1,112 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#pragma once
+
+#include <miopen/miopen.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace miopen {
+
+struct ConvolutionContext;
+struct ProblemDescription;
+
+namespace conv {
+
+struct ImmedCacheStats
+{
+    std::size_t hits      = 0;
+    std::size_t misses    = 0;
+    std::size_t evictions = 0;
+};
+
+/// Sorted solution lists of the immediate mode, memoized per problem. Applicability of solvers
+/// depends on the problem, the device, the execution context and the environment, which all make
+/// up the key. Every miss costs a scan of the solvers (or a disk lookup) by the caller.
+///
+/// When full, the least recently used eighth of the entries is evicted. Lookups only take a
+/// shared lock and mark the entry used with an atomic counter.
+class ImmedSolutionsCache
+{
+    public:
+    using Solutions = std::vector<miopenConvSolution_t>;
+
+    explicit ImmedSolutionsCache(std::size_t max_entries_ = 64 * 1024);
+
+    static ImmedSolutionsCache& Instance();
+
+    bool Find(const std::string& key, Solutions& solutions) const;
+    void Store(const std::string& key, const Solutions& solutions);
+    void Clear();
+
+    std::size_t Size() const;
+    ImmedCacheStats GetStats() const;
+
+    private:
+    struct Entry
+    {
+        Solutions solutions;
+        mutable std::atomic<std::uint64_t> last_used{0};
+    };
+
+    void Evict();
+
+    std::size_t max_entries;
+    mutable std::atomic<std::uint64_t> clock{0};
+    mutable std::atomic<std::size_t> hits{0};
+    mutable std::atomic<std::size_t> misses{0};
+    std::size_t evictions = 0;
+    mutable std::shared_timed_mutex mutex;
+    std::unordered_map<std::string, Entry> entries;
+};
+
+/// Builds the key of the cache. Device is the database basename of the handle, algorithms is the
+/// mask of enabled miopenConvAlgorithm_t values, kind tells different lists of the same problem
+/// apart.
+std::string GetImmedCacheKey(const ConvolutionContext& ctx,
+                             const miopen::ProblemDescription& problem,
+                             char kind,
+                             const std::string& device,
+                             unsigned algorithms);
+
+/// Reads the list stored by StoreImmedSolutions from the plain text database at path. Returns
+/// false if there is no record or it refers to unknown solvers.
+bool LoadImmedSolutions(const std::string& path,
+                        const std::string& key,
+                        ImmedSolutionsCache::Solutions& solutions);
+
+bool StoreImmedSolutions(const std::string& path,
+                         const std::string& key,
+                         const ImmedSolutionsCache::Solutions& solutions);
+
+} // namespace conv
+} // namespace miopen
@@ -33,6 +33,7 @@
 
 #include <boost/optional.hpp>
 
+#include <functional>
 #include <string>
 #include <vector>
 #include <ostream>
@@ -88,6 +89,12 @@ struct ConvSolution
 
 std::ostream& operator<<(std::ostream& os, const ConvSolution& s);
 
+/// Kernels of the succeeded solutions which are not built yet. A kernel used by several
+/// solutions (or several problems) is returned once, as the program cache is keyed by
+/// the kernel file and the compilation options only.
+std::vector<KernelInfo> GetKernelsToBuild(const std::vector<const ConvSolution*>& sols,
+                                          const std::function<bool(const KernelInfo&)>& is_built);
+
 void PrecompileSolutions(const Handle& h, const std::vector<const ConvSolution*>& sols);
 
 } // namespace solver
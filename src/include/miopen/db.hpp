@@ -27,6 +27,7 @@
 #define GUARD_MIOPEN_DB_HPP_
 
 #include <miopen/db_record.hpp>
+#include <miopen/db_record_cache.hpp>
 #include <miopen/rank.hpp>
 
 #include <boost/core/explicit_operator_bool.hpp>
@@ -35,6 +36,7 @@
 
 #include <chrono>
 #include <string>
+#include <type_traits>
 
 namespace boost {
 namespace filesystem {
@@ -48,6 +50,15 @@ struct RecordPositions;
 class LockFile;
 
 /// No instance of this class should be used from several threads at the same time.
+///
+/// In the indexed mode (see MIOPEN_DEBUG_TEXT_DB_INDEX) lookups are served from a process-wide
+/// memory-mapped key index which is rebuilt only when size or modification time of the file
+/// changes. Updates are appended to the end of the file, the last occurrence of a key wins and an
+/// empty payload ("KEY=") marks the key as removed. The file is compacted once stale lines take up
+/// more than a half of it. Files in this format start with a marker line; the default mode
+/// recognizes it, reads such files the same way and routes its own updates through the indexed
+/// writer, so both modes may share the same db file. An unmarked file is compacted and marked on
+/// its first indexed update.
 class PlainTextDb
 {
     public:
@@ -58,6 +69,8 @@ class PlainTextDb
 
     PlainTextDb(const std::string& filename_, bool is_system = false);
 
+    PlainTextDb(const std::string& filename_, bool is_system, bool indexed_);
+
     /// Searches db for provided key and returns found record or none if key not found in database
     boost::optional<DbRecord> FindRecord(const std::string& key);
 
@@ -145,9 +158,13 @@ class PlainTextDb
     std::string filename;
     LockFile& lock_file;
     const bool warn_if_unreadable;
+    const bool indexed;
 
     boost::optional<DbRecord> FindRecordUnsafe(const std::string& key, RecordPositions* pos);
+    boost::optional<DbRecord> FindRecordIndexedUnsafe(const std::string& key,
+                                                      RecordPositions* pos);
     bool FlushUnsafe(const DbRecord& record, const RecordPositions* pos);
+    bool FlushIndexedUnsafe(const DbRecord& record);
     bool StoreRecordUnsafe(const DbRecord& record);
     bool UpdateRecordUnsafe(DbRecord& record);
     bool RemoveRecordUnsafe(const std::string& key);
@@ -160,6 +177,26 @@ class PlainTextDb
     }
 };
 
+template <class TDb, class F>
+auto BatchWrites(rank<1>, TDb& db, const F& f) -> decltype(db.Batch(f))
+{
+    return db.Batch(f);
+}
+
+template <class TDb, class F>
+void BatchWrites(rank<0>, TDb&, const F& f)
+{
+    f();
+}
+
+/// Runs f, which writes to db, as a single batch if the db is able to group its writes (as the
+/// SQLite ones do by means of a transaction). Otherwise, the writes are done one by one.
+template <class TDb, class F>
+void BatchWrites(TDb& db, const F& f)
+{
+    BatchWrites(rank<1>{}, db, f);
+}
+
 #if MIOPEN_DISABLE_USERDB
 struct sink
 {
@@ -170,56 +207,68 @@ struct sink
 };
 #endif
 
+/// Lookups of DbRecords are served through the process-wide DbRecordCache.
 template <class TInstalled, class TUser, bool merge_records>
 class MultiFileDb
 {
     public:
-    MultiFileDb(const std::string& installed_path,
-                const std::string& user_path,
+    MultiFileDb(const std::string& installed_path_,
+                const std::string& user_path_,
                 const std::string& arch  = "",
                 const std::size_t num_cu = 0)
-        : _installed(GetDbInstance<TInstalled>(installed_path, true, arch, num_cu))
+        : installed_path(installed_path_),
+          user_path(user_path_),
+          cache_prefix(installed_path + '\n' + user_path + '\n' + arch + '\n' +
+                       std::to_string(num_cu) + '\n' + (merge_records ? "1" : "0") + '\n'),
+          _installed(GetDbInstance<TInstalled>(installed_path_, true, arch, num_cu))
 #if !MIOPEN_DISABLE_USERDB
           ,
-          _user(GetDbInstance<TUser>(user_path, false, arch, num_cu))
+          _user(GetDbInstance<TUser>(user_path_, false, arch, num_cu))
 #endif
     {
-#if MIOPEN_DISABLE_USERDB
-        (void)(user_path);
-#endif
     }
 
     template <bool merge = merge_records, std::enable_if_t<merge>* = nullptr, typename... U>
     auto FindRecord(const U&... args)
     {
+        return FindRecordCached(
+            rank<1>{},
+            [&]() {
 #if !MIOPEN_DISABLE_USERDB
-        auto users = _user.FindRecord(args...);
+                auto users = _user.FindRecord(args...);
 #endif
-        auto installed = _installed.FindRecord(args...);
+                auto installed = _installed.FindRecord(args...);
 
 #if !MIOPEN_DISABLE_USERDB
-        if(users && installed)
-        {
-            users->Merge(installed.value());
-            return users;
-        }
-
-        if(users)
-            return users;
+                if(users && installed)
+                {
+                    users->Merge(installed.value());
+                    return users;
+                }
+
+                if(users)
+                    return users;
 #endif
 
-        return installed;
+                return installed;
+            },
+            args...);
     }
 
     template <bool merge = merge_records, std::enable_if_t<!merge>* = nullptr, typename... U>
     auto FindRecord(const U&... args)
     {
+        return FindRecordCached(
+            rank<1>{},
+            [&]() {
 #if !MIOPEN_DISABLE_USERDB
-        auto users = _user.FindRecord(args...);
-        return users ? users : _installed.FindRecord(args...);
+                auto users = _user.FindRecord(args...);
+                return users ? users : _installed.FindRecord(args...);
 #else
-        return _installed.FindRecord(args...);
+                return _installed.FindRecord(args...);
 #endif
+            },
+            args...);
     }
 
     template <typename... U>
@@ -229,7 +278,9 @@ class MultiFileDb
         sink{args...};
         return true;
 #else
-        return _user.StoreRecord(args...);
+        auto ret = _user.StoreRecord(args...);
+        DbRecordCache::Instance().Invalidate();
+        return ret;
 #endif
     }
 
@@ -240,7 +291,9 @@ class MultiFileDb
         sink{args...};
         return true;
 #else
-        return _user.UpdateRecord(args...);
+        auto ret = _user.UpdateRecord(args...);
+        DbRecordCache::Instance().Invalidate();
+        return ret;
 #endif
     }
 
@@ -251,7 +304,9 @@ class MultiFileDb
         sink{args...};
         return true;
 #else
-        return _user.RemoveRecord(args...);
+        auto ret = _user.RemoveRecord(args...);
+        DbRecordCache::Instance().Invalidate();
+        return ret;
 #endif
     }
 
@@ -262,18 +317,16 @@ class MultiFileDb
         sink{args...};
         return true;
 #else
-        return _user.Update(args...);
+        auto ret = _user.Update(args...);
+        DbRecordCache::Instance().Invalidate();
+        return ret;
 #endif
     }
 
     template <typename... U>
     auto Load(U&... args)
     {
-#if !MIOPEN_DISABLE_USERDB
-        if(_user.Load(args...))
-            return true;
-#endif
-        return _installed.Load(args...);
+        return LoadCached(rank<1>{}, args...);
     }
 
     template <typename... U>
@@ -283,11 +336,94 @@ class MultiFileDb
         sink{args...};
         return true;
 #else
-        return _user.Remove(args...);
+        auto ret = _user.Remove(args...);
+        DbRecordCache::Instance().Invalidate();
+        return ret;
+#endif
+    }
+
+    /// Writes go to the user db only, so only its writes are batched.
+    template <class F>
+    void Batch(const F& f)
+    {
+#if MIOPEN_DISABLE_USERDB
+        f();
+#else
+        BatchWrites(_user, f);
 #endif
     }
 
     private:
+    std::string installed_path;
+    std::string user_path;
+    std::string cache_prefix;
+
+    template <class TFind, class... U>
+    static auto FindRecordCached(rank<0>, TFind&& find, const U&...)
+    {
+        return find();
+    }
+
+    /// Only lookups of DbRecords by a single key are cached.
+    template <class TFind,
+              class TProblem,
+              std::enable_if_t<std::is_same<decltype(std::declval<TFind&>()()),
+                                            boost::optional<DbRecord>>{}>* = nullptr>
+    boost::optional<DbRecord> FindRecordCached(rank<1>, TFind&& find, const TProblem& problem)
+    {
+        auto& cache = DbRecordCache::Instance();
+        if(!cache.IsEnabled())
+            return find();
+
+        const auto key   = cache_prefix + DbRecordCache::GetKey(problem);
+        const auto stamp = cache.GetStamp(installed_path, user_path);
+        auto cached      = cache.Find(key, stamp);
+
+        if(cached)
+            return std::move(*cached);
+
+        auto record = find();
+        cache.Insert(key, stamp, record);
+        return record;
+    }
+
+    template <typename... U>
+    auto LoadCached(rank<0>, U&... args)
+    {
+#if !MIOPEN_DISABLE_USERDB
+        if(_user.Load(args...))
+            return true;
+#endif
+        return _installed.Load(args...);
+    }
+
+    /// A merged record has the values of the user db whenever it has them, so it can answer
+    /// Load. Values which fail to deserialize are looked up in the dbs once again, as the
+    /// installed db may hold valid ones.
+    /// The arguments are taken the same way as by the overload above, so that only the rank
+    /// selects between them.
+    template <class TProblem,
+              class TId,
+              class TValue,
+              bool merge = merge_records,
+              class TFound =
+                  decltype(std::declval<TInstalled&>().FindRecord(std::declval<const TProblem&>())),
+              std::enable_if_t<merge && std::is_convertible<TId&, const std::string&>{} &&
+                               std::is_same<TFound, boost::optional<DbRecord>>{}>* = nullptr>
+    bool LoadCached(rank<1>, TProblem& problem, TId& id, TValue& values)
+    {
+        if(DbRecordCache::Instance().IsEnabled())
+        {
+            const auto record = FindRecord(problem);
+            if(!record || !DbRecordCache::HasValues(*record, id))
+                return false;
+            if(record->GetValues(id, values))
+                return true;
+        }
+
+        return LoadCached(rank<0>{}, problem, id, values);
+    }
+
     template <class TDb, class TRet = decltype(TDb::GetCached("", true, "", 0))>
     static TRet GetDbInstance(rank<1>,
                               const std::string& path,
@@ -374,6 +510,12 @@ class DbTimer
         return Measure("Remove", [&]() { return inner.Remove(args...); });
     }
 
+    template <class F>
+    void Batch(const F& f)
+    {
+        BatchWrites(inner, f);
+    }
+
     private:
     TInnerDb inner;
 
@@ -242,6 +242,7 @@ class DbRecord
     friend class PlainTextDb;
     friend class SQLitePerfDb;
     friend class ReadonlyRamDb;
+    friend class DbRecordCache;
 };
 
 } // namespace miopen
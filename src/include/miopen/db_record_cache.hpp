@@ -0,0 +1,166 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_DB_RECORD_CACHE_HPP_
+#define GUARD_MIOPEN_DB_RECORD_CACHE_HPP_
+
+#include <miopen/db_record.hpp>
+#include <miopen/rank.hpp>
+
+#include <boost/optional.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace miopen {
+
+/// Process-wide cache of records found by MultiFileDb, shared by all threads and db instances.
+///
+/// Entries are keyed by db paths and a problem key and hold merged records, including the
+/// knowledge that a record is absent. The cache is split into shards with their own reader-writer
+/// locks, so concurrent lookups of cached records serialize neither on each other nor on the db
+/// file locks. An entry is ignored once inode, modification time or size of any of its db files
+/// changes, and all entries are dropped when the process writes through a MultiFileDb. A full
+/// shard evicts its least recently used entries.
+///
+/// The capacity in records is set by MIOPEN_DEBUG_DB_CACHE_SIZE, 0 disables the cache.
+class DbRecordCache
+{
+    public:
+    struct Stats
+    {
+        std::size_t hits   = 0;
+        std::size_t misses = 0;
+    };
+
+    struct FileStamp
+    {
+        std::uint64_t inode = 0;
+        std::int64_t mtime  = -1;
+        std::int64_t size   = -1;
+
+        bool operator==(const FileStamp& other) const
+        {
+            return inode == other.inode && mtime == other.mtime && size == other.size;
+        }
+    };
+
+    /// State of the db files and of the process writes the cached record corresponds to.
+    struct Stamp
+    {
+        std::uint64_t generation = 0;
+        FileStamp installed;
+        FileStamp user;
+        FileStamp user_wal;
+
+        bool operator==(const Stamp& other) const
+        {
+            return generation == other.generation && installed == other.installed &&
+                   user == other.user && user_wal == other.user_wal;
+        }
+    };
+
+    DbRecordCache(std::size_t capacity_);
+    ~DbRecordCache();
+
+    static DbRecordCache& Instance();
+
+    bool IsEnabled() const { return capacity > 0; }
+
+    Stamp GetStamp(const std::string& installed_path, const std::string& user_path) const;
+
+    /// Returns none on a miss. A hit holds none if the db has no record under the key.
+    boost::optional<boost::optional<DbRecord>> Find(const std::string& key, const Stamp& stamp);
+
+    void
+    Insert(const std::string& key, const Stamp& stamp, const boost::optional<DbRecord>& record);
+
+    /// Makes all the entries stale. Shall be called after any write to a cached db.
+    void Invalidate() { ++generation; }
+
+    /// Removes all the entries and resets the statistics.
+    void Clear();
+
+    Stats GetStats() const;
+
+    static const std::string& GetKey(const std::string& key) { return key; }
+
+    /// Problems are keyed by their text db serialization or, if they can only be stored in
+    /// SQLite dbs, by their SQL where-clause along with its values.
+    template <class TProblem>
+    static std::string GetKey(const TProblem& problem)
+    {
+        return GetKey(rank<1>{}, problem);
+    }
+
+    /// Tells if the record has values under the ID, regardless of whether they can be
+    /// deserialized.
+    static bool HasValues(const DbRecord& record, const std::string& id)
+    {
+        return record.map.find(id) != record.map.end();
+    }
+
+    private:
+    struct Shard;
+
+    template <class TProblem>
+    static auto GetKey(rank<1>, const TProblem& problem)
+        -> decltype(problem.Serialize(std::declval<std::ostream&>()), std::string{})
+    {
+        return DbRecord::Serialize(problem);
+    }
+
+    template <class TProblem>
+    static auto GetKey(rank<0>, const TProblem& problem)
+        -> decltype(problem.WhereClause(), std::string{})
+    {
+        auto key    = std::string{};
+        auto values = std::vector<std::string>{};
+        std::tie(key, values) = problem.WhereClause();
+        for(const auto& value : values)
+            key += '\n' + value;
+        return key;
+    }
+
+    const std::size_t capacity;
+    std::unique_ptr<Shard[]> shards;
+    std::atomic<std::uint64_t> generation{0};
+    std::atomic<std::uint64_t> tick{0};
+    std::atomic<std::size_t> hits{0};
+    std::atomic<std::size_t> misses{0};
+
+    Shard& GetShard(const std::string& key) const;
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_DB_RECORD_CACHE_HPP_
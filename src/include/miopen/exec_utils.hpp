@@ -29,10 +29,48 @@
 #include <istream>
 #include <ostream>
 #include <string>
+#include <vector>
 
 namespace miopen {
 namespace exec {
 
+struct Redirect
+{
+    int fd;
+    /// The file opened for writing, empty to duplicate `target_fd` instead.
+    std::string path;
+    int target_fd = -1;
+};
+
+/// A command line run without a shell.
+struct Command
+{
+    /// Working directory, the current one if empty.
+    std::string dir;
+    /// NAME=VALUE pairs added to the environment.
+    std::vector<std::string> env;
+    /// The executable, searched in PATH, and its arguments.
+    std::vector<std::string> args;
+    /// Applied in order in the working directory, the same way as by a shell.
+    std::vector<Redirect> redirects;
+};
+
+/// Splits a shell command line. Quoting, leading variable assignments and output
+/// redirections (>file, 2>file, 2>&1) are supported. Returns false if the line needs a shell,
+/// e.g. because of pipes, lists, expansions or input redirections.
+bool ParseCommand(const std::string& line, Command& command);
+
+/// Starts the command with posix_spawn. Returns the process id, -1 if it could not be started.
+int StartProcess(const Command& command);
+
+/// Waits for a process started by StartProcess(). Returns the same as Spawn().
+int WaitProcess(int pid);
+
+/// Runs the command with posix_spawn and waits for it. Returns the exit status, 127 if the
+/// command could not be started and 128 plus the signal number if it was killed.
+int Spawn(const Command& command);
+
+/// Runs the command without a shell if ParseCommand() accepts it.
 /// Redirecting both input and output is not supported.
 int Run(const std::string& p, std::istream* in, std::ostream* out);
 
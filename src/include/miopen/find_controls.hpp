@@ -29,6 +29,7 @@
 
 #include <miopen/logger.hpp>
 #include <miopen/solver_id.hpp>
+#include <cstddef>
 #include <ostream>
 
 namespace miopen {
@@ -102,6 +103,10 @@ class FindEnforce
 
 solver::Id GetEnvFindOnlySolver();
 
+/// Number of threads used to evaluate applicability and default solutions of solvers
+/// concurrently (MIOPEN_DEBUG_SOLVER_EVAL_THREADS). Values below 2 mean sequential evaluation.
+std::size_t GetSolverEvaluationThreads();
+
 class FindMode
 {
     public:
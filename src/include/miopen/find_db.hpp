@@ -132,6 +132,14 @@ class FindDbRecord_t
     auto end() { return content->As<FindDbData>().end(); }
     bool empty() const { return !content.is_initialized(); }
 
+    /// Returns true if TryLoad would use the stored record without regenerating it.
+    template <class TProblemDescription>
+    static bool IsReady(Handle& handle, const TProblemDescription& problem)
+    {
+        const FindDbRecord_t<TDb> record{handle, problem};
+        return record.in_sync && !record.Validate(handle, problem.BuildConfKey());
+    }
+
     template <class TProblemDescription>
     static std::vector<PerfField> TryLoad(Handle& handle,
                                           const TProblemDescription& problem,
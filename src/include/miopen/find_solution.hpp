@@ -29,10 +29,16 @@
 
 #include <miopen/env.hpp>
 #include <miopen/conv_solution.hpp>
+#include <miopen/db.hpp>
 #include <miopen/find_controls.hpp>
+#include <miopen/par_for.hpp>
 #include <miopen/solver_id.hpp>
 
+#include <exception>
+#include <functional>
 #include <limits>
+#include <mutex>
+#include <string>
 #include <vector>
 
 namespace miopen {
@@ -130,9 +136,126 @@ FindSolution(Solver s, const Context& context, Db& db, const AnyInvokeParams& in
     return solution;
 }
 
+/// Serializes access to a performance database shared by concurrently evaluated solvers.
+template <class Db>
+class SerializedDbAccess
+{
+    public:
+    SerializedDbAccess(Db& db_) : db(db_) {}
+
+    template <class... Ts>
+    auto Load(Ts&&... xs)
+    {
+        const std::lock_guard<std::mutex> lock{mutex};
+        return db.Load(std::forward<Ts>(xs)...);
+    }
+
+    template <class... Ts>
+    auto Update(Ts&&... xs)
+    {
+        const std::lock_guard<std::mutex> lock{mutex};
+        return db.Update(std::forward<Ts>(xs)...);
+    }
+
+    template <class... Ts>
+    auto Remove(Ts&&... xs)
+    {
+        const std::lock_guard<std::mutex> lock{mutex};
+        return db.Remove(std::forward<Ts>(xs)...);
+    }
+
+    private:
+    Db& db;
+    std::mutex mutex;
+};
+
+/// Queues the updates of a performance database and writes them all at once, as a single
+/// batch (see BatchWrites), so that the results of a tuning run are committed once. The queue
+/// is written out by Flush() or upon destruction. Queued records are not visible to Load(),
+/// as every solver tunes and stores its own record.
+template <class Db>
+class DeferredDbUpdates
+{
+    public:
+    DeferredDbUpdates(Db& db_) : db(db_) {}
+    DeferredDbUpdates(const DeferredDbUpdates&) = delete;
+    DeferredDbUpdates& operator=(const DeferredDbUpdates&) = delete;
+
+    ~DeferredDbUpdates()
+    {
+        try
+        {
+            Flush();
+        }
+        catch(const std::exception& ex)
+        {
+            MIOPEN_LOG_E("Perf Db: failed to store the search results: " << ex.what());
+        }
+    }
+
+    template <class... Ts>
+    auto Load(Ts&&... xs)
+    {
+        return db.Load(std::forward<Ts>(xs)...);
+    }
+
+    template <class Context, class Config>
+    bool Update(const Context& context, const std::string& id, const Config& config)
+    {
+        updates.emplace_back([this, context, id, config]() { db.Update(context, id, config); });
+        return true;
+    }
+
+    template <class... Ts>
+    auto Remove(Ts&&... xs)
+    {
+        Flush();
+        return db.Remove(std::forward<Ts>(xs)...);
+    }
+
+    void Flush()
+    {
+        if(updates.empty())
+            return;
+
+        const auto pending = std::move(updates);
+        updates.clear();
+        BatchWrites(db, [&]() {
+            for(const auto& update : pending)
+                update();
+        });
+    }
+
+    private:
+    Db& db;
+    std::vector<std::function<void()>> updates;
+};
+
+enum class SolverEvaluation
+{
+    Skipped,
+    NonDynamic,
+    NotApplicable,
+    Evaluated,
+};
+
+template <class Solution>
+struct SolverEvaluationResult
+{
+    std::string id;
+    SolverEvaluation status = SolverEvaluation::Skipped;
+    Solution solution;
+    std::exception_ptr error;
+};
+
 template <class... Solvers>
 struct SolverContainer
 {
+    /// Solvers are evaluated concurrently by this many threads, unless tuning may be involved.
+    /// Results are consumed in the order of Solvers, so the output is the same as
+    /// with sequential evaluation.
+    std::size_t eval_threads = GetSolverEvaluationThreads();
+
     // Search for all applicable solutions among many solvers
     template <class Context, class Db, class Solution = miopen::solver::ConvSolution>
     std::vector<Solution>
@@ -141,9 +264,17 @@ struct SolverContainer
                           const AnyInvokeParams& invoke_ctx,
                           std::size_t limit = std::numeric_limits<std::size_t>::max()) const
     {
+        const FindEnforce enforce;
+        if(eval_threads > 1 && !search_params.do_search && !enforce.IsSearch(search_params))
+        {
+            return SearchForAllSolutionsConcurrently<Solution>(
+                search_params, db, invoke_ctx, limit);
+        }
+
         std::vector<Solution> ss;
         std::size_t count    = 0;
         const auto find_only = GetEnvFindOnlySolver();
+        DeferredDbUpdates<std::remove_reference_t<Db>> deferred_db{db};
         miopen::each_args(
             [&](auto solver) {
                 if(count >= limit)
@@ -159,7 +290,8 @@ struct SolverContainer
                     MIOPEN_LOG_I2(SolverDbId(solver) << ": Not applicable");
                 else
                 {
-                    const Solution s = FindSolution(solver, search_params, db, invoke_ctx);
+                    const Solution s =
+                        FindSolution(solver, search_params, deferred_db, invoke_ctx);
                     if(s.Succeeded())
                     {
                         ++count;
@@ -179,6 +311,7 @@ struct SolverContainer
                 }
             },
             Solvers{}...);
+        deferred_db.Flush();
         return ss;
     }
 
@@ -189,6 +322,9 @@ struct SolverContainer
                        const Problem& problem,
                        std::size_t limit = std::numeric_limits<std::size_t>::max()) const
     {
+        if(eval_threads > 1)
+            return SearchForSolutionsConcurrently<Solution>(ctx, problem, limit);
+
         std::vector<Solution> ss;
         std::size_t count    = 0;
         const auto find_only = GetEnvFindOnlySolver();
@@ -289,6 +425,145 @@ struct SolverContainer
 
         return found;
     }
+
+    private:
+    /// Evaluates all solvers on up to eval_threads threads. Exceptions are captured
+    /// and left to the caller to rethrow, in the order of Solvers.
+    template <class Solution, class F>
+    std::vector<SolverEvaluationResult<Solution>> EvaluateConcurrently(const F& evaluate) const
+    {
+        std::vector<SolverEvaluationResult<Solution>> results(sizeof...(Solvers));
+        std::vector<std::function<void()>> tasks;
+        tasks.reserve(sizeof...(Solvers));
+
+        miopen::each_args(
+            [&](auto solver) {
+                auto& result = results[tasks.size()];
+                result.id    = SolverDbId(solver);
+                tasks.emplace_back([&evaluate, &result, solver]() {
+                    try
+                    {
+                        evaluate(solver, result);
+                    }
+                    catch(...)
+                    {
+                        result.error = std::current_exception();
+                    }
+                });
+            },
+            Solvers{}...);
+
+        // Costs of solvers differ a lot, so threads pick the next solver dynamically.
+        par_for_strided(tasks.size(), max_threads{eval_threads}, [&](auto i) { tasks[i](); });
+        return results;
+    }
+
+    template <class Solution, class Context, class Db>
+    std::vector<Solution> SearchForAllSolutionsConcurrently(const Context& search_params,
+                                                            Db& db,
+                                                            const AnyInvokeParams& invoke_ctx,
+                                                            std::size_t limit) const
+    {
+        const auto find_only = GetEnvFindOnlySolver();
+        SerializedDbAccess<Db> serialized_db{db};
+
+        const auto results = EvaluateConcurrently<Solution>([&](auto solver, auto& result) {
+            if(find_only.IsValid() && find_only != Id{SolverDbId(solver)})
+                result.status = SolverEvaluation::Skipped;
+            else if(search_params.use_dynamic_solutions_only && !solver.IsDynamic())
+                result.status = SolverEvaluation::NonDynamic;
+            else if(!solver.IsApplicable(search_params))
+                result.status = SolverEvaluation::NotApplicable;
+            else
+            {
+                result.solution = FindSolution(solver, search_params, serialized_db, invoke_ctx);
+                result.status   = SolverEvaluation::Evaluated;
+            }
+        });
+
+        std::vector<Solution> ss;
+        for(const auto& result : results)
+        {
+            if(ss.size() >= limit)
+                break;
+            if(result.error)
+                std::rethrow_exception(result.error);
+
+            switch(result.status)
+            {
+            case SolverEvaluation::Skipped: break;
+            case SolverEvaluation::NonDynamic:
+                MIOPEN_LOG_I2(result.id << ": Skipped (non-dynamic)");
+                break;
+            case SolverEvaluation::NotApplicable:
+                MIOPEN_LOG_I2(result.id << ": Not applicable");
+                break;
+            case SolverEvaluation::Evaluated:
+                if(result.solution.Succeeded())
+                {
+                    ss.push_back(result.solution);
+                    MIOPEN_LOG_I2(result.id << ": Success.");
+                }
+                else
+                {
+                    MIOPEN_LOG_I(result.id << ": [Warning] Applicable Solver not succeeded.");
+                }
+                break;
+            }
+        }
+        return ss;
+    }
+
+    template <class Solution, class Problem>
+    std::vector<Solution> SearchForSolutionsConcurrently(const ExecutionContext& ctx,
+                                                         const Problem& problem,
+                                                         std::size_t limit) const
+    {
+        const auto find_only = GetEnvFindOnlySolver();
+
+        const auto results = EvaluateConcurrently<Solution>([&](auto solver, auto& result) {
+            if(find_only.IsValid() && find_only != Id{SolverDbId(solver)})
+                result.status = SolverEvaluation::Skipped;
+            else if(!solver.IsApplicable(ctx, problem))
+                result.status = SolverEvaluation::NotApplicable;
+            else
+            {
+                result.solution           = solver.GetSolution(ctx, problem);
+                result.solution.solver_id = SolverDbId(solver);
+                result.status             = SolverEvaluation::Evaluated;
+            }
+        });
+
+        std::vector<Solution> ss;
+        for(const auto& result : results)
+        {
+            if(ss.size() >= limit)
+                break;
+            if(result.error)
+                std::rethrow_exception(result.error);
+
+            switch(result.status)
+            {
+            case SolverEvaluation::Skipped:
+            case SolverEvaluation::NonDynamic: break;
+            case SolverEvaluation::NotApplicable:
+                MIOPEN_LOG_I2(result.id << ": Not applicable");
+                break;
+            case SolverEvaluation::Evaluated:
+                if(result.solution.Succeeded())
+                {
+                    ss.push_back(result.solution);
+                    MIOPEN_LOG_I2(result.id << ": Success.");
+                }
+                else
+                {
+                    MIOPEN_LOG_E(result.id << ": Applicable Solver not succeeded.");
+                }
+                break;
+            }
+        }
+        return ss;
+    }
 };
 
 } // namespace solver
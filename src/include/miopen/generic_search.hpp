@@ -32,13 +32,21 @@
 #include <miopen/handle.hpp>
 #include <miopen/invoke_params.hpp>
 #include <miopen/env.hpp>
+#include <miopen/compile_pipeline.hpp>
+#include <miopen/search_strategy.hpp>
+#include <miopen/tuning_checkpoint.hpp>
 
 #include <vector>
+#include <algorithm>
 #include <cstdlib>
+#include <sstream>
+#include <string>
+#include <numeric>
 #include <limits>
 #include <iterator>
 #include <chrono>
 #include <cassert>
+#include <unordered_set>
 
 #include <miopen/conv/context.hpp>
 #include <miopen/conv_solution.hpp>
@@ -154,6 +162,42 @@ class ComputedContainer
     const_iterator end() const { return {}; }
 };
 
+/// Random access to the configs of a ComputedContainer without holding all of them. Every
+/// stride-th position is kept as an iterator, the configs in between are computed from the
+/// nearest kept one. Access is const and may be done from several threads.
+template <typename PerformanceConfig, typename Context>
+class IndexedComputedContainer
+{
+    using Container = ComputedContainer<PerformanceConfig, Context>;
+
+    std::size_t stride;
+    std::size_t n_configs = 0;
+    std::vector<typename Container::const_iterator> marks;
+
+    public:
+    /// The container has to outlive the object, as the iterators refer to it.
+    IndexedComputedContainer(const Container& container, const std::size_t stride_ = 64)
+        : stride(std::max<std::size_t>(stride_, 1))
+    {
+        for(auto it = container.begin(); it != container.end(); ++it, ++n_configs)
+        {
+            if(n_configs % stride == 0)
+                marks.push_back(it);
+        }
+    }
+
+    std::size_t size() const { return n_configs; }
+
+    PerformanceConfig operator[](const std::size_t index) const
+    {
+        assert(index < n_configs);
+        auto it = marks[index / stride];
+        for(auto i = index % stride; i > 0; --i)
+            ++it;
+        return *it;
+    }
+};
+
 template <typename PerformanceConfig>
 class HeartBeat
 {
@@ -161,7 +205,9 @@ class HeartBeat
     size_t n_best;
     float best_time; // within beat
     float elapsed_cumulative;
+    float first_result_ms;
     Timer timer;
+    Timer total_timer;
     PerformanceConfig best_config;
 
     void Continue()
@@ -172,15 +218,32 @@ class HeartBeat
     }
 
     public:
-    HeartBeat() : n_within_beat(), n_best(), best_time(), elapsed_cumulative() {}
+    HeartBeat() : n_within_beat(), n_best(), best_time(), elapsed_cumulative(), first_result_ms()
+    {
+    }
 
     void Start()
     {
         elapsed_cumulative = 0.0f;
+        first_result_ms    = -1.0f;
         best_config        = PerformanceConfig();
+        total_timer.start();
         Continue();
     }
 
+    /// Reports the wall time of the search, how soon the first measurement was done, and
+    /// how long the measurements have been waiting for the kernels to compile.
+    void Stop(const size_t n_recent, const float compile_wait_ms)
+    {
+        MIOPEN_LOG_W("Tuning wall time: " << total_timer.elapsed_ms() / 1000.0f
+                                          << " sec, time to first result: "
+                                          << std::max(first_result_ms, 0.0f) / 1000.0f
+                                          << " sec, waited for compilation: "
+                                          << compile_wait_ms / 1000.0f
+                                          << " sec, measured: "
+                                          << n_recent);
+    }
+
     void Monitor(const bool is_recent_failed,
                  const float recent_time,
                  const size_t n_recent,
@@ -190,6 +253,8 @@ class HeartBeat
                  const PerformanceConfig& recent_config)
     {
         ++n_within_beat;
+        if(first_result_ms < 0.0f)
+            first_result_ms = total_timer.elapsed_ms();
         if(!is_recent_failed && (recent_time < best_time))
         {
             best_time   = recent_time;
@@ -307,6 +372,194 @@ using RunAndMeasure_t =
                                                           std::declval<ConvSolution>(),
                                                           std::declval<float&>()));
 
+template <class Solver>
+using GetSearchStrategy_t = decltype(std::declval<const Solver>().GetSearchStrategy());
+
+/// Solvers may prefer a search strategy by implementing
+/// `SearchStrategy GetSearchStrategy() const`. MIOPEN_DEBUG_TUNING_STRATEGY overrides it.
+template <class Solver>
+SearchStrategy GetSolverSearchStrategy(const Solver& s, std::true_type)
+{
+    return s.GetSearchStrategy();
+}
+
+template <class Solver>
+SearchStrategy GetSolverSearchStrategy(const Solver&, std::false_type)
+{
+    return SearchStrategy::Exhaustive;
+}
+
+template <class Solver>
+SearchStrategy GetSolverSearchStrategy(const Solver& s)
+{
+    return GetSolverSearchStrategy(s, is_detected<GetSearchStrategy_t, Solver>{});
+}
+
+/// Measures performance configs of the solver with its invokers on the GPU.
+template <class Solver, class Context, class PerformanceConfig>
+class GenericSearchEvaluator : public SearchEvaluator
+{
+    public:
+    GenericSearchEvaluator(const Solver& s_,
+                           const Context& context_,
+                           const IndexedComputedContainer<PerformanceConfig, Context>& configs_,
+                           const ConvSolution& default_solution_,
+                           const AnyInvokeParams& invoke_ctx_,
+                           const SearchBudget& budget)
+        : s(s_),
+          context(context_),
+          configs(configs_),
+          default_solution(default_solution_),
+          invoke_ctx(invoke_ctx_),
+          n_total(budget.max_trials != 0 ? std::min(configs.size(), budget.max_trials)
+                                         : configs.size()),
+          pipeline([this](std::size_t index) { return Build(index); },
+                   CompilePipeline::GetDefaultThreads(),
+                   2 * CompilePipeline::GetDefaultThreads())
+    {
+        heartbeat.Start();
+    }
+
+    /// Starts building the kernels of the configs in the background. Measurements do not wait
+    /// for all of them, only for the config being measured.
+    void Prepare(const std::vector<std::size_t>& indices) override
+    {
+        auto unbuilt = std::vector<std::size_t>{};
+        std::copy_if(indices.begin(),
+                     indices.end(),
+                     std::back_inserter(unbuilt),
+                     [&](auto index) { return built.count(index) == 0; });
+        pipeline.Schedule(unbuilt);
+    }
+
+    /// Blocks until the kernels of the prepared configs are built.
+    void Drain() { pipeline.Drain(); }
+
+    /// Cancels the builds the search has not got to.
+    void Stop(std::size_t n_trials)
+    {
+        pipeline.Cancel();
+        heartbeat.Stop(n_trials, pipeline.GetWaitTimeMs());
+        MIOPEN_LOG_I2("Configs compiled in background: " << pipeline.GetBuilt() << ", cancelled: "
+                                                         << pipeline.GetCancelled());
+    }
+
+    bool Run(std::size_t index, std::size_t runs, float& time) override
+    {
+        const auto config = configs[index];
+        MIOPEN_LOG_I2('#' << index << '/' << n_total << " x" << runs << ' ' << config);
+        auto& profile_h = context.GetStream();
+        time            = 0.0f;
+
+        try
+        {
+            if(index != prepared_index)
+            {
+                prepared_index = none;
+
+                if(built.count(index) == 0)
+                {
+                    pipeline.Wait(index);
+                    built.insert(index);
+                }
+
+                const auto current_solution = s.GetSolution(context, config, true);
+                if(default_solution.workspce_sz != current_solution.workspce_sz)
+                {
+                    MIOPEN_LOG_E('#' << index << " (" << configs.size() << ") "
+                                     << "Workspace size should not depend on PerformanceConfig: "
+                                     << default_solution.workspce_sz
+                                     << " != "
+                                     << current_solution.workspce_sz);
+                    return false;
+                }
+
+                invoker = profile_h.PrepareInvoker(*current_solution.invoker_factory,
+                                                   current_solution.construction_params);
+
+                prepared_index = index;
+            }
+
+            for(std::size_t i = 0; i < runs; ++i)
+            {
+                invoker(profile_h, invoke_ctx);
+                time += profile_h.GetKernelTime();
+            }
+        }
+        catch(...)
+        {
+            prepared_index = none;
+            return false;
+        }
+        return true;
+    }
+
+    void OnTrial(std::size_t index, bool failed, float time, const SearchResult& progress) override
+    {
+        const auto config = configs[index];
+        MIOPEN_LOG_T("##"
+                     << "(n_current, n_failed, n_runs_total):  "
+                     << progress.n_trials
+                     << '/'
+                     << progress.n_failed
+                     << '/'
+                     << n_total
+                     << " elapsed_time: "
+                     << time
+                     << ", best_time: "
+                     << progress.best_time
+                     << ", "
+                     << config);
+        heartbeat.Monitor(failed,
+                          time,
+                          progress.n_trials,
+                          progress.best_time,
+                          progress.n_failed,
+                          n_total,
+                          config);
+    }
+
+    private:
+    static constexpr std::size_t none = std::numeric_limits<std::size_t>::max();
+
+    const Solver& s;
+    const Context& context;
+    const IndexedComputedContainer<PerformanceConfig, Context>& configs;
+    const ConvSolution& default_solution;
+    const AnyInvokeParams& invoke_ctx;
+    const std::size_t n_total;
+    HeartBeat<PerformanceConfig> heartbeat;
+    Invoker invoker;
+    std::size_t prepared_index = none;
+    std::unordered_set<std::size_t> built;
+    // Destroyed first, the workers use the members above.
+    CompilePipeline pipeline;
+
+    /// Runs on the workers of the pipeline. The programs are added to the handle by the
+    /// measuring thread.
+    CompilePipeline::Finish Build(std::size_t index) const
+    {
+        auto& profile_h     = context.GetStream();
+        const auto solution = s.GetSolution(context, configs[index], true);
+        auto kernels        = std::vector<KernelInfo>{};
+        auto programs       = std::vector<Program>{};
+        for(auto&& kernel : solution.construction_params)
+        {
+            programs.push_back(
+                profile_h.LoadProgram(kernel.kernel_file, kernel.comp_options, false, ""));
+            kernels.push_back(kernel);
+        }
+        return [&profile_h, kernels, programs]() {
+            for(std::size_t i = 0; i < programs.size(); ++i)
+            {
+                if(profile_h.HasProgram(kernels[i].kernel_file, kernels[i].comp_options))
+                    continue;
+                profile_h.AddProgram(programs[i], kernels[i].kernel_file, kernels[i].comp_options);
+            }
+        };
+    }
+};
+
 template <class Solver, class Context>
 auto GenericSearch(const Solver s, const Context& context_, const AnyInvokeParams& invoke_ctx_)
     -> decltype(s.GetPerformanceConfig(context_))
@@ -339,164 +592,70 @@ auto GenericSearch(const Solver s, const Context& context_, const AnyInvokeParam
 
     const ComputedContainer<PerformanceConfig, Context> all_configs = useSpare ? spare : main;
     const int n_runs_total = useSpare ? spare_size : main_size;
+
+    const auto strategy = GetSearchStrategy(GetSolverSearchStrategy(s));
+    const auto budget   = SearchBudget::FromEnv();
+    const auto policy   = TimingPolicy::FromEnv();
+    const IndexedComputedContainer<PerformanceConfig, Context> configs(all_configs);
+
     MIOPEN_LOG_W(SolverDbId(s) << ": Searching the best solution among " << n_runs_total
                                << (useSpare ? " (spare)" : "")
+                               << ", strategy: "
+                               << strategy
                                << "...");
 
-    bool is_passed  = false; // left false only if all iterations failed.
-    float best_time = std::numeric_limits<float>::max();
-    size_t n_failed = 0;
-    size_t n_best   = 0;
-    HeartBeat<PerformanceConfig> heartbeat;
-    heartbeat.Start();
+    GenericSearchEvaluator<Solver, Context, PerformanceConfig> evaluator{
+        s, context, configs, default_solution, invoke_ctx, budget};
 
-// PrecompileKernels call saves to binary_cache, this needs to be escaped if KERN_CACHE is not on.
-#if MIOPEN_ENABLE_SQLITE_KERN_CACHE
-    std::vector<KernelInfo> kernels;
-    for(const auto& current_config : all_configs)
+    if(IsEnabled(MIOPEN_DEBUG_COMPILE_ONLY{}))
     {
-        ConvSolution current_solution = s.GetSolution(context, current_config, true);
-        for(auto&& kernel : current_solution.construction_params)
-        {
-            if(profile_h.HasProgram(kernel.kernel_file, kernel.comp_options))
-                continue;
-            kernels.push_back(kernel);
-        }
+        auto indices = std::vector<std::size_t>(configs.size());
+        std::iota(indices.begin(), indices.end(), 0);
+        evaluator.Prepare(indices);
+        evaluator.Drain();
+        MIOPEN_THROW(miopenStatusGpuOperationsSkipped,
+                     "Running kernels on GPU is disabled. Search skipped");
     }
-    std::ignore = PrecompileKernels(profile_h, kernels);
-#endif
-
-    if(!IsEnabled(MIOPEN_DEBUG_COMPILE_ONLY{}))
-    {
-        size_t n_current = 0;
-        for(const auto& current_config : all_configs)
-        {
-            float elapsed_time = 0.0f;
-            int ret            = 0;
-            MIOPEN_LOG_I2('#' << n_current << '/' << n_failed << '/' << n_runs_total << ' '
-                              << current_config);
 
-            ConvSolution current_solution;
-            Invoker invoker;
+    const auto serialize = [](const auto& data) {
+        std::ostringstream ss;
+        data.Serialize(ss);
+        return ss.str();
+    };
 
-            try
-            {
-                current_solution = s.GetSolution(context, current_config, true);
-                if(default_solution.workspce_sz != current_solution.workspce_sz)
-                {
-                    ret = -2;
-                    MIOPEN_LOG_E('#' << n_current << " (" << n_runs_total << ") "
-                                     << "Workspace size should not depend on PerformanceConfig: "
-                                     << default_solution.workspce_sz
-                                     << " != "
-                                     << current_solution.workspce_sz);
-                }
+    TuningCheckpoint checkpoint{TuningCheckpoint::GetPath(profile_h.GetDbBasename(),
+                                                          SolverDbId(s),
+                                                          serialize(context) +
+                                                              (useSpare ? " spare" : ""))};
+    CheckpointedSearchEvaluator checkpointed{
+        evaluator, checkpoint, [&](std::size_t index) { return serialize(configs[index]); }};
 
-                invoker = profile_h.PrepareInvoker(*current_solution.invoker_factory,
-                                                   current_solution.construction_params);
-                invoker(profile_h, invoke_ctx);
-                elapsed_time = profile_h.GetKernelTime();
-            }
-            catch(...)
-            {
-                ret = 1;
-            }
-
-            MIOPEN_LOG_T("##"
-                         << "(n_current, n_failed, n_runs_total):  "
-                         << n_current
-                         << '/'
-                         << n_failed
-                         << '/'
-                         << n_runs_total
-                         << " elapsed_time: "
-                         << elapsed_time
-                         << ", best_time: "
-                         << best_time
-                         << ", "
-                         << current_config);
-
-            if(ret == 0)
-            {
-                // Smooth the jitter of measurements:
-                // If the 1st probe is NOT too bad (measured time <= 1.05 * best known time),
-                // then re-run it 4 times more and compute average time,
-                // and decide using average of all 5 attempts vs. the best.
-                if(elapsed_time / best_time < 1.05f)
-                {
-                    MIOPEN_LOG_I2("Finding average for: " << elapsed_time << " / " << best_time
-                                                          << " = "
-                                                          << (elapsed_time / best_time));
-
-                    try
-                    {
-                        for(int i = 0; i < 4; ++i)
-                        {
-                            invoker(profile_h, invoke_ctx);
-                            elapsed_time += profile_h.GetKernelTime();
-                        }
-                    }
-                    catch(...)
-                    {
-                        ret = 1;
-                    }
-
-                    if(ret == 0)
-                    {
-                        is_passed = true;
-                        elapsed_time /= 5;
-                        if(elapsed_time < best_time)
-                        {
-                            MIOPEN_LOG_I('#' << n_current << '/' << n_failed << '/' << n_runs_total
-                                             << ' '
-                                             << elapsed_time
-                                             << " < "
-                                             << best_time
-                                             << ' '
-                                             << current_config);
-                            best_config = current_config;
-                            best_time   = elapsed_time;
-                            n_best      = n_current;
-                        }
-                        else
-                        {
-                            MIOPEN_LOG_I2(
-                                "Average is not better: " << elapsed_time << " >= " << best_time);
-                        }
-                    }
-                }
-            }
-
-            if(ret != 0)
-            {
-                MIOPEN_LOG_E('#' << n_current << " (" << n_runs_total << ") "
-                                 << " Failed rc="
-                                 << ret);
-                ++n_failed;
-            }
-            heartbeat.Monitor(ret != 0,
-                              elapsed_time,
-                              n_current,
-                              best_time,
-                              n_failed,
-                              n_runs_total,
-                              current_config);
-            ++n_current;
-        }
-    }
-    else
+    if(checkpoint.GetSize() != 0)
     {
-        MIOPEN_THROW(miopenStatusGpuOperationsSkipped,
-                     "Running kernels on GPU is disabled. Search skipped");
+        auto partial_best = std::string{"none"};
+        auto partial_time = 0.0f;
+        if(checkpoint.GetBest(partial_best, partial_time))
+            partial_best += " (" + std::to_string(partial_time) + " ms)";
+        MIOPEN_LOG_W("Resuming from " << checkpoint.GetPath().string() << ": "
+                                      << checkpoint.GetSize()
+                                      << " measurements, best so far "
+                                      << partial_best);
     }
 
-    MIOPEN_LOG_W("Done: " << n_runs_total << '/' << n_failed << '/' << n_runs_total << ", best #"
-                          << n_best
+    const auto result = RunSearch(strategy, budget, configs.size(), checkpointed, policy);
+    evaluator.Stop(result.n_trials);
+    if(result.is_passed)
+        best_config = configs[result.best];
+    checkpoint.Remove();
+
+    MIOPEN_LOG_W("Done: " << result.n_trials << '/' << result.n_failed << '/' << n_runs_total
+                          << ", best #"
+                          << result.best
                           << ' '
-                          << best_time
+                          << result.best_time
                           << ' '
                           << best_config);
-    if(!is_passed)
+    if(!result.is_passed)
         MIOPEN_THROW("Search failed");
     // Run once with the default config and show score.
 
@@ -504,7 +663,7 @@ auto GenericSearch(const Solver s, const Context& context_, const AnyInvokeParam
                                                    default_solution.construction_params);
     invoker(profile_h, invoke_ctx);
     const auto default_time = profile_h.GetKernelTime();
-    const auto score        = (best_time > 0.0f) ? default_time / best_time : 0.0f;
+    const auto score        = (result.best_time > 0.0f) ? default_time / result.best_time : 0.0f;
     MIOPEN_LOG_W("...Score: " << score << " (default time " << default_time << ')');
 
     return best_config;
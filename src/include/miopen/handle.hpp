@@ -39,6 +39,7 @@
 #include <miopen/solver_id.hpp>
 #include <miopen/stringutils.hpp>
 #include <miopen/target_properties.hpp>
+#include <miopen/tensor_op_key.hpp>
 
 #include <boost/range/adaptor/transformed.hpp>
 
@@ -102,6 +103,19 @@ struct Handle : miopenHandle
                            bool is_kernel_str            = false,
                            const std::string& kernel_src = "") const;
 
+    /// Builds the kernel of a tensor operation and caches it by the typed key. The returned
+    /// invoke is memoized and stays valid until the kernel is added again under the same key.
+    const KernelInvoke& AddKernel(const TensorOpKey& key,
+                                  const std::string& program_name,
+                                  const std::string& kernel_name,
+                                  const std::vector<size_t>& vld,
+                                  const std::vector<size_t>& vgd,
+                                  const std::string& params) const;
+
+    /// Returns the memoized invoke of the kernel added by the typed AddKernel(), or nullptr.
+    /// Does not allocate on a hit.
+    const KernelInvoke* GetKernelInvoke(const TensorOpKey& key) const;
+
     bool HasKernel(const std::string& algorithm, const std::string& network_config) const;
 
     void ClearKernels(const std::string& algorithm, const std::string& network_config) const;
@@ -224,17 +238,17 @@ struct Handle : miopenHandle
 
     void RegisterInvoker(const Invoker& invoker,
                          const NetworkConfig& config,
-                         const std::string& solver,
+                         solver::Id solver,
                          const AlgorithmName& algo)
     {
-        invokers.Register({config, solver}, invoker);
+        invokers.Register(config, solver, invoker);
         invokers.SetAsFound1_0(config, algo, solver);
     }
 
     boost::optional<const Invoker&>
     GetInvoker(const NetworkConfig& config,
                const boost::optional<solver::Id>& solver,
-               const boost::optional<AlgorithmName>& algo = boost::none) const
+               const boost::optional<const AlgorithmName&>& algo = boost::none) const
     {
         assert(solver || algo);
         assert(!(solver && algo));
@@ -242,7 +256,7 @@ struct Handle : miopenHandle
         {
             MIOPEN_LOG_I2("Returning an invoker for problem " << config.ToString() << " and solver "
                                                               << solver->ToString());
-            return invokers[std::make_pair(config.ToString(), solver->ToString())];
+            return invokers.Get(config, *solver);
         }
         MIOPEN_LOG_I2("Returning an invoker for problem " << config.ToString() << " and algorithm "
                                                           << algo->ToString());
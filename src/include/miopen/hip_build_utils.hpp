@@ -43,6 +43,10 @@ boost::filesystem::path HipBuild(boost::optional<miopen::TmpDir>& tmp_dir,
                                  const TargetProperties& target,
                                  bool sources_already_reside_on_filesystem = false);
 
+/// Directory with the HIP kernel includes. It is written on the first call and
+/// lives until the process exits.
+const boost::filesystem::path& GetHipKernelIncDir();
+
 void bin_file_to_str(const boost::filesystem::path& file, std::string& buf);
 
 struct external_tool_version_t
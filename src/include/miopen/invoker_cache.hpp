@@ -28,44 +28,46 @@
 
 #include <miopen/errors.hpp>
 #include <miopen/invoker.hpp>
+#include <miopen/names.hpp>
+#include <miopen/solver_id.hpp>
 
 #include <boost/optional.hpp>
 
-#include <map>
 #include <memory>
 #include <string>
-#include <utility>
 
 namespace miopen {
 
+/// Invokers prepared for the problems, keyed by the network config and the solver.
+///
+/// Lookups are lock-free and do not allocate: the keys are the precomputed hash of the network
+/// config and the numeric solver id, and the entries are never removed, so the readers walk
+/// immutable hash chains while a writer publishes new ones under a mutex. The references
+/// returned stay valid until the cache is destroyed.
 class InvokerCache
 {
     public:
-    // network_config, solver_id
-    using Key = std::pair<std::string, std::string>;
+    InvokerCache();
+    ~InvokerCache();
+    InvokerCache(InvokerCache&&) noexcept;
+    InvokerCache& operator=(InvokerCache&&) noexcept;
 
-    boost::optional<const Invoker&> operator[](const Key& key) const;
+    boost::optional<const Invoker&> Get(const NetworkConfig& network_config,
+                                        solver::Id solver_id) const;
     // For find 1.0
-    boost::optional<const Invoker&> GetFound1_0(const std::string& network_config,
-                                                const std::string& algorithm) const;
-    void Register(const Key& key, const Invoker& invoker);
+    boost::optional<const Invoker&> GetFound1_0(const NetworkConfig& network_config,
+                                                const AlgorithmName& algorithm) const;
+    /// Keeps the invoker registered first if there is one for the same key already.
+    void
+    Register(const NetworkConfig& network_config, solver::Id solver_id, const Invoker& invoker);
     // For find 1.0
-    void SetAsFound1_0(const std::string& network_config,
-                       const std::string& algorithm,
-                       const std::string& solver_id);
+    void SetAsFound1_0(const NetworkConfig& network_config,
+                       const AlgorithmName& algorithm,
+                       solver::Id solver_id);
 
     private:
-    struct Item
-    {
-        // algorithm -> solver_id
-        // for find 1.0
-        std::map<std::string, std::string> found_1_0;
-        // solver_id -> invoker
-        std::map<std::string, Invoker> invokers;
-    };
-
-    // network_config -> Item
-    std::map<std::string, Item> invokers;
+    class impl;
+    std::unique_ptr<impl> pImpl;
 };
 
 } // namespace miopen
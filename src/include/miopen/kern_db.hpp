@@ -32,12 +32,12 @@
 
 #include <miopen/sqlite_db.hpp>
 #include <miopen/bz2.hpp>
-#include <miopen/md5.hpp>
 
 #include <boost/core/explicit_operator_bool.hpp>
 #include <boost/none.hpp>
 #include <boost/optional/optional.hpp>
 
+#include <cstdint>
 #include <string>
 #include <chrono>
 #include <thread>
@@ -69,31 +69,77 @@ struct KernelConfig
            << ",`kernel_blob` BLOB NOT NULL"
            << ",`kernel_hash` TEXT NOT NULL"
            << ",`uncompressed_size` INT NOT NULL"
+           << ",`codec` TEXT NOT NULL DEFAULT ''"
            << ");"
            << "CREATE UNIQUE INDEX IF NOT EXISTS "
            << "`idx_" << KernelConfig::table_name() << "` "
            << "ON " << KernelConfig::table_name() << "(kernel_name, kernel_args);";
         return ss.str();
     }
-    std::string Where() const
+    /// Upgrades the tables created before the codec was recorded per row.
+    static std::string AddCodecQuery()
     {
-        std::ostringstream ss;
-        ss << "(kernel_name = '" << kernel_name << "')"
-           << " AND (kernel_args = '" << kernel_args << "')";
-        return ss.str();
+        return "ALTER TABLE `" + KernelConfig::table_name() +
+               "` ADD COLUMN `codec` TEXT NOT NULL DEFAULT '';";
     }
+    static std::string Where() { return "(kernel_name = ?) AND (kernel_args = ?)"; }
+    std::vector<std::string> WhereValues() const { return {kernel_name, kernel_args}; }
+};
+
+/// How the kernel binaries are compressed in the cache. The codec is recorded in every row, so
+/// the rows stored with any of them stay readable when the setting changes. The rows without a
+/// codec are bzip2-compressed (unless uncompressed_size is 0) and checksummed with md5, the rest
+/// are checksummed with xxhash64.
+struct KernDbCodec
+{
+    enum Id
+    {
+        None,
+        Bz2,
+        Lz,
+    };
+
+    Id id     = Lz;
+    int level = 1;
+
+    /// Parses "<name>[:<level>]", e.g. "lz:1" or "BZ2:9". Returns none for unknown names.
+    static boost::optional<KernDbCodec> Parse(const std::string& str);
+    /// The codec set by MIOPEN_DEBUG_KERNEL_CACHE_CODEC, LZ at level 1 by default.
+    static KernDbCodec GetDefault();
+    std::string ToString() const;
 };
 
 class KernDb : public SQLiteBase<KernDb>
 {
     std::function<std::string(std::string, bool*)> compress_fn;
     std::function<std::string(std::string, unsigned int)> decompress_fn;
+    KernDbCodec codec;
+    bool has_codec_column = false;
+
+    struct EncodedBlob
+    {
+        std::string data;
+        std::int64_t uncompressed_size;
+        std::string hash;
+        std::string codec;
+    };
+
+    EncodedBlob Encode(const std::string& blob) const;
+    std::string Decode(std::string data,
+                       const std::string& hash,
+                       std::int64_t uncompressed_size,
+                       const std::string& codec_name) const;
 
     public:
     KernDb(const std::string& filename_,
            bool is_system,
            const std::string& arch,
            std::size_t num_cu);
+    KernDb(const std::string& filename_,
+           bool is_system,
+           const std::string& arch,
+           std::size_t num_cu,
+           KernDbCodec codec_);
     // This constructor is only intended for testing
     KernDb(const std::string& filename_,
            bool _is_system,
@@ -106,10 +152,9 @@ class KernDb : public SQLiteBase<KernDb>
     {
         if(filename.empty())
             return true;
-        auto del_query =
-            "DELETE FROM " + T::table_name() + " WHERE " + problem_config.Where() + ";";
-        auto stmt = SQLite::Statement{sql, del_query};
-        auto rc   = stmt.Step(sql);
+        auto del_query = "DELETE FROM " + T::table_name() + " WHERE " + T::Where() + ";";
+        SQLite::CachedStatement stmt{sql, del_query, problem_config.WhereValues()};
+        auto rc = stmt->Step(sql);
         if(rc == SQLITE_DONE)
             return true;
         else
@@ -124,27 +169,19 @@ class KernDb : public SQLiteBase<KernDb>
     {
         if(filename.empty())
             return boost::none;
-        // Where clause with inserted values defeats the purpose of a prepraed statement
-        auto select_query = "SELECT kernel_blob, kernel_hash, uncompressed_size FROM " +
-                            T::table_name() + " WHERE " + problem_config.Where() + ";";
-        auto stmt = SQLite::Statement{sql, select_query};
+        const auto select_query = "SELECT kernel_blob, kernel_hash, uncompressed_size" +
+                                  std::string{has_codec_column ? ", codec" : ""} + " FROM " +
+                                  T::table_name() + " WHERE " + T::Where() + ";";
+        SQLite::CachedStatement stmt{sql, select_query, problem_config.WhereValues()};
         // only one result field
         // assert one row
-        auto rc = stmt.Step(sql);
+        auto rc = stmt->Step(sql);
         if(rc == SQLITE_ROW)
         {
-            auto compressed_blob           = stmt.ColumnBlob(0);
-            auto md5_hash                  = stmt.ColumnText(1);
-            auto uncompressed_size         = stmt.ColumnInt64(2);
-            std::string& decompressed_blob = compressed_blob;
-            if(uncompressed_size != 0)
-            {
-                decompressed_blob = decompress_fn(compressed_blob, uncompressed_size);
-            }
-            auto new_md5 = md5(decompressed_blob);
-            if(new_md5 != md5_hash)
-                MIOPEN_THROW(miopenStatusInternalError, "Possible database corruption");
-            return decompressed_blob;
+            return Decode(stmt->ColumnBlob(0),
+                          stmt->ColumnText(1),
+                          stmt->ColumnInt64(2),
+                          has_codec_column ? stmt->ColumnText(3) : std::string{});
         }
         else if(rc == SQLITE_DONE)
             return boost::none;
@@ -158,29 +195,21 @@ class KernDb : public SQLiteBase<KernDb>
     {
         if(filename.empty())
             return boost::none;
-        auto insert_query = "INSERT OR IGNORE INTO " + T::table_name() +
-                            "(kernel_name, kernel_args, kernel_blob, kernel_hash, "
-                            "uncompressed_size) VALUES(?, ?, ?, ?, ?);";
-        auto md5_sum           = md5(problem_config.kernel_blob);
-        auto uncompressed_size = problem_config.kernel_blob.size();
-        bool success           = false;
-        auto compressed_blob   = compress_fn(problem_config.kernel_blob, &success);
-        auto stmt              = SQLite::Statement{sql, insert_query};
-        stmt.BindText(1, problem_config.kernel_name);
-        stmt.BindText(2, problem_config.kernel_args);
-        if(!success)
-        {
-            stmt.BindBlob(3, problem_config.kernel_blob);
-            stmt.BindInt64(5, 0);
-        }
-        else
-        {
-            stmt.BindBlob(3, compressed_blob);
-            stmt.BindInt64(5, uncompressed_size);
-        }
-        stmt.BindText(4, md5_sum);
+        const auto insert_query =
+            "INSERT OR IGNORE INTO " + T::table_name() +
+            "(kernel_name, kernel_args, kernel_blob, kernel_hash, uncompressed_size" +
+            (has_codec_column ? ", codec) VALUES(?, ?, ?, ?, ?, ?);" : ") VALUES(?, ?, ?, ?, ?);");
+        const auto encoded = Encode(problem_config.kernel_blob);
+        SQLite::CachedStatement stmt{sql, insert_query};
+        stmt->BindText(1, problem_config.kernel_name);
+        stmt->BindText(2, problem_config.kernel_args);
+        stmt->BindBlob(3, encoded.data);
+        stmt->BindText(4, encoded.hash);
+        stmt->BindInt64(5, encoded.uncompressed_size);
+        if(has_codec_column)
+            stmt->BindText(6, encoded.codec);
 
-        auto rc = stmt.Step(sql);
+        auto rc = stmt->Step(sql);
         if(rc != SQLITE_DONE)
             MIOPEN_THROW(miopenStatusInternalError, sql.ErrorMessage());
         return problem_config.kernel_blob;
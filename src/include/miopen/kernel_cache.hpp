@@ -45,6 +45,7 @@
 #include <miopen/handle.hpp>
 #include <miopen/kernel.hpp>
 #include <miopen/simple_hash.hpp>
+#include <miopen/tensor_op_key.hpp>
 #include <miopen/miopen.h>
 #include <string>
 #include <unordered_map>
@@ -64,6 +65,26 @@ class KernelCache
     using KernelMap  = std::unordered_map<Key, std::vector<Kernel>, SimpleHash>;
     using ProgramMap = std::unordered_map<Key, Program, SimpleHash>;
 
+    /// Kernel of a tensor operation along with the invoke resolved for it. The invoke is bound
+    /// to the stream and the profiling mode of the handle, so it is re-resolved when those
+    /// change, and otherwise reused without allocating.
+    class TensorOpKernel
+    {
+        public:
+        explicit TensorOpKernel(Kernel k) : kernel(std::move(k)) {}
+
+        const KernelInvoke& GetInvoke(const Handle& h);
+
+        private:
+        Kernel kernel;
+        KernelInvoke invoke;
+        miopenAcceleratorQueue_t stream = nullptr;
+        bool profiling                  = false;
+        bool resolved                   = false;
+    };
+
+    using TensorOpKernelMap = std::unordered_map<TensorOpKey, TensorOpKernel, TensorOpKey::Hasher>;
+
     Kernel AddKernel(const Handle& h,
                      const std::string& algorithm,
                      const std::string& network_config,
@@ -85,6 +106,11 @@ class KernelCache
 
     bool HasKernels(const std::string& algorithm, const std::string& network_config) const;
 
+    /// Returns nullptr if no kernel is cached for the key. Does not allocate.
+    TensorOpKernel* FindKernel(const TensorOpKey& key);
+
+    TensorOpKernel& AddKernel(const TensorOpKey& key, Kernel k);
+
     bool HasProgram(const std::string& name, const std::string& params) const;
 
     void AddProgram(Program prog, const std::string& program_name, std::string params);
@@ -94,6 +120,7 @@ class KernelCache
     private:
     KernelMap kernel_map;
     ProgramMap program_map;
+    TensorOpKernelMap tensor_op_kernel_map;
 };
 
 } // namespace miopen
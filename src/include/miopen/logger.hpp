@@ -30,6 +30,7 @@
 #include <array>
 #include <vector>
 #include <iostream>
+#include <memory>
 #include <sstream>
 #include <type_traits>
 #include <chrono>
@@ -206,6 +207,62 @@ extern bool LoggingQuiet; // NOLINT (cppcoreguidelines-avoid-non-const-global-va
 const char* LoggingLevelToCString(LoggingLevel level);
 std::string LoggingPrefix();
 
+enum class LogRecordKind
+{
+    Message,  // MIOPEN_LOG* macros.
+    Function, // MIOPEN_LOG_FUNCTION, one record per line.
+    Command,  // MIOPEN_LOG_DRIVER_CMD.
+};
+
+/// Name of the function issuing a log record, see MIOPEN_GET_FN_NAME(). Parsed only when the
+/// record is written.
+struct LogFunctionName
+{
+    const char* func;
+    const char* pretty_func;
+};
+
+/// Passes the record to the log. By default it is written to stderr immediately. With
+/// MIOPEN_ENABLE_LOGGING_ASYNC the calling thread only puts it into a per-thread buffer,
+/// and a background thread writes it out. MIOPEN_ENABLE_LOGGING_JSON writes JSON lines
+/// instead of text.
+void LogWrite(LogRecordKind kind, LoggingLevel level, const std::string& fn, std::string text);
+void LogWrite(LogRecordKind kind, LoggingLevel level, LogFunctionName fn, std::string text);
+
+/// Blocks until the records issued so far are written.
+void LogFlush();
+
+namespace logger {
+
+/// Stream for formatting a log message. Reuses a per-thread stream, which is much cheaper
+/// than constructing one. A message formatted while formatting another one (e.g. by an
+/// operator<< which logs) gets its own stream.
+class MessageStream
+{
+    public:
+    MessageStream();
+    ~MessageStream();
+
+    MessageStream(const MessageStream&) = delete;
+    MessageStream& operator=(const MessageStream&) = delete;
+
+    std::ostream& Get() { return *stream; }
+    std::string Str() const { return stream->str(); }
+
+    private:
+    std::ostringstream* stream;
+    std::unique_ptr<std::ostringstream> own;
+};
+
+/// Switches between the synchronous and asynchronous modes, overriding the environment.
+void SetAsync(bool enable);
+
+/// Number of records dropped in the asynchronous mode because the buffer of the issuing
+/// thread was full.
+std::size_t GetDropped();
+
+} // namespace logger
+
 /// \return true if level is enabled.
 /// \param level - one of the values defined in LoggingLevel.
 bool IsLogging(LoggingLevel level, bool disableQuieting = false);
@@ -237,6 +294,9 @@ inline void* LogObjImpl(void* x) { return x; }
 
 inline const void* LogObjImpl(const void* x) { return x; }
 
+#define MIOPEN_LOG_FN_NAME_() \
+    (miopen::LogFunctionName{__func__, __PRETTY_FUNCTION__}) /* NOLINT */
+
 #ifndef _MSC_VER
 template <class T, typename std::enable_if<(std::is_pointer<T>{}), int>::type = 0>
 std::ostream& LogParam(std::ostream& os, std::string name, const T& x)
@@ -273,24 +333,28 @@ std::ostream& LogParam(std::ostream& os, std::string name, const std::vector<T>&
         std::ostringstream().swap(miopen_log_func_ss);                          \
         /* Use stringstram as ostream to engage existing template functions: */ \
         std::ostream& miopen_log_func_ostream = miopen_log_func_ss;             \
-        miopen_log_func_ostream << miopen::LoggingPrefix();                     \
-        miopen::LogParam(miopen_log_func_ostream, #param, param) << std::endl;  \
-        std::cerr << miopen_log_func_ss.str();                                  \
+        miopen::LogParam(miopen_log_func_ostream, #param, param);               \
+        miopen::LogWrite(miopen::LogRecordKind::Function,                       \
+                         miopen::LoggingLevel::Info,                            \
+                         MIOPEN_LOG_FN_NAME_(),                                 \
+                         miopen_log_func_ss.str());                             \
     } while(false);
 
-#define MIOPEN_LOG_FUNCTION(...)                                                        \
-    do                                                                                  \
-        if(miopen::IsLoggingFunctionCalls())                                            \
-        {                                                                               \
-            std::ostringstream miopen_log_func_ss;                                      \
-            miopen_log_func_ss << miopen::LoggingPrefix() << __PRETTY_FUNCTION__ << "{" \
-                               << std::endl;                                            \
-            std::cerr << miopen_log_func_ss.str();                                      \
-            MIOPEN_PP_EACH_ARGS(MIOPEN_LOG_FUNCTION_EACH, __VA_ARGS__)                  \
-            std::ostringstream().swap(miopen_log_func_ss);                              \
-            miopen_log_func_ss << miopen::LoggingPrefix() << "}" << std::endl;          \
-            std::cerr << miopen_log_func_ss.str();                                      \
-        }                                                                               \
+#define MIOPEN_LOG_FUNCTION(...)                                       \
+    do                                                                 \
+        if(miopen::IsLoggingFunctionCalls())                           \
+        {                                                              \
+            std::ostringstream miopen_log_func_ss;                     \
+            miopen::LogWrite(miopen::LogRecordKind::Function,          \
+                             miopen::LoggingLevel::Info,               \
+                             MIOPEN_LOG_FN_NAME_(),                    \
+                             std::string(__PRETTY_FUNCTION__) + "{");  \
+            MIOPEN_PP_EACH_ARGS(MIOPEN_LOG_FUNCTION_EACH, __VA_ARGS__) \
+            miopen::LogWrite(miopen::LogRecordKind::Function,          \
+                             miopen::LoggingLevel::Info,               \
+                             MIOPEN_LOG_FN_NAME_(),                    \
+                             "}");                                     \
+        }                                                              \
     while(false)
 #else
 #define MIOPEN_LOG_FUNCTION(...)
@@ -301,20 +365,23 @@ std::string LoggingParseFunction(const char* func, const char* pretty_func);
 #define MIOPEN_GET_FN_NAME() \
     (miopen::LoggingParseFunction(__func__, __PRETTY_FUNCTION__)) /* NOLINT */
 
-#define MIOPEN_LOG_XQ_(level, disableQuieting, fn_name, ...)                                 \
-    do                                                                                       \
-    {                                                                                        \
-        if(miopen::IsLogging(level, disableQuieting))                                        \
-        {                                                                                    \
-            std::ostringstream miopen_log_ss;                                                \
-            miopen_log_ss << miopen::LoggingPrefix() << LoggingLevelToCString(level) << " [" \
-                          << fn_name << "] " << __VA_ARGS__ << std::endl;                    \
-            std::cerr << miopen_log_ss.str();                                                \
-        }                                                                                    \
+/// Messages of the levels above MIOPEN_LOG_MAX_LEVEL are compiled out, the check of the
+/// constant level is eliminated along with the message.
+#define MIOPEN_LOG_XQ_(level, disableQuieting, fn_name, ...)                           \
+    do                                                                                 \
+    {                                                                                  \
+        if(static_cast<int>(level) <= MIOPEN_LOG_MAX_LEVEL &&                          \
+           miopen::IsLogging(level, disableQuieting))                                  \
+        {                                                                              \
+            miopen::logger::MessageStream miopen_log_ss;                               \
+            miopen_log_ss.Get() << __VA_ARGS__;                                        \
+            miopen::LogWrite(                                                          \
+                miopen::LogRecordKind::Message, level, fn_name, miopen_log_ss.Str());  \
+        }                                                                              \
     } while(false)
 
-#define MIOPEN_LOG(level, ...) MIOPEN_LOG_XQ_(level, false, MIOPEN_GET_FN_NAME(), __VA_ARGS__)
-#define MIOPEN_LOG_NQ_(level, ...) MIOPEN_LOG_XQ_(level, true, MIOPEN_GET_FN_NAME(), __VA_ARGS__)
+#define MIOPEN_LOG(level, ...) MIOPEN_LOG_XQ_(level, false, MIOPEN_LOG_FN_NAME_(), __VA_ARGS__)
+#define MIOPEN_LOG_NQ_(level, ...) MIOPEN_LOG_XQ_(level, true, MIOPEN_LOG_FN_NAME_(), __VA_ARGS__)
 
 #define MIOPEN_LOG_E(...) MIOPEN_LOG(miopen::LoggingLevel::Error, __VA_ARGS__)
 #define MIOPEN_LOG_E_FROM(from, ...) \
@@ -332,15 +399,15 @@ std::string LoggingParseFunction(const char* func, const char* pretty_func);
 // Warnings in installable builds, errors otherwise.
 #define MIOPEN_LOG_WE(...) MIOPEN_LOG(LogWELevel, __VA_ARGS__)
 
-#define MIOPEN_LOG_DRIVER_CMD(...)                                                      \
-    do                                                                                  \
-    {                                                                                   \
-        std::ostringstream miopen_driver_cmd_ss;                                        \
-        miopen_driver_cmd_ss << miopen::LoggingPrefix() << "Command"                    \
-                             << " [" << miopen::LoggingParseFunction(                   \
-                                            __func__, __PRETTY_FUNCTION__) /* NOLINT */ \
-                             << "] ./bin/MIOpenDriver " << __VA_ARGS__ << std::endl;    \
-        std::cerr << miopen_driver_cmd_ss.str();                                        \
+#define MIOPEN_LOG_DRIVER_CMD(...)                                                       \
+    do                                                                                   \
+    {                                                                                    \
+        std::ostringstream miopen_driver_cmd_ss;                                         \
+        miopen_driver_cmd_ss << "./bin/MIOpenDriver " << __VA_ARGS__;                    \
+        miopen::LogWrite(miopen::LogRecordKind::Command,                                 \
+                         miopen::LoggingLevel::Info,                                     \
+                         MIOPEN_LOG_FN_NAME_(),                                          \
+                         miopen_driver_cmd_ss.str());                                    \
     } while(false)
 
 #if MIOPEN_LOG_FUNC_TIME_ENABLE
@@ -0,0 +1,46 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_LZ_HPP_
+#define GUARD_MIOPEN_LZ_HPP_
+
+#include <string>
+
+namespace miopen {
+
+/// Byte-oriented LZ77 codec in the spirit of LZ4: it trades compression ratio for decoding at
+/// memory speed. The level (1..9) sets how hard the compressor searches for matches; the format
+/// and the decoding speed do not depend on it.
+///
+/// Sets *compressed to false and returns the input unchanged if the data does not shrink.
+std::string lz_compress(const std::string& s, int level = 1, bool* compressed = nullptr);
+
+/// Decompresses data produced by lz_compress. Throws std::runtime_error if the data is malformed
+/// or does not decompress to exactly size bytes.
+std::string lz_decompress(const std::string& s, std::size_t size);
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_LZ_HPP_
@@ -26,30 +26,58 @@
 
 #pragma once
 
+#include <cstdint>
 #include <string>
 
 namespace miopen {
 
+/// 64-bit FNV-1a hash of the string. The names hash their values once, when constructed, so
+/// that the caches keyed by them do not rehash the strings on every lookup.
+inline std::uint64_t HashName(const std::string& value)
+{
+    auto hash = std::uint64_t{14695981039346656037ULL};
+    for(const auto c : value)
+    {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
 struct NetworkConfig
 {
     NetworkConfig() = default;
-    explicit NetworkConfig(const std::string& value_) : value(value_) {}
+    explicit NetworkConfig(const std::string& value_) : value(value_), hash(HashName(value)) {}
     operator std::string() const { return value; }
     std::string ToString() const { return value; }
+    std::uint64_t GetHash() const { return hash; }
+
+    friend bool operator==(const NetworkConfig& left, const NetworkConfig& right)
+    {
+        return left.hash == right.hash && left.value == right.value;
+    }
 
     private:
     std::string value;
+    std::uint64_t hash = HashName({});
 };
 
 struct AlgorithmName
 {
     AlgorithmName() = default;
-    explicit AlgorithmName(const std::string& value_) : value(value_) {}
+    explicit AlgorithmName(const std::string& value_) : value(value_), hash(HashName(value)) {}
     operator std::string() const { return value; }
     std::string ToString() const { return value; }
+    std::uint64_t GetHash() const { return hash; }
+
+    friend bool operator==(const AlgorithmName& left, const AlgorithmName& right)
+    {
+        return left.hash == right.hash && left.value == right.value;
+    }
 
     private:
     std::string value;
+    std::uint64_t hash = HashName({});
 };
 
 } // namespace miopen
@@ -27,12 +27,10 @@
 #ifndef MIOPEN_GUARD_MLOPEN_PAR_FOR_HPP
 #define MIOPEN_GUARD_MLOPEN_PAR_FOR_HPP
 
+#include <miopen/thread_pool.hpp>
+
 #include <algorithm>
-#include <cassert>
-#include <cmath>
-#include <functional>
-#include <numeric>
-#include <vector>
+#include <cstddef>
 
 #ifdef __MINGW32__
 #include <mingw.thread.h>
@@ -42,43 +40,15 @@
 
 namespace miopen {
 
-struct joinable_thread : std::thread
+inline std::size_t hardware_threads()
 {
-    template <class... Xs>
-    joinable_thread(Xs&&... xs) : std::thread(std::forward<Xs>(xs)...) // NOLINT
-    {
-    }
-
-    joinable_thread& operator=(joinable_thread&& other) = default;
-    joinable_thread(joinable_thread&& other)            = default;
-
-    ~joinable_thread()
-    {
-        if(this->joinable())
-            this->join();
-    }
-};
-
-struct thread_factory
-{
-    template <class F>
-    joinable_thread operator()(std::size_t& work, std::size_t n, std::size_t grainsize, F f) const
-    {
-        auto result = joinable_thread([=] {
-            std::size_t start = work;
-            std::size_t last  = std::min(n, work + grainsize);
-            for(std::size_t i = start; i < last; i++)
-            {
-                f(i);
-            }
-        });
-        work += grainsize;
-        return result;
-    }
-};
+    return std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+}
 
+/// Calls f(i) for each i in [0, n) on up to threadsize threads of the process-wide pool.
+/// Chunks of chunk iterations are handed out dynamically, so uneven iterations are balanced.
 template <class F>
-void par_for_impl(std::size_t n, std::size_t threadsize, F f)
+void par_for_impl(std::size_t n, std::size_t threadsize, std::size_t chunk, F f)
 {
     if(threadsize <= 1)
     {
@@ -87,22 +57,26 @@ void par_for_impl(std::size_t n, std::size_t threadsize, F f)
     }
     else
     {
-        std::vector<joinable_thread> threads(threadsize);
-        const std::size_t grainsize = std::ceil(static_cast<double>(n) / threads.size());
-
-        std::size_t work = 0;
-        std::generate(threads.begin(),
-                      threads.end(),
-                      std::bind(thread_factory{}, std::ref(work), n, grainsize, f));
-        assert(work >= n);
+        ThreadPool::Instance().ParallelFor(
+            n, threadsize, chunk, [&](std::size_t begin, std::size_t end) {
+                for(std::size_t i = begin; i < end; i++)
+                    f(i);
+            });
     }
 }
 
+template <class F>
+void par_for_impl(std::size_t n, std::size_t threadsize, F f)
+{
+    // Several chunks per thread leave room for balancing without much contention.
+    const auto chunk = std::max<std::size_t>(n / (threadsize * 4 + 1), 1);
+    par_for_impl(n, threadsize, chunk, f);
+}
+
 template <class F>
 void par_for(std::size_t n, std::size_t min_grain, F f)
 {
-    const auto threadsize =
-        std::min<std::size_t>(std::thread::hardware_concurrency(), n / min_grain);
+    const auto threadsize = std::min<std::size_t>(hardware_threads(), n / min_grain);
     par_for_impl(n, threadsize, f);
 }
 
@@ -114,7 +88,7 @@ struct min_grain
 template <class F>
 void par_for(std::size_t n, min_grain mg, F f)
 {
-    const auto threadsize = std::min<std::size_t>(std::thread::hardware_concurrency(), n / mg.n);
+    const auto threadsize = std::min<std::size_t>(hardware_threads(), n / mg.n);
     par_for_impl(n, threadsize, f);
 }
 
@@ -132,20 +106,17 @@ struct max_threads
 template <class F>
 void par_for(std::size_t n, max_threads mt, F f)
 {
-    const auto threadsize = std::min<std::size_t>(std::thread::hardware_concurrency(), mt.n);
+    const auto threadsize = std::min<std::size_t>(hardware_threads(), mt.n);
     par_for_impl(n, std::min(threadsize, n), f);
 }
 
+/// Calls f(i) for each i in [0, n) handing out single iterations, for loops of few
+/// expensive and uneven iterations like kernel compilation.
 template <class F>
 void par_for_strided(std::size_t n, max_threads mt, F f)
 {
-    auto threadsize = std::min<std::size_t>(std::thread::hardware_concurrency(), mt.n);
-    par_for_impl(threadsize, threadsize, [&](auto start) {
-        for(std::size_t i = start; i < n; i += threadsize)
-        {
-            f(i);
-        }
-    });
+    const auto threadsize = std::min<std::size_t>(hardware_threads(), mt.n);
+    par_for_impl(n, std::min(threadsize, n), 1, f);
 }
 
 } // namespace miopen
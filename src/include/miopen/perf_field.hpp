@@ -54,14 +54,29 @@ struct FindDbData : solver::Serializable<FindDbData>
     /// solver doesn't use kernel cache and doesn't require a validation of built kernel existence.
     // Todo: remove when all finds will support invokers
     FindDbKCacheKey kcache_key;
+    /// TimingStatistic the time has been computed with, and the variance of the measured runs.
+    /// Records written before they were stored hold the time of a single run: MIN with the
+    /// variance of -1, i.e. unknown.
+    std::string statistic;
+    float variance;
 
-    FindDbData() : solver_id("<invalid>"), time(-1), workspace(-1) {}
+    FindDbData()
+        : solver_id("<invalid>"), time(-1), workspace(-1), statistic(legacy_statistic), variance(-1)
+    {
+    }
 
     FindDbData(const std::string& solver_id_,
                float time_,
                std::size_t workspace_,
-               const FindDbKCacheKey& kcache_key_)
-        : solver_id(solver_id_), time(time_), workspace(workspace_), kcache_key(kcache_key_)
+               const FindDbKCacheKey& kcache_key_,
+               const std::string& statistic_ = legacy_statistic,
+               float variance_               = -1)
+        : solver_id(solver_id_),
+          time(time_),
+          workspace(workspace_),
+          kcache_key(kcache_key_),
+          statistic(statistic_),
+          variance(variance_)
     {
         if(!kcache_key.IsValid())
             MIOPEN_THROW("Invalid kernel cache key: " + kcache_key.algorithm_name + ", " +
@@ -76,7 +91,19 @@ struct FindDbData : solver::Serializable<FindDbData>
         f(self.workspace, "workspace");
         f(self.kcache_key.algorithm_name, "kcache_key::algorithm_name");
         f(self.kcache_key.network_config, "kcache_key::network_confing");
+        f(self.statistic, "statistic");
+        f(self.variance, "variance");
+    }
+
+    bool Deserialize(const std::string& s)
+    {
+        if(solver::Serializable<FindDbData>::Deserialize(s))
+            return true;
+        return solver::Serializable<FindDbData>::Deserialize(s + ',' + legacy_statistic + ",-1");
     }
+
+    private:
+    static constexpr const char* legacy_statistic = "MIN";
 };
 
 } // namespace miopen
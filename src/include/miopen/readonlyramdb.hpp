@@ -26,16 +26,30 @@
 #ifndef MIOPEN_GUARD_MLOPEN_READONLYRAMDB_HPP
 #define MIOPEN_GUARD_MLOPEN_READONLYRAMDB_HPP
 
+#include <miopen/binary_db.hpp>
 #include <miopen/db_record.hpp>
 
 #include <boost/optional.hpp>
+#include <boost/utility/string_view.hpp>
 
+#include <cstddef>
+#include <memory>
+#include <shared_mutex>
 #include <unordered_map>
 #include <string>
-#include <sstream>
+#include <vector>
 
 namespace miopen {
 
+/// Read-only in-memory view of a system db file.
+///
+/// The file is memory-mapped (embedded databases are used in place) and indexed by a flat
+/// open-addressing table of keys which point into the mapped bytes. Payloads are parsed into
+/// DbRecord only on the first access to a key and then memoized. Lookups of memoized records
+/// take a shared lock only.
+///
+/// Databases in the binary format (see binary_db.hpp) are detected by their header and looked
+/// up through their own sorted index instead.
 class ReadonlyRamDb
 {
     public:
@@ -48,28 +62,10 @@ class ReadonlyRamDb
 
     boost::optional<DbRecord> FindRecord(const std::string& problem) const
     {
-        MIOPEN_LOG_I2("Looking for key " << problem << " in file " << db_path);
-        const auto it = cache.find(problem);
-
-        if(it == cache.end())
-            return boost::none;
-
-        auto record = DbRecord{problem};
-
-        MIOPEN_LOG_I2("Key match: " << problem);
-        MIOPEN_LOG_I2("Contents found: " << it->second.content);
-
-        if(!record.ParseContents(it->second.content))
-        {
-            MIOPEN_LOG_E("Error parsing payload under the key: " << problem << " form file "
-                                                                 << db_path
-                                                                 << "#"
-                                                                 << it->second.line);
-            MIOPEN_LOG_E("Contents: " << it->second.content);
+        const auto record = FindParsed(problem);
+        if(!record)
             return boost::none;
-        }
-
-        return record;
+        return *record;
     }
 
     template <class TProblem>
@@ -82,7 +78,7 @@ class ReadonlyRamDb
     template <class TProblem, class TValue>
     bool Load(const TProblem& problem, const std::string& id, TValue& value) const
     {
-        const auto record = FindRecord(problem);
+        const auto record = FindParsed(DbRecord::Serialize(problem));
         if(!record)
             return false;
         return record->GetValues(id, value);
@@ -91,21 +87,34 @@ class ReadonlyRamDb
     private:
     struct CacheItem
     {
-        int line;
-        std::string content;
+        boost::string_view key;
+        boost::string_view content;
+        int line = 0;
     };
 
     std::string db_path;
-    std::unordered_map<std::string, CacheItem> cache;
-
-    ReadonlyRamDb(const ReadonlyRamDb&) = default;
-    ReadonlyRamDb(ReadonlyRamDb&&)      = default;
-    ReadonlyRamDb& operator=(const ReadonlyRamDb&) = default;
-    ReadonlyRamDb& operator=(ReadonlyRamDb&&) = default;
-
+    /// Keeps the mapping (or a fallback copy of the file) alive. Empty for embedded databases.
+    std::shared_ptr<const void> storage;
+    /// Power-of-two sized; empty slots have an empty key.
+    std::vector<CacheItem> cache;
+    std::size_t records_count = 0;
+    boost::optional<binary_db::Reader> binary;
+
+    mutable std::shared_timed_mutex parsed_mutex;
+    /// Null for the records which failed to parse.
+    mutable std::unordered_map<std::size_t, std::shared_ptr<const DbRecord>> parsed;
+
+    ReadonlyRamDb(const ReadonlyRamDb&) = delete;
+    ReadonlyRamDb(ReadonlyRamDb&&)      = delete;
+    ReadonlyRamDb& operator=(const ReadonlyRamDb&) = delete;
+    ReadonlyRamDb& operator=(ReadonlyRamDb&&) = delete;
+
+    const CacheItem* Lookup(boost::string_view key) const;
+    void Insert(const CacheItem& item);
+    bool ParseRecord(std::size_t slot, DbRecord& record) const;
+    std::shared_ptr<const DbRecord> FindParsed(const std::string& problem) const;
     void Prefetch(const std::string& path, bool warn_if_unreadable);
-    void
-    ParseAndLoadDb(std::istream& input_stream, const std::string& path, bool warn_if_unreadable);
+    void ParseAndLoadDb(boost::string_view contents, const std::string& path);
 };
 
 } // namespace miopen
@@ -45,6 +45,7 @@ namespace miopen {
 
 struct Handle;
 struct TensorDescriptor;
+class RNNPlanRecorder;
 
 template <class T>
 struct c_array_view
@@ -270,6 +271,90 @@ struct RNNDescriptor : miopenRNNDescriptor
 
     inline bool isNotRNNskip() const { return inputMode != miopenRNNskip; }
     inline bool isRNNskip() const { return inputMode == miopenRNNskip; }
+
+    private:
+    // Bodies of the calls above, launching through the recorder of their plan.
+    void RecordForwardTraining(RNNPlanRecorder& handle,
+                               const int seqLen,
+                               c_array_view<const miopenTensorDescriptor_t> xDesc,
+                               ConstData_t x,
+                               const TensorDescriptor& hxDesc,
+                               ConstData_t hx,
+                               const TensorDescriptor& cxDesc,
+                               ConstData_t cx,
+                               const TensorDescriptor& wDesc,
+                               ConstData_t w,
+                               c_array_view<const miopenTensorDescriptor_t> yDesc,
+                               Data_t y,
+                               const TensorDescriptor& hyDesc,
+                               Data_t hy,
+                               const TensorDescriptor& cyDesc,
+                               Data_t cy,
+                               Data_t workSpace,
+                               size_t workSpaceSize,
+                               Data_t reserveSpace,
+                               size_t reserveSpaceSize) const;
+
+    void RecordForwardInference(RNNPlanRecorder& handle,
+                                const int seqLen,
+                                c_array_view<const miopenTensorDescriptor_t> xDesc,
+                                ConstData_t x,
+                                const TensorDescriptor& hxDesc,
+                                ConstData_t hx,
+                                const TensorDescriptor& cxDesc,
+                                ConstData_t cx,
+                                const TensorDescriptor& wDesc,
+                                ConstData_t w,
+                                c_array_view<const miopenTensorDescriptor_t> yDesc,
+                                Data_t y,
+                                const TensorDescriptor& hyDesc,
+                                Data_t hy,
+                                const TensorDescriptor& cyDesc,
+                                Data_t cy,
+                                Data_t workSpace,
+                                size_t workSpaceSize) const;
+
+    void RecordBackwardData(RNNPlanRecorder& handle,
+                            const int seqLen,
+                            c_array_view<const miopenTensorDescriptor_t> yDesc,
+                            ConstData_t y,
+                            c_array_view<const miopenTensorDescriptor_t> dyDesc,
+                            ConstData_t dy,
+                            const TensorDescriptor& dhyDesc,
+                            ConstData_t dhy,
+                            const TensorDescriptor& dcyDesc,
+                            ConstData_t dcy,
+                            const TensorDescriptor& wDesc,
+                            ConstData_t w,
+                            const TensorDescriptor& hxDesc,
+                            ConstData_t hx,
+                            const TensorDescriptor& cxDesc,
+                            ConstData_t cx,
+                            c_array_view<const miopenTensorDescriptor_t> dxDesc,
+                            Data_t dx,
+                            const TensorDescriptor& dhxDesc,
+                            Data_t dhx,
+                            const TensorDescriptor& dcxDesc,
+                            Data_t dcx,
+                            Data_t workSpace,
+                            size_t workSpaceSize,
+                            Data_t reserveSpace,
+                            size_t reserveSpaceSize) const;
+
+    void RecordBackwardWeights(RNNPlanRecorder& handle,
+                               const int seqLen,
+                               c_array_view<const miopenTensorDescriptor_t> xDesc,
+                               ConstData_t x,
+                               const TensorDescriptor& hxDesc,
+                               ConstData_t hx,
+                               c_array_view<const miopenTensorDescriptor_t> dyDesc,
+                               ConstData_t dy,
+                               const TensorDescriptor& dwDesc,
+                               Data_t dw,
+                               Data_t workSpace,
+                               size_t workSpaceSize,
+                               ConstData_t reserveSpace,
+                               size_t reserveSpaceSize) const;
 };
 
 std::ostream& operator<<(std::ostream& stream, const RNNDescriptor& r);
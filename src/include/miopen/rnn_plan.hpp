@@ -0,0 +1,297 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_RNN_PLAN_HPP_
+#define GUARD_MIOPEN_RNN_PLAN_HPP_
+
+#include <miopen/activ.hpp>
+#include <miopen/common.hpp>
+#include <miopen/gemm_v2.hpp>
+#include <miopen/rnn.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+namespace miopen {
+
+/// Buffers an RNN call is made on, in the order of its arguments.
+struct RNNPlanBindings
+{
+    std::vector<ConstData_t> buffers;
+    miopenDropoutDescriptor_t dropoutDesc = nullptr;
+};
+
+/// Launches of an RNN call, recorded once and replayed for the calls with the same problem.
+///
+/// The launches keep the descriptors and offsets resolved while recording and refer to the
+/// buffers by their position in RNNPlanBindings, so a replay only rebinds the pointers.
+struct RNNPlan
+{
+    using Launch = std::function<void(Handle&, const RNNPlanBindings&, float& ctime)>;
+
+    std::vector<Launch> launches;
+
+    void Run(Handle& handle, const RNNPlanBindings& bindings) const;
+};
+
+/// Identifies the plan of an RNN call: everything its host-side decisions depend on.
+///
+/// Besides the descriptors and the sizes, the key has the pattern of null and aliased buffers,
+/// as they select launches and the buffers are bound by position. The hash is updated as the
+/// values are added, like in TensorOpKey.
+class RNNPlanKey
+{
+    public:
+    RNNPlanKey(const RNNDescriptor& rnn, char direction, int seqLen);
+
+    RNNPlanKey& Add(std::size_t value)
+    {
+        values.push_back(value);
+        hash ^= value;
+        hash *= prime;
+        return *this;
+    }
+
+    RNNPlanKey& Add(const TensorDescriptor& desc);
+    RNNPlanKey& Add(c_array_view<const miopenTensorDescriptor_t> descs, int seqLen);
+    RNNPlanKey& Add(const RNNPlanBindings& bindings);
+
+    friend bool operator==(const RNNPlanKey& left, const RNNPlanKey& right)
+    {
+        return left.hash == right.hash && left.values == right.values;
+    }
+
+    struct Hasher
+    {
+        std::size_t operator()(const RNNPlanKey& key) const noexcept { return key.hash; }
+    };
+
+    private:
+    // 64-bit FNV-1a parameters
+    static constexpr std::size_t offset_basis = 14695981039346656037ULL;
+    static constexpr std::size_t prime        = 1099511628211ULL;
+
+    std::size_t hash = offset_basis;
+    std::vector<std::size_t> values;
+};
+
+/// Takes the place of the handle while an RNN call is recorded: each launch is run right away
+/// and, unless keep is false, appended to the plan.
+class RNNPlanRecorder
+{
+    public:
+    RNNPlanRecorder(Handle& handle_, const RNNPlanBindings& bindings_, bool keep_ = true)
+        : handle(handle_), bindings(bindings_), keep(keep_)
+    {
+    }
+
+    Handle& GetHandle() const { return handle; }
+
+    /// Position of the buffer in the bindings, nullptr gets npos.
+    std::size_t Slot(ConstData_t buffer) const;
+
+    void Record(RNNPlan::Launch launch);
+
+    RNNPlan plan;
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+    private:
+    Handle& handle;
+    const RNNPlanBindings& bindings;
+    bool keep;
+    float ctime = 0;
+};
+
+/// Looks the plan up by the key and replays it, or records a new one with the given function.
+/// With MIOPEN_DEBUG_RNN_PLAN_CACHE=0 every call runs the recording function without keeping
+/// the plan.
+void RunRNNPlan(Handle& handle,
+                const RNNPlanKey& key,
+                const RNNPlanBindings& bindings,
+                const std::function<void(RNNPlanRecorder&)>& record);
+
+// Recording counterparts of the launches done by the RNN calls.
+
+miopenStatus_t CallGemm(RNNPlanRecorder& handle,
+                        GemmDescriptor gemm_desc,
+                        ConstData_t A,
+                        int a_offset,
+                        ConstData_t B,
+                        int b_offset,
+                        Data_t C,
+                        int c_offset,
+                        std::nullptr_t kcache_key,
+                        GemmBackend_t gemm_backend);
+
+void SetTensor(RNNPlanRecorder& handle,
+               const TensorDescriptor& yDesc,
+               Data_t y,
+               const void* alpha,
+               int offset = 0);
+
+void OpTensor(RNNPlanRecorder& handle,
+              miopenTensorOp_t tensorOp,
+              const void* alpha0,
+              const TensorDescriptor& aTensorDesc,
+              ConstData_t ATensor,
+              const void* alpha1,
+              const TensorDescriptor& bTensorDesc,
+              ConstData_t BTensor,
+              const void* beta,
+              const TensorDescriptor& cTensorDesc,
+              Data_t CTensor,
+              size_t Aoffset = 0,
+              size_t Boffset = 0,
+              size_t Coffset = 0);
+
+void CopyTensor(RNNPlanRecorder& handle,
+                const TensorDescriptor& srcDesc,
+                ConstData_t src,
+                const TensorDescriptor& dstDesc,
+                Data_t dst,
+                int srcOffset = 0,
+                int dstOffset = 0);
+
+void profileRNNkernels(RNNPlanRecorder& handle, unsigned char select, float& ctime);
+
+/// The dropout descriptor is taken from the bindings when replaying.
+void DropoutForward(RNNPlanRecorder& handle,
+                    const TensorDescriptor& noise_shape,
+                    const TensorDescriptor& xDesc,
+                    ConstData_t x,
+                    const TensorDescriptor& yDesc,
+                    Data_t y,
+                    Data_t reserveSpace,
+                    size_t reserveSpaceSizeInBytes,
+                    size_t in_offset,
+                    size_t out_offset,
+                    size_t rsvsp_offset);
+
+void DropoutBackward(RNNPlanRecorder& handle,
+                     const TensorDescriptor& noise_shape,
+                     const TensorDescriptor& dyDesc,
+                     ConstData_t dy,
+                     const TensorDescriptor& dxDesc,
+                     Data_t dx,
+                     Data_t reserveSpace,
+                     size_t reserveSpaceSizeInBytes,
+                     size_t in_offset,
+                     size_t out_offset,
+                     size_t rsvsp_offset);
+
+void LSTMForwardHiddenStateUpdate(RNNPlanRecorder& handle,
+                                  miopenDataType_t rnn_data_type,
+                                  bool is_inference,
+                                  bool is_seq_begin,
+                                  int direction,
+                                  int max_batch,
+                                  int cur_batch,
+                                  int use_batch,
+                                  int hy_h,
+                                  int hy_stride,
+                                  int wei_len,
+                                  int wei_stride,
+                                  ConstData_t cx,
+                                  std::size_t cx_offset,
+                                  Data_t reserve_space,
+                                  std::size_t i_offset,
+                                  std::size_t f_offset,
+                                  std::size_t o_offset,
+                                  std::size_t c_offset,
+                                  std::size_t cell_offset,
+                                  std::size_t cell_offset_pre,
+                                  std::size_t activ_cell_offset,
+                                  std::size_t hidden_offset);
+
+void LSTMBackwardHiddenStateUpdate(RNNPlanRecorder& handle,
+                                   miopenDataType_t rnn_data_type,
+                                   bool is_seq_begin,
+                                   bool is_seq_end,
+                                   int direction,
+                                   int max_batch,
+                                   int cur_batch,
+                                   int use_batch,
+                                   int use_batch2,
+                                   int hy_h,
+                                   int hy_stride,
+                                   int wei_len,
+                                   int wei_stride,
+                                   ConstData_t cx,
+                                   std::size_t cx_offset,
+                                   Data_t reserve_space,
+                                   std::size_t i_offset,
+                                   std::size_t f_offset,
+                                   std::size_t o_offset,
+                                   std::size_t c_offset,
+                                   std::size_t activ_cell_offset,
+                                   std::size_t cell_offset_pre,
+                                   ConstData_t dcy,
+                                   std::size_t dcy_offset,
+                                   Data_t work_space,
+                                   std::size_t di_offset,
+                                   std::size_t df_offset,
+                                   std::size_t do_offset,
+                                   std::size_t dc_offset,
+                                   std::size_t dcell_offset,
+                                   std::size_t dcell_offset_pre,
+                                   std::size_t dhidden_offset,
+                                   std::size_t f_offset_pre);
+
+/// Activation descriptor whose launches are recorded.
+struct RNNPlanActivation : ActivationDescriptor
+{
+    using ActivationDescriptor::ActivationDescriptor;
+
+    void Forward(RNNPlanRecorder& handle,
+                 const void* alpha,
+                 const TensorDescriptor& xDesc,
+                 ConstData_t x,
+                 const void* beta,
+                 const TensorDescriptor& yDesc,
+                 Data_t y,
+                 size_t xOffset = 0,
+                 size_t yOffset = 0) const;
+
+    void Backward(RNNPlanRecorder& handle,
+                  const void* alpha,
+                  const TensorDescriptor& yDesc,
+                  ConstData_t y,
+                  const TensorDescriptor& dyDesc,
+                  ConstData_t dy,
+                  const TensorDescriptor& xDesc,
+                  ConstData_t x,
+                  const void* beta,
+                  const TensorDescriptor& dxDesc,
+                  Data_t dx,
+                  size_t yOffset  = 0,
+                  size_t dyOffset = 0,
+                  size_t xOffset  = 0,
+                  size_t dxOffset = 0) const;
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_RNN_PLAN_HPP_
@@ -0,0 +1,130 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_SEARCH_STRATEGY_HPP_
+#define GUARD_MIOPEN_SEARCH_STRATEGY_HPP_
+
+#include <miopen/timing_policy.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <iosfwd>
+#include <limits>
+#include <vector>
+
+namespace miopen {
+namespace solver {
+
+/// How GenericSearch picks the performance configs to measure.
+///
+/// - Exhaustive: measures every config in the order of the container.
+/// - Random: measures a random sample of configs.
+/// - SuccessiveHalving: measures a sample once, then repeatedly keeps the better half and
+///   measures it again with twice as many runs, until one config is left.
+/// - Annealing: simulated annealing walk over neighbouring configs, i.e. configs close to each
+///   other in the order of the container.
+enum class SearchStrategy
+{
+    Exhaustive,
+    Random,
+    SuccessiveHalving,
+    Annealing,
+};
+
+std::ostream& operator<<(std::ostream& os, SearchStrategy strategy);
+
+/// Returns MIOPEN_DEBUG_TUNING_STRATEGY if set, otherwise the strategy preferred by the solver.
+SearchStrategy GetSearchStrategy(SearchStrategy solver_default);
+
+/// Limits of a search. Zero values mean "no limit".
+struct SearchBudget
+{
+    /// Maximum number of measured configs. Random and Annealing default to
+    /// max(10% of the configs, min(100, all configs)) when it is zero.
+    std::size_t max_trials = 0;
+    /// Wall clock time after which no new configs are measured.
+    std::chrono::milliseconds max_time{0};
+    /// Early stopping: the search ends after this many trials in a row that did not improve
+    /// the best time.
+    std::size_t patience = 0;
+
+    /// Reads MIOPEN_DEBUG_TUNING_MAX_TRIALS, MIOPEN_DEBUG_TUNING_MAX_TIME (seconds) and
+    /// MIOPEN_DEBUG_TUNING_PATIENCE.
+    static SearchBudget FromEnv();
+};
+
+struct SearchResult
+{
+    bool is_passed       = false; ///< False if no config has been measured successfully.
+    std::size_t best     = 0;     ///< Index of the best config.
+    float best_time      = std::numeric_limits<float>::max();
+    std::size_t n_trials = 0;
+    std::size_t n_failed = 0;
+};
+
+/// Measures the candidate configs for the search strategies. GenericSearch implements it with
+/// invokers, tests implement it with synthetic cost models.
+class SearchEvaluator
+{
+    public:
+    virtual ~SearchEvaluator() = default;
+
+    /// Called with the configs the strategy is about to measure, e.g. to compile them at once.
+    virtual void Prepare(const std::vector<std::size_t>& /*indices*/) {}
+
+    /// Runs the config `runs` times in a row and sets `time` to the total time in ms.
+    /// Returns false if the config has failed.
+    virtual bool Run(std::size_t index, std::size_t runs, float& time) = 0;
+
+    /// Times a trial of the config with the policy, running it once per Run(). Returns false
+    /// if the config has failed.
+    virtual bool
+    Time(std::size_t index, const TimingPolicy& policy, float best, TimingResult& result)
+    {
+        return MeasureTime(policy, best, [&](float& time) { return Run(index, 1, time); }, result);
+    }
+
+    /// Called after each trial. `time` is the time of the trial (averaged if the config has
+    /// been run several times) or zero if it has failed.
+    virtual void OnTrial(std::size_t /*index*/,
+                         bool /*failed*/,
+                         float /*time*/,
+                         const SearchResult& /*progress*/)
+    {
+    }
+};
+
+/// Searches for the fastest of `n_configs` configs. The trials are timed with the policy,
+/// except for SuccessiveHalving which sets the number of runs of each rung itself.
+SearchResult RunSearch(SearchStrategy strategy,
+                       const SearchBudget& budget,
+                       std::size_t n_configs,
+                       SearchEvaluator& evaluator,
+                       const TimingPolicy& policy = {});
+
+} // namespace solver
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_SEARCH_STRATEGY_HPP_
@@ -189,6 +189,51 @@ class SQLite
         int BindText(int idx, const std::string& txt);
         int BindBlob(int idx, const std::string& blob);
         int BindInt64(int idx, int64_t);
+        /// Makes the statement ready to be stepped through again and clears all the bindings.
+        void Reset();
+    };
+
+    /// A prepared statement borrowed from the per-connection statement cache. Statements are
+    /// cached by the text of the query, so values should be bound instead of being inlined into
+    /// the query. The statement is reset and returned to the cache upon destruction.
+    class CachedStatement
+    {
+        public:
+        CachedStatement(const SQLite& sql_, const std::string& query_);
+        CachedStatement(const SQLite& sql_,
+                        const std::string& query_,
+                        const std::vector<std::string>& vals);
+        ~CachedStatement();
+        CachedStatement(const CachedStatement&) = delete;
+        CachedStatement& operator=(const CachedStatement&) = delete;
+
+        Statement& operator*() { return stmt; }
+        Statement* operator->() { return &stmt; }
+
+        private:
+        const SQLite& sql;
+        std::string query;
+        Statement stmt;
+    };
+
+    /// Groups all the writes made through the connection while the object is alive into a single
+    /// transaction. Nested transactions are merged into the outermost one. Unless committed, the
+    /// outermost transaction is rolled back upon destruction. Transactions of different threads
+    /// on the same connection wait for each other.
+    class Transaction
+    {
+        public:
+        Transaction(const SQLite& sql_);
+        ~Transaction();
+        Transaction(const Transaction&) = delete;
+        Transaction& operator=(const Transaction&) = delete;
+        void Commit();
+
+        private:
+        const SQLite& sql;
+        std::unique_lock<std::recursive_mutex> lock;
+        bool outermost;
+        bool finished = false;
     };
 
     using result_type = std::vector<std::unordered_map<std::string, std::string>>;
@@ -204,6 +249,10 @@ class SQLite
     int Retry(std::function<int()>) const;
     static int Retry(std::function<int()> f, std::string filename);
     std::string ErrorMessage() const;
+
+    private:
+    Statement AcquireStatement(const std::string& query) const;
+    void ReleaseStatement(const std::string& query, Statement&& stmt) const;
 };
 
 template <typename Derived>
@@ -340,6 +389,21 @@ class SQLiteBase
         return reinterpret_cast<Derived*>(this)->LoadUnsafe(args...);
     }
 
+    /// Commits all the writes made by f at once.
+    template <class F>
+    inline void Batch(const F& f)
+    {
+        if(dbInvalid)
+        {
+            f();
+            return;
+        }
+
+        SQLite::Transaction transaction{sql};
+        f();
+        transaction.Commit();
+    }
+
     std::string filename;
     std::string arch;
     size_t num_cu;
@@ -383,8 +447,8 @@ class SQLitePerfDb : public SQLiteBase<SQLitePerfDb>
         std::string clause;
         std::vector<std::string> vals;
         std::tie(clause, vals) = prob_desc.InsertQuery();
-        auto stmt = SQLite::Statement{sql, clause, vals};
-        auto rc   = stmt.Step(sql);
+        SQLite::CachedStatement stmt{sql, clause, vals};
+        auto rc = stmt->Step(sql);
         if(rc != SQLITE_DONE)
             MIOPEN_THROW(miopenStatusInternalError,
                          "Failed to insert config: " + sql.ErrorMessage());
@@ -398,12 +462,12 @@ class SQLitePerfDb : public SQLiteBase<SQLitePerfDb>
         std::vector<std::string> vals;
         std::tie(clause, vals) = prob_desc.WhereClause();
         auto query = "SELECT id FROM " + prob_desc.table_name() + " WHERE ( " + clause + " );";
-        auto stmt  = SQLite::Statement{sql, query, vals};
+        SQLite::CachedStatement stmt{sql, query, vals};
         while(true)
         {
-            auto rc = stmt.Step(sql);
+            auto rc = stmt->Step(sql);
             if(rc == SQLITE_ROW)
-                return stmt.ColumnText(0);
+                return stmt->ColumnText(0);
             else if(rc == SQLITE_DONE)
                 return "";
             else if(rc == SQLITE_ERROR || rc == SQLITE_MISUSE)
@@ -426,16 +490,18 @@ class SQLitePerfDb : public SQLiteBase<SQLitePerfDb>
             "ON perf_db.config = " + problem_config.table_name() +".id "
             "WHERE "
             "( " + clause + " )"
-            "AND (arch = '" + arch + "' ) "
-            "AND (num_cu = '" + std::to_string(num_cu) + "');";
+            "AND (arch = ? ) "
+            "AND (num_cu = ? );";
         // clang-format on
-        auto stmt = SQLite::Statement{sql, select_query, values};
+        values.push_back(arch);
+        values.push_back(std::to_string(num_cu));
+        SQLite::CachedStatement stmt{sql, select_query, values};
         DbRecord rec;
         while(true)
         {
-            auto rc = stmt.Step(sql);
+            auto rc = stmt->Step(sql);
             if(rc == SQLITE_ROW)
-                rec.SetValues(stmt.ColumnText(0), stmt.ColumnText(1));
+                rec.SetValues(stmt->ColumnText(0), stmt->ColumnText(1));
             else if(rc == SQLITE_DONE)
                 break;
             else if(rc == SQLITE_ERROR || rc == SQLITE_MISUSE)
@@ -465,10 +531,11 @@ class SQLitePerfDb : public SQLiteBase<SQLitePerfDb>
             "WHERE config IN ("
             "SELECT id FROM config WHERE ( "
             + clause + " ) )"
-            "AND solver == '" +  id + "' ;";
+            "AND solver == ? ;";
         // clang-format on
-        auto stmt = SQLite::Statement{sql, query, values};
-        auto rc   = stmt.Step(sql);
+        values.push_back(id);
+        SQLite::CachedStatement stmt{sql, query, values};
+        auto rc = stmt->Step(sql);
         if(rc == SQLITE_DONE)
             return true;
         else
@@ -492,8 +559,8 @@ class SQLitePerfDb : public SQLiteBase<SQLitePerfDb>
             std::string clause;
             std::vector<std::string> vals;
             std::tie(clause, vals) = problem_config.InsertQuery();
-            auto stmt = SQLite::Statement{sql, clause, vals};
-            auto rc   = stmt.Step(sql);
+            SQLite::CachedStatement stmt{sql, clause, vals};
+            auto rc = stmt->Step(sql);
             if(rc != SQLITE_DONE)
                 MIOPEN_THROW(miopenStatusInternalError,
                              "Failed to insert config: " + sql.ErrorMessage());
@@ -521,8 +588,8 @@ class SQLitePerfDb : public SQLiteBase<SQLitePerfDb>
             vals.push_back(params.str());
             vals.push_back(arch);
             vals.push_back(std::to_string(num_cu));
-            auto stmt = SQLite::Statement{sql, query, vals};
-            auto rc   = stmt.Step(sql);
+            SQLite::CachedStatement stmt{sql, query, vals};
+            auto rc = stmt->Step(sql);
             if(rc != SQLITE_DONE)
             {
                 MIOPEN_LOG_E("Failed to insert performance record in the database: " +
@@ -561,8 +628,8 @@ class SQLitePerfDb : public SQLiteBase<SQLitePerfDb>
             "SELECT id FROM config WHERE ( "
             + clause + " ))";
         // clang-format on
-        auto stmt = SQLite::Statement{sql, query, values};
-        auto rc   = stmt.Step(sql);
+        SQLite::CachedStatement stmt{sql, query, values};
+        auto rc = stmt->Step(sql);
         if(rc != SQLITE_DONE)
         {
             MIOPEN_LOG_E("Unable to Clear databaes entry: " + sql.ErrorMessage());
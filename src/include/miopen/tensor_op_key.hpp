@@ -0,0 +1,133 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_TENSOR_OP_KEY_HPP_
+#define GUARD_MIOPEN_TENSOR_OP_KEY_HPP_
+
+#include <miopen/errors.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <ostream>
+#include <sstream>
+#include <string>
+
+namespace miopen {
+
+/// Kernel cache key of the tensor operations (set, scale, copy, etc).
+///
+/// Unlike the network config strings used elsewhere, the key has a fixed size and its hash is
+/// updated as the values are added, so building it and looking up the kernel cache with it
+/// does not allocate.
+class TensorOpKey
+{
+    public:
+    static constexpr std::size_t max_values = 16;
+
+    /// \param op_ String literal naming the operation. Keys of the same operation must use the
+    /// same number of values for the same kernel.
+    explicit TensorOpKey(const char* op_) : op(op_), hash(offset_basis)
+    {
+        for(auto c = op; *c != '\0'; ++c)
+            Mix(static_cast<unsigned char>(*c));
+    }
+
+    TensorOpKey& Add(std::size_t value)
+    {
+        if(count == max_values)
+            MIOPEN_THROW("Too many values in the tensor operation key: " + ToString());
+        values[count++] = value;
+        Mix(value);
+        return *this;
+    }
+
+    template <class Range>
+    TensorOpKey& AddRange(const Range& range)
+    {
+        for(const auto value : range)
+            Add(value);
+        return *this;
+    }
+
+    const char* GetOp() const { return op; }
+    std::size_t GetHash() const { return hash; }
+
+    /// Same layout as the network config strings, e.g. "set 1 64 3 224 224".
+    std::string ToString() const
+    {
+        std::ostringstream ss;
+        ss << *this;
+        return ss.str();
+    }
+
+    friend bool operator==(const TensorOpKey& left, const TensorOpKey& right)
+    {
+        return left.hash == right.hash && left.count == right.count &&
+               std::equal(left.values.begin(),
+                          left.values.begin() + left.count,
+                          right.values.begin()) &&
+               std::strcmp(left.op, right.op) == 0;
+    }
+
+    friend bool operator!=(const TensorOpKey& left, const TensorOpKey& right)
+    {
+        return !(left == right);
+    }
+
+    friend std::ostream& operator<<(std::ostream& stream, const TensorOpKey& key)
+    {
+        stream << key.op;
+        for(std::size_t i = 0; i < key.count; ++i)
+            stream << ' ' << key.values[i];
+        return stream;
+    }
+
+    struct Hasher
+    {
+        std::size_t operator()(const TensorOpKey& key) const noexcept { return key.GetHash(); }
+    };
+
+    private:
+    // 64-bit FNV-1a parameters
+    static constexpr std::size_t offset_basis = 14695981039346656037ULL;
+    static constexpr std::size_t prime        = 1099511628211ULL;
+
+    const char* op;
+    std::size_t hash;
+    std::size_t count = 0;
+    std::array<std::size_t, max_values> values{};
+
+    void Mix(std::size_t value)
+    {
+        hash ^= value;
+        hash *= prime;
+    }
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_TENSOR_OP_KEY_HPP_
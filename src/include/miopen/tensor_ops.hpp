@@ -31,41 +31,79 @@
 #include <miopen/object.hpp>
 #include <miopen/tensor.hpp>
 #include <miopen/functional.hpp>
+#include <array>
+#include <ostream>
 #include <vector>
-#include <boost/range/combine.hpp>
-#include <boost/range/adaptor/filtered.hpp>
+#include <boost/range/iterator_range.hpp>
 
 namespace miopen {
 
 struct Handle;
 
-struct f_length_is_not_1_t
+/// Tensor with the dimensions that are contiguous in memory merged together. Lengths and
+/// strides are kept in place, so flattening a descriptor does not allocate.
+struct FlatTensor
 {
-    template <typename T>
-    bool operator()(T&& v)
+    static constexpr std::size_t max_size = 5;
+
+    miopenDataType_t type = miopenFloat;
+    std::size_t size      = 0;
+    std::array<std::size_t, max_size> lengths{};
+    std::array<std::size_t, max_size> strides{};
+
+    miopenDataType_t GetType() const { return type; }
+    std::size_t GetSize() const { return size; }
+
+    boost::iterator_range<const std::size_t*> GetLengths() const
     {
-        return boost::get<0>(v) > 1;
+        return {lengths.data(), lengths.data() + size};
     }
-};
 
-TensorDescriptor GetFlattenedTensorDescriptor(const TensorDescriptor& desc);
+    boost::iterator_range<const std::size_t*> GetStrides() const
+    {
+        return {strides.data(), strides.data() + size};
+    }
 
+    std::size_t GetElementSize() const;
+    std::size_t GetElementSpace() const;
+    bool IsPacked() const { return GetElementSize() == GetElementSpace(); }
+
+    void PushBack(std::size_t length, std::size_t stride)
+    {
+        if(size == max_size)
+            MIOPEN_THROW(miopenStatusBadParm, "Tensor dimension sizes unsupported.");
+        lengths[size] = length;
+        strides[size] = stride;
+        ++size;
+    }
+
+    friend std::ostream& operator<<(std::ostream& stream, const FlatTensor& t);
+};
+
+/// Flattens the tensors so that the same element has the same flat index in all of them.
+/// Dimensions of length 1 are dropped, and two neighbouring dimensions are merged if each of
+/// the tensors has them contiguous in memory. Throws if more than FlatTensor::max_size
+/// dimensions remain.
 template <typename... TDescriptors>
-std::tuple<TDescriptors...>
-GetConsistentFlattenedTensorDescriptors(const TDescriptors&... real_descriptor_pack)
+std::array<FlatTensor, sizeof...(TDescriptors)>
+GetConsistentFlatTensors(const TDescriptors&... real_descriptor_pack)
 {
     constexpr std::size_t NTensor = sizeof...(TDescriptors);
-    std::integral_constant<std::size_t, NTensor> NTensorConstant;
 
-    std::array<const TensorDescriptor*, NTensor> real_descriptors{{(&real_descriptor_pack)...}};
+    const std::array<const TensorDescriptor*, NTensor> real_descriptors{
+        {(&real_descriptor_pack)...}};
+    std::array<FlatTensor, NTensor> flat_tensors;
+
+    for(std::size_t itensor = 0; itensor < NTensor; ++itensor)
+        flat_tensors[itensor].type = real_descriptors[itensor]->GetType();
+
+    const auto& lens = real_descriptors[0]->GetLengths();
 
 #ifndef NDEBUG
     // sanity check: all input TensorDescriptors should have the same GetLengths()
-    const auto& real_desc_0_lens = real_descriptors[0]->GetLengths();
-
     for(std::size_t itensor = 1; itensor < NTensor; ++itensor)
     {
-        if(real_desc_0_lens != real_descriptors[itensor]->GetLengths())
+        if(lens != real_descriptors[itensor]->GetLengths())
             MIOPEN_THROW(miopenStatusBadParm, "Lengths of Tensors are different.");
     }
 #endif
@@ -77,38 +115,37 @@ GetConsistentFlattenedTensorDescriptors(const TDescriptors&... real_descriptor_p
 
     if(is_all_packed)
     {
-        auto sz = real_descriptors[0]->GetElementSize();
-        return create_tuple<NTensor>([&](auto itensor) {
-            return TensorDescriptor{real_descriptors[itensor]->GetType(), {sz}, {1}};
-        });
+        const auto sz = real_descriptors[0]->GetElementSize();
+        for(auto& flat_tensor : flat_tensors)
+            flat_tensor.PushBack(sz, 1);
+        return flat_tensors;
     }
 
-    // start flattening tensors
-    std::array<std::vector<std::size_t>, NTensor> array_of_flat_lengths;
-    std::array<std::vector<std::size_t>, NTensor> array_of_flat_strides;
-
-    auto non1_length_strides =
-        boost::combine(real_descriptors[0]->GetLengths(), real_descriptor_pack.GetStrides()...) |
-        boost::adaptors::filtered(f_length_is_not_1_t());
+    // start flattening tensors, skipping the dimensions of length 1
+    const auto none      = lens.size();
+    auto i_previous      = none;
+    std::size_t flat_len = 1;
 
-    auto i               = non1_length_strides.begin();
-    std::size_t flat_len = boost::get<0>(*i);
-    auto i_previous      = i++;
-
-    // the 0-th dimension full-length doesn't matter
-    for(; i != non1_length_strides.end(); ++i)
+    for(std::size_t i = 0; i < lens.size(); ++i)
     {
-        std::size_t len = boost::get<0>(*i);
+        const auto len = lens[i];
+        if(len <= 1)
+            continue;
+
+        // the 0-th dimension full-length doesn't matter
+        if(i_previous == none)
+        {
+            flat_len   = len;
+            i_previous = i;
+            continue;
+        }
 
         bool is_all_full_length = true;
-        repeat_n(
-            [&](auto itensor) {
-                std::size_t stride          = boost::get<itensor + 1>(*i);
-                std::size_t previous_stride = boost::get<itensor + 1>(*i_previous);
-                std::size_t full_len        = previous_stride / stride;
-                is_all_full_length &= (len == full_len);
-            },
-            NTensorConstant);
+        for(std::size_t itensor = 0; itensor < NTensor; ++itensor)
+        {
+            const auto& strides = real_descriptors[itensor]->GetStrides();
+            is_all_full_length &= (len == strides[i_previous] / strides[i]);
+        }
 
         if(is_all_full_length)
         {
@@ -116,37 +153,26 @@ GetConsistentFlattenedTensorDescriptors(const TDescriptors&... real_descriptor_p
         }
         else
         {
-            array_of_flat_lengths[0].push_back(flat_len);
-
-            repeat_n(
-                [&](auto itensor) {
-                    std::size_t previous_stride = boost::get<itensor + 1>(*i_previous);
-                    array_of_flat_strides[itensor].push_back(previous_stride);
-                },
-                NTensorConstant);
+            for(std::size_t itensor = 0; itensor < NTensor; ++itensor)
+                flat_tensors[itensor].PushBack(
+                    flat_len, real_descriptors[itensor]->GetStrides()[i_previous]);
             flat_len = len;
         }
         i_previous = i;
     }
-    // lengths of all flattend tensors are the same
-    array_of_flat_lengths[0].push_back(flat_len);
-
-    // strides of all flattend tensors are different
-    repeat_n(
-        [&](auto itensor) {
-            std::size_t previous_stride = boost::get<itensor + 1>(*i_previous);
-            array_of_flat_strides[itensor].push_back(previous_stride);
-        },
-        NTensorConstant);
-
-    for(std::size_t itensor            = 1; itensor < NTensor; ++itensor)
-        array_of_flat_lengths[itensor] = array_of_flat_lengths[0];
-
-    return create_tuple<NTensor>([&](auto itensor) {
-        return TensorDescriptor{real_descriptors[itensor]->GetType(),
-                                std::move(array_of_flat_lengths[itensor]),
-                                std::move(array_of_flat_strides[itensor])};
-    });
+
+    // lengths of all flattend tensors are the same, strides are different
+    for(std::size_t itensor = 0; itensor < NTensor; ++itensor)
+        flat_tensors[itensor].PushBack(
+            flat_len,
+            i_previous == none ? 1 : real_descriptors[itensor]->GetStrides()[i_previous]);
+
+    return flat_tensors;
+}
+
+inline FlatTensor GetFlatTensor(const TensorDescriptor& desc)
+{
+    return GetConsistentFlatTensors(desc)[0];
 }
 
 void ScaleTensor(const Handle& handle,
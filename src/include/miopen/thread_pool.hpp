@@ -0,0 +1,92 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_THREAD_POOL_HPP_
+#define GUARD_MIOPEN_THREAD_POOL_HPP_
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#ifdef __MINGW32__
+#include <mingw.thread.h>
+#else
+#include <thread>
+#endif
+
+namespace miopen {
+
+/// Process-wide pool of worker threads backing par_for and friends.
+///
+/// Workers are created lazily, on the first request for that many threads, and live until the
+/// process exits. A parallel loop is split into chunks which are claimed dynamically, so a
+/// participant done with a cheap chunk proceeds with the next unclaimed one instead of idling
+/// until a fixed share of the work is done. The calling thread takes part in the loop, therefore
+/// nested loops and loops issued from workers do not deadlock when all workers are busy.
+class ThreadPool
+{
+    public:
+    /// Upper bound of the pool size, protects from runaway thread counts.
+    static constexpr std::size_t max_workers = 256;
+
+    static ThreadPool& Instance();
+
+    ThreadPool() = default;
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /// Calls f(begin, end) for consecutive ranges of at most chunk elements which cover [0, n),
+    /// using up to threads threads including the calling one. Blocks until all the ranges are
+    /// processed. The first exception thrown by f is rethrown; ranges not yet started when it
+    /// was thrown are skipped.
+    void ParallelFor(std::size_t n,
+                     std::size_t threads,
+                     std::size_t chunk,
+                     const std::function<void(std::size_t, std::size_t)>& f);
+
+    std::size_t Size() const;
+
+    private:
+    struct Job;
+
+    void Reserve(std::size_t workers);
+    void WorkerLoop();
+
+    mutable std::mutex mutex;
+    std::condition_variable has_work;
+    std::deque<std::shared_ptr<Job>> queue;
+    std::vector<std::thread> workers;
+    bool stopping = false;
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_THREAD_POOL_HPP_
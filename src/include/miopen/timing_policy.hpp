@@ -0,0 +1,86 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_TIMING_POLICY_HPP_
+#define GUARD_MIOPEN_TIMING_POLICY_HPP_
+
+#include <cstddef>
+#include <functional>
+#include <iosfwd>
+
+namespace miopen {
+
+/// How the time of a candidate is computed from its runs.
+///
+/// - Min: the fastest run.
+/// - Median: the middle run, or the average of the two middle ones.
+/// - TrimmedMean: the average of the runs without the fastest and the slowest quarter.
+enum class TimingStatistic
+{
+    Min,
+    Median,
+    TrimmedMean,
+};
+
+const char* ToCString(TimingStatistic statistic);
+std::ostream& operator<<(std::ostream& os, TimingStatistic statistic);
+
+/// How Find and GenericSearch measure a candidate.
+struct TimingPolicy
+{
+    /// Runs before the measured ones, they absorb first launch effects and clock ramp-up.
+    std::size_t warmup = 1;
+    /// Measured runs.
+    std::size_t repeats       = 5;
+    TimingStatistic statistic = TimingStatistic::Median;
+    /// The candidate is not run again if its first measured run is at least this many times
+    /// slower than the best time so far. Zero disables the early exit.
+    float early_exit = 1.05f;
+
+    /// Reads MIOPEN_DEBUG_TIMING_WARMUP, MIOPEN_DEBUG_TIMING_REPEATS,
+    /// MIOPEN_DEBUG_TIMING_STATISTIC (MIN, MEDIAN or TRIMMED_MEAN) and
+    /// MIOPEN_DEBUG_TIMING_EARLY_EXIT (percents of the best time, 0 disables).
+    static TimingPolicy FromEnv();
+};
+
+struct TimingResult
+{
+    float time                = 0.0f;
+    float variance            = 0.0f; ///< Of the measured runs.
+    std::size_t runs          = 0;    ///< Measured runs, less than the repeats after an early exit.
+    TimingStatistic statistic = TimingStatistic::Min;
+};
+
+/// Times a candidate according to the policy. `run` launches it once and sets the time of the
+/// launch in ms, e.g. from Handle::GetKernelTime(). `best` is the best time of the candidates
+/// measured before. Returns false if any run has failed.
+bool MeasureTime(const TimingPolicy& policy,
+                 float best,
+                 const std::function<bool(float&)>& run,
+                 TimingResult& result);
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_TIMING_POLICY_HPP_
@@ -0,0 +1,132 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_TUNING_CHECKPOINT_HPP_
+#define GUARD_MIOPEN_TUNING_CHECKPOINT_HPP_
+
+#include <miopen/search_strategy.hpp>
+
+#include <boost/filesystem/path.hpp>
+
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <map>
+#include <string>
+#include <utility>
+
+namespace miopen {
+namespace solver {
+
+/// Side file in the user db directory that keeps the measurements of an auto-tune search,
+/// so a search interrupted by a job timeout or preemption can be resumed.
+///
+/// The file is a text file with one record per line:
+///   run <runs> <total time in ms | fail> <config>
+///   trial <time in ms | fail> <config>
+///   best <time in ms> <config>
+/// "trial" lines hold the trials timed by the policy of the search. The last "best" line holds
+/// the best config found so far.
+class TuningCheckpoint
+{
+    public:
+    /// Loads the records of the file, if it exists. An empty path disables checkpointing.
+    explicit TuningCheckpoint(boost::filesystem::path path_);
+
+    /// Returns the path of the checkpoint of the search, or an empty path if checkpoints
+    /// are disabled by MIOPEN_DEBUG_TUNING_CHECKPOINT=0 or there is no user db.
+    static boost::filesystem::path GetPath(const std::string& db_basename,
+                                           const std::string& solver,
+                                           const std::string& problem);
+
+    const boost::filesystem::path& GetPath() const { return path; }
+    bool IsEnabled() const { return !path.empty(); }
+    std::size_t GetSize() const { return measurements.size(); }
+
+    /// Stands for the runs of a trial timed by the policy.
+    static constexpr std::size_t trial = 0;
+
+    /// Returns true if the config has been run the given number of times, and sets the
+    /// outcome of the runs.
+    bool Find(const std::string& config, std::size_t runs, bool& failed, float& time) const;
+
+    /// Returns false if no best config has been recorded yet.
+    bool GetBest(std::string& config, float& time) const;
+
+    void Record(const std::string& config, std::size_t runs, bool failed, float time);
+    void RecordBest(const std::string& config, float time);
+
+    /// Removes the file once the search has completed.
+    void Remove();
+
+    private:
+    struct Outcome
+    {
+        bool failed;
+        float time;
+    };
+
+    boost::filesystem::path path;
+    std::ofstream file;
+    std::map<std::pair<std::string, std::size_t>, Outcome> measurements;
+    std::string best_config;
+    float best_time = 0.0f;
+
+    void Append(const std::string& line);
+};
+
+/// Replays the measurements recorded in the checkpoint instead of running the configs again,
+/// and records the new ones. The strategies are deterministic, so a resumed search takes the
+/// same path as the interrupted one until it gets to the configs that have not been measured.
+class CheckpointedSearchEvaluator : public SearchEvaluator
+{
+    public:
+    CheckpointedSearchEvaluator(SearchEvaluator& inner_,
+                                TuningCheckpoint& checkpoint_,
+                                std::function<std::string(std::size_t)> get_config_);
+
+    void Prepare(const std::vector<std::size_t>& indices) override;
+    bool Run(std::size_t index, std::size_t runs, float& time) override;
+    bool Time(std::size_t index,
+              const TimingPolicy& policy,
+              float best,
+              TimingResult& result) override;
+    void OnTrial(std::size_t index, bool failed, float time, const SearchResult& progress) override;
+
+    /// Number of measurements replayed from the checkpoint.
+    std::size_t GetReplayed() const { return replayed; }
+
+    private:
+    SearchEvaluator& inner;
+    TuningCheckpoint& checkpoint;
+    std::function<std::string(std::size_t)> get_config;
+    std::size_t replayed = 0;
+    float recorded_best  = std::numeric_limits<float>::max();
+};
+
+} // namespace solver
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_TUNING_CHECKPOINT_HPP_
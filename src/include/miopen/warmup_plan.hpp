@@ -0,0 +1,106 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_WARMUP_PLAN_HPP_
+#define GUARD_MIOPEN_WARMUP_PLAN_HPP_
+
+#include <miopen/miopen.h>
+#include <miopen/problem_description.hpp>
+
+#include <cstddef>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace miopen {
+
+/// A convolution recorded by MIOPEN_ENABLE_LOGGING_CMD as a MIOpenDriver command line,
+/// see LogCmdConvolution().
+struct DriverConvCommand
+{
+    miopenDataType_t type = miopenFloat;
+    std::vector<int> in_lens;  // n, c, [d,] h, w
+    std::vector<int> wei_lens; // k, c / groups, [d,] y, x
+    std::vector<int> pads;
+    std::vector<int> strides;
+    std::vector<int> dilations;
+    std::string in_layout;
+    std::string fil_layout;
+    std::string out_layout;
+    miopenConvolutionMode_t mode = miopenConvolution;
+    int group_count              = 1;
+    /// The -F flag: a mask of 1 (forward), 2 (backward data) and 4 (backward weights),
+    /// 0 means all of them.
+    int directions = 0;
+
+    int GetSpatialDimension() const { return static_cast<int>(in_lens.size()) - 2; }
+};
+
+/// Prints the command in the MIOpenDriver syntax, without the "./bin/MIOpenDriver" prefix.
+std::ostream& operator<<(std::ostream& os, const DriverConvCommand& command);
+
+/// Extracts the convolution from a log line in the text or the JSON format. Returns false
+/// for the lines which do not hold a valid convolution command.
+bool ParseDriverConvCommand(const std::string& line, DriverConvCommand& command);
+
+/// A unique problem to warm up: the command has exactly one direction set.
+struct WarmupProblem
+{
+    DriverConvCommand command;
+    ProblemDescription problem;
+};
+
+/// Deduplicates the problems of the recorded commands. Problems are identified by their
+/// db key, so the same layer logged by several calls (e.g. Find and Run) or several runs
+/// is compiled once. No GPU is involved.
+class WarmupPlan
+{
+    public:
+    /// Adds the convolutions of a log. Returns the number of new problems.
+    std::size_t AddLog(std::istream& log);
+    /// Adds a convolution for each of its directions. Returns the number of new problems.
+    std::size_t Add(const DriverConvCommand& command);
+
+    const std::vector<WarmupProblem>& GetProblems() const { return problems; }
+    /// Number of the convolution commands seen.
+    std::size_t GetCommandCount() const { return n_commands; }
+    /// Number of the problems which were already in the plan.
+    std::size_t GetDuplicateCount() const { return n_duplicates; }
+    /// Number of the convolution commands which do not describe a valid problem.
+    std::size_t GetInvalidCount() const { return n_invalid; }
+
+    private:
+    std::vector<WarmupProblem> problems;
+    std::unordered_set<std::string> keys;
+    std::size_t n_commands   = 0;
+    std::size_t n_duplicates = 0;
+    std::size_t n_invalid    = 0;
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_WARMUP_PLAN_HPP_
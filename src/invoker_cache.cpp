@@ -27,83 +27,217 @@
 #include <miopen/invoker_cache.hpp>
 #include <miopen/logger.hpp>
 
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <vector>
+
 namespace miopen {
 
-boost::optional<const Invoker&> InvokerCache::operator[](const Key& key) const
+class InvokerCache::impl
 {
-    const auto item = invokers.find(key.first);
-    if(item == invokers.end())
-        return boost::none;
-    const auto& item_invokers = item->second.invokers;
-    const auto invoker        = item_invokers.find(key.second);
-    if(invoker == item_invokers.end())
-        return boost::none;
-    return invoker->second;
-}
+    struct Entry
+    {
+        std::uint64_t hash;
+        NetworkConfig network_config;
+        solver::Id solver_id;
+        // For find 1.0 results only
+        AlgorithmName algorithm;
+        // For invokers only
+        Invoker invoker;
+        // For find 1.0 results, the entry of the invoker found
+        const Entry* found;
+    };
 
-boost::optional<const Invoker&> InvokerCache::GetFound1_0(const std::string& network_config,
-                                                          const std::string& algorithm) const
-{
-    const auto item = invokers.find(network_config);
-    if(item == invokers.end())
+    struct Link
     {
-        MIOPEN_LOG_I2("No invokers found for " << network_config);
-        return boost::none;
+        const Entry* entry;
+        const Link* next;
+    };
+
+    struct Table
+    {
+        explicit Table(std::size_t size) : buckets(size) {}
+        std::vector<std::atomic<const Link*>> buckets;
+        std::deque<Link> links;
+    };
+
+    public:
+    impl() { Rehash(64); }
+
+    template <class Match>
+    const Entry* Find(std::uint64_t hash, Match match) const
+    {
+        const auto table = current.load(std::memory_order_acquire);
+        const auto& head = table->buckets[hash & (table->buckets.size() - 1)];
+        for(auto link = head.load(std::memory_order_acquire); link != nullptr; link = link->next)
+        {
+            if(link->entry->hash == hash && match(*link->entry))
+                return link->entry;
+        }
+        return nullptr;
+    }
+
+    const Entry* FindInvoker(const NetworkConfig& network_config, solver::Id solver_id) const
+    {
+        return Find(InvokerHash(network_config, solver_id), [&](const Entry& entry) {
+            return entry.found == nullptr && entry.solver_id == solver_id &&
+                   entry.network_config == network_config;
+        });
     }
-    if(item->second.found_1_0.empty())
+
+    const Entry* FindFound1_0(const NetworkConfig& network_config,
+                              const AlgorithmName& algorithm) const
     {
-        MIOPEN_LOG_I2("Invokers found for " << network_config
-                                            << " but there is no find 1.0 result.");
-        return boost::none;
+        return Find(Found1_0Hash(network_config, algorithm), [&](const Entry& entry) {
+            return entry.found != nullptr && entry.algorithm == algorithm &&
+                   entry.network_config == network_config;
+        });
     }
-    const auto& item_invokers = item->second.invokers;
-    const auto& found_1_0_ids = item->second.found_1_0;
-    const auto found_1_0_id   = found_1_0_ids.find(algorithm);
-    if(found_1_0_id == found_1_0_ids.end())
+
+    bool Register(const NetworkConfig& network_config,
+                  solver::Id solver_id,
+                  const Invoker& invoker)
     {
-        MIOPEN_LOG_I2("Invokers found for " << network_config
-                                            << " but there is no one with an algorithm "
-                                            << algorithm);
-        return boost::none;
+        std::lock_guard<std::mutex> lock{mutex};
+        if(FindInvoker(network_config, solver_id) != nullptr)
+            return false;
+        entries.push_back({InvokerHash(network_config, solver_id),
+                           network_config,
+                           solver_id,
+                           {},
+                           invoker,
+                           nullptr});
+        Publish(entries.back());
+        return true;
     }
-    const auto invoker = item_invokers.find(found_1_0_id->second);
-    if(invoker == item_invokers.end())
-        MIOPEN_THROW("No invoker with solver_id of " + found_1_0_id->second +
-                     " was registered for " + network_config);
-    return invoker->second;
-}
 
-void InvokerCache::Register(const Key& key, const Invoker& invoker)
+    bool SetAsFound1_0(const NetworkConfig& network_config,
+                       const AlgorithmName& algorithm,
+                       solver::Id solver_id)
+    {
+        std::lock_guard<std::mutex> lock{mutex};
+        const auto invoker = FindInvoker(network_config, solver_id);
+        if(invoker == nullptr)
+            return false;
+        const auto found = FindFound1_0(network_config, algorithm);
+        if(found != nullptr && found->found == invoker)
+            return true;
+        // The new entry shadows the previous result for the algorithm, if any.
+        entries.push_back({Found1_0Hash(network_config, algorithm),
+                           network_config,
+                           solver_id,
+                           algorithm,
+                           {},
+                           invoker});
+        Publish(entries.back());
+        return true;
+    }
+
+    private:
+    std::atomic<const Table*> current{nullptr};
+    // Only the writers use the fields below, under the mutex. The entries never move and the
+    // tables replaced by bigger ones are kept, as the readers may still be using them.
+    std::mutex mutex;
+    std::deque<Entry> entries;
+    std::vector<std::unique_ptr<Table>> tables;
+
+    static std::uint64_t Combine(std::uint64_t hash, std::uint64_t value)
+    {
+        return hash ^ (value + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2));
+    }
+
+    static std::uint64_t InvokerHash(const NetworkConfig& network_config, solver::Id solver_id)
+    {
+        return Combine(network_config.GetHash(), solver_id.Value());
+    }
+
+    static std::uint64_t Found1_0Hash(const NetworkConfig& network_config,
+                                      const AlgorithmName& algorithm)
+    {
+        return Combine(network_config.GetHash(), algorithm.GetHash());
+    }
+
+    static void Insert(Table& table, const Entry& entry)
+    {
+        auto& head = table.buckets[entry.hash & (table.buckets.size() - 1)];
+        table.links.push_back({&entry, head.load(std::memory_order_relaxed)});
+        head.store(&table.links.back(), std::memory_order_release);
+    }
+
+    void Publish(const Entry& entry)
+    {
+        auto& table = *tables.back();
+        if(entries.size() > table.buckets.size())
+            Rehash(table.buckets.size() * 2);
+        else
+            Insert(table, entry);
+    }
+
+    void Rehash(std::size_t size)
+    {
+        auto table = std::make_unique<Table>(size);
+        // Linking in the order of insertion keeps the newest entries first in the chains.
+        for(const auto& entry : entries)
+            Insert(*table, entry);
+        current.store(table.get(), std::memory_order_release);
+        tables.push_back(std::move(table));
+    }
+};
+
+InvokerCache::InvokerCache() : pImpl{std::make_unique<impl>()} {}
+InvokerCache::~InvokerCache()                                  = default;
+InvokerCache::InvokerCache(InvokerCache&&) noexcept            = default;
+InvokerCache& InvokerCache::operator=(InvokerCache&&) noexcept = default;
+
+boost::optional<const Invoker&> InvokerCache::Get(const NetworkConfig& network_config,
+                                                  solver::Id solver_id) const
 {
-    auto it = invokers.find(key.first);
-    if(it != invokers.end())
-        it->second.invokers.insert({key.second, invoker});
-    auto& item = invokers.insert({key.first, Item{}}).first->second;
-    item.invokers.insert({key.second, invoker});
-    MIOPEN_LOG_I2("Invoker registered for algorithm " << key.first << " and solver " << key.second);
+    const auto entry = pImpl->FindInvoker(network_config, solver_id);
+    if(entry == nullptr)
+        return boost::none;
+    return entry->invoker;
 }
 
-void InvokerCache::SetAsFound1_0(const std::string& network_config,
-                                 const std::string& algorithm,
-                                 const std::string& solver_id)
+boost::optional<const Invoker&> InvokerCache::GetFound1_0(const NetworkConfig& network_config,
+                                                          const AlgorithmName& algorithm) const
 {
-    const auto item = invokers.find(network_config);
-    if(item == invokers.end())
-        MIOPEN_THROW("No invoker was registered for " + network_config);
-
+    const auto entry = pImpl->FindFound1_0(network_config, algorithm);
+    if(entry == nullptr)
     {
-        // Validating at find time
-        const auto& item_invokers = item->second.invokers;
-        const auto invoker        = item_invokers.find(solver_id);
-        if(invoker == item_invokers.end())
-            MIOPEN_THROW("No invoker with solver_id of " + solver_id + " was registered for " +
-                         network_config);
+        MIOPEN_LOG_I2("No find 1.0 result for " << network_config.ToString()
+                                                << " with an algorithm "
+                                                << algorithm.ToString());
+        return boost::none;
     }
+    return entry->found->invoker;
+}
+
+void InvokerCache::Register(const NetworkConfig& network_config,
+                            solver::Id solver_id,
+                            const Invoker& invoker)
+{
+    if(!solver_id.IsValid())
+        MIOPEN_THROW("Invoker registered for an invalid solver_id for " +
+                     network_config.ToString());
+    if(pImpl->Register(network_config, solver_id, invoker))
+        MIOPEN_LOG_I2("Invoker registered for algorithm " << network_config.ToString()
+                                                          << " and solver "
+                                                          << solver_id.ToString());
+}
 
-    item->second.found_1_0[algorithm] = solver_id;
-    MIOPEN_LOG_I2("Solver " << solver_id << " registered as find 1.0 best for " << algorithm
+void InvokerCache::SetAsFound1_0(const NetworkConfig& network_config,
+                                 const AlgorithmName& algorithm,
+                                 solver::Id solver_id)
+{
+    // Validating at find time
+    if(!pImpl->SetAsFound1_0(network_config, algorithm, solver_id))
+        MIOPEN_THROW("No invoker with solver_id of " + solver_id.ToString() +
+                     " was registered for " + network_config.ToString());
+    MIOPEN_LOG_I2("Solver " << solver_id.ToString() << " registered as find 1.0 best for "
+                            << algorithm.ToString()
                             << " in "
-                            << network_config);
+                            << network_config.ToString());
 }
 
 } // namespace miopen
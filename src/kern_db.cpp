@@ -24,16 +24,91 @@
  *
  *******************************************************************************/
 #include <miopen/kern_db.hpp>
+#include <miopen/env.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/lz.hpp>
+#include <miopen/md5.hpp>
+#include <miopen/stringutils.hpp>
+#include <miopen/xxhash.hpp>
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_KERNEL_CACHE_CODEC)
 
 namespace miopen {
+boost::optional<KernDbCodec> KernDbCodec::Parse(const std::string& str)
+{
+    const auto colon = str.find(':');
+    const auto name  = ToUpper(str.substr(0, colon));
+    KernDbCodec result;
+    if(name == "NONE")
+        result.id = None;
+    else if(name == "BZ2")
+        result = {Bz2, 9};
+    else if(name == "LZ")
+        result = {Lz, 1};
+    else
+        return boost::none;
+
+    if(colon != std::string::npos)
+    {
+        const auto level = str.substr(colon + 1);
+        if(level.empty() || level.find_first_not_of("0123456789") != std::string::npos)
+            return boost::none;
+        result.level = std::stoi(level);
+        if(result.level < 1 || result.level > 9)
+            return boost::none;
+    }
+    return result;
+}
+
+KernDbCodec KernDbCodec::GetDefault()
+{
+    const char* const p = GetStringEnv(MIOPEN_DEBUG_KERNEL_CACHE_CODEC{});
+    if(p == nullptr)
+        return {};
+    const auto codec = Parse(p);
+    if(codec)
+        return *codec;
+    MIOPEN_LOG_W("Unknown MIOPEN_DEBUG_KERNEL_CACHE_CODEC value: " << p << ", using LZ");
+    return {};
+}
+
+std::string KernDbCodec::ToString() const
+{
+    switch(id)
+    {
+    case None: return "none";
+    case Bz2: return "bz2:" + std::to_string(level);
+    case Lz: return "lz:" + std::to_string(level);
+    }
+    return {};
+}
+
 KernDb::KernDb(const std::string& filename_,
                bool is_system,
                const std::string& arch_,
                const std::size_t num_cu_)
-    : KernDb(filename_, is_system, arch_, num_cu_, compress, decompress)
+    : KernDb(filename_, is_system, arch_, num_cu_, KernDbCodec::GetDefault())
 {
 }
 
+KernDb::KernDb(const std::string& filename_,
+               bool is_system,
+               const std::string& arch_,
+               const std::size_t num_cu_,
+               KernDbCodec codec_)
+    : KernDb(filename_,
+             is_system,
+             arch_,
+             num_cu_,
+             [=](std::string s, bool* compressed) {
+                 const auto level = codec_.id == KernDbCodec::Bz2 ? codec_.level : 9;
+                 return compress(std::move(s), compressed, level);
+             },
+             decompress)
+{
+    codec = codec_;
+}
+
 KernDb::KernDb(const std::string& filename_,
                bool is_system,
                const std::string& _arch,
@@ -42,7 +117,8 @@ KernDb::KernDb(const std::string& filename_,
                std::function<std::string(std::string, unsigned int)> _decompress_fn)
     : SQLiteBase(filename_, is_system, _arch, _num_cu),
       compress_fn(_compress_fn),
-      decompress_fn(_decompress_fn)
+      decompress_fn(_decompress_fn),
+      codec{KernDbCodec::Bz2, 9}
 {
     if(dbInvalid)
     {
@@ -65,7 +141,81 @@ KernDb::KernDb(const std::string& filename_,
            << filename;
         MIOPEN_LOG_W(ss.str());
         dbInvalid = true;
+        return;
     }
+    has_codec_column = CheckTableColumns(KernelConfig::table_name(), {"codec"});
+    if(!has_codec_column && !is_system)
+    {
+        try
+        {
+            sql.Exec(KernelConfig::AddCodecQuery());
+        }
+        catch(const Exception&)
+        {
+            // Another process may have added the column in the meantime.
+        }
+        has_codec_column = CheckTableColumns(KernelConfig::table_name(), {"codec"});
+    }
+}
+
+KernDb::EncodedBlob KernDb::Encode(const std::string& blob) const
+{
+    EncodedBlob result;
+    auto compressed = false;
+    // A table without the codec column can only hold the rows older readers understand.
+    const auto id = has_codec_column ? codec.id : KernDbCodec::Bz2;
+    switch(id)
+    {
+    case KernDbCodec::None: break;
+    case KernDbCodec::Bz2: result.data = compress_fn(blob, &compressed); break;
+    case KernDbCodec::Lz: result.data = lz_compress(blob, codec.level, &compressed); break;
+    }
+
+    if(compressed)
+    {
+        result.uncompressed_size = blob.size();
+        result.codec             = codec.ToString();
+    }
+    else
+    {
+        result.data              = blob;
+        result.uncompressed_size = 0;
+        result.codec             = KernDbCodec{KernDbCodec::None}.ToString();
+    }
+    result.hash = has_codec_column ? xxhash64(blob) : md5(blob);
+    return result;
+}
+
+std::string KernDb::Decode(std::string data,
+                           const std::string& hash,
+                           std::int64_t uncompressed_size,
+                           const std::string& codec_name) const
+{
+    auto id = KernDbCodec::Bz2;
+    if(!codec_name.empty())
+    {
+        const auto row_codec = KernDbCodec::Parse(codec_name);
+        if(!row_codec)
+            MIOPEN_THROW(miopenStatusInternalError, "Unknown kernel cache codec: " + codec_name);
+        id = row_codec->id;
+    }
+
+    if(uncompressed_size != 0)
+    {
+        switch(id)
+        {
+        case KernDbCodec::None: break;
+        case KernDbCodec::Bz2:
+            data = decompress_fn(data, static_cast<unsigned int>(uncompressed_size));
+            break;
+        case KernDbCodec::Lz: data = lz_decompress(data, uncompressed_size); break;
+        }
+    }
+
+    const auto actual_hash = codec_name.empty() ? md5(data) : xxhash64(data);
+    if(actual_hash != hash)
+        MIOPEN_THROW(miopenStatusInternalError, "Possible database corruption");
+    return data;
 }
 
 } // namespace miopen
@@ -175,6 +175,36 @@ void KernelCache::ClearKernels(const std::string& algorithm, const std::string&
     v.clear();
 }
 
+KernelCache::TensorOpKernel* KernelCache::FindKernel(const TensorOpKey& key)
+{
+    const auto it = tensor_op_kernel_map.find(key);
+    return it != tensor_op_kernel_map.end() ? &it->second : nullptr;
+}
+
+KernelCache::TensorOpKernel& KernelCache::AddKernel(const TensorOpKey& key, Kernel k)
+{
+    MIOPEN_LOG_I2("Key: " << key);
+    const auto inserted = tensor_op_kernel_map.emplace(key, TensorOpKernel{k});
+    if(!inserted.second)
+        inserted.first->second = TensorOpKernel{std::move(k)};
+    return inserted.first->second;
+}
+
+const KernelInvoke& KernelCache::TensorOpKernel::GetInvoke(const Handle& h)
+{
+    const auto current_stream    = h.GetStream();
+    const auto current_profiling = h.IsProfilingEnabled();
+
+    if(!resolved || stream != current_stream || profiling != current_profiling)
+    {
+        invoke    = h.Run(kernel);
+        stream    = current_stream;
+        profiling = current_profiling;
+        resolved  = true;
+    }
+    return invoke;
+}
+
 KernelCache::KernelCache() {}
 
 } // namespace miopen
@@ -27,10 +27,22 @@
 #include <miopen/logger.hpp>
 #include <miopen/config.h>
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
 #include <cstdlib>
 #include <chrono>
 #include <ios>
 #include <iomanip>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#ifdef __MINGW32__
+#include <mingw.thread.h>
+#else
+#include <thread>
+#endif
 
 #ifdef __linux__
 #include <unistd.h>
@@ -60,6 +72,14 @@ MIOPEN_DECLARE_ENV_VAR(MIOPEN_ENABLE_LOGGING_ELAPSED_TIME)
 /// See LoggingLevel in the header.
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_LOG_LEVEL)
 
+/// Write the log from a background thread. The threads issuing log records
+/// only put them into their buffers, which reduces the cost of logging in
+/// multi-threaded applications.
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_ENABLE_LOGGING_ASYNC)
+
+/// Write each log record as a JSON object on a separate line.
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_ENABLE_LOGGING_JSON)
+
 namespace debug {
 
 bool LoggingQuiet = false; // NOLINT (cppcoreguidelines-avoid-non-const-global-variables)
@@ -94,23 +114,386 @@ inline int GetProcessAndThreadId()
 {
 #ifdef __linux__
     // LWP is fine for identifying both processes and threads.
-    return syscall(SYS_gettid); // NOLINT
+    thread_local const int id = syscall(SYS_gettid); // NOLINT
+    return id;
 #else
     return 0; // Not implemented.
 #endif
 }
 
-inline float GetTimeDiff()
+inline int GetProcessId()
+{
+#ifdef __linux__
+    return getpid();
+#else
+    return 0; // Not implemented.
+#endif
+}
+
+inline float GetTimeDiff(const std::chrono::steady_clock::time_point now)
 {
     // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
-    static auto prev = std::chrono::steady_clock::now();
-    auto now         = std::chrono::steady_clock::now();
+    static auto prev = now;
     auto rv =
         std::chrono::duration_cast<std::chrono::duration<float, std::milli>>(now - prev).count();
     prev = now;
     return rv;
 }
 
+struct LogRecord
+{
+    LogRecordKind kind;
+    LoggingLevel level;
+    int thread_id;
+    std::chrono::steady_clock::time_point time;
+    std::string fn;
+    LogFunctionName fn_name;
+    std::string text;
+
+    std::string GetFunction() const
+    {
+        if(fn_name.func == nullptr)
+            return fn;
+        return LoggingParseFunction(fn_name.func, fn_name.pretty_func);
+    }
+};
+
+/// Serializes the writes, so the lines from different threads do not interleave.
+std::mutex& GetOutputMutex()
+{
+    static std::mutex mutex;
+    return mutex;
+}
+
+const char* LogRecordKindToCString(const LogRecordKind kind)
+{
+    switch(kind)
+    {
+    case LogRecordKind::Message: return "message";
+    case LogRecordKind::Function: return "function";
+    case LogRecordKind::Command: return "command";
+    }
+    return "<Unknown>";
+}
+
+void WriteText(std::ostream& os, const LogRecord& record)
+{
+    if(miopen::IsEnabled(MIOPEN_ENABLE_LOGGING_MPMT{}))
+        os << record.thread_id << ' ';
+    os << "MIOpen";
+#if MIOPEN_BACKEND_OPENCL
+    os << "(OpenCL)";
+#elif MIOPEN_BACKEND_HIP
+    os << "(HIP)";
+#endif
+    if(miopen::IsEnabled(MIOPEN_ENABLE_LOGGING_ELAPSED_TIME{}))
+    {
+        const auto flags = os.flags();
+        os << std::fixed << std::setprecision(3) << std::setw(8) << GetTimeDiff(record.time);
+        os.flags(flags);
+    }
+    os << ": ";
+
+    switch(record.kind)
+    {
+    case LogRecordKind::Message:
+        os << LoggingLevelToCString(record.level) << " [" << record.GetFunction() << "] ";
+        break;
+    case LogRecordKind::Function: break;
+    case LogRecordKind::Command: os << "Command [" << record.GetFunction() << "] "; break;
+    }
+    os << record.text << '\n';
+}
+
+void WriteJsonString(std::ostream& os, const std::string& str)
+{
+    os << '"';
+    for(const auto c : str)
+    {
+        switch(c)
+        {
+        case '"': os << "\\\""; break;
+        case '\\': os << "\\\\"; break;
+        case '\n': os << "\\n"; break;
+        case '\r': os << "\\r"; break;
+        case '\t': os << "\\t"; break;
+        default:
+            if(static_cast<unsigned char>(c) < 0x20)
+            {
+                const auto flags = os.flags();
+                os << "\\u" << std::hex << std::setw(4) << std::setfill('0')
+                   << static_cast<int>(c);
+                os.flags(flags);
+                os << std::setfill(' ');
+            }
+            else
+            {
+                os << c;
+            }
+        }
+    }
+    os << '"';
+}
+
+void WriteJson(std::ostream& os, const LogRecord& record)
+{
+    // The records are stamped with the monotonic clock, which is cheaper to read.
+    static const auto steady_start = std::chrono::steady_clock::now();
+    static const auto system_start = std::chrono::system_clock::now();
+    const auto time = system_start.time_since_epoch() + (record.time - steady_start);
+
+    os << "{\"time_us\":" << std::chrono::duration_cast<std::chrono::microseconds>(time).count()
+       << ",\"pid\":" << GetProcessId()
+       << ",\"tid\":" << record.thread_id << ",\"level\":\""
+       << LoggingLevelToCString(record.level) << "\",\"kind\":\""
+       << LogRecordKindToCString(record.kind) << "\",\"function\":";
+    WriteJsonString(os, record.GetFunction());
+    os << ",\"message\":";
+    WriteJsonString(os, record.text);
+    os << "}\n";
+}
+
+template <class It>
+void WriteRecords(It begin, It end)
+{
+    std::ostringstream ss;
+    const auto json = miopen::IsEnabled(MIOPEN_ENABLE_LOGGING_JSON{});
+    std::lock_guard<std::mutex> lock(GetOutputMutex());
+    for(auto it = begin; it != end; ++it)
+    {
+        if(json)
+            WriteJson(ss, *it);
+        else
+            WriteText(ss, *it);
+    }
+    std::cerr << ss.str() << std::flush;
+}
+
+/// Single producer, single consumer ring of log records. The thread issuing the records
+/// does not wait for anything: when the ring is full, the record is dropped and counted.
+class LogRing
+{
+    public:
+    static constexpr std::size_t capacity = 4096;
+
+    LogRing() : slots(capacity) {}
+
+    /// Returns true when the ring gets half full, so the writer should be woken up.
+    bool Push(LogRecord&& record)
+    {
+        const auto h = head.load(std::memory_order_relaxed);
+        if(h - tail.load(std::memory_order_acquire) == capacity)
+        {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        slots[h % capacity] = std::move(record);
+        head.store(h + 1, std::memory_order_release);
+        return h + 1 - tail.load(std::memory_order_relaxed) == capacity / 2;
+    }
+
+    void PopAll(std::vector<LogRecord>& records)
+    {
+        auto t       = tail.load(std::memory_order_relaxed);
+        const auto h = head.load(std::memory_order_acquire);
+        for(; t != h; ++t)
+            records.push_back(std::move(slots[t % capacity]));
+        tail.store(t, std::memory_order_release);
+    }
+
+    std::size_t GetDropped() const { return dropped.load(std::memory_order_relaxed); }
+
+    /// Set when the owning thread exits, the ring is removed after the last records are
+    /// written.
+    std::atomic<bool> closed{false};
+
+    private:
+    std::vector<LogRecord> slots;
+    std::atomic<std::size_t> head{0};
+    std::atomic<std::size_t> tail{0};
+    std::atomic<std::size_t> dropped{0};
+};
+
+/// Owns the rings of the threads and the thread which writes out their records.
+///
+/// The instance is never destroyed, so the records issued from static destructors are not
+/// lost: the writer is stopped at exit, and the records issued after that are written
+/// synchronously.
+class AsyncLog
+{
+    public:
+    static AsyncLog& Instance()
+    {
+        static auto* const instance = new AsyncLog{}; // NOLINT (cppcoreguidelines-owning-memory)
+        return *instance;
+    }
+
+    /// Returns false if the writer has been stopped.
+    bool Push(LogRecord&& record)
+    {
+        std::call_once(started, [this]() {
+            writer = std::thread([this]() { WriterLoop(); });
+            std::atexit([]() { Instance().Stop(); });
+        });
+        if(stopped.load(std::memory_order_acquire))
+            return false;
+        if(GetRing().Push(std::move(record)))
+            wake.notify_one();
+        return true;
+    }
+
+    void Drain()
+    {
+        std::lock_guard<std::mutex> drain_lock(drain_mutex);
+
+        auto current = std::vector<std::shared_ptr<LogRing>>{};
+        {
+            std::lock_guard<std::mutex> lock(rings_mutex);
+            current = rings;
+        }
+
+        batch.clear();
+        auto dropped = dropped_closed;
+        for(const auto& ring : current)
+        {
+            const auto closed = ring->closed.load(std::memory_order_acquire);
+            ring->PopAll(batch);
+            dropped += ring->GetDropped();
+            if(closed)
+            {
+                dropped_closed += ring->GetDropped();
+                std::lock_guard<std::mutex> lock(rings_mutex);
+                rings.erase(std::find(rings.begin(), rings.end(), ring));
+            }
+        }
+
+        // Records of each thread are in order, merge the threads.
+        std::stable_sort(batch.begin(), batch.end(), [](const auto& left, const auto& right) {
+            return left.time < right.time;
+        });
+        if(!batch.empty())
+            WriteRecords(batch.begin(), batch.end());
+
+        if(dropped > reported_dropped)
+        {
+            std::ostringstream ss;
+            ss << dropped - reported_dropped << " log records have been dropped, total "
+               << dropped;
+            const auto record = LogRecord{LogRecordKind::Message,
+                                          LoggingLevel::Warning,
+                                          GetProcessAndThreadId(),
+                                          std::chrono::steady_clock::now(),
+                                          "AsyncLog",
+                                          {},
+                                          ss.str()};
+            WriteRecords(&record, &record + 1);
+            reported_dropped = dropped;
+        }
+    }
+
+    std::size_t GetDropped()
+    {
+        std::lock_guard<std::mutex> drain_lock(drain_mutex);
+        std::lock_guard<std::mutex> lock(rings_mutex);
+        auto dropped = dropped_closed;
+        for(const auto& ring : rings)
+            dropped += ring->GetDropped();
+        return dropped;
+    }
+
+    private:
+    struct RingHolder
+    {
+        std::shared_ptr<LogRing> ring;
+        ~RingHolder()
+        {
+            if(ring)
+                ring->closed.store(true, std::memory_order_release);
+        }
+    };
+
+    std::once_flag started;
+    std::thread writer;
+    std::atomic<bool> stopped{false};
+    std::mutex wake_mutex;
+    std::condition_variable wake;
+
+    std::mutex rings_mutex;
+    std::vector<std::shared_ptr<LogRing>> rings;
+
+    // Used by the thread holding drain_mutex.
+    std::mutex drain_mutex;
+    std::vector<LogRecord> batch;
+    std::size_t dropped_closed   = 0;
+    std::size_t reported_dropped = 0;
+
+    LogRing& GetRing()
+    {
+        thread_local RingHolder holder;
+        if(!holder.ring)
+        {
+            holder.ring = std::make_shared<LogRing>();
+            std::lock_guard<std::mutex> lock(rings_mutex);
+            rings.push_back(holder.ring);
+        }
+        return *holder.ring;
+    }
+
+    void WriterLoop()
+    {
+        for(;;)
+        {
+            {
+                std::unique_lock<std::mutex> lock(wake_mutex);
+                wake.wait_for(lock, std::chrono::milliseconds{10}, [this]() {
+                    return stopped.load(std::memory_order_acquire);
+                });
+            }
+            if(stopped.load(std::memory_order_acquire))
+                return;
+            Drain();
+        }
+    }
+
+    void Stop()
+    {
+        {
+            std::lock_guard<std::mutex> lock(wake_mutex);
+            stopped.store(true, std::memory_order_release);
+        }
+        wake.notify_all();
+        writer.join();
+        Drain();
+    }
+};
+
+struct CachedStream
+{
+    std::ostringstream stream;
+    bool in_use = false;
+};
+
+CachedStream& GetCachedStream()
+{
+    thread_local CachedStream cached;
+    return cached;
+}
+
+// -1: use the environment, 0: synchronous, 1: asynchronous.
+std::atomic<int>& GetAsyncMode()
+{
+    static std::atomic<int> mode{-1};
+    return mode;
+}
+
+bool IsAsync()
+{
+    const auto mode = GetAsyncMode().load(std::memory_order_relaxed);
+    if(mode < 0)
+        return miopen::IsEnabled(MIOPEN_ENABLE_LOGGING_ASYNC{});
+    return mode != 0;
+}
+
 } // namespace
 
 bool IsLoggingDebugQuiet()
@@ -184,12 +567,100 @@ std::string LoggingPrefix()
 #endif
     if(miopen::IsEnabled(MIOPEN_ENABLE_LOGGING_ELAPSED_TIME{}))
     {
-        ss << std::fixed << std::setprecision(3) << std::setw(8) << GetTimeDiff();
+        ss << std::fixed << std::setprecision(3) << std::setw(8)
+           << GetTimeDiff(std::chrono::steady_clock::now());
     }
     ss << ": ";
     return ss.str();
 }
 
+namespace {
+
+void LogWrite(LogRecord&& record)
+{
+    if(IsAsync() && AsyncLog::Instance().Push(std::move(record)))
+        return;
+    WriteRecords(&record, &record + 1);
+}
+
+} // namespace
+
+void LogWrite(const LogRecordKind kind,
+              const LoggingLevel level,
+              const std::string& fn,
+              std::string text)
+{
+    LogWrite(LogRecord{kind,
+                       level,
+                       GetProcessAndThreadId(),
+                       std::chrono::steady_clock::now(),
+                       fn,
+                       {},
+                       std::move(text)});
+}
+
+void LogWrite(const LogRecordKind kind,
+              const LoggingLevel level,
+              const LogFunctionName fn,
+              std::string text)
+{
+    LogWrite(LogRecord{kind,
+                       level,
+                       GetProcessAndThreadId(),
+                       std::chrono::steady_clock::now(),
+                       {},
+                       fn,
+                       std::move(text)});
+}
+
+void LogFlush()
+{
+    if(IsAsync())
+        AsyncLog::Instance().Drain();
+    std::lock_guard<std::mutex> lock(GetOutputMutex());
+    std::cerr.flush();
+}
+
+namespace logger {
+
+MessageStream::MessageStream()
+{
+    auto& cached = GetCachedStream();
+    if(cached.in_use)
+    {
+        own    = std::make_unique<std::ostringstream>();
+        stream = own.get();
+        return;
+    }
+    cached.in_use = true;
+    stream        = &cached.stream;
+}
+
+MessageStream::~MessageStream()
+{
+    if(own)
+        return;
+    // The state a new stream would have.
+    stream->str({});
+    stream->clear();
+    stream->flags(std::ios_base::dec | std::ios_base::skipws);
+    stream->precision(6);
+    stream->width(0);
+    stream->fill(' ');
+    GetCachedStream().in_use = false;
+}
+
+void SetAsync(const bool enable)
+{
+    if(!enable)
+        LogFlush();
+    GetAsyncMode().store(enable ? 1 : 0, std::memory_order_relaxed);
+}
+
+std::size_t GetDropped() { return AsyncLog::Instance().GetDropped(); }
+
+} // namespace logger
+
 /// Expected to be invoked with __func__ and __PRETTY_FUNCTION__.
 std::string LoggingParseFunction(const char* func, const char* pretty_func)
 {
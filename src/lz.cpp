@@ -0,0 +1,254 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/lz.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+// The stream is a sequence of blocks, each made of:
+//   - a token byte: the high nibble is the literal count, the low one is the match length - 4;
+//     a nibble of 15 is continued by bytes added to it, up to and including the first byte < 255;
+//   - the literals;
+//   - a 2-byte little-endian offset back into the output (1..65535) and the match length bytes.
+// The last block has no match: the stream simply ends after its literals.
+
+namespace miopen {
+namespace {
+constexpr std::size_t MinMatch    = 4;
+constexpr std::size_t MaxOffset   = 65535;
+constexpr int HashBits            = 16;
+constexpr std::uint32_t NoPos     = 0xffffffff;
+constexpr std::size_t SkipTrigger = 6;
+
+inline std::uint32_t Read32(const unsigned char* p)
+{
+    std::uint32_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+inline std::uint32_t Hash(std::uint32_t v) { return (v * 2654435761U) >> (32 - HashBits); }
+
+inline void PutLength(std::string& out, std::size_t len)
+{
+    for(; len >= 255; len -= 255)
+        out.push_back(static_cast<char>(255));
+    out.push_back(static_cast<char>(len));
+}
+
+void PutBlock(std::string& out,
+              const unsigned char* lit,
+              std::size_t lit_len,
+              std::size_t offset,
+              std::size_t match_len)
+{
+    const auto ml = match_len == 0 ? 0 : match_len - MinMatch;
+    out.push_back(static_cast<char>((std::min<std::size_t>(lit_len, 15) << 4) |
+                                    std::min<std::size_t>(ml, 15)));
+    if(lit_len >= 15)
+        PutLength(out, lit_len - 15);
+    out.append(reinterpret_cast<const char*>(lit), lit_len);
+    if(match_len == 0)
+        return;
+    out.push_back(static_cast<char>(offset & 0xff));
+    out.push_back(static_cast<char>(offset >> 8));
+    if(ml >= 15)
+        PutLength(out, ml - 15);
+}
+
+[[noreturn]] void Malformed(const std::string& what)
+{
+    throw std::runtime_error("lz_decompress failed: " + what);
+}
+
+std::size_t GetLength(const unsigned char*& ip, const unsigned char* end)
+{
+    std::size_t len = 0;
+    unsigned char b;
+    do
+    {
+        if(ip == end)
+            Malformed("the compressed data ends unexpectedly");
+        b = *ip++;
+        len += b;
+    } while(b == 255);
+    return len;
+}
+} // namespace
+
+std::string lz_compress(const std::string& s, int level, bool* compressed)
+{
+    level            = std::max(1, std::min(level, 9));
+    const auto src   = reinterpret_cast<const unsigned char*>(s.data());
+    const auto n     = s.size();
+    const auto depth = std::size_t{1} << (level - 1);
+    // Level 1 keeps only the most recent position per hash, the higher ones chain them.
+    std::vector<std::uint32_t> head(std::size_t{1} << HashBits, NoPos);
+    std::vector<std::uint32_t> chain(level > 1 ? n : 0, NoPos);
+
+    std::string out;
+    out.reserve(n / 2 + 16);
+
+    const auto insert = [&](std::size_t pos) {
+        auto& h = head[Hash(Read32(src + pos))];
+        if(level > 1)
+            chain[pos] = h;
+        h = static_cast<std::uint32_t>(pos);
+    };
+
+    std::size_t anchor = 0;
+    std::size_t pos    = 0;
+    std::size_t misses = 0;
+    while(n >= MinMatch && pos + MinMatch <= n)
+    {
+        const auto v     = Read32(src + pos);
+        auto candidate   = head[Hash(v)];
+        std::size_t best = 0;
+        std::size_t from = 0;
+        for(std::size_t tries = 0; candidate != NoPos && tries < depth; ++tries)
+        {
+            if(pos - candidate > MaxOffset)
+                break;
+            if(Read32(src + candidate) == v)
+            {
+                auto len = MinMatch;
+                while(pos + len < n && src[candidate + len] == src[pos + len])
+                    ++len;
+                if(len > best)
+                {
+                    best = len;
+                    from = candidate;
+                }
+            }
+            if(level == 1)
+                break;
+            candidate = chain[candidate];
+        }
+
+        if(best == 0)
+        {
+            insert(pos);
+            // Skip faster through data that does not compress.
+            pos += 1 + (misses++ >> SkipTrigger);
+            continue;
+        }
+
+        PutBlock(out, src + anchor, pos - anchor, pos - from, best);
+        const auto match_end = pos + best;
+        if(level == 1)
+        {
+            insert(pos);
+            if(match_end - 2 + MinMatch <= n)
+                insert(match_end - 2);
+        }
+        else
+        {
+            for(; pos < match_end && pos + MinMatch <= n; ++pos)
+                insert(pos);
+        }
+        pos    = match_end;
+        anchor = pos;
+        misses = 0;
+    }
+    PutBlock(out, src + anchor, n - anchor, 0, 0);
+
+    const auto success = out.size() < n;
+    if(compressed != nullptr)
+        *compressed = success;
+    return success ? out : s;
+}
+
+std::string lz_decompress(const std::string& s, std::size_t size)
+{
+    std::string result(size, 0);
+    auto ip        = reinterpret_cast<const unsigned char*>(s.data());
+    const auto end = ip + s.size();
+    const auto out = reinterpret_cast<unsigned char*>(&result[0]);
+    std::size_t op = 0;
+
+    while(ip < end)
+    {
+        const auto token = *ip++;
+        auto lit_len     = static_cast<std::size_t>(token >> 4);
+        if(lit_len == 15)
+            lit_len += GetLength(ip, end);
+        if(lit_len > static_cast<std::size_t>(end - ip))
+            Malformed("the compressed data ends unexpectedly");
+        if(lit_len > size - op)
+            Malformed("the data does not fit the expected size");
+        // Short runs are copied with a fixed size when there is room to overshoot.
+        if(lit_len <= 16 && end - ip >= 16 && size - op >= 16)
+            std::memcpy(out + op, ip, 16);
+        else
+            std::memcpy(out + op, ip, lit_len);
+        ip += lit_len;
+        op += lit_len;
+        if(ip == end)
+            break;
+
+        if(end - ip < 2)
+            Malformed("the compressed data ends unexpectedly");
+        const auto offset =
+            static_cast<std::size_t>(ip[0]) | (static_cast<std::size_t>(ip[1]) << 8);
+        ip += 2;
+        auto match_len = static_cast<std::size_t>(token & 15);
+        if(match_len == 15)
+            match_len += GetLength(ip, end);
+        match_len += MinMatch;
+        if(offset == 0 || offset > op)
+            Malformed("invalid match offset");
+        if(match_len > size - op)
+            Malformed("the data does not fit the expected size");
+        const auto from = op - offset;
+        if(offset >= 8 && size - op >= match_len + 8)
+        {
+            for(std::size_t i = 0; i < match_len; i += 8)
+                std::memcpy(out + op + i, out + from + i, 8);
+            op += match_len;
+        }
+        else
+        {
+            // Overlapping matches repeat the last offset bytes, so the chunk that can be copied
+            // at once doubles every time.
+            for(auto left = match_len; left > 0;)
+            {
+                const auto chunk = std::min(op - from, left);
+                std::memcpy(out + op, out + from, chunk);
+                op += chunk;
+                left -= chunk;
+            }
+        }
+    }
+
+    if(op != size)
+        Malformed("the data does not match the expected size");
+    return result;
+}
+
+} // namespace miopen
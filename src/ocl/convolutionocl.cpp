@@ -30,6 +30,7 @@
 #include <miopen/convolution.hpp>
 #include <miopen/conv_algo_name.hpp>
 #include <miopen/db.hpp>
+#include <miopen/db_path.hpp>
 #include <miopen/db_record.hpp>
 #include <miopen/env.hpp>
 #include <miopen/find_db.hpp>
@@ -41,18 +42,26 @@
 #include <miopen/solver.hpp>
 #include <miopen/tensor_ops.hpp>
 #include <miopen/tensor.hpp>
+#include <miopen/timer.hpp>
+#include <miopen/timing_policy.hpp>
 #include <miopen/util.hpp>
 #include <miopen/visit_float.hpp>
 #include <miopen/datatype.hpp>
 #include <miopen/any_solver.hpp>
 #include <miopen/conv/tensors.hpp>
 #include <miopen/conv/compiled_in_parameters.hpp>
+#include <miopen/conv/find_batch.hpp>
+#include <miopen/conv/immed_cache.hpp>
 #include <miopen/conv/data_invoke_params.hpp>
 #include <miopen/conv/wrw_invoke_params.hpp>
 
+#include <algorithm>
 #include <cassert>
+#include <sstream>
+#include <tuple>
 #include <type_traits>
 
+
 #include <boost/range/adaptors.hpp>
 
 namespace miopen {
@@ -65,6 +74,8 @@ MIOPEN_DECLARE_ENV_VAR(MIOPEN_CONV_PRECISE_ROCBLAS_TIMING)
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_CONV_FFT)
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEVICE_ARCH)
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_CONV_IMMED_FALLBACK)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_CONV_IMMED_CACHE)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_CONV_IMMED_CACHE_DISK)
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_COMPILE_ONLY)
 
 size_t GetKernelGlobalWorkDim(const KernelInvoke& kernel, int dim) { return kernel.gdims[dim]; }
@@ -277,6 +288,8 @@ static void EvaluateInvokers(Handle& handle,
     miopen::solver::ConvSolution selected{miopenStatusUnknownError};
     float best = std::numeric_limits<float>::max();
     Invoker best_invoker;
+    TimingResult best_timing;
+    const auto policy = TimingPolicy::FromEnv();
 
     for(const auto& sol : solutions)
     {
@@ -308,15 +321,24 @@ static void EvaluateInvokers(Handle& handle,
         const auto invoker = handle.PrepareInvoker(*sol.invoker_factory, sol.construction_params);
         try
         {
-            invoker(handle, invoke_ctx);
-            const auto elapsed = handle.GetKernelTime();
+            const auto run = [&](float& elapsed) {
+                invoker(handle, invoke_ctx);
+                elapsed = handle.GetKernelTime();
+                return true;
+            };
+            auto timing = TimingResult{};
+            MeasureTime(policy, best, run, timing);
+            const auto elapsed = timing.time;
 
             MIOPEN_LOG_I(sol << ": " << elapsed << (elapsed < best ? " < " : " >= ") << best);
+            MIOPEN_LOG_I2(timing.statistic << " of " << timing.runs << " runs, variance "
+                                           << timing.variance);
             if(elapsed < best)
             {
                 best         = elapsed;
                 selected     = sol;
                 best_invoker = invoker;
+                best_timing  = timing;
             }
         }
         catch(const miopen::Exception& ex)
@@ -334,7 +356,9 @@ static void EvaluateInvokers(Handle& handle,
                          FindDbData{selected.solver_id,
                                     best,
                                     selected.workspce_sz,
-                                    FindDbKCacheKey::MakeUnused(algorithm_name)});
+                                    FindDbKCacheKey::MakeUnused(algorithm_name),
+                                    ToCString(best_timing.statistic),
+                                    best_timing.variance});
     }
 }
 
@@ -347,6 +371,87 @@ static inline void AppendPointersToElements(const std::vector<miopen::solver::Co
                    [](const miopen::solver::ConvSolution& s) { return &s; });
 }
 
+/// Candidate solutions of a forward Find, grouped by algorithm in the order of evaluation.
+using FwdFindCandidates = std::vector<std::pair<AlgorithmName, std::vector<solver::ConvSolution>>>;
+
+static FwdFindCandidates
+FindFwdCandidates(Handle& handle,
+                  const TensorDescriptor& xDesc,
+                  ConstData_t x,
+                  const TensorDescriptor& wDesc,
+                  ConstData_t w,
+                  const TensorDescriptor& yDesc,
+                  Data_t y,
+                  Data_t workSpace,
+                  size_t workSpaceSize,
+                  const ConvolutionDescriptor& conv,
+                  bool exhaustiveSearch,
+                  ConvolutionContext& ctx, // non-const only for use_winograd_only hack.
+                  bool use_winograd_only)
+{
+    ValidateGroupCount(xDesc, wDesc, conv);
+
+    const auto invoke_ctx = conv::DataInvokeParams{
+        InvokeType::Evaluate, {xDesc, x, wDesc, w, yDesc, y}, workSpace, workSpaceSize};
+
+    // Find solutions
+    auto winograd = !use_winograd_only ? conv.FindWinogradSolutions(ctx, invoke_ctx) : [&]() {
+        AutoUseFastDynamicSolutions tmp{ctx};
+        return conv.FindWinogradSolutions(ctx, invoke_ctx);
+    }();
+    ConvolutionUserBuffers bufs(workSpace, workSpaceSize);
+    bufs.SetFwd(x, w, y);
+    auto gemm = !use_winograd_only ? conv.FindDataGemmSolutions(ctx, invoke_ctx)
+                                   : std::vector<miopen::solver::ConvSolution>{};
+    auto direct = !use_winograd_only
+                      ? conv.FindDataDirectSolutions(
+                            handle, xDesc, wDesc, yDesc, exhaustiveSearch, true, bufs, invoke_ctx)
+                      : std::vector<miopen::solver::ConvSolution>{};
+    auto igemm = !use_winograd_only
+                     ? conv.FindDataImplicitGemmSolutions(
+                           handle, xDesc, wDesc, yDesc, exhaustiveSearch, true, bufs, invoke_ctx)
+                     : std::vector<miopen::solver::ConvSolution>{};
+    auto fft = !use_winograd_only ? conv.FindFftSolutions(ctx, invoke_ctx)
+                                  : std::vector<miopen::solver::ConvSolution>{};
+
+    FwdFindCandidates candidates;
+    candidates.emplace_back(AlgorithmName{"miopenConvolutionFwdAlgoGEMM"}, std::move(gemm));
+    candidates.emplace_back(AlgorithmName{"miopenConvolutionFwdAlgoWinograd"},
+                            std::move(winograd));
+    candidates.emplace_back(AlgorithmName{"miopenConvolutionFwdAlgoDirect"}, std::move(direct));
+    candidates.emplace_back(AlgorithmName{"miopenConvolutionFwdAlgoImplicitGEMM"},
+                            std::move(igemm));
+    candidates.emplace_back(AlgorithmName{"miopenConvolutionFwdAlgoFFT"}, std::move(fft));
+    return candidates;
+}
+
+static void AppendPointersToElements(const FwdFindCandidates& from,
+                                     std::vector<const miopen::solver::ConvSolution*>& to)
+{
+    for(const auto& algo : from)
+        AppendPointersToElements(algo.second, to);
+}
+
+static void EvaluateFwdCandidates(Handle& handle,
+                                  const TensorDescriptor& xDesc,
+                                  ConstData_t x,
+                                  const TensorDescriptor& wDesc,
+                                  ConstData_t w,
+                                  const TensorDescriptor& yDesc,
+                                  Data_t y,
+                                  Data_t workSpace,
+                                  size_t workSpaceSize,
+                                  const FwdFindCandidates& candidates,
+                                  const NetworkConfig& network_config,
+                                  DbRecord& record)
+{
+    const auto invoke_ctx = conv::DataInvokeParams{
+        InvokeType::Evaluate, {xDesc, x, wDesc, w, yDesc, y}, workSpace, workSpaceSize};
+
+    for(const auto& algo : candidates)
+        EvaluateInvokers(handle, algo.second, algo.first, network_config, invoke_ctx, record);
+}
+
 static void DirConvFindCore(Handle& handle,
                             const TensorDescriptor& xDesc,
                             ConstData_t x,
@@ -363,77 +468,126 @@ static void DirConvFindCore(Handle& handle,
                             bool use_winograd_only)
 {
     AutoEnableProfiling enableProfiling{handle};
-    ValidateGroupCount(xDesc, wDesc, conv);
 
     const auto network_config = ctx.BuildConfKey();
-    const auto invoke_ctx     = conv::DataInvokeParams{
-        InvokeType::Evaluate, {xDesc, x, wDesc, w, yDesc, y}, workSpace, workSpaceSize};
-
-    // Find solutions
-    const auto winograd = !use_winograd_only ? conv.FindWinogradSolutions(ctx, invoke_ctx) : [&]() {
-        AutoUseFastDynamicSolutions tmp{ctx};
-        return conv.FindWinogradSolutions(ctx, invoke_ctx);
-    }();
-    ConvolutionUserBuffers bufs(workSpace, workSpaceSize);
-    bufs.SetFwd(x, w, y);
-    const auto gemm = !use_winograd_only ? conv.FindDataGemmSolutions(ctx, invoke_ctx)
-                                         : std::vector<miopen::solver::ConvSolution>{};
-    const auto direct =
-        !use_winograd_only
-            ? conv.FindDataDirectSolutions(
-                  handle, xDesc, wDesc, yDesc, exhaustiveSearch, true, bufs, invoke_ctx)
-            : std::vector<miopen::solver::ConvSolution>{};
-    const auto igemm =
-        !use_winograd_only
-            ? conv.FindDataImplicitGemmSolutions(
-                  handle, xDesc, wDesc, yDesc, exhaustiveSearch, true, bufs, invoke_ctx)
-            : std::vector<miopen::solver::ConvSolution>{};
-    const auto fft = !use_winograd_only ? conv.FindFftSolutions(ctx, invoke_ctx)
-                                        : std::vector<miopen::solver::ConvSolution>{};
+    const auto candidates     = FindFwdCandidates(handle,
+                                              xDesc,
+                                              x,
+                                              wDesc,
+                                              w,
+                                              yDesc,
+                                              y,
+                                              workSpace,
+                                              workSpaceSize,
+                                              conv,
+                                              exhaustiveSearch,
+                                              ctx,
+                                              use_winograd_only);
 
     // Precompile
     {
         std::vector<const miopen::solver::ConvSolution*> all;
-        all.reserve(gemm.size() + winograd.size() + direct.size() + igemm.size() + fft.size());
-        AppendPointersToElements(gemm, all);
-        AppendPointersToElements(winograd, all);
-        AppendPointersToElements(direct, all);
-        AppendPointersToElements(igemm, all);
-        AppendPointersToElements(fft, all);
+        AppendPointersToElements(candidates, all);
         PrecompileSolutions(handle, all);
     }
 
     // Evaluate Invokers
-    EvaluateInvokers(handle,
-                     gemm,
-                     AlgorithmName{"miopenConvolutionFwdAlgoGEMM"},
-                     network_config,
-                     invoke_ctx,
-                     record);
-    EvaluateInvokers(handle,
-                     winograd,
-                     AlgorithmName{"miopenConvolutionFwdAlgoWinograd"},
-                     network_config,
-                     invoke_ctx,
-                     record);
-    EvaluateInvokers(handle,
-                     direct,
-                     AlgorithmName{"miopenConvolutionFwdAlgoDirect"},
-                     network_config,
-                     invoke_ctx,
-                     record);
-    EvaluateInvokers(handle,
-                     igemm,
-                     AlgorithmName{"miopenConvolutionFwdAlgoImplicitGEMM"},
-                     network_config,
-                     invoke_ctx,
-                     record);
-    EvaluateInvokers(handle,
-                     fft,
-                     AlgorithmName{"miopenConvolutionFwdAlgoFFT"},
-                     network_config,
-                     invoke_ctx,
-                     record);
+    EvaluateFwdCandidates(handle,
+                          xDesc,
+                          x,
+                          wDesc,
+                          w,
+                          yDesc,
+                          y,
+                          workSpace,
+                          workSpaceSize,
+                          candidates,
+                          network_config,
+                          record);
+}
+
+static void ValidateFwdFindArgs(ConstData_t x,
+                                ConstData_t w,
+                                ConstData_t y,
+                                const int requestAlgoCount,
+                                int* const returnedAlgoCount,
+                                miopenConvAlgoPerf_t* perfResults)
+{
+    if(x == nullptr || w == nullptr || y == nullptr)
+        MIOPEN_THROW(miopenStatusBadParm, "Buffers cannot be NULL");
+    if(returnedAlgoCount == nullptr)
+        MIOPEN_THROW(miopenStatusBadParm, "returnedAlgoCount cannot be nullptr");
+    if(perfResults == nullptr)
+        MIOPEN_THROW(miopenStatusBadParm, "perfResults cannot be nullptr");
+    if(requestAlgoCount < 1)
+        MIOPEN_THROW(miopenStatusBadParm, "requestAlgoCount cannot be < 1");
+}
+
+static void SetFwdFindContext(ConvolutionContext& ctx,
+                              const ConvolutionDescriptor& conv,
+                              ConstData_t x,
+                              ConstData_t w,
+                              Data_t y,
+                              Data_t workSpace,
+                              size_t workSpaceSize)
+{
+    ctx.DetectRocm();
+    ConvolutionUserBuffers bufs(workSpace, workSpaceSize);
+    bufs.SetFwd(x, w, y);
+    ctx.SetBufs(bufs);
+    ctx.skip_solutions_that_take_long_time_to_build_and_have_narrow_coverage =
+        conv.findMode.IsFastHybrid(ctx);
+    ctx.use_dynamic_solutions_only = conv.findMode.IsDynamicHybrid(ctx);
+}
+
+static void ReturnFwdFindResults(std::vector<PerfField>& perf_db,
+                                 const int requestAlgoCount,
+                                 int* const returnedAlgoCount,
+                                 miopenConvAlgoPerf_t* perfResults)
+{
+    if(IsEnabled(MIOPEN_DEBUG_COMPILE_ONLY{}))
+        MIOPEN_THROW(
+            miopenStatusGpuOperationsSkipped,
+            "MIOPEN_DEBUG_COMPILE_ONLY is enabled, escaping forward convolution. Search skipped.");
+
+    if(perf_db.empty())
+        MIOPEN_THROW("Forward Convolution cannot be executed due to incorrect params");
+
+    std::sort(begin(perf_db), end(perf_db));
+
+    for(const auto& entry : perf_db)
+        MIOPEN_LOG_I(entry.name << "\t" << entry.time << "\t" << entry.workspace);
+
+    *returnedAlgoCount = std::min(requestAlgoCount, static_cast<int>(perf_db.size()));
+
+    for(int i = 0; i < *returnedAlgoCount; i++)
+    {
+        perfResults[i].fwd_algo = StringToConvolutionFwdAlgo(perf_db[i].name);
+        perfResults[i].time     = perf_db[i].time;
+        perfResults[i].memory   = perf_db[i].workspace;
+    }
+
+    MIOPEN_LOG_I("FW Chosen Algorithm: " << perf_db[0].solver_id << " , " << perf_db[0].workspace
+                                         << ", "
+                                         << perf_db[0].time);
+}
+
+/// Returns true if the immediate mode solution should be used instead of Find.
+static bool GetImmediateFwdSolution(Handle& handle,
+                                    const ConvolutionDescriptor& conv,
+                                    const ConvolutionContext& ctx,
+                                    const TensorDescriptor& xDesc,
+                                    const TensorDescriptor& wDesc,
+                                    const TensorDescriptor& yDesc,
+                                    miopenConvSolution_t& sol)
+{
+    if(!conv.findMode.IsFast(ctx) && !conv.findMode.IsHybrid(ctx))
+        return false;
+    size_t count;
+    bool fallback;
+    conv.GetForwardSolutions(handle, wDesc, xDesc, yDesc, 1, &count, &sol, &fallback);
+    // In Hybrid Find mode, we use Normal Find instead of Immediate fallback kernels.
+    return (count > 0) && !(conv.findMode.IsHybrid(ctx) && fallback);
 }
 
 void ConvolutionDescriptor::FindConvFwdAlgorithm(Handle& handle,
@@ -451,14 +605,7 @@ void ConvolutionDescriptor::FindConvFwdAlgorithm(Handle& handle,
                                                  bool exhaustiveSearch) const
 {
     MIOPEN_LOG_I("requestAlgoCount = " << requestAlgoCount << ", workspace = " << workSpaceSize);
-    if(x == nullptr || w == nullptr || y == nullptr)
-        MIOPEN_THROW(miopenStatusBadParm, "Buffers cannot be NULL");
-    if(returnedAlgoCount == nullptr)
-        MIOPEN_THROW(miopenStatusBadParm, "returnedAlgoCount cannot be nullptr");
-    if(perfResults == nullptr)
-        MIOPEN_THROW(miopenStatusBadParm, "perfResults cannot be nullptr");
-    if(requestAlgoCount < 1)
-        MIOPEN_THROW(miopenStatusBadParm, "requestAlgoCount cannot be < 1");
+    ValidateFwdFindArgs(x, w, y, requestAlgoCount, returnedAlgoCount, perfResults);
 
     *returnedAlgoCount = 0;
 
@@ -468,18 +615,8 @@ void ConvolutionDescriptor::FindConvFwdAlgorithm(Handle& handle,
 
     std::vector<PerfField> perf_db;
 
-    bool use_immediate_solution = false;
     miopenConvSolution_t sol;
-    if(findMode.IsFast(ctx) || findMode.IsHybrid(ctx))
-    {
-        size_t count;
-        bool fallback;
-        GetForwardSolutions(handle, wDesc, xDesc, yDesc, 1, &count, &sol, &fallback);
-        use_immediate_solution = (count > 0) && !(findMode.IsHybrid(ctx) && fallback);
-        // In Hybrid Find mode, we use Normal Find instead of Immediate fallback kernels.
-    }
-
-    if(use_immediate_solution)
+    if(GetImmediateFwdSolution(handle, *this, ctx, xDesc, wDesc, yDesc, sol))
     {
         CompileForwardSolution(handle, wDesc, xDesc, yDesc, sol.solution_id);
         /// It is possible to measure actual execution time and return it to the caller.
@@ -490,13 +627,7 @@ void ConvolutionDescriptor::FindConvFwdAlgorithm(Handle& handle,
     }
     else
     {
-        ctx.DetectRocm();
-        ConvolutionUserBuffers bufs(workSpace, workSpaceSize);
-        bufs.SetFwd(x, w, y);
-        ctx.SetBufs(bufs);
-        ctx.skip_solutions_that_take_long_time_to_build_and_have_narrow_coverage =
-            findMode.IsFastHybrid(ctx);
-        ctx.use_dynamic_solutions_only = findMode.IsDynamicHybrid(ctx);
+        SetFwdFindContext(ctx, *this, x, w, y, workSpace, workSpaceSize);
         perf_db = UserFindDbRecord::TryLoad(handle, problem, [&](DbRecord& record) {
             DirConvFindCore(handle,
                             xDesc,
@@ -515,31 +646,155 @@ void ConvolutionDescriptor::FindConvFwdAlgorithm(Handle& handle,
         });
     }
 
-    if(IsEnabled(MIOPEN_DEBUG_COMPILE_ONLY{}))
-        MIOPEN_THROW(
-            miopenStatusGpuOperationsSkipped,
-            "MIOPEN_DEBUG_COMPILE_ONLY is enabled, escaping forward convolution. Search skipped.");
+    ReturnFwdFindResults(perf_db, requestAlgoCount, returnedAlgoCount, perfResults);
+}
 
-    if(perf_db.empty())
-        MIOPEN_THROW("Forward Convolution cannot be executed due to incorrect params");
+void FindConvFwdAlgorithmBatch(Handle& handle,
+                               const std::vector<ConvFwdFindRequest>& requests,
+                               bool exhaustiveSearch)
+{
+    Timer timer;
+    timer.start();
 
-    std::sort(begin(perf_db), end(perf_db));
+    for(const auto& r : requests)
+    {
+        if(r.conv == nullptr || r.xDesc == nullptr || r.wDesc == nullptr || r.yDesc == nullptr)
+            MIOPEN_THROW(miopenStatusBadParm, "Descriptors cannot be NULL");
+        ValidateFwdFindArgs(r.x, r.w, r.y, r.requestAlgoCount, r.returnedAlgoCount, r.perfResults);
+        *r.returnedAlgoCount = 0;
+    }
 
-    for(const auto& entry : perf_db)
-        MIOPEN_LOG_I(entry.name << "\t" << entry.time << "\t" << entry.workspace);
+    // Requests served by the immediate mode do not benchmark anything and are not batched.
+    std::vector<std::size_t> batched;
+    std::vector<ProblemDescription> problems;
+    std::vector<ConvolutionContext> contexts;
+    std::vector<std::string> keys;
 
-    *returnedAlgoCount = std::min(requestAlgoCount, static_cast<int>(perf_db.size()));
+    for(std::size_t i = 0; i < requests.size(); ++i)
+    {
+        const auto& r = requests[i];
+        const ProblemDescription problem(
+            *r.xDesc, *r.wDesc, *r.yDesc, *r.conv, conv::Direction::Forward);
+        auto ctx = ConvolutionContext{problem};
+        ctx.SetStream(&handle);
 
-    for(int i = 0; i < *returnedAlgoCount; i++)
+        miopenConvSolution_t sol;
+        if(GetImmediateFwdSolution(handle, *r.conv, ctx, *r.xDesc, *r.wDesc, *r.yDesc, sol))
+        {
+            r.conv->FindConvFwdAlgorithm(handle,
+                                         *r.xDesc,
+                                         r.x,
+                                         *r.wDesc,
+                                         r.w,
+                                         *r.yDesc,
+                                         r.y,
+                                         r.requestAlgoCount,
+                                         r.returnedAlgoCount,
+                                         r.perfResults,
+                                         r.workSpace,
+                                         r.workSpaceSize,
+                                         exhaustiveSearch);
+            continue;
+        }
+
+        SetFwdFindContext(ctx, *r.conv, r.x, r.w, r.y, r.workSpace, r.workSpaceSize);
+        keys.push_back(ctx.BuildConfKey().ToString());
+        batched.push_back(i);
+        problems.push_back(problem);
+        contexts.push_back(std::move(ctx));
+    }
+
+    AutoEnableProfiling enableProfiling{handle};
+    const auto groups = GroupFindRequests(keys);
+
+    // Gather the candidates of the problems missing from the find-db. Solutions which search
+    // for their parameters do it here, each one compiling its own kernels.
+    std::vector<FwdFindCandidates> candidates(groups.size());
+    std::size_t n_searched = 0;
+    for(std::size_t g = 0; g < groups.size(); ++g)
     {
-        perfResults[i].fwd_algo = StringToConvolutionFwdAlgo(perf_db[i].name);
-        perfResults[i].time     = perf_db[i].time;
-        perfResults[i].memory   = perf_db[i].workspace;
+        const auto k = groups[g].front();
+        if(UserFindDbRecord::IsReady(handle, problems[k]))
+            continue;
+        const auto& r = requests[batched[k]];
+        candidates[g] = FindFwdCandidates(handle,
+                                          *r.xDesc,
+                                          r.x,
+                                          *r.wDesc,
+                                          r.w,
+                                          *r.yDesc,
+                                          r.y,
+                                          r.workSpace,
+                                          r.workSpaceSize,
+                                          *r.conv,
+                                          exhaustiveSearch,
+                                          contexts[k],
+                                          r.conv->IsWinograd3x3SupportedAndFast(contexts[k]));
+        ++n_searched;
     }
 
-    MIOPEN_LOG_I("FW Chosen Algorithm: " << perf_db[0].solver_id << " , " << perf_db[0].workspace
-                                         << ", "
-                                         << perf_db[0].time);
+    // Compile the kernels of all the layers in one parallel batch.
+    {
+        std::vector<const miopen::solver::ConvSolution*> all;
+        for(const auto& c : candidates)
+            AppendPointersToElements(c, all);
+        PrecompileSolutions(handle, all);
+    }
+
+    for(std::size_t g = 0; g < groups.size(); ++g)
+    {
+        const auto k  = groups[g].front();
+        const auto& r = requests[batched[k]];
+        auto& ctx     = contexts[k];
+
+        auto perf_db = UserFindDbRecord::TryLoad(handle, problems[k], [&](DbRecord& record) {
+            if(candidates[g].empty())
+            {
+                // The record has been invalidated since it was checked.
+                DirConvFindCore(handle,
+                                *r.xDesc,
+                                r.x,
+                                *r.wDesc,
+                                r.w,
+                                *r.yDesc,
+                                r.y,
+                                r.workSpace,
+                                r.workSpaceSize,
+                                *r.conv,
+                                exhaustiveSearch,
+                                record,
+                                ctx,
+                                r.conv->IsWinograd3x3SupportedAndFast(ctx));
+                return;
+            }
+            EvaluateFwdCandidates(handle,
+                                  *r.xDesc,
+                                  r.x,
+                                  *r.wDesc,
+                                  r.w,
+                                  *r.yDesc,
+                                  r.y,
+                                  r.workSpace,
+                                  r.workSpaceSize,
+                                  candidates[g],
+                                  ctx.BuildConfKey(),
+                                  record);
+        });
+
+        for(const auto i : groups[g])
+        {
+            const auto& dup = requests[batched[i]];
+            ReturnFwdFindResults(
+                perf_db, dup.requestAlgoCount, dup.returnedAlgoCount, dup.perfResults);
+        }
+    }
+
+    MIOPEN_LOG_I("Batched Find of " << requests.size() << " problems (" << groups.size()
+                                    << " unique, "
+                                    << n_searched
+                                    << " searched) ready in "
+                                    << timer.elapsed_ms()
+                                    << " ms");
 }
 
 void ValidateConvTensors(const ConvTensors& tensors)
@@ -734,35 +989,69 @@ struct SolutionSortWrapper : miopenConvSolution_t
     }
 };
 
-void ConvolutionDescriptor::GetSolutionsFallback(Handle& handle,
-                                                 const ProblemDescription& problem,
-                                                 const size_t maxSolutionCount,
-                                                 size_t* const solutionCount,
-                                                 miopenConvSolution_t* const solutions) const
+static std::string GetImmedCacheKey(const ConvolutionContext& ctx,
+                                    const ProblemDescription& problem,
+                                    const char kind)
 {
-    if(miopen::IsDisabled(MIOPEN_DEBUG_CONV_IMMED_FALLBACK{}))
+    unsigned algorithms = 0;
+    for(const auto algo : {miopenConvolutionAlgoGEMM,
+                           miopenConvolutionAlgoDirect,
+                           miopenConvolutionAlgoFFT,
+                           miopenConvolutionAlgoWinograd,
+                           miopenConvolutionAlgoImplicitGEMM})
     {
-        MIOPEN_LOG_I("Disabled via environment");
-        *solutionCount = 0;
-        return;
+        if(!IsAlgorithmDisabled(algo))
+            algorithms |= 1u << static_cast<unsigned>(algo);
     }
+    return conv::GetImmedCacheKey(
+        ctx, problem, kind, ctx.GetStream().GetDbBasename(), algorithms);
+}
 
-    /// \todo This is terrible. Should do away when we converge to
-    /// single conv::ProblemDescription type.
-    const auto& inDesc = problem.direction.IsForward() ? problem.conv_problem.GetIn()
-                                                       : problem.conv_problem.GetOut();
-    const auto& weightsDesc = problem.conv_problem.GetWeights();
-    // This check is needed on fallback path only.
-    // On regular path (find-db hit) this was checked during Find().
-    ValidateGroupCount(inDesc, weightsDesc, *this);
+#if !MIOPEN_DISABLE_USERDB
+static std::string GetImmedCacheDbPath(const Handle& handle)
+{
+    return GetUserDbPath() + "/" + handle.GetDbBasename() + "." + GetUserDbSuffix() + ".uidb.txt";
+}
+#endif
+
+static bool LoadImmedSolutions(const Handle& handle,
+                               const std::string& key,
+                               std::vector<miopenConvSolution_t>& solutions)
+{
+#if !MIOPEN_DISABLE_USERDB
+    if(!miopen::IsEnabled(MIOPEN_DEBUG_CONV_IMMED_CACHE_DISK{}))
+        return false;
+    return conv::LoadImmedSolutions(GetImmedCacheDbPath(handle), key, solutions);
+#else
+    std::ignore = handle;
+    std::ignore = key;
+    std::ignore = solutions;
+    return false;
+#endif
+}
 
+static void StoreImmedSolutions(const Handle& handle,
+                                const std::string& key,
+                                const std::vector<miopenConvSolution_t>& solutions)
+{
+#if !MIOPEN_DISABLE_USERDB
+    if(!miopen::IsEnabled(MIOPEN_DEBUG_CONV_IMMED_CACHE_DISK{}) || solutions.empty())
+        return;
+    if(!conv::StoreImmedSolutions(GetImmedCacheDbPath(handle), key, solutions))
+        MIOPEN_LOG_W("Failed to store immediate mode solutions at " << GetImmedCacheDbPath(handle));
+#else
+    std::ignore = handle;
+    std::ignore = key;
+    std::ignore = solutions;
+#endif
+}
+
+static std::vector<miopenConvSolution_t> EvaluateFallbackSolutions(const ConvolutionContext& ctx,
+                                                                   const size_t maxSolutionCount)
+{
     std::vector<SolutionSortWrapper> interim;
     interim.reserve(maxSolutionCount); // For speed. In most cases we have less entries than asked.
 
-    auto ctx = ConvolutionContext{problem};
-    ctx.SetStream(&handle);
-    ctx.DetectRocm();
-
     const auto wti2time = [](const float& wti) {
         assert(wti != 0.0f);
         if(wti <= 0.0f) // Return negative values as is, avoid DIV/0.
@@ -793,6 +1082,58 @@ void ConvolutionDescriptor::GetSolutionsFallback(Handle& handle,
         interim.emplace_back(wti2time(wti), s.GetWorkspaceSize(ctx), solver_id.Value(), algo);
     }
 
+    std::sort(begin(interim), end(interim));
+    return {interim.begin(), interim.end()};
+}
+
+void ConvolutionDescriptor::GetSolutionsFallback(Handle& handle,
+                                                 const ProblemDescription& problem,
+                                                 const size_t maxSolutionCount,
+                                                 size_t* const solutionCount,
+                                                 miopenConvSolution_t* const solutions) const
+{
+    if(miopen::IsDisabled(MIOPEN_DEBUG_CONV_IMMED_FALLBACK{}))
+    {
+        MIOPEN_LOG_I("Disabled via environment");
+        *solutionCount = 0;
+        return;
+    }
+
+    /// \todo This is terrible. Should do away when we converge to
+    /// single conv::ProblemDescription type.
+    const auto& inDesc = problem.direction.IsForward() ? problem.conv_problem.GetIn()
+                                                       : problem.conv_problem.GetOut();
+    const auto& weightsDesc = problem.conv_problem.GetWeights();
+    // This check is needed on fallback path only.
+    // On regular path (find-db hit) this was checked during Find().
+    ValidateGroupCount(inDesc, weightsDesc, *this);
+
+    auto ctx = ConvolutionContext{problem};
+    ctx.SetStream(&handle);
+    ctx.DetectRocm();
+
+    std::vector<miopenConvSolution_t> interim;
+
+    if(miopen::IsDisabled(MIOPEN_DEBUG_CONV_IMMED_CACHE{}))
+    {
+        interim = EvaluateFallbackSolutions(ctx, maxSolutionCount);
+    }
+    else
+    {
+        const auto key = GetImmedCacheKey(ctx, problem, 'F');
+        auto& cache    = conv::ImmedSolutionsCache::Instance();
+
+        if(!cache.Find(key, interim))
+        {
+            if(!LoadImmedSolutions(handle, key, interim))
+            {
+                interim = EvaluateFallbackSolutions(ctx, maxSolutionCount);
+                StoreImmedSolutions(handle, key, interim);
+            }
+            cache.Store(key, interim);
+        }
+    }
+
     MIOPEN_LOG_I2("maxSolutionCount = " << maxSolutionCount << ", available = " << interim.size());
     for(const auto& s : interim)
         MIOPEN_LOG_I2("id: " << s.solution_id << " algo: " << s.algorithm << ", time: " << s.time
@@ -804,7 +1145,6 @@ void ConvolutionDescriptor::GetSolutionsFallback(Handle& handle,
     // * Used as index for writing into output array (solutions).
     // * Counts the number of entries written, yielding value for solutionsCount.
     auto i = std::size_t{0};
-    std::sort(begin(interim), end(interim));
     for(const auto& entry : interim)
     {
         if(i >= maxSolutionCount)
@@ -831,8 +1171,7 @@ void GetSolutions(Handle& handle,
         return;
     }
 
-    std::vector<SolutionSortWrapper> interim;
-    interim.reserve(maxSolutionCount); // For speed. In most cases we have less entries than asked.
+    std::vector<miopenConvSolution_t> interim;
 
     // Individual Solvers can be enabled/disabled by environment settings.
     // Applicability is also affected by presence of external tools (e.g. assembler)
@@ -843,26 +1182,51 @@ void GetSolutions(Handle& handle,
     ctx.SetStream(&handle);
     ctx.DetectRocm();
 
-    for(const auto& pair : fdb_record)
+    // The result also depends on the find-db record, so its contents are a part of the key.
+    const auto use_cache = !miopen::IsDisabled(MIOPEN_DEBUG_CONV_IMMED_CACHE{});
+    auto key             = std::string{};
+    if(use_cache)
     {
-        const auto algo = static_cast<miopenConvAlgorithm_t>(algoResolver(pair.first));
-        if(IsAlgorithmDisabled(algo))
-            continue;
+        std::ostringstream ss;
+        ss << GetImmedCacheKey(ctx, problem, 'D');
+        for(const auto& pair : fdb_record)
+            ss << ';' << pair.first << ':' << pair.second.solver_id << ',' << pair.second.time
+               << ',' << pair.second.workspace;
+        key = ss.str();
+    }
+
+    if(!use_cache || !conv::ImmedSolutionsCache::Instance().Find(key, interim))
+    {
+        std::vector<SolutionSortWrapper> sorted;
+        // For speed. In most cases we have less entries than asked.
+        sorted.reserve(maxSolutionCount);
 
-        const auto solver_id = solver::Id{pair.second.solver_id};
-        // Wrong IDs can't be used to call IsApplicable(), so let's
-        // ignore obsolete or invalid IDs read from find-db first.
-        if(!solver_id.IsValid())
+        for(const auto& pair : fdb_record)
         {
-            // Do not disturb users with warnings unless detailed log is enabled.
-            MIOPEN_LOG_I("[Warning] incorrect solver_id: " << pair.second.solver_id);
-            continue;
+            const auto algo = static_cast<miopenConvAlgorithm_t>(algoResolver(pair.first));
+            if(IsAlgorithmDisabled(algo))
+                continue;
+
+            const auto solver_id = solver::Id{pair.second.solver_id};
+            // Wrong IDs can't be used to call IsApplicable(), so let's
+            // ignore obsolete or invalid IDs read from find-db first.
+            if(!solver_id.IsValid())
+            {
+                // Do not disturb users with warnings unless detailed log is enabled.
+                MIOPEN_LOG_I("[Warning] incorrect solver_id: " << pair.second.solver_id);
+                continue;
+            }
+
+            if(solver_id.GetSolver().IsApplicable(ctx))
+                sorted.emplace_back(
+                    pair.second.time, pair.second.workspace, solver_id.Value(), algo);
         }
+        std::sort(begin(sorted), end(sorted));
+        interim.assign(sorted.begin(), sorted.end());
 
-        if(solver_id.GetSolver().IsApplicable(ctx))
-            interim.emplace_back(pair.second.time, pair.second.workspace, solver_id.Value(), algo);
+        if(use_cache)
+            conv::ImmedSolutionsCache::Instance().Store(key, interim);
     }
-    std::sort(begin(interim), end(interim));
 
     auto i = std::size_t{0};
     for(const auto& entry : interim)
@@ -958,8 +1322,7 @@ static Invoker PrepareInvoker(Handle& handle,
     const auto invoker =
         handle.PrepareInvoker(*solution.invoker_factory, solution.construction_params);
 
-    handle.RegisterInvoker(
-        invoker, config, solver_id.ToString(), AlgorithmName(solver_id.GetAlgo(dir)));
+    handle.RegisterInvoker(invoker, config, solver_id, AlgorithmName(solver_id.GetAlgo(dir)));
     return invoker; // NOLINT (performance-no-automatic-move)
 }
 
@@ -325,6 +325,24 @@ KernelInvoke Handle::AddKernel(const std::string& algorithm,
     return this->Run(obj);
 }
 
+const KernelInvoke& Handle::AddKernel(const TensorOpKey& key,
+                                      const std::string& program_name,
+                                      const std::string& kernel_name,
+                                      const std::vector<size_t>& vld,
+                                      const std::vector<size_t>& vgd,
+                                      const std::string& params) const
+{
+    auto kernel = this->impl->cache.AddKernel(
+        *this, kernel_name, key.ToString(), program_name, kernel_name, vld, vgd, params);
+    return this->impl->cache.AddKernel(key, std::move(kernel)).GetInvoke(*this);
+}
+
+const KernelInvoke* Handle::GetKernelInvoke(const TensorOpKey& key) const
+{
+    const auto kernel = this->impl->cache.FindKernel(key);
+    return kernel != nullptr ? &kernel->GetInvoke(*this) : nullptr;
+}
+
 Invoker Handle::PrepareInvoker(const InvokerFactory& factory,
                                const std::vector<solver::KernelInfo>& kernels) const
 {
@@ -0,0 +1,572 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/rnn_plan.hpp>
+
+#include <miopen/dropout.hpp>
+#include <miopen/env.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/logger.hpp>
+#include <miopen/rnn_util.hpp>
+#include <miopen/tensor_ops.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_RNN_PLAN_CACHE)
+
+namespace miopen {
+
+namespace {
+
+Data_t Bind(const RNNPlanBindings& bindings, std::size_t slot)
+{
+    if(slot == RNNPlanRecorder::npos)
+        return nullptr;
+    // Casting away const is undefined behaviour, but the buffer was given as Data_t to the
+    // launch writing it.
+    // NOLINTNEXTLINE (cppcoreguidelines-pro-type-const-cast)
+    return const_cast<Data_t>(bindings.buffers[slot]);
+}
+
+class RNNPlanCache
+{
+    public:
+    static RNNPlanCache& Instance()
+    {
+        // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+        static RNNPlanCache instance;
+        return instance;
+    }
+
+    std::shared_ptr<const RNNPlan> Find(const RNNPlanKey& key) const
+    {
+        const std::shared_lock<std::shared_timed_mutex> lock{mutex};
+        const auto it = entries.find(key);
+        return it == entries.end() ? nullptr : it->second;
+    }
+
+    void Store(const RNNPlanKey& key, std::shared_ptr<const RNNPlan> plan)
+    {
+        const std::unique_lock<std::shared_timed_mutex> lock{mutex};
+        // The plans of long sequences are large, bound the memory of processes seeing many.
+        if(entries.size() >= max_entries)
+            entries.clear();
+        entries[key] = std::move(plan);
+    }
+
+    private:
+    static constexpr std::size_t max_entries = 128;
+
+    mutable std::shared_timed_mutex mutex;
+    std::unordered_map<RNNPlanKey, std::shared_ptr<const RNNPlan>, RNNPlanKey::Hasher> entries;
+};
+
+} // namespace
+
+void RNNPlan::Run(Handle& handle, const RNNPlanBindings& bindings) const
+{
+    float ctime = 0;
+    for(const auto& launch : launches)
+        launch(handle, bindings, ctime);
+}
+
+RNNPlanKey::RNNPlanKey(const RNNDescriptor& rnn, char direction, int seqLen)
+{
+    Add(direction).Add(seqLen);
+    Add(rnn.hsize).Add(rnn.nLayers).Add(rnn.nHiddenTensorsPerLayer).Add(rnn.workspaceScale);
+    Add(rnn.rnnMode).Add(rnn.dirMode).Add(rnn.algoMode).Add(rnn.inputMode).Add(rnn.biasMode);
+    Add(rnn.dataType);
+
+    // Only the rate selects launches, the other parameters of dropout are used when launching.
+    if(rnn.dropoutDesc == nullptr)
+    {
+        Add(0);
+    }
+    else
+    {
+        std::uint32_t rate = 0;
+        static_assert(sizeof(rate) == sizeof(float), "");
+        std::memcpy(&rate, &deref(rnn.dropoutDesc).dropout, sizeof(rate));
+        Add(1).Add(rate);
+    }
+}
+
+RNNPlanKey& RNNPlanKey::Add(const TensorDescriptor& desc)
+{
+    Add(desc.GetType()).Add(desc.GetSize());
+    for(const auto len : desc.GetLengths())
+        Add(len);
+    for(const auto stride : desc.GetStrides())
+        Add(stride);
+    return *this;
+}
+
+RNNPlanKey& RNNPlanKey::Add(c_array_view<const miopenTensorDescriptor_t> descs, int seqLen)
+{
+    for(int i = 0; i < seqLen; i++)
+        Add(descs[i]);
+    return *this;
+}
+
+RNNPlanKey& RNNPlanKey::Add(const RNNPlanBindings& bindings)
+{
+    const auto& buffers = bindings.buffers;
+    for(const auto buffer : buffers)
+    {
+        if(buffer == nullptr)
+            Add(0);
+        else
+            Add(std::find(buffers.begin(), buffers.end(), buffer) - buffers.begin() + 1);
+    }
+    return *this;
+}
+
+std::size_t RNNPlanRecorder::Slot(ConstData_t buffer) const
+{
+    if(buffer == nullptr)
+        return npos;
+    const auto& buffers = bindings.buffers;
+    const auto it       = std::find(buffers.begin(), buffers.end(), buffer);
+    if(it == buffers.end())
+        MIOPEN_THROW(miopenStatusInternalError, "RNN launch on a buffer which is not bound.");
+    return it - buffers.begin();
+}
+
+void RNNPlanRecorder::Record(RNNPlan::Launch launch)
+{
+    launch(handle, bindings, ctime);
+    if(keep)
+        plan.launches.push_back(std::move(launch));
+}
+
+void RunRNNPlan(Handle& handle,
+                const RNNPlanKey& key,
+                const RNNPlanBindings& bindings,
+                const std::function<void(RNNPlanRecorder&)>& record)
+{
+    if(miopen::IsDisabled(MIOPEN_DEBUG_RNN_PLAN_CACHE{}))
+    {
+        RNNPlanRecorder recorder{handle, bindings, false};
+        record(recorder);
+        return;
+    }
+
+    auto& cache = RNNPlanCache::Instance();
+    if(const auto plan = cache.Find(key))
+    {
+        plan->Run(handle, bindings);
+        return;
+    }
+
+    RNNPlanRecorder recorder{handle, bindings};
+    record(recorder);
+    MIOPEN_LOG_I2("Recorded RNN plan of " << recorder.plan.launches.size() << " launches");
+    cache.Store(key, std::make_shared<const RNNPlan>(std::move(recorder.plan)));
+}
+
+miopenStatus_t CallGemm(RNNPlanRecorder& handle,
+                        GemmDescriptor gemm_desc,
+                        ConstData_t A,
+                        int a_offset,
+                        ConstData_t B,
+                        int b_offset,
+                        Data_t C,
+                        int c_offset,
+                        std::nullptr_t,
+                        GemmBackend_t gemm_backend)
+{
+    const auto a = handle.Slot(A);
+    const auto b = handle.Slot(B);
+    const auto c = handle.Slot(C);
+    handle.Record([=](Handle& h, const RNNPlanBindings& bindings, float&) {
+        const auto status = CallGemm(h,
+                                     gemm_desc,
+                                     Bind(bindings, a),
+                                     a_offset,
+                                     Bind(bindings, b),
+                                     b_offset,
+                                     Bind(bindings, c),
+                                     c_offset,
+                                     nullptr,
+                                     gemm_backend);
+        if(status == miopenStatusNotImplemented)
+            MIOPEN_LOG_E("GEMM not implemented");
+        else if(status != miopenStatusSuccess)
+            MIOPEN_LOG_E("GEMM failed");
+    });
+    // The launch reports the failures itself, as it has to when replayed.
+    return miopenStatusSuccess;
+}
+
+void SetTensor(RNNPlanRecorder& handle,
+               const TensorDescriptor& yDesc,
+               Data_t y,
+               const void* alpha,
+               int offset)
+{
+    const auto y_slot      = handle.Slot(y);
+    const auto alpha_value = *static_cast<const float*>(alpha);
+    handle.Record([=](Handle& h, const RNNPlanBindings& bindings, float&) {
+        SetTensor(h, yDesc, Bind(bindings, y_slot), &alpha_value, offset);
+    });
+}
+
+void OpTensor(RNNPlanRecorder& handle,
+              miopenTensorOp_t tensorOp,
+              const void* alpha0,
+              const TensorDescriptor& aTensorDesc,
+              ConstData_t ATensor,
+              const void* alpha1,
+              const TensorDescriptor& bTensorDesc,
+              ConstData_t BTensor,
+              const void* beta,
+              const TensorDescriptor& cTensorDesc,
+              Data_t CTensor,
+              size_t Aoffset,
+              size_t Boffset,
+              size_t Coffset)
+{
+    const auto a            = handle.Slot(ATensor);
+    const auto b            = handle.Slot(BTensor);
+    const auto c            = handle.Slot(CTensor);
+    const auto alpha0_value = *static_cast<const float*>(alpha0);
+    const auto alpha1_value = *static_cast<const float*>(alpha1);
+    const auto beta_value   = *static_cast<const float*>(beta);
+    handle.Record([=](Handle& h, const RNNPlanBindings& bindings, float&) {
+        OpTensor(h,
+                 tensorOp,
+                 &alpha0_value,
+                 aTensorDesc,
+                 Bind(bindings, a),
+                 &alpha1_value,
+                 bTensorDesc,
+                 Bind(bindings, b),
+                 &beta_value,
+                 cTensorDesc,
+                 Bind(bindings, c),
+                 Aoffset,
+                 Boffset,
+                 Coffset);
+    });
+}
+
+void CopyTensor(RNNPlanRecorder& handle,
+                const TensorDescriptor& srcDesc,
+                ConstData_t src,
+                const TensorDescriptor& dstDesc,
+                Data_t dst,
+                int srcOffset,
+                int dstOffset)
+{
+    const auto src_slot = handle.Slot(src);
+    const auto dst_slot = handle.Slot(dst);
+    handle.Record([=](Handle& h, const RNNPlanBindings& bindings, float&) {
+        CopyTensor(h,
+                   srcDesc,
+                   Bind(bindings, src_slot),
+                   dstDesc,
+                   Bind(bindings, dst_slot),
+                   srcOffset,
+                   dstOffset);
+    });
+}
+
+void profileRNNkernels(RNNPlanRecorder& handle, unsigned char select, float&)
+{
+    // The time is accumulated by the launches, the caller's one is not used.
+    handle.Record([=](Handle& h, const RNNPlanBindings&, float& ctime) {
+        profileRNNkernels(h, select, ctime);
+    });
+}
+
+void DropoutForward(RNNPlanRecorder& handle,
+                    const TensorDescriptor& noise_shape,
+                    const TensorDescriptor& xDesc,
+                    ConstData_t x,
+                    const TensorDescriptor& yDesc,
+                    Data_t y,
+                    Data_t reserveSpace,
+                    size_t reserveSpaceSizeInBytes,
+                    size_t in_offset,
+                    size_t out_offset,
+                    size_t rsvsp_offset)
+{
+    const auto x_slot   = handle.Slot(x);
+    const auto y_slot   = handle.Slot(y);
+    const auto rsv_slot = handle.Slot(reserveSpace);
+    handle.Record([=](Handle& h, const RNNPlanBindings& bindings, float&) {
+        deref(bindings.dropoutDesc)
+            .DropoutForward(h,
+                            noise_shape,
+                            xDesc,
+                            Bind(bindings, x_slot),
+                            yDesc,
+                            Bind(bindings, y_slot),
+                            Bind(bindings, rsv_slot),
+                            reserveSpaceSizeInBytes,
+                            in_offset,
+                            out_offset,
+                            rsvsp_offset);
+    });
+}
+
+void DropoutBackward(RNNPlanRecorder& handle,
+                     const TensorDescriptor& noise_shape,
+                     const TensorDescriptor& dyDesc,
+                     ConstData_t dy,
+                     const TensorDescriptor& dxDesc,
+                     Data_t dx,
+                     Data_t reserveSpace,
+                     size_t reserveSpaceSizeInBytes,
+                     size_t in_offset,
+                     size_t out_offset,
+                     size_t rsvsp_offset)
+{
+    const auto dy_slot  = handle.Slot(dy);
+    const auto dx_slot  = handle.Slot(dx);
+    const auto rsv_slot = handle.Slot(reserveSpace);
+    handle.Record([=](Handle& h, const RNNPlanBindings& bindings, float&) {
+        deref(bindings.dropoutDesc)
+            .DropoutBackward(h,
+                             noise_shape,
+                             dyDesc,
+                             Bind(bindings, dy_slot),
+                             dxDesc,
+                             Bind(bindings, dx_slot),
+                             Bind(bindings, rsv_slot),
+                             reserveSpaceSizeInBytes,
+                             in_offset,
+                             out_offset,
+                             rsvsp_offset);
+    });
+}
+
+void LSTMForwardHiddenStateUpdate(RNNPlanRecorder& handle,
+                                  miopenDataType_t rnn_data_type,
+                                  bool is_inference,
+                                  bool is_seq_begin,
+                                  int direction,
+                                  int max_batch,
+                                  int cur_batch,
+                                  int use_batch,
+                                  int hy_h,
+                                  int hy_stride,
+                                  int wei_len,
+                                  int wei_stride,
+                                  ConstData_t cx,
+                                  std::size_t cx_offset,
+                                  Data_t reserve_space,
+                                  std::size_t i_offset,
+                                  std::size_t f_offset,
+                                  std::size_t o_offset,
+                                  std::size_t c_offset,
+                                  std::size_t cell_offset,
+                                  std::size_t cell_offset_pre,
+                                  std::size_t activ_cell_offset,
+                                  std::size_t hidden_offset)
+{
+    const auto cx_slot  = handle.Slot(cx);
+    const auto rsv_slot = handle.Slot(reserve_space);
+    handle.Record([=](Handle& h, const RNNPlanBindings& bindings, float&) {
+        LSTMForwardHiddenStateUpdate(h,
+                                     rnn_data_type,
+                                     is_inference,
+                                     is_seq_begin,
+                                     direction,
+                                     max_batch,
+                                     cur_batch,
+                                     use_batch,
+                                     hy_h,
+                                     hy_stride,
+                                     wei_len,
+                                     wei_stride,
+                                     Bind(bindings, cx_slot),
+                                     cx_offset,
+                                     Bind(bindings, rsv_slot),
+                                     i_offset,
+                                     f_offset,
+                                     o_offset,
+                                     c_offset,
+                                     cell_offset,
+                                     cell_offset_pre,
+                                     activ_cell_offset,
+                                     hidden_offset);
+    });
+}
+
+void LSTMBackwardHiddenStateUpdate(RNNPlanRecorder& handle,
+                                   miopenDataType_t rnn_data_type,
+                                   bool is_seq_begin,
+                                   bool is_seq_end,
+                                   int direction,
+                                   int max_batch,
+                                   int cur_batch,
+                                   int use_batch,
+                                   int use_batch2,
+                                   int hy_h,
+                                   int hy_stride,
+                                   int wei_len,
+                                   int wei_stride,
+                                   ConstData_t cx,
+                                   std::size_t cx_offset,
+                                   Data_t reserve_space,
+                                   std::size_t i_offset,
+                                   std::size_t f_offset,
+                                   std::size_t o_offset,
+                                   std::size_t c_offset,
+                                   std::size_t activ_cell_offset,
+                                   std::size_t cell_offset_pre,
+                                   ConstData_t dcy,
+                                   std::size_t dcy_offset,
+                                   Data_t work_space,
+                                   std::size_t di_offset,
+                                   std::size_t df_offset,
+                                   std::size_t do_offset,
+                                   std::size_t dc_offset,
+                                   std::size_t dcell_offset,
+                                   std::size_t dcell_offset_pre,
+                                   std::size_t dhidden_offset,
+                                   std::size_t f_offset_pre)
+{
+    const auto cx_slot  = handle.Slot(cx);
+    const auto rsv_slot = handle.Slot(reserve_space);
+    const auto dcy_slot = handle.Slot(dcy);
+    const auto ws_slot  = handle.Slot(work_space);
+    handle.Record([=](Handle& h, const RNNPlanBindings& bindings, float&) {
+        LSTMBackwardHiddenStateUpdate(h,
+                                      rnn_data_type,
+                                      is_seq_begin,
+                                      is_seq_end,
+                                      direction,
+                                      max_batch,
+                                      cur_batch,
+                                      use_batch,
+                                      use_batch2,
+                                      hy_h,
+                                      hy_stride,
+                                      wei_len,
+                                      wei_stride,
+                                      Bind(bindings, cx_slot),
+                                      cx_offset,
+                                      Bind(bindings, rsv_slot),
+                                      i_offset,
+                                      f_offset,
+                                      o_offset,
+                                      c_offset,
+                                      activ_cell_offset,
+                                      cell_offset_pre,
+                                      Bind(bindings, dcy_slot),
+                                      dcy_offset,
+                                      Bind(bindings, ws_slot),
+                                      di_offset,
+                                      df_offset,
+                                      do_offset,
+                                      dc_offset,
+                                      dcell_offset,
+                                      dcell_offset_pre,
+                                      dhidden_offset,
+                                      f_offset_pre);
+    });
+}
+
+void RNNPlanActivation::Forward(RNNPlanRecorder& handle,
+                                const void* alpha,
+                                const TensorDescriptor& xDesc,
+                                ConstData_t x,
+                                const void* beta,
+                                const TensorDescriptor& yDesc,
+                                Data_t y,
+                                size_t xOffset,
+                                size_t yOffset) const
+{
+    const auto x_slot         = handle.Slot(x);
+    const auto y_slot         = handle.Slot(y);
+    const auto alpha_value    = *static_cast<const float*>(alpha);
+    const auto beta_value     = *static_cast<const float*>(beta);
+    ActivationDescriptor desc = *this;
+    handle.Record([=](Handle& h, const RNNPlanBindings& bindings, float&) mutable {
+        desc.Forward(h,
+                     &alpha_value,
+                     xDesc,
+                     Bind(bindings, x_slot),
+                     &beta_value,
+                     yDesc,
+                     Bind(bindings, y_slot),
+                     xOffset,
+                     yOffset);
+    });
+}
+
+void RNNPlanActivation::Backward(RNNPlanRecorder& handle,
+                                 const void* alpha,
+                                 const TensorDescriptor& yDesc,
+                                 ConstData_t y,
+                                 const TensorDescriptor& dyDesc,
+                                 ConstData_t dy,
+                                 const TensorDescriptor& xDesc,
+                                 ConstData_t x,
+                                 const void* beta,
+                                 const TensorDescriptor& dxDesc,
+                                 Data_t dx,
+                                 size_t yOffset,
+                                 size_t dyOffset,
+                                 size_t xOffset,
+                                 size_t dxOffset) const
+{
+    const auto y_slot         = handle.Slot(y);
+    const auto dy_slot        = handle.Slot(dy);
+    const auto x_slot         = handle.Slot(x);
+    const auto dx_slot        = handle.Slot(dx);
+    const auto alpha_value    = *static_cast<const float*>(alpha);
+    const auto beta_value     = *static_cast<const float*>(beta);
+    ActivationDescriptor desc = *this;
+    handle.Record([=](Handle& h, const RNNPlanBindings& bindings, float&) mutable {
+        desc.Backward(h,
+                      &alpha_value,
+                      yDesc,
+                      Bind(bindings, y_slot),
+                      dyDesc,
+                      Bind(bindings, dy_slot),
+                      xDesc,
+                      Bind(bindings, x_slot),
+                      &beta_value,
+                      dxDesc,
+                      Bind(bindings, dx_slot),
+                      yOffset,
+                      dyOffset,
+                      xOffset,
+                      dxOffset);
+    });
+}
+
+} // namespace miopen
@@ -25,6 +25,7 @@
  *******************************************************************************/
 
 #include <miopen/rnn.hpp>
+#include <miopen/rnn_plan.hpp>
 #include <miopen/rnn_util.hpp>
 
 #include <miopen/activ.hpp>
@@ -58,6 +59,55 @@ void RNNDescriptor::RNNForwardInference(Handle& handle,
                                         Data_t workSpace,
                                         size_t workSpaceSize) const
 {
+    auto bindings        = RNNPlanBindings{};
+    bindings.buffers     = {x, hx, cx, w, y, hy, cy, workSpace};
+    bindings.dropoutDesc = dropoutDesc;
+
+    auto key = RNNPlanKey{*this, 'I', seqLen};
+    key.Add(xDesc, seqLen).Add(yDesc, seqLen);
+    key.Add(hxDesc).Add(cxDesc).Add(wDesc).Add(hyDesc).Add(cyDesc);
+    key.Add(workSpaceSize).Add(bindings);
+    RunRNNPlan(handle, key, bindings, [&](RNNPlanRecorder& recorder) {
+        RecordForwardInference(recorder,
+                               seqLen,
+                               xDesc,
+                               x,
+                               hxDesc,
+                               hx,
+                               cxDesc,
+                               cx,
+                               wDesc,
+                               w,
+                               yDesc,
+                               y,
+                               hyDesc,
+                               hy,
+                               cyDesc,
+                               cy,
+                               workSpace,
+                               workSpaceSize);
+    });
+}
+
+void RNNDescriptor::RecordForwardInference(RNNPlanRecorder& handle,
+                                           const int seqLen,
+                                           c_array_view<const miopenTensorDescriptor_t> xDesc,
+                                           ConstData_t x,
+                                           const TensorDescriptor& hxDesc,
+                                           ConstData_t hx,
+                                           const TensorDescriptor& cxDesc,
+                                           ConstData_t cx,
+                                           const TensorDescriptor& wDesc,
+                                           ConstData_t w,
+                                           c_array_view<const miopenTensorDescriptor_t> yDesc,
+                                           Data_t y,
+                                           const TensorDescriptor& hyDesc,
+                                           Data_t hy,
+                                           const TensorDescriptor& cyDesc,
+                                           Data_t cy,
+                                           Data_t workSpace,
+                                           size_t workSpaceSize) const
+{
 
     if(x == nullptr || w == nullptr || y == nullptr)
     {
@@ -68,7 +118,7 @@ void RNNDescriptor::RNNForwardInference(Handle& handle,
     {
         MIOPEN_THROW(miopenStatusBadParm);
     }
-    if(workSpaceSize < GetWorkspaceSize(handle, seqLen, xDesc))
+    if(workSpaceSize < GetWorkspaceSize(handle.GetHandle(), seqLen, xDesc))
     {
         MIOPEN_THROW("Workspace is required");
     }
@@ -216,7 +266,7 @@ void RNNDescriptor::RNNForwardInference(Handle& handle,
         break;
     }
 
-    ActivationDescriptor tanhDesc, sigDesc, activDesc;
+    RNNPlanActivation tanhDesc, sigDesc, activDesc;
     sigDesc  = {miopenActivationLOGISTIC, 1, 0, 1};
     tanhDesc = {miopenActivationTANH, 1, 1, 1};
     if(rnnMode == miopenRNNRELU)
@@ -1282,6 +1332,59 @@ void RNNDescriptor::RNNForwardTraining(Handle& handle,
                                        size_t workSpaceSize,
                                        Data_t reserveSpace,
                                        size_t reserveSpaceSize) const
+{
+    auto bindings        = RNNPlanBindings{};
+    bindings.buffers     = {x, hx, cx, w, y, hy, cy, workSpace, reserveSpace};
+    bindings.dropoutDesc = dropoutDesc;
+
+    auto key = RNNPlanKey{*this, 'T', seqLen};
+    key.Add(xDesc, seqLen).Add(yDesc, seqLen);
+    key.Add(hxDesc).Add(cxDesc).Add(wDesc).Add(hyDesc).Add(cyDesc);
+    key.Add(workSpaceSize).Add(reserveSpaceSize).Add(bindings);
+    RunRNNPlan(handle, key, bindings, [&](RNNPlanRecorder& recorder) {
+        RecordForwardTraining(recorder,
+                              seqLen,
+                              xDesc,
+                              x,
+                              hxDesc,
+                              hx,
+                              cxDesc,
+                              cx,
+                              wDesc,
+                              w,
+                              yDesc,
+                              y,
+                              hyDesc,
+                              hy,
+                              cyDesc,
+                              cy,
+                              workSpace,
+                              workSpaceSize,
+                              reserveSpace,
+                              reserveSpaceSize);
+    });
+}
+
+void RNNDescriptor::RecordForwardTraining(RNNPlanRecorder& handle,
+                                          const int seqLen,
+                                          c_array_view<const miopenTensorDescriptor_t> xDesc,
+                                          ConstData_t x,
+                                          const TensorDescriptor& hxDesc,
+                                          ConstData_t hx,
+                                          const TensorDescriptor& cxDesc,
+                                          ConstData_t cx,
+                                          const TensorDescriptor& wDesc,
+                                          ConstData_t w,
+                                          c_array_view<const miopenTensorDescriptor_t> yDesc,
+                                          Data_t y,
+                                          const TensorDescriptor& hyDesc,
+                                          Data_t hy,
+                                          const TensorDescriptor& cyDesc,
+                                          Data_t cy,
+                                          Data_t workSpace,
+                                          size_t workSpaceSize,
+                                          Data_t reserveSpace,
+                                          size_t reserveSpaceSize) const
 {
     (void)workSpace;
 
@@ -1294,11 +1397,11 @@ void RNNDescriptor::RNNForwardTraining(Handle& handle,
     {
         MIOPEN_THROW(miopenStatusBadParm);
     }
-    if(workSpaceSize < GetWorkspaceSize(handle, seqLen, xDesc))
+    if(workSpaceSize < GetWorkspaceSize(handle.GetHandle(), seqLen, xDesc))
     {
         MIOPEN_THROW("Workspace is required");
     }
-    if(reserveSpaceSize < GetReserveSize(handle, seqLen, xDesc))
+    if(reserveSpaceSize < GetReserveSize(handle.GetHandle(), seqLen, xDesc))
     {
         MIOPEN_THROW("Reservespace is required");
     }
@@ -1446,7 +1549,7 @@ void RNNDescriptor::RNNForwardTraining(Handle& handle,
         break;
     }
 
-    ActivationDescriptor tanhDesc, sigDesc, activDesc;
+    RNNPlanActivation tanhDesc, sigDesc, activDesc;
     sigDesc  = {miopenActivationLOGISTIC, 1, 0, 1};
     tanhDesc = {miopenActivationTANH, 1, 1, 1};
     if(rnnMode == miopenRNNRELU)
@@ -1561,18 +1664,17 @@ void RNNDescriptor::RNNForwardTraining(Handle& handle,
                                              (wDesc.GetType() == miopenFloat ? 4 : 2) +
                                          (li - 1) * drop_rsv_size;
 
-                miopen::deref(dropoutDesc)
-                    .DropoutForward(handle,
-                                    drop_in_desc,
-                                    drop_in_desc,
-                                    reserveSpace,
-                                    drop_out_desc,
-                                    reserveSpace,
-                                    reserveSpace,
-                                    drop_rsv_size,
-                                    drop_in_offset,
-                                    drop_out_offset,
-                                    drop_rsv_offset);
+                DropoutForward(handle,
+                               drop_in_desc,
+                               drop_in_desc,
+                               reserveSpace,
+                               drop_out_desc,
+                               reserveSpace,
+                               reserveSpace,
+                               drop_rsv_size,
+                               drop_in_offset,
+                               drop_out_offset,
+                               drop_rsv_offset);
                 // Update time
                 profileRNNkernels(handle, 1, ctime);
 
@@ -2586,6 +2688,71 @@ void RNNDescriptor::RNNBackwardData(Handle& handle,
                                     Data_t reserveSpace,
                                     size_t reserveSpaceSize) const
 {
+    auto bindings        = RNNPlanBindings{};
+    bindings.buffers     = {y, dy, dhy, dcy, w, hx, cx, dx, dhx, dcx, workSpace, reserveSpace};
+    bindings.dropoutDesc = dropoutDesc;
+
+    auto key = RNNPlanKey{*this, 'D', seqLen};
+    key.Add(yDesc, seqLen).Add(dyDesc, seqLen).Add(dxDesc, seqLen);
+    key.Add(dhyDesc).Add(dcyDesc).Add(wDesc).Add(hxDesc).Add(cxDesc).Add(dhxDesc).Add(dcxDesc);
+    key.Add(workSpaceSize).Add(reserveSpaceSize).Add(bindings);
+    RunRNNPlan(handle, key, bindings, [&](RNNPlanRecorder& recorder) {
+        RecordBackwardData(recorder,
+                           seqLen,
+                           yDesc,
+                           y,
+                           dyDesc,
+                           dy,
+                           dhyDesc,
+                           dhy,
+                           dcyDesc,
+                           dcy,
+                           wDesc,
+                           w,
+                           hxDesc,
+                           hx,
+                           cxDesc,
+                           cx,
+                           dxDesc,
+                           dx,
+                           dhxDesc,
+                           dhx,
+                           dcxDesc,
+                           dcx,
+                           workSpace,
+                           workSpaceSize,
+                           reserveSpace,
+                           reserveSpaceSize);
+    });
+}
+
+void RNNDescriptor::RecordBackwardData(RNNPlanRecorder& handle,
+                                       const int seqLen,
+                                       c_array_view<const miopenTensorDescriptor_t> yDesc,
+                                       ConstData_t y,
+                                       c_array_view<const miopenTensorDescriptor_t> dyDesc,
+                                       ConstData_t dy,
+                                       const TensorDescriptor& dhyDesc,
+                                       ConstData_t dhy,
+                                       const TensorDescriptor& dcyDesc,
+                                       ConstData_t dcy,
+                                       const TensorDescriptor& wDesc,
+                                       ConstData_t w,
+                                       const TensorDescriptor& hxDesc,
+                                       ConstData_t hx,
+                                       const TensorDescriptor& cxDesc,
+                                       ConstData_t cx,
+                                       c_array_view<const miopenTensorDescriptor_t> dxDesc,
+                                       Data_t dx,
+                                       const TensorDescriptor& dhxDesc,
+                                       Data_t dhx,
+                                       const TensorDescriptor& dcxDesc,
+                                       Data_t dcx,
+                                       Data_t workSpace,
+                                       size_t workSpaceSize,
+                                       Data_t reserveSpace,
+                                       size_t reserveSpaceSize) const
+{
 
     // Suppress warning
     (void)y;
@@ -2607,11 +2774,11 @@ void RNNDescriptor::RNNBackwardData(Handle& handle,
     {
         MIOPEN_THROW(miopenStatusBadParm);
     }
-    if(workSpaceSize < GetWorkspaceSize(handle, seqLen, dxDesc))
+    if(workSpaceSize < GetWorkspaceSize(handle.GetHandle(), seqLen, dxDesc))
     {
         MIOPEN_THROW("Workspace is required");
     }
-    if(reserveSpaceSize < GetReserveSize(handle, seqLen, dxDesc))
+    if(reserveSpaceSize < GetReserveSize(handle.GetHandle(), seqLen, dxDesc))
     {
         MIOPEN_THROW("Reservespace is required");
     }
@@ -2761,7 +2928,7 @@ void RNNDescriptor::RNNBackwardData(Handle& handle,
         break;
     }
 
-    ActivationDescriptor tanhDesc, sigDesc, activDesc;
+    RNNPlanActivation tanhDesc, sigDesc, activDesc;
     sigDesc  = {miopenActivationLOGISTIC, 1, 0, 1};
     tanhDesc = {miopenActivationTANH, 1, 1, 1};
     if(rnnMode == miopenRNNRELU)
@@ -2860,18 +3027,17 @@ void RNNDescriptor::RNNBackwardData(Handle& handle,
                                              (wDesc.GetType() == miopenFloat ? 4 : 2) +
                                          li * drop_rsv_size;
 
-                miopen::deref(dropoutDesc)
-                    .DropoutBackward(handle,
-                                     drop_in_desc,
-                                     drop_in_desc,
-                                     workSpace,
-                                     drop_in_desc,
-                                     workSpace,
-                                     reserveSpace,
-                                     drop_rsv_size,
-                                     hid_shift + dhd_off,
-                                     hid_shift + dhd_off,
-                                     drop_rsv_offset);
+                DropoutBackward(handle,
+                                drop_in_desc,
+                                drop_in_desc,
+                                workSpace,
+                                drop_in_desc,
+                                workSpace,
+                                reserveSpace,
+                                drop_rsv_size,
+                                hid_shift + dhd_off,
+                                hid_shift + dhd_off,
+                                drop_rsv_offset);
                 // Update time
                 profileRNNkernels(handle, 1, ctime);
             }
@@ -4078,16 +4244,57 @@ void RNNDescriptor::RNNBackwardWeights(Handle& handle,
                                        ConstData_t reserveSpace,
                                        size_t reserveSpaceSize) const
 {
+    auto bindings        = RNNPlanBindings{};
+    bindings.buffers     = {x, hx, dy, dw, workSpace, reserveSpace};
+    bindings.dropoutDesc = dropoutDesc;
+
+    auto key = RNNPlanKey{*this, 'W', seqLen};
+    key.Add(xDesc, seqLen).Add(dyDesc, seqLen);
+    key.Add(hxDesc).Add(dwDesc);
+    key.Add(workSpaceSize).Add(reserveSpaceSize).Add(bindings);
+    RunRNNPlan(handle, key, bindings, [&](RNNPlanRecorder& recorder) {
+        RecordBackwardWeights(recorder,
+                              seqLen,
+                              xDesc,
+                              x,
+                              hxDesc,
+                              hx,
+                              dyDesc,
+                              dy,
+                              dwDesc,
+                              dw,
+                              workSpace,
+                              workSpaceSize,
+                              reserveSpace,
+                              reserveSpaceSize);
+    });
+}
+
+void RNNDescriptor::RecordBackwardWeights(RNNPlanRecorder& handle,
+                                          const int seqLen,
+                                          c_array_view<const miopenTensorDescriptor_t> xDesc,
+                                          ConstData_t x,
+                                          const TensorDescriptor& hxDesc,
+                                          ConstData_t hx,
+                                          c_array_view<const miopenTensorDescriptor_t> dyDesc,
+                                          ConstData_t dy,
+                                          const TensorDescriptor& dwDesc,
+                                          Data_t dw,
+                                          Data_t workSpace,
+                                          size_t workSpaceSize,
+                                          ConstData_t reserveSpace,
+                                          size_t reserveSpaceSize) const
+{
 
     if(x == nullptr || dw == nullptr || dy == nullptr)
     {
         MIOPEN_THROW(miopenStatusBadParm);
     }
-    if(workSpaceSize < GetWorkspaceSize(handle, seqLen, xDesc))
+    if(workSpaceSize < GetWorkspaceSize(handle.GetHandle(), seqLen, xDesc))
     {
         MIOPEN_THROW("Workspace is required");
     }
-    if(reserveSpaceSize < GetReserveSize(handle, seqLen, xDesc))
+    if(reserveSpaceSize < GetReserveSize(handle.GetHandle(), seqLen, xDesc))
     {
         MIOPEN_THROW("Reservespace is required");
     }
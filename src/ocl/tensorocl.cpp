@@ -27,6 +27,7 @@
 #include <miopen/errors.hpp>
 #include <miopen/float_equal.hpp>
 #include <miopen/handle.hpp>
+#include <miopen/logger.hpp>
 #include <miopen/tensor_ops.hpp>
 #include <miopen/datatype.hpp>
 #include <miopen/visit_float.hpp>
@@ -40,47 +41,24 @@
 
 namespace miopen {
 
-TensorDescriptor GetFlattenedTensorDescriptor(const TensorDescriptor& desc)
+std::size_t FlatTensor::GetElementSize() const
 {
-    // is packed
-    if(desc.IsPacked())
-        return {desc.GetType(), {desc.GetElementSize()}, {1}};
-
-    // start flattening tensor
-    std::vector<std::size_t> flat_lengths;
-    std::vector<std::size_t> flat_strides;
-
-    auto non1_length_strides = boost::combine(desc.GetLengths(), desc.GetStrides()) |
-                               boost::adaptors::filtered(f_length_is_not_1_t());
-
-    auto i               = non1_length_strides.begin();
-    std::size_t flat_len = boost::get<0>(*i);
-    auto i_previous      = i++;
-
-    // the 0-th dimension full-length doesn't matter
-    for(; i != non1_length_strides.end(); ++i)
-    {
-        std::size_t len             = boost::get<0>(*i);
-        std::size_t stride          = boost::get<1>(*i);
-        std::size_t previous_stride = boost::get<1>(*i_previous);
-        std::size_t full_len        = previous_stride / stride;
+    return std::accumulate(
+        lengths.begin(), lengths.begin() + size, std::size_t{1}, std::multiplies<std::size_t>());
+}
 
-        if(len == full_len)
-        {
-            flat_len *= len;
-        }
-        else
-        {
-            flat_lengths.push_back(flat_len);
-            flat_strides.push_back(previous_stride);
-            flat_len = len;
-        }
-        i_previous = i;
-    }
-    flat_lengths.push_back(flat_len);
-    flat_strides.push_back(boost::get<1>(*i_previous));
+std::size_t FlatTensor::GetElementSpace() const
+{
+    std::size_t space = 1;
+    for(std::size_t i = 0; i < size; ++i)
+        space += (lengths[i] - 1) * strides[i];
+    return space;
+}
 
-    return {desc.GetType(), std::move(flat_lengths), std::move(flat_strides)};
+std::ostream& operator<<(std::ostream& stream, const FlatTensor& t)
+{
+    LogRange(stream << "{", t.GetLengths(), ", ") << "}, ";
+    return LogRange(stream << "{", t.GetStrides(), ", ") << "}";
 }
 
 // Free Tensor Functions
@@ -172,11 +150,6 @@ void OpTensor3d(const Handle& handle,
 
     size_t local_threads = 256;
 
-    std::string network_config{};
-
-    network_config = std::to_string(bTensorDesc.GetType()) + "-" +
-                     std::to_string(aTensorDesc.GetType()) + "-" + std::to_string(tensorOp) + "-";
-
     // for naive tensor ops
     size_t RD_BLCK              = (clens[2] % 4 == 0) ? 4 : (clens[2] % 2 == 0) ? 2 : 1;
     const std::string data_type = GetDataType(bTensorDesc.GetType());
@@ -193,6 +166,26 @@ void OpTensor3d(const Handle& handle,
     grp_sz2               = std::min(size_t(max_num_wg / grp_sz), grp_sz2);
     size_t glb_sz2        = local_threads2 * grp_sz2;
 
+    const std::string program_name = "MIOpenTensorKernels.cl";
+
+    const std::vector<size_t> vld{local_threads, 1, 1};
+
+    const auto get_parms = [&]() {
+        std::string parms = " -DMIOPEN_TYPE=" + GetDataType(bTensorDesc.GetType());
+
+        parms += GetDataTypeKernelParams(aTensorDesc.GetType());
+
+        parms += " -DMIOPEN_TENSOR_OP=";
+        switch(tensorOp)
+        {
+        case 0: parms += "miopenAdd"; break;
+        case 1: parms += "miopenMul"; break;
+        case 2: parms += "miopenMin"; break;
+        case 3: parms += "miopenMax"; break;
+        }
+        return parms;
+    };
+
     visit_float(bTensorDesc.GetType(), [&](auto as_float) {
 
         auto miopen_alpha0 = as_float(*(static_cast<const float*>(alpha0)));
@@ -202,216 +195,126 @@ void OpTensor3d(const Handle& handle,
         if(clens[0] == 1 && blens[0] == 1 && alens[0] == 1 &&
            (blens[1] == clens[1] || blens[1] == 1) && blens[2] == clens[2])
         {
+            auto key = TensorOpKey{"Op2dTensorLite"};
+            key.Add(bTensorDesc.GetType()).Add(aTensorDesc.GetType()).Add(tensorOp);
+            key.Add(RD_BLCK).Add(local_threads).Add(grp_sz).Add(local_threads2).Add(grp_sz2);
 
-            network_config += std::to_string(RD_BLCK) + "x" + std::to_string(local_threads) + "x" +
-                              std::to_string(grp_sz) + std::to_string(local_threads2) +
-                              std::to_string(grp_sz2);
-
-            auto&& kernels = handle.GetKernels("Op2dTensorLite", network_config);
+            const KernelInvoke* kernel_ptr = handle.GetKernelInvoke(key);
 
-            if(!kernels.empty())
+            if(kernel_ptr == nullptr)
             {
-                auto kernel = kernels.front();
+                auto parms = get_parms();
+                parms += " -DUSE_2D_TENSOR_LITE";
+                parms += " -DRD_BLCK=" + std::to_string(RD_BLCK) + " -DREAD_TYPE=" + READ_TYPE;
 
-                kernel(ATensor,
-                       int(astrides[1]), // a_cstride,
-                       BTensor,
-                       int(bstrides[1]), // b_cstride,
-                       CTensor,
-                       int(cstrides[1]), // c_cstride,
-                       miopen_alpha0,
-                       miopen_alpha1,
-                       miopen_beta,
-                       long(Aoffset),
-                       long(Boffset),
-                       long(Coffset),
-                       long(total_work),
-                       long(total_work2),
-                       int(!float_equal(miopen_beta, 0.0)),
-                       int(blens[1] == 1));
+                const std::vector<size_t> vgd1{glb_sz, glb_sz2, 1};
 
-                return;
+                kernel_ptr =
+                    &handle.AddKernel(key, program_name, "Op2dTensorLite", vld, vgd1, parms);
             }
+
+            const auto& kernel = *kernel_ptr;
+
+            kernel(ATensor,
+                   int(astrides[1]), // a_cstride,
+                   BTensor,
+                   int(bstrides[1]), // b_cstride,
+                   CTensor,
+                   int(cstrides[1]), // c_cstride,
+                   miopen_alpha0,
+                   miopen_alpha1,
+                   miopen_beta,
+                   long(Aoffset),
+                   long(Boffset),
+                   long(Coffset),
+                   long(total_work),
+                   long(total_work2),
+                   int(!float_equal(miopen_beta, 0.0)),
+                   int(blens[1] == 1));
         }
         else if(blens[0] == 1 && clens[0] == 1 && clens[1] == 1 && blens[2] == clens[2])
         {
-            network_config += std::to_string(RD_BLCK) + "x" + std::to_string(local_threads) + "x" +
-                              std::to_string(grp_sz);
+            auto key = TensorOpKey{"Op2dTensorSquash"};
+            key.Add(bTensorDesc.GetType()).Add(aTensorDesc.GetType()).Add(tensorOp);
+            key.Add(RD_BLCK).Add(local_threads).Add(grp_sz);
 
-            auto&& kernels = handle.GetKernels("Op2dTensorSquash", network_config);
+            const KernelInvoke* kernel_ptr = handle.GetKernelInvoke(key);
 
-            if(!kernels.empty())
+            if(kernel_ptr == nullptr)
             {
-                auto kernel = kernels.front();
+                auto parms = get_parms();
+                parms += " -DUSE_2D_TENSOR_SQUASH";
+                parms += " -DRD_BLCK=" + std::to_string(RD_BLCK) + " -DREAD_TYPE=" + READ_TYPE;
 
-                kernel(ATensor,
-                       BTensor,
-                       int(blens[1]),    // b_c,
-                       int(bstrides[1]), // b_cstride,
-                       CTensor,
-                       miopen_alpha0,
-                       miopen_alpha1,
-                       miopen_beta,
-                       long(Aoffset),
-                       long(Boffset),
-                       long(Coffset),
-                       long(total_work),
-                       int(!float_equal(miopen_alpha0, 0.0)),
-                       int(!float_equal(miopen_alpha1, 0.0)),
-                       int(!float_equal(miopen_beta, 0.0)));
+                const std::vector<size_t> vgd1{glb_sz, 1, 1};
 
-                return;
+                kernel_ptr =
+                    &handle.AddKernel(key, program_name, "Op2dTensorSquash", vld, vgd1, parms);
             }
+
+            const auto& kernel = *kernel_ptr;
+
+            kernel(ATensor,
+                   BTensor,
+                   int(blens[1]),    // b_c,
+                   int(bstrides[1]), // b_cstride,
+                   CTensor,
+                   miopen_alpha0,
+                   miopen_alpha1,
+                   miopen_beta,
+                   long(Aoffset),
+                   long(Boffset),
+                   long(Coffset),
+                   long(total_work),
+                   int(!float_equal(miopen_alpha0, 0.0)),
+                   int(!float_equal(miopen_alpha1, 0.0)),
+                   int(!float_equal(miopen_beta, 0.0)));
         }
         else
         {
+            auto key = TensorOpKey{"Op3dTensorGeneric"};
+            key.Add(bTensorDesc.GetType()).Add(aTensorDesc.GetType()).Add(tensorOp);
+            key.Add(max_num_wg).Add(local_threads).Add(num_wg);
 
-            network_config += std::to_string(max_num_wg) + "-" + std::to_string(local_threads) +
-                              "x" + std::to_string(num_wg);
-
-            auto&& kernels = handle.GetKernels("Op3dTensorGeneric", network_config);
+            const KernelInvoke* kernel_ptr = handle.GetKernelInvoke(key);
 
-            if(!kernels.empty())
+            if(kernel_ptr == nullptr)
             {
-                auto kernel = kernels.front();
+                auto parms = get_parms();
+                parms += " -DUSE_3D_TENSOR_GENERIC";
+                parms += " -DMAX_NUM_WG=" + std::to_string(max_num_wg);
 
-                kernel(ATensor,
-                       int(astrides[0]), // a_nstride,
-                       int(astrides[1]), // a_cstride,
-                       BTensor,
-                       int(blens[1]),    // b_c,
-                       int(blens[2]),    // b_h,
-                       int(bstrides[0]), // b_nstride,
-                       int(bstrides[1]), // b_cstride,
-                       CTensor,
-                       int(clens[1]),    // c_c,
-                       int(clens[2]),    // c_h,
-                       int(cstrides[0]), // c_nstride,
-                       int(cstrides[1]), // c_cstride,
-                       miopen_alpha0,
-                       miopen_alpha1,
-                       miopen_beta,
-                       bitmap,
-                       work_per_wg,
-                       long(Aoffset),
-                       long(Boffset),
-                       long(Coffset),
-                       int(num_wg_orig));
+                // Special case for adding tensors in place
+                const std::vector<size_t> vgd{num_wg * local_threads, 1, 1};
 
-                return;
+                kernel_ptr =
+                    &handle.AddKernel(key, program_name, "Op3dTensorGeneric", vld, vgd, parms);
             }
-        }
-
-        std::string parms = " -DMIOPEN_TYPE=" + GetDataType(bTensorDesc.GetType());
-
-        parms += GetDataTypeKernelParams(aTensorDesc.GetType());
-
-        parms += " -DMIOPEN_TENSOR_OP=";
-        switch(tensorOp)
-        {
-        case 0: parms += "miopenAdd"; break;
-        case 1: parms += "miopenMul"; break;
-        case 2: parms += "miopenMin"; break;
-        case 3: parms += "miopenMax"; break;
-        }
-        std::string program_name = "MIOpenTensorKernels.cl";
 
-        const std::vector<size_t> vld{local_threads, 1, 1};
+            const auto& kernel = *kernel_ptr;
 
-        if(clens[0] == 1 && blens[0] == 1 && alens[0] == 1 &&
-           (blens[1] == clens[1] || blens[1] == 1) && blens[2] == clens[2])
-        {
-            parms += " -DUSE_2D_TENSOR_LITE";
-            parms += " -DRD_BLCK=" + std::to_string(RD_BLCK) + " -DREAD_TYPE=" + READ_TYPE;
-
-            const std::vector<size_t> vgd1{glb_sz, glb_sz2, 1};
-
-            handle.AddKernel(
-                "Op2dTensorLite", network_config, program_name, "Op2dTensorLite", vld, vgd1, parms)(
-                ATensor,
-                int(astrides[1]), // a_cstride,
-                BTensor,
-                int(bstrides[1]), // b_cstride,
-                CTensor,
-                int(cstrides[1]), // c_cstride,
-                miopen_alpha0,
-                miopen_alpha1,
-                miopen_beta,
-                long(Aoffset),
-                long(Boffset),
-                long(Coffset),
-                long(total_work),
-                long(total_work2),
-                int(!float_equal(miopen_beta, 0.0)),
-                int(blens[1] == 1));
-        }
-        else if(blens[0] == 1 && clens[0] == 1 && clens[1] == 1 && blens[2] == clens[2])
-        {
-            parms += " -DUSE_2D_TENSOR_SQUASH";
-            parms += " -DRD_BLCK=" + std::to_string(RD_BLCK) + " -DREAD_TYPE=" + READ_TYPE;
-
-            const std::vector<size_t> vgd1{glb_sz, 1, 1};
-
-            handle.AddKernel("Op2dTensorSquash",
-                             network_config,
-                             program_name,
-                             "Op2dTensorSquash",
-                             vld,
-                             vgd1,
-                             parms)(ATensor,
-                                    BTensor,
-                                    int(blens[1]),    // b_c,
-                                    int(bstrides[1]), // b_cstride,
-                                    CTensor,
-                                    miopen_alpha0,
-                                    miopen_alpha1,
-                                    miopen_beta,
-                                    long(Aoffset),
-                                    long(Boffset),
-                                    long(Coffset),
-                                    long(total_work),
-                                    int(!float_equal(miopen_alpha0, 0.0)),
-                                    int(!float_equal(miopen_alpha1, 0.0)),
-                                    int(!float_equal(miopen_beta, 0.0)));
-        }
-        else
-        {
-            // Special case for adding tensors in place
-            size_t global_threads;
-            global_threads = num_wg * local_threads;
-            const std::vector<size_t> vgd{global_threads, 1, 1};
-
-            parms += " -DUSE_3D_TENSOR_GENERIC";
-            parms += " -DMAX_NUM_WG=" + std::to_string(max_num_wg);
-
-            handle.AddKernel("Op3dTensorGeneric",
-                             network_config,
-                             program_name,
-                             "Op3dTensorGeneric",
-                             vld,
-                             vgd,
-                             parms)(ATensor,
-                                    int(astrides[0]), // a_nstride,
-                                    int(astrides[1]), // a_cstride,
-                                    BTensor,
-                                    int(blens[1]),    // b_c,
-                                    int(blens[2]),    // b_h,
-                                    int(bstrides[0]), // b_nstride,
-                                    int(bstrides[1]), // b_cstride,
-                                    CTensor,
-                                    int(clens[1]),    // c_c,
-                                    int(clens[2]),    // c_h,
-                                    int(cstrides[0]), // c_nstride,
-                                    int(cstrides[1]), // c_cstride,
-                                    miopen_alpha0,
-                                    miopen_alpha1,
-                                    miopen_beta,
-                                    bitmap,
-                                    work_per_wg,
-                                    long(Aoffset),
-                                    long(Boffset),
-                                    long(Coffset),
-                                    int(num_wg_orig));
+            kernel(ATensor,
+                   int(astrides[0]), // a_nstride,
+                   int(astrides[1]), // a_cstride,
+                   BTensor,
+                   int(blens[1]),    // b_c,
+                   int(blens[2]),    // b_h,
+                   int(bstrides[0]), // b_nstride,
+                   int(bstrides[1]), // b_cstride,
+                   CTensor,
+                   int(clens[1]),    // c_c,
+                   int(clens[2]),    // c_h,
+                   int(cstrides[0]), // c_nstride,
+                   int(cstrides[1]), // c_cstride,
+                   miopen_alpha0,
+                   miopen_alpha1,
+                   miopen_beta,
+                   bitmap,
+                   work_per_wg,
+                   long(Aoffset),
+                   long(Boffset),
+                   long(Coffset),
+                   int(num_wg_orig));
         }
     });
 }
@@ -535,12 +438,42 @@ void OpTensor4d(const Handle& handle,
     grp_sz            = std::min(size_t(max_num_wg), grp_sz);
     size_t glb_sz     = local_threads * grp_sz;
 
-    std::string network_config{};
-    network_config +=
-        std::to_string(bTensorDesc.GetType()) + "-" + std::to_string(aTensorDesc.GetType()) + "-" +
-        std::to_string(tensorOp) + "-" + std::to_string(max_num_wg) + "-" +
-        ((fwd_conv_bias == 0 && packed_equal_tensor) ? "" : std::to_string(global_threads)) + "-" +
-        std::to_string(local_threads);
+    const auto get_parms = [&]() {
+        std::string parms = " -DMIOPEN_TYPE=" + GetDataType(bTensorDesc.GetType()) +
+                            " -DMAX_NUM_WG=" + std::to_string(max_num_wg);
+
+        parms += GetDataTypeKernelParams(aTensorDesc.GetType());
+
+        parms += " -DMIOPEN_TENSOR_OP=";
+        switch(tensorOp)
+        {
+        case 0: parms += "miopenAdd"; break;
+        case 1: parms += "miopenMul"; break;
+        case 2: parms += "miopenMin"; break;
+        case 3: parms += "miopenMax"; break;
+        }
+        return parms;
+    };
+
+    const auto get_key = [&](const char* kernel_name) {
+        auto key = TensorOpKey{kernel_name};
+        key.Add(bTensorDesc.GetType()).Add(aTensorDesc.GetType()).Add(tensorOp).Add(max_num_wg);
+        return key;
+    };
+
+    // Returns the kernel built with vgd which is the same for all but the lite kernel.
+    const auto get_kernel = [&](const char* kernel_name, const char* define) {
+        auto key = get_key(kernel_name);
+        key.Add(global_threads).Add(local_threads);
+
+        const KernelInvoke* kernel_ptr = handle.GetKernelInvoke(key);
+
+        if(kernel_ptr == nullptr)
+            kernel_ptr = &handle.AddKernel(
+                key, program_name, kernel_name, vld, vgd, get_parms() + " -D" + define);
+
+        return kernel_ptr;
+    };
 
     visit_float(bTensorDesc.GetType(), [&](auto as_float) {
 
@@ -552,392 +485,174 @@ void OpTensor4d(const Handle& handle,
         {
             if(packed_tensor)
             {
-                auto&& kernels = handle.GetKernels("OpTensorFwdBias", network_config);
-
-                if(!kernels.empty())
-                {
-                    auto kernel = kernels.front();
-                    kernel(ATensor,
-                           BTensor,
-                           int(blens[1]),
-                           CTensor,
-                           int(clens[0]),
-                           int(cstrides[0]),
-                           int(cstrides[1]),
-                           work_per_wg,
-                           miopen_alpha0,
-                           miopen_alpha1,
-                           miopen_beta,
-                           long(Aoffset),
-                           long(Boffset),
-                           long(Coffset),
-                           int(num_wg_orig),
-                           int(incr_wg));
-
-                    return;
-                }
-            }
-            else
-            {
+                const auto& kernel = *get_kernel("OpTensorFwdBias", "USE_FWD_BIAS");
 
-                auto&& kernels = handle.GetKernels("OpTensorFwdBiasGeneric", network_config);
-
-                if(!kernels.empty())
-                {
-                    auto kernel = kernels.front();
-                    kernel(ATensor,
-                           int(astrides[0]),
-                           int(astrides[1]),
-                           int(astrides[2]),
-                           BTensor,
-                           int(blens[1]),
-                           int(bstrides[1]),
-                           CTensor,
-                           int(clens[0]),
-                           int(clens[3]),
-                           int(cstrides[0]),
-                           int(cstrides[1]),
-                           int(cstrides[2]),
-                           miopen_alpha0,
-                           miopen_alpha1,
-                           miopen_beta,
-                           work_per_wg,
-                           long(Aoffset),
-                           long(Boffset),
-                           long(Coffset),
-                           int(num_wg_orig),
-                           int(incr_wg));
-                    return;
-                }
-            }
-        }
-        // precede leading_ones for bitmap = 1,1,1,1
-        else if(packed_equal_tensor)
-        {
-            network_config += "x" + std::to_string(grp_sz) + "x" + std::to_string(RD_BLCK);
-            auto&& kernels = handle.GetKernels("Op4dTensorLite", network_config);
-            if(!kernels.empty())
-            {
-                auto kernel = kernels.front();
                 kernel(ATensor,
                        BTensor,
+                       int(blens[1]),
                        CTensor,
+                       int(clens[0]),
+                       int(cstrides[0]),
+                       int(cstrides[1]),
+                       work_per_wg,
                        miopen_alpha0,
                        miopen_alpha1,
                        miopen_beta,
                        long(Aoffset),
                        long(Boffset),
                        long(Coffset),
-                       long(total_work),
-                       int(!float_equal(miopen_beta, 0.0)));
-                return;
-            }
-        }
-        else if(leading_ones)
-        {
-            if(packed_tensor)
-            {
-
-                auto&& kernels = handle.GetKernels("OpTensorLeadingOnes", network_config);
-
-                if(!kernels.empty())
-                {
-                    auto kernel = kernels.front();
-                    kernel(ATensor,
-                           BTensor,
-                           CTensor,
-                           int(clens[1]),
-                           int(clens[2]),
-                           int(clens[3]),
-                           int(cstrides[0]),
-                           int(cstrides[1]),
-                           work_per_wg,
-                           miopen_alpha0,
-                           miopen_alpha1,
-                           miopen_beta,
-                           long(Aoffset),
-                           long(Boffset),
-                           long(Coffset),
-                           int(num_wg_orig),
-                           bitmap);
-
-                    return;
-                }
+                       int(num_wg_orig),
+                       int(incr_wg));
             }
             else
             {
-                auto&& kernels = handle.GetKernels("OpTensorLeadingOnesGeneric", network_config);
-
-                if(!kernels.empty())
-                {
-                    auto kernel = kernels.front();
-                    kernel(ATensor,
-                           int(astrides[0]),
-                           int(astrides[1]),
-                           int(astrides[2]),
-                           BTensor,
-                           int(bstrides[0]),
-                           int(bstrides[1]),
-                           int(bstrides[2]),
-                           CTensor,
-                           int(clens[1]),
-                           int(clens[2]),
-                           int(clens[3]),
-                           int(cstrides[0]),
-                           int(cstrides[1]),
-                           int(cstrides[2]),
-                           miopen_alpha0,
-                           miopen_alpha1,
-                           miopen_beta,
-                           work_per_wg,
-                           long(Aoffset),
-                           long(Boffset),
-                           long(Coffset),
-                           int(num_wg_orig),
-                           bitmap);
-                    return;
-                }
-            }
-        }
-        else
-        {
-            auto&& kernels = handle.GetKernels("Op4dTensorGeneric", network_config);
+                const auto& kernel =
+                    *get_kernel("OpTensorFwdBiasGeneric", "USE_FWD_BIAS_GENERIC");
 
-            if(!kernels.empty())
-            {
-                auto kernel = kernels.front();
                 kernel(ATensor,
-                       int(astrides[0]), // a_nstride,
-                       int(astrides[1]), // a_cstride,
-                       int(astrides[2]), // a_hstride,
+                       int(astrides[0]),
+                       int(astrides[1]),
+                       int(astrides[2]),
                        BTensor,
-                       int(blens[1]),    // b_c,
-                       int(blens[2]),    // b_h,
-                       int(blens[3]),    // b_w,
-                       int(bstrides[0]), // b_nstride,
-                       int(bstrides[1]), // b_cstride,
-                       int(bstrides[2]), // b_hstride,
+                       int(blens[1]),
+                       int(bstrides[1]),
                        CTensor,
-                       int(clens[1]),    // c_c,
-                       int(clens[2]),    // c_h,
-                       int(clens[3]),    // c_w,
-                       int(cstrides[0]), // c_nstride,
-                       int(cstrides[1]), // c_cstride,
-                       int(cstrides[2]), // c_hstride,
+                       int(clens[0]),
+                       int(clens[3]),
+                       int(cstrides[0]),
+                       int(cstrides[1]),
+                       int(cstrides[2]),
                        miopen_alpha0,
                        miopen_alpha1,
                        miopen_beta,
-                       bitmap,
                        work_per_wg,
                        long(Aoffset),
                        long(Boffset),
                        long(Coffset),
-                       int(num_wg_orig));
-                return;
+                       int(num_wg_orig),
+                       int(incr_wg));
             }
         }
+        // precede leading_ones for bitmap = 1,1,1,1
+        else if(packed_equal_tensor)
+        {
+            auto key = get_key("Op4dTensorLite");
+            key.Add(local_threads).Add(grp_sz).Add(RD_BLCK);
 
-        std::string parms = " -DMIOPEN_TYPE=" + GetDataType(bTensorDesc.GetType()) +
-                            " -DMAX_NUM_WG=" + std::to_string(max_num_wg);
+            const KernelInvoke* kernel_ptr = handle.GetKernelInvoke(key);
 
-        parms += GetDataTypeKernelParams(aTensorDesc.GetType());
+            if(kernel_ptr == nullptr)
+            {
+                auto parms = get_parms();
+                parms += " -DUSE_4D_TENSOR_LITE";
+                parms += " -DRD_BLCK=" + std::to_string(RD_BLCK) + " -DREAD_TYPE=" + READ_TYPE;
 
-        parms += " -DMIOPEN_TENSOR_OP=";
-        switch(tensorOp)
-        {
-        case 0: parms += "miopenAdd"; break;
-        case 1: parms += "miopenMul"; break;
-        case 2: parms += "miopenMin"; break;
-        case 3: parms += "miopenMax"; break;
-        }
+                const std::vector<size_t> vgd1{glb_sz, 1, 1};
 
-        if(fwd_conv_bias != 0)
-        {
-            if(packed_tensor)
-            {
-                parms += " -DUSE_FWD_BIAS";
-
-                handle.AddKernel("OpTensorFwdBias",
-                                 network_config,
-                                 program_name,
-                                 "OpTensorFwdBias",
-                                 vld,
-                                 vgd,
-                                 parms)(ATensor,
-                                        BTensor,
-                                        int(blens[1]),
-                                        CTensor,
-                                        int(clens[0]),
-                                        int(cstrides[0]),
-                                        int(cstrides[1]),
-                                        work_per_wg,
-                                        miopen_alpha0,
-                                        miopen_alpha1,
-                                        miopen_beta,
-                                        long(Aoffset),
-                                        long(Boffset),
-                                        long(Coffset),
-                                        int(num_wg_orig),
-                                        int(incr_wg));
+                kernel_ptr =
+                    &handle.AddKernel(key, program_name, "Op4dTensorLite", vld, vgd1, parms);
             }
-            else
-            {
-                parms += " -DUSE_FWD_BIAS_GENERIC";
-                handle.AddKernel("OpTensorFwdBiasGeneric",
-                                 network_config,
-                                 program_name,
-                                 "OpTensorFwdBiasGeneric",
-                                 vld,
-                                 vgd,
-                                 parms)(ATensor,
-                                        int(astrides[0]),
-                                        int(astrides[1]),
-                                        int(astrides[2]),
-                                        BTensor,
-                                        int(blens[1]),
-                                        int(bstrides[1]),
-                                        CTensor,
-                                        int(clens[0]),
-                                        int(clens[3]),
-                                        int(cstrides[0]),
-                                        int(cstrides[1]),
-                                        int(cstrides[2]),
-                                        miopen_alpha0,
-                                        miopen_alpha1,
-                                        miopen_beta,
-                                        work_per_wg,
-                                        long(Aoffset),
-                                        long(Boffset),
-                                        long(Coffset),
-                                        int(num_wg_orig),
-                                        int(incr_wg));
-            }
-        }
-        // precede leading_ones for bitmap = 1,1,1,1
-        else if(packed_equal_tensor)
-        {
-            parms += " -DUSE_4D_TENSOR_LITE";
-            parms += " -DRD_BLCK=" + std::to_string(RD_BLCK) + " -DREAD_TYPE=" + READ_TYPE;
-
-            const std::vector<size_t> vgd1{glb_sz, 1, 1};
-
-            handle.AddKernel(
-                "Op4dTensorLite", network_config, program_name, "Op4dTensorLite", vld, vgd1, parms)(
-                ATensor,
-                BTensor,
-                CTensor,
-                miopen_alpha0,
-                miopen_alpha1,
-                miopen_beta,
-                long(Aoffset),
-                long(Boffset),
-                long(Coffset),
-                long(total_work),
-                int(!float_equal(miopen_beta, 0.0)));
+
+            const auto& kernel = *kernel_ptr;
+
+            kernel(ATensor,
+                   BTensor,
+                   CTensor,
+                   miopen_alpha0,
+                   miopen_alpha1,
+                   miopen_beta,
+                   long(Aoffset),
+                   long(Boffset),
+                   long(Coffset),
+                   long(total_work),
+                   int(!float_equal(miopen_beta, 0.0)));
         }
         else if(leading_ones)
         {
             if(packed_tensor)
             {
-                parms += " -DUSE_LEADING_ONES";
-                handle.AddKernel("OpTensorLeadingOnes",
-                                 network_config,
-                                 program_name,
-                                 "OpTensorLeadingOnes",
-                                 vld,
-                                 vgd,
-                                 parms)(ATensor,
-                                        BTensor,
-                                        CTensor,
-                                        int(clens[1]),
-                                        int(clens[2]),
-                                        int(clens[3]),
-                                        int(cstrides[0]),
-                                        int(cstrides[1]),
-                                        work_per_wg,
-                                        miopen_alpha0,
-                                        miopen_alpha1,
-                                        miopen_beta,
-                                        long(Aoffset),
-                                        long(Boffset),
-                                        long(Coffset),
-                                        int(num_wg_orig),
-                                        bitmap);
+                const auto& kernel = *get_kernel("OpTensorLeadingOnes", "USE_LEADING_ONES");
+
+                kernel(ATensor,
+                       BTensor,
+                       CTensor,
+                       int(clens[1]),
+                       int(clens[2]),
+                       int(clens[3]),
+                       int(cstrides[0]),
+                       int(cstrides[1]),
+                       work_per_wg,
+                       miopen_alpha0,
+                       miopen_alpha1,
+                       miopen_beta,
+                       long(Aoffset),
+                       long(Boffset),
+                       long(Coffset),
+                       int(num_wg_orig),
+                       bitmap);
             }
             else
             {
+                const auto& kernel =
+                    *get_kernel("OpTensorLeadingOnesGeneric", "USE_LEADING_ONES_GENERIC");
 
-                parms += " -DUSE_LEADING_ONES_GENERIC";
-
-                handle.AddKernel("OpTensorLeadingOnesGeneric",
-                                 network_config,
-                                 program_name,
-                                 "OpTensorLeadingOnesGeneric",
-                                 vld,
-                                 vgd,
-                                 parms)(ATensor,
-                                        int(astrides[0]),
-                                        int(astrides[1]),
-                                        int(astrides[2]),
-                                        BTensor,
-                                        int(bstrides[0]),
-                                        int(bstrides[1]),
-                                        int(bstrides[2]),
-                                        CTensor,
-                                        int(clens[1]),
-                                        int(clens[2]),
-                                        int(clens[3]),
-                                        int(cstrides[0]),
-                                        int(cstrides[1]),
-                                        int(cstrides[2]),
-                                        miopen_alpha0,
-                                        miopen_alpha1,
-                                        miopen_beta,
-                                        work_per_wg,
-                                        long(Aoffset),
-                                        long(Boffset),
-                                        long(Coffset),
-                                        int(num_wg_orig),
-                                        bitmap);
+                kernel(ATensor,
+                       int(astrides[0]),
+                       int(astrides[1]),
+                       int(astrides[2]),
+                       BTensor,
+                       int(bstrides[0]),
+                       int(bstrides[1]),
+                       int(bstrides[2]),
+                       CTensor,
+                       int(clens[1]),
+                       int(clens[2]),
+                       int(clens[3]),
+                       int(cstrides[0]),
+                       int(cstrides[1]),
+                       int(cstrides[2]),
+                       miopen_alpha0,
+                       miopen_alpha1,
+                       miopen_beta,
+                       work_per_wg,
+                       long(Aoffset),
+                       long(Boffset),
+                       long(Coffset),
+                       int(num_wg_orig),
+                       bitmap);
             }
         }
         else
         {
-            parms += " -DUSE_4D_TENSOR_GENERIC";
-
-            handle.AddKernel("Op4dTensorGeneric",
-                             network_config,
-                             program_name,
-                             "Op4dTensorGeneric",
-                             vld,
-                             vgd,
-                             parms)(ATensor,
-                                    int(astrides[0]), // a_nstride,
-                                    int(astrides[1]), // a_cstride,
-                                    int(astrides[2]), // a_hstride,
-                                    BTensor,
-                                    int(blens[1]),    // b_c,
-                                    int(blens[2]),    // b_h,
-                                    int(blens[3]),    // b_w,
-                                    int(bstrides[0]), // b_nstride,
-                                    int(bstrides[1]), // b_cstride,
-                                    int(bstrides[2]), // b_hstride,
-                                    CTensor,
-                                    int(clens[1]),    // c_c,
-                                    int(clens[2]),    // c_h,
-                                    int(clens[3]),    // c_w,
-                                    int(cstrides[0]), // c_nstride,
-                                    int(cstrides[1]), // c_cstride,
-                                    int(cstrides[2]), // c_hstride,
-                                    miopen_alpha0,
-                                    miopen_alpha1,
-                                    miopen_beta,
-                                    bitmap,
-                                    work_per_wg,
-                                    long(Aoffset),
-                                    long(Boffset),
-                                    long(Coffset),
-                                    int(num_wg_orig));
+            const auto& kernel = *get_kernel("Op4dTensorGeneric", "USE_4D_TENSOR_GENERIC");
+
+            kernel(ATensor,
+                   int(astrides[0]), // a_nstride,
+                   int(astrides[1]), // a_cstride,
+                   int(astrides[2]), // a_hstride,
+                   BTensor,
+                   int(blens[1]),    // b_c,
+                   int(blens[2]),    // b_h,
+                   int(blens[3]),    // b_w,
+                   int(bstrides[0]), // b_nstride,
+                   int(bstrides[1]), // b_cstride,
+                   int(bstrides[2]), // b_hstride,
+                   CTensor,
+                   int(clens[1]),    // c_c,
+                   int(clens[2]),    // c_h,
+                   int(clens[3]),    // c_w,
+                   int(cstrides[0]), // c_nstride,
+                   int(cstrides[1]), // c_cstride,
+                   int(cstrides[2]), // c_hstride,
+                   miopen_alpha0,
+                   miopen_alpha1,
+                   miopen_beta,
+                   bitmap,
+                   work_per_wg,
+                   long(Aoffset),
+                   long(Boffset),
+                   long(Coffset),
+                   int(num_wg_orig));
         }
     });
 }
@@ -1005,223 +720,121 @@ void OpTensorOther(const Handle& handle,
 
     const std::vector<size_t> vgd{global_threads, 1, 1};
 
-    std::string network_config{};
-    network_config += std::to_string(bTensorDesc.GetType()) + "-" +
-                      std::to_string(aTensorDesc.GetType()) + "-" + std::to_string(tensorOp) + "-" +
-                      std::to_string(global_threads) + "-" + std::to_string(local_threads);
+    const auto get_kernel = [&](const char* kernel_name, const char* define) {
+        auto key = TensorOpKey{kernel_name};
+        key.Add(bTensorDesc.GetType()).Add(aTensorDesc.GetType()).Add(tensorOp);
+        key.Add(global_threads).Add(local_threads);
 
-    visit_float(bTensorDesc.GetType(), [&](auto as_float) {
+        const KernelInvoke* kernel_ptr = handle.GetKernelInvoke(key);
 
-        auto miopen_alpha0 = as_float(*(static_cast<const float*>(alpha0)));
-        auto miopen_alpha1 = as_float(*(static_cast<const float*>(alpha1)));
-        auto miopen_beta   = as_float(*(static_cast<const float*>(beta)));
-
-        if(bsize == 5)
+        if(kernel_ptr == nullptr)
         {
-            auto&& kernels = handle.GetKernels("Op5dTensorGeneric", network_config);
+            std::string parms = " -DMIOPEN_TYPE=" + GetDataType(bTensorDesc.GetType()) +
+                                " -DMAX_NUM_WG=" + std::to_string(max_num_wg);
 
-            if(!kernels.empty())
-            {
-                auto kernel = kernels.front();
-                kernel(ATensor,
-                       int(astrides[0]),
-                       int(astrides[1]),
-                       int(astrides[2]),
-                       int(astrides[3]),
-                       BTensor,
-                       int(blens[1]),    // b_c,
-                       int(blens[2]),    // b_d,
-                       int(blens[3]),    // b_h,
-                       int(blens[4]),    // b_w,
-                       int(bstrides[0]), // b_nstride,
-                       int(bstrides[1]), // b_cstride,
-                       int(bstrides[2]), // b_dstride,
-                       int(bstrides[3]), // b_hstride,
-                       CTensor,
-                       int(clens[1]),    // c_c,
-                       int(clens[2]),    // c_d,
-                       int(clens[3]),    // c_h,
-                       int(clens[4]),    // c_w,
-                       int(cstrides[0]), // c_nstride,
-                       int(cstrides[1]), // c_cstride,
-                       int(cstrides[2]), // c_dstride,
-                       int(cstrides[3]), // c_hstride,
-                       miopen_alpha0,
-                       miopen_alpha1,
-                       miopen_beta,
-                       bitmap,
-                       work_per_wg,
-                       long(Aoffset),
-                       long(Boffset),
-                       long(Coffset),
-                       int(num_wg_orig));
-                return;
-            }
-        }
-        else if(bsize == 2)
-        {
-            auto&& kernels = handle.GetKernels("Op2dTensorGeneric", network_config);
+            parms += GetDataTypeKernelParams(aTensorDesc.GetType());
 
-            if(!kernels.empty())
+            parms += " -DMIOPEN_TENSOR_OP=";
+            switch(tensorOp)
             {
-                auto kernel = kernels.front();
-                kernel(ATensor,
-                       int(astrides[0]),
-                       BTensor,
-                       int(blens[1]),
-                       int(bstrides[0]),
-                       CTensor,
-                       int(clens[1]),
-                       int(cstrides[0]),
-                       miopen_alpha0,
-                       miopen_alpha1,
-                       miopen_beta,
-                       bitmap,
-                       work_per_wg,
-                       long(Aoffset),
-                       long(Boffset),
-                       long(Coffset),
-                       int(num_wg_orig));
-                return;
+            case 0: parms += "miopenAdd"; break;
+            case 1: parms += "miopenMul"; break;
+            case 2: parms += "miopenMin"; break;
+            case 3: parms += "miopenMax"; break;
             }
-        }
-        else if(bsize == 1)
-        {
-            auto&& kernels = handle.GetKernels("Op1dTensorGeneric", network_config);
 
-            if(!kernels.empty())
-            {
+            parms += std::string(" -D") + define;
 
-                auto kernel = kernels.front();
-                kernel(ATensor,
-                       BTensor,
-                       int(blens[0]),
-                       CTensor,
-                       int(clens[0]),
-                       miopen_alpha0,
-                       miopen_alpha1,
-                       miopen_beta,
-                       bitmap,
-                       work_per_wg,
-                       long(Aoffset),
-                       long(Boffset),
-                       long(Coffset),
-                       int(num_wg_orig));
-                return;
-            }
+            kernel_ptr = &handle.AddKernel(key, program_name, kernel_name, vld, vgd, parms);
         }
 
-        std::string parms = " -DMIOPEN_TYPE=" + GetDataType(bTensorDesc.GetType()) +
-                            " -DMAX_NUM_WG=" + std::to_string(max_num_wg);
+        return kernel_ptr;
+    };
 
-        parms += GetDataTypeKernelParams(aTensorDesc.GetType());
+    visit_float(bTensorDesc.GetType(), [&](auto as_float) {
 
-        parms += " -DMIOPEN_TENSOR_OP=";
-        switch(tensorOp)
-        {
-        case 0: parms += "miopenAdd"; break;
-        case 1: parms += "miopenMul"; break;
-        case 2: parms += "miopenMin"; break;
-        case 3: parms += "miopenMax"; break;
-        }
+        auto miopen_alpha0 = as_float(*(static_cast<const float*>(alpha0)));
+        auto miopen_alpha1 = as_float(*(static_cast<const float*>(alpha1)));
+        auto miopen_beta   = as_float(*(static_cast<const float*>(beta)));
 
         if(bsize == 5)
         {
-            parms += " -DUSE_5D_TENSOR_GENERIC";
-
-            handle.AddKernel("Op5dTensorGeneric",
-                             network_config,
-                             program_name,
-                             "Op5dTensorGeneric",
-                             vld,
-                             vgd,
-                             parms)(ATensor,
-                                    int(astrides[0]),
-                                    int(astrides[1]),
-                                    int(astrides[2]),
-                                    int(astrides[3]),
-                                    BTensor,
-                                    int(blens[1]),    // b_c,
-                                    int(blens[2]),    // b_d,
-                                    int(blens[3]),    // b_h,
-                                    int(blens[4]),    // b_w,
-                                    int(bstrides[0]), // b_nstride,
-                                    int(bstrides[1]), // b_cstride,
-                                    int(bstrides[2]), // b_dstride,
-                                    int(bstrides[3]), // b_hstride,
-                                    CTensor,
-                                    int(clens[1]),    // c_c,
-                                    int(clens[2]),    // c_d,
-                                    int(clens[3]),    // c_h,
-                                    int(clens[4]),    // c_w,
-                                    int(cstrides[0]), // c_nstride,
-                                    int(cstrides[1]), // c_cstride,
-                                    int(cstrides[2]), // c_dstride,
-                                    int(cstrides[3]), // c_hstride,
-                                    miopen_alpha0,
-                                    miopen_alpha1,
-                                    miopen_beta,
-                                    bitmap,
-                                    work_per_wg,
-                                    long(Aoffset),
-                                    long(Boffset),
-                                    long(Coffset),
-                                    int(num_wg_orig));
+            const auto& kernel = *get_kernel("Op5dTensorGeneric", "USE_5D_TENSOR_GENERIC");
+
+            kernel(ATensor,
+                   int(astrides[0]),
+                   int(astrides[1]),
+                   int(astrides[2]),
+                   int(astrides[3]),
+                   BTensor,
+                   int(blens[1]),    // b_c,
+                   int(blens[2]),    // b_d,
+                   int(blens[3]),    // b_h,
+                   int(blens[4]),    // b_w,
+                   int(bstrides[0]), // b_nstride,
+                   int(bstrides[1]), // b_cstride,
+                   int(bstrides[2]), // b_dstride,
+                   int(bstrides[3]), // b_hstride,
+                   CTensor,
+                   int(clens[1]),    // c_c,
+                   int(clens[2]),    // c_d,
+                   int(clens[3]),    // c_h,
+                   int(clens[4]),    // c_w,
+                   int(cstrides[0]), // c_nstride,
+                   int(cstrides[1]), // c_cstride,
+                   int(cstrides[2]), // c_dstride,
+                   int(cstrides[3]), // c_hstride,
+                   miopen_alpha0,
+                   miopen_alpha1,
+                   miopen_beta,
+                   bitmap,
+                   work_per_wg,
+                   long(Aoffset),
+                   long(Boffset),
+                   long(Coffset),
+                   int(num_wg_orig));
         }
         else if(bsize == 2)
         {
-            parms += " -DUSE_2D_TENSOR_GENERIC";
-
-            handle.AddKernel("Op2dTensorGeneric",
-                             network_config,
-                             program_name,
-                             "Op2dTensorGeneric",
-                             vld,
-                             vgd,
-                             parms)(ATensor,
-                                    int(astrides[0]),
-                                    BTensor,
-                                    int(blens[1]),
-                                    int(bstrides[0]),
-                                    CTensor,
-                                    int(clens[1]),
-                                    int(cstrides[0]),
-                                    miopen_alpha0,
-                                    miopen_alpha1,
-                                    miopen_beta,
-                                    bitmap,
-                                    work_per_wg,
-                                    long(Aoffset),
-                                    long(Boffset),
-                                    long(Coffset),
-                                    int(num_wg_orig));
+            const auto& kernel = *get_kernel("Op2dTensorGeneric", "USE_2D_TENSOR_GENERIC");
+
+            kernel(ATensor,
+                   int(astrides[0]),
+                   BTensor,
+                   int(blens[1]),
+                   int(bstrides[0]),
+                   CTensor,
+                   int(clens[1]),
+                   int(cstrides[0]),
+                   miopen_alpha0,
+                   miopen_alpha1,
+                   miopen_beta,
+                   bitmap,
+                   work_per_wg,
+                   long(Aoffset),
+                   long(Boffset),
+                   long(Coffset),
+                   int(num_wg_orig));
         }
         else if(bsize == 1)
         {
-            parms += " -DUSE_1D_TENSOR_GENERIC";
-
-            handle.AddKernel("Op1dTensorGeneric",
-                             network_config,
-                             program_name,
-                             "Op1dTensorGeneric",
-                             vld,
-                             vgd,
-                             parms)(ATensor,
-                                    BTensor,
-                                    int(blens[0]),
-                                    CTensor,
-                                    int(clens[0]),
-                                    miopen_alpha0,
-                                    miopen_alpha1,
-                                    miopen_beta,
-                                    bitmap,
-                                    work_per_wg,
-                                    long(Aoffset),
-                                    long(Boffset),
-                                    long(Coffset),
-                                    int(num_wg_orig));
-        }
+            const auto& kernel = *get_kernel("Op1dTensorGeneric", "USE_1D_TENSOR_GENERIC");
 
+            kernel(ATensor,
+                   BTensor,
+                   int(blens[0]),
+                   CTensor,
+                   int(clens[0]),
+                   miopen_alpha0,
+                   miopen_alpha1,
+                   miopen_beta,
+                   bitmap,
+                   work_per_wg,
+                   long(Aoffset),
+                   long(Boffset),
+                   long(Coffset),
+                   int(num_wg_orig));
+        }
     });
 }
 
@@ -1365,7 +978,8 @@ struct two_exp_ceiling_t
     }
 };
 
-static std::vector<std::size_t> get_worker_sizes(const std::vector<std::size_t>& data_sizes)
+template <class Range>
+static std::vector<std::size_t> get_worker_sizes(const Range& data_sizes)
 {
     const std::size_t dim = data_sizes.size();
 
@@ -1404,7 +1018,7 @@ void SetTensor(const Handle& handle,
         MIOPEN_THROW(miopenStatusBadParm);
     }
 
-    const TensorDescriptor yDesc_flat = GetFlattenedTensorDescriptor(yDesc);
+    const FlatTensor yDesc_flat = GetFlatTensor(yDesc);
 
 #ifndef NDEBUG
     if(yDesc.GetSize() != yDesc_flat.GetSize())
@@ -1419,26 +1033,17 @@ void SetTensor(const Handle& handle,
 
     assert(yDim_flat > 0 && yDim_flat <= 5);
 
-    std::string kernel_name = "SubTensorOpWithScalar" + std::to_string(yDim_flat) + "d";
-
     const miopenDataType_t dataType = yDesc_flat.GetType();
 
-    std::string network_config = "set " + std::to_string(dataType);
-    for(auto& len : yDesc_flat.GetLengths())
-    {
-        network_config += " " + std::to_string(len);
-    }
-
-    auto&& kernels = handle.GetKernels(kernel_name, network_config);
+    auto key = TensorOpKey{"set"};
+    key.Add(dataType).AddRange(yDesc_flat.GetLengths());
 
-    KernelInvoke kernel;
+    const KernelInvoke* kernel_ptr = handle.GetKernelInvoke(key);
 
-    if(!kernels.empty())
-    {
-        kernel = kernels.front();
-    }
-    else
+    if(kernel_ptr == nullptr)
     {
+        std::string kernel_name = "SubTensorOpWithScalar" + std::to_string(yDim_flat) + "d";
+
         std::string program_name = "MIOpenSubTensorOpWithScalarKernel.cl";
 
         std::vector<std::size_t> worker_sizes = get_worker_sizes(yDesc_flat.GetLengths());
@@ -1457,15 +1062,12 @@ void SetTensor(const Handle& handle,
             parms += " -DWORK_LENGTH_" + std::to_string(i) + "=" + std::to_string(worker_sizes[i]);
         }
 
-        kernel = handle.AddKernel(kernel_name,
-                                  network_config,
-                                  program_name,
-                                  kernel_name,
-                                  {wld, 1, 1},
-                                  {wgd, 1, 1},
-                                  parms);
+        kernel_ptr = &handle.AddKernel(
+            key, program_name, kernel_name, {wld, 1, 1}, {wgd, 1, 1}, parms);
     }
 
+    const auto& kernel = *kernel_ptr;
+
     switch(yDim_flat)
     {
     case 1:
@@ -1563,7 +1165,7 @@ void ScaleTensor(const Handle& handle,
         MIOPEN_THROW(miopenStatusBadParm);
     }
 
-    const TensorDescriptor yDesc_flat = GetFlattenedTensorDescriptor(yDesc);
+    const FlatTensor yDesc_flat = GetFlatTensor(yDesc);
 
 #ifndef NDEBUG
     if(yDesc.GetSize() != yDesc_flat.GetSize())
@@ -1585,26 +1187,17 @@ void ScaleTensor(const Handle& handle,
                      "Tensor scale operation is not supported for int8, int8x4, and bfloat16.");
     }
 
-    std::string kernel_name = "SubTensorOpWithScalar" + std::to_string(yDim_flat) + "d";
+    const auto lens = yDesc_flat.GetLengths();
 
-    const std::vector<std::size_t>& lens = yDesc_flat.GetLengths();
+    auto key = TensorOpKey{"scale"};
+    key.Add(dataType).AddRange(lens);
 
-    std::string network_config = "scale " + std::to_string(yDesc_flat.GetType());
-    for(auto& len : lens)
-    {
-        network_config += " " + std::to_string(len);
-    }
-
-    auto&& kernels = handle.GetKernels(kernel_name, network_config);
+    const KernelInvoke* kernel_ptr = handle.GetKernelInvoke(key);
 
-    KernelInvoke kernel;
-
-    if(!kernels.empty())
-    {
-        kernel = kernels.front();
-    }
-    else
+    if(kernel_ptr == nullptr)
     {
+        std::string kernel_name = "SubTensorOpWithScalar" + std::to_string(yDim_flat) + "d";
+
         std::string program_name = "MIOpenSubTensorOpWithScalarKernel.cl";
 
         std::vector<std::size_t> worker_sizes = get_worker_sizes(lens);
@@ -1623,15 +1216,12 @@ void ScaleTensor(const Handle& handle,
             parms += " -DWORK_LENGTH_" + std::to_string(i) + "=" + std::to_string(worker_sizes[i]);
         }
 
-        kernel = handle.AddKernel(kernel_name,
-                                  network_config,
-                                  program_name,
-                                  kernel_name,
-                                  {wld, 1, 1},
-                                  {wgd, 1, 1},
-                                  parms);
+        kernel_ptr = &handle.AddKernel(
+            key, program_name, kernel_name, {wld, 1, 1}, {wgd, 1, 1}, parms);
     }
 
+    const auto& kernel = *kernel_ptr;
+
     switch(yDim_flat)
     {
     case 1:
@@ -1741,9 +1331,9 @@ void CopyTensor(const Handle& handle,
         MIOPEN_THROW(miopenStatusBadParm, "Tensor dimension lengths do not match.");
     }
 
-    auto flat_descriptors = GetConsistentFlattenedTensorDescriptors(srcDesc, dstDesc);
-    const TensorDescriptor& srcDesc_flat = std::get<0>(flat_descriptors);
-    const TensorDescriptor& dstDesc_flat = std::get<1>(flat_descriptors);
+    const auto flat_descriptors    = GetConsistentFlatTensors(srcDesc, dstDesc);
+    const FlatTensor& srcDesc_flat = flat_descriptors[0];
+    const FlatTensor& dstDesc_flat = flat_descriptors[1];
 
 #ifndef NDEBUG
     if(srcDesc.GetSize() != srcDesc_flat.GetSize())
@@ -1765,26 +1355,18 @@ void CopyTensor(const Handle& handle,
 
     if(srcOffset > 0 || dstOffset > 0 || (!(srcDesc_flat.IsPacked() && dstDesc_flat.IsPacked())))
     {
-        std::string kernel_name = "SubTensorOpWithSubTensor" + std::to_string(srcDim_flat) + "d";
-
-        const std::vector<std::size_t>& lens = srcDesc_flat.GetLengths();
+        const auto lens = srcDesc_flat.GetLengths();
 
-        std::string network_config = "copy " + std::to_string(srcDesc_flat.GetType());
-        for(auto& len : lens)
-        {
-            network_config += " " + std::to_string(len);
-        }
-
-        auto&& kernels = handle.GetKernels(kernel_name, network_config);
+        auto key = TensorOpKey{"copy"};
+        key.Add(srcDesc_flat.GetType()).AddRange(lens);
 
-        KernelInvoke kernel;
+        const KernelInvoke* kernel_ptr = handle.GetKernelInvoke(key);
 
-        if(!kernels.empty())
-        {
-            kernel = kernels.front();
-        }
-        else
+        if(kernel_ptr == nullptr)
         {
+            std::string kernel_name =
+                "SubTensorOpWithSubTensor" + std::to_string(srcDim_flat) + "d";
+
             std::string program_name = "MIOpenSubTensorOpWithSubTensorKernel.cl";
 
             std::vector<std::size_t> worker_sizes = get_worker_sizes(lens);
@@ -1804,15 +1386,12 @@ void CopyTensor(const Handle& handle,
                     " -DWORK_LENGTH_" + std::to_string(i) + "=" + std::to_string(worker_sizes[i]);
             }
 
-            kernel = handle.AddKernel(kernel_name,
-                                      network_config,
-                                      program_name,
-                                      kernel_name,
-                                      {wld, 1, 1},
-                                      {wgd, 1, 1},
-                                      parms);
+            kernel_ptr = &handle.AddKernel(
+                key, program_name, kernel_name, {wld, 1, 1}, {wgd, 1, 1}, parms);
         }
 
+        const auto& kernel = *kernel_ptr;
+
         switch(srcDim_flat)
         {
         case 1:
@@ -1957,9 +1536,9 @@ void CastTensor(const Handle& handle,
         MIOPEN_THROW(miopenStatusBadParm, "Tensor cast operation is not supported for int8x4.");
     }
 
-    auto flat_descriptors = GetConsistentFlattenedTensorDescriptors(srcDesc, dstDesc);
-    const TensorDescriptor& srcDesc_flat = std::get<0>(flat_descriptors);
-    const TensorDescriptor& dstDesc_flat = std::get<1>(flat_descriptors);
+    const auto flat_descriptors    = GetConsistentFlatTensors(srcDesc, dstDesc);
+    const FlatTensor& srcDesc_flat = flat_descriptors[0];
+    const FlatTensor& dstDesc_flat = flat_descriptors[1];
 
 #ifndef NDEBUG
     if(srcDesc.GetSize() != srcDesc_flat.GetSize())
@@ -1986,27 +1565,20 @@ void CastTensor(const Handle& handle,
     }
     else
     {
-        std::string kernel_name = "SubTensorOpWithCastTensor" + std::to_string(srcDim_flat) + "d";
+        const auto lens = srcDesc_flat.GetLengths();
 
-        const std::vector<std::size_t>& lens = srcDesc_flat.GetLengths();
-
-        std::string network_config = "cast " + std::to_string(dstDesc_flat.GetType());
-        for(auto& len : lens)
-        {
-            network_config += " " + std::to_string(len);
-        }
+        auto key = TensorOpKey{"cast"};
+        key.Add(srcDesc_flat.GetType()).Add(dstDesc_flat.GetType()).AddRange(lens);
 
-        auto&& kernels = handle.GetKernels(kernel_name, network_config);
-        KernelInvoke kernel;
+        const KernelInvoke* kernel_ptr = handle.GetKernelInvoke(key);
 
         auto miopen_alpha = *(static_cast<const float*>(alpha));
 
-        if(!kernels.empty())
-        {
-            kernel = kernels.front();
-        }
-        else
+        if(kernel_ptr == nullptr)
         {
+            std::string kernel_name =
+                "SubTensorOpWithCastTensor" + std::to_string(srcDim_flat) + "d";
+
             std::string program_name = "MIOpenSubTensorOpWithCastTensorKernel.cl";
 
             std::vector<std::size_t> worker_sizes = get_worker_sizes(lens);
@@ -2033,15 +1605,12 @@ void CastTensor(const Handle& handle,
                 parms += " -DMIOPEN_USE_RNE_BFLOAT16=1";
             }
 
-            kernel = handle.AddKernel(kernel_name,
-                                      network_config,
-                                      program_name,
-                                      kernel_name,
-                                      {wld, 1, 1},
-                                      {wgd, 1, 1},
-                                      parms);
+            kernel_ptr = &handle.AddKernel(
+                key, program_name, kernel_name, {wld, 1, 1}, {wgd, 1, 1}, parms);
         }
 
+        const auto& kernel = *kernel_ptr;
+
         switch(srcDim_flat)
         {
         case 1:
@@ -2164,8 +1733,8 @@ void TransformTensor(const Handle& handle,
         MIOPEN_THROW(miopenStatusBadParm);
     }
 
-    auto x_len = xDesc.GetLengths();
-    auto y_len = yDesc.GetLengths();
+    const auto& x_len = xDesc.GetLengths();
+    const auto& y_len = yDesc.GetLengths();
 
     if(x_len.size() != y_len.size())
     {
@@ -2196,12 +1765,14 @@ void TransformTensor(const Handle& handle,
 
         size_t batch_n = x_len[0];
 
-        x_len[0] = 1;
-        y_len[0] = 1;
+        auto x_batch_len = x_len;
+        auto y_batch_len = y_len;
+        x_batch_len[0]   = 1;
+        y_batch_len[0]   = 1;
 
         miopen::TensorDescriptor x_batch_desc, y_batch_desc;
-        x_batch_desc = miopen::TensorDescriptor(miopenInt8, x_len);
-        y_batch_desc = miopen::TensorDescriptor(miopenInt8, y_len);
+        x_batch_desc = miopen::TensorDescriptor(miopenInt8, x_batch_len);
+        y_batch_desc = miopen::TensorDescriptor(miopenInt8, y_batch_len);
 
         size_t x_batch_sz = x_batch_desc.GetElementSize();
         size_t y_batch_sz = y_batch_desc.GetElementSize();
@@ -2258,9 +1829,9 @@ void TransformTensor(const Handle& handle,
             MIOPEN_THROW("Tensor x and y spatial sizes do not match");
         }
 
-        auto flat_descriptors              = GetConsistentFlattenedTensorDescriptors(xDesc, yDesc);
-        const TensorDescriptor& xDesc_flat = std::get<0>(flat_descriptors);
-        const TensorDescriptor& yDesc_flat = std::get<1>(flat_descriptors);
+        const auto flat_descriptors  = GetConsistentFlatTensors(xDesc, yDesc);
+        const FlatTensor& xDesc_flat = flat_descriptors[0];
+        const FlatTensor& yDesc_flat = flat_descriptors[1];
 
 #ifndef NDEBUG
         if(xDesc.GetSize() != xDesc_flat.GetSize())
@@ -2300,26 +1871,17 @@ void TransformTensor(const Handle& handle,
             MIOPEN_THROW("Tensor x and y have different data types");
         }
 
-        std::string kernel_name = "SubTensorOpWithTransform" + std::to_string(yDim_flat) + "d";
-
-        const std::vector<std::size_t>& lens = yDesc_flat.GetLengths();
-
-        std::string network_config = "transform " + std::to_string(yDesc_flat.GetType());
-        for(auto& len : lens)
-        {
-            network_config += "x" + std::to_string(len);
-        }
+        const auto lens = yDesc_flat.GetLengths();
 
-        auto&& kernels = handle.GetKernels(kernel_name, network_config);
+        auto key = TensorOpKey{"transform"};
+        key.Add(yDesc_flat.GetType()).AddRange(lens);
 
-        KernelInvoke kernel;
+        const KernelInvoke* kernel_ptr = handle.GetKernelInvoke(key);
 
-        if(!kernels.empty())
-        {
-            kernel = kernels.front();
-        }
-        else
+        if(kernel_ptr == nullptr)
         {
+            std::string kernel_name = "SubTensorOpWithTransform" + std::to_string(yDim_flat) + "d";
+
             std::string program_name = "MIOpenSubTensorOpWithTransformKernel.cl";
 
             std::vector<std::size_t> worker_sizes = get_worker_sizes(lens);
@@ -2340,15 +1902,12 @@ void TransformTensor(const Handle& handle,
                     " -DWORK_LENGTH_" + std::to_string(i) + "=" + std::to_string(worker_sizes[i]);
             }
 
-            kernel = handle.AddKernel(kernel_name,
-                                      network_config,
-                                      program_name,
-                                      kernel_name,
-                                      {wld, 1, 1},
-                                      {wgd, 1, 1},
-                                      parms);
+            kernel_ptr = &handle.AddKernel(
+                key, program_name, kernel_name, {wld, 1, 1}, {wgd, 1, 1}, parms);
         }
 
+        const auto& kernel = *kernel_ptr;
+
         switch(yDim_flat)
         {
         case 1:
@@ -34,12 +34,20 @@
 
 #include <boost/filesystem.hpp>
 #include <boost/filesystem/path.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
 
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
 #include <fstream>
+#include <iterator>
 #include <mutex>
-#include <sstream>
 #include <map>
 
+#include <unistd.h>
+
 namespace miopen {
 extern boost::optional<std::string>&
 testing_find_db_path_override(); /// \todo Remove when #1723 is resolved.
@@ -72,42 +80,255 @@ ReadonlyRamDb& ReadonlyRamDb::GetCached(const std::string& path,
     return *instance;
 }
 
+static std::size_t GetResidentMemory()
+{
+#ifdef __linux__
+    auto statm        = std::ifstream{"/proc/self/statm"};
+    std::size_t total = 0, resident = 0;
+    if(statm >> total >> resident)
+        return resident * static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+#endif
+    return 0;
+}
+
 template <class TFunc>
 static auto Measure(const std::string& funcName, TFunc&& func)
 {
     if(!miopen::IsLogging(LoggingLevel::Info))
         return func();
 
-    const auto start = std::chrono::high_resolution_clock::now();
+    const auto start_rss = static_cast<long long>(GetResidentMemory());
+    const auto start     = std::chrono::high_resolution_clock::now();
     func();
-    const auto end = std::chrono::high_resolution_clock::now();
-    MIOPEN_LOG_I("Db::" << funcName << " time: " << (end - start).count() * .000001f << " ms");
+    const auto end     = std::chrono::high_resolution_clock::now();
+    const auto end_rss = static_cast<long long>(GetResidentMemory());
+    MIOPEN_LOG_I("Db::" << funcName << " time: " << (end - start).count() * .000001f
+                        << " ms, resident memory change: "
+                        << (end_rss - start_rss) / 1024
+                        << " KiB");
+}
+
+static std::size_t HashKey(boost::string_view key)
+{
+    // FNV-1a
+    std::uint64_t hash = 14695981039346656037ull;
+    for(const auto c : key)
+    {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ull;
+    }
+    return static_cast<std::size_t>(hash);
+}
+
+const ReadonlyRamDb::CacheItem* ReadonlyRamDb::Lookup(boost::string_view key) const
+{
+    if(cache.empty() || key.empty())
+        return nullptr;
+
+    const auto mask = cache.size() - 1;
+    for(auto slot = HashKey(key) & mask;; slot = (slot + 1) & mask)
+    {
+        const auto& item = cache[slot];
+        if(item.key.empty())
+            return nullptr;
+        if(item.key == key)
+            return &item;
+    }
+}
+
+void ReadonlyRamDb::Insert(const CacheItem& item)
+{
+    const auto mask = cache.size() - 1;
+    for(auto slot = HashKey(item.key) & mask;; slot = (slot + 1) & mask)
+    {
+        auto& existing = cache[slot];
+        if(existing.key.empty())
+        {
+            existing = item;
+            ++records_count;
+            return;
+        }
+        // The first occurrence of a key wins.
+        if(existing.key == item.key)
+            return;
+    }
+}
+
+bool ReadonlyRamDb::ParseRecord(std::size_t slot, DbRecord& record) const
+{
+    if(binary)
+    {
+        auto values = binary_db::Reader::Values{};
+        if(!binary->Read(slot, values))
+        {
+            MIOPEN_LOG_E("Error reading payload under the key: " << record.GetKey() << " from file "
+                                                                 << db_path
+                                                                 << ", record #"
+                                                                 << slot);
+            return false;
+        }
+
+        // No values, as in "KEY=", is the same as no record.
+        if(values.empty())
+            return false;
+
+        for(const auto& value : values)
+            record.map.emplace(value.first.to_string(), value.second.to_string());
+        return true;
+    }
+
+    const auto& item = cache[slot];
+    MIOPEN_LOG_I2("Contents found: " << item.content);
+
+    if(item.content.empty())
+        return false;
+
+    if(!record.ParseContents(item.content.to_string()))
+    {
+        MIOPEN_LOG_E("Error parsing payload under the key: " << record.GetKey() << " form file "
+                                                             << db_path
+                                                             << "#"
+                                                             << item.line);
+        MIOPEN_LOG_E("Contents: " << item.content);
+        return false;
+    }
+
+    return true;
 }
 
-void ReadonlyRamDb::ParseAndLoadDb(std::istream& input_stream,
-                                   const std::string& path,
-                                   bool warn_if_unreadable)
+std::shared_ptr<const DbRecord> ReadonlyRamDb::FindParsed(const std::string& problem) const
 {
-    if(!input_stream)
+    MIOPEN_LOG_I2("Looking for key " << problem << " in file " << db_path);
+    auto slot = std::size_t{0};
+
+    if(binary)
     {
-        const auto log_level = (warn_if_unreadable && !MIOPEN_DISABLE_SYSDB) ? LoggingLevel::Warning
-                                                                             : LoggingLevel::Info;
-        MIOPEN_LOG(log_level, "File is unreadable: " << path);
+        const auto found = binary->Find(problem);
+        if(!found)
+            return nullptr;
+        slot = *found;
+    }
+    else
+    {
+        const auto item = Lookup(problem);
+        if(item == nullptr)
+            return nullptr;
+        slot = static_cast<std::size_t>(item - cache.data());
+    }
+
+    MIOPEN_LOG_I2("Key match: " << problem);
+
+    {
+        const std::shared_lock<std::shared_timed_mutex> lock{parsed_mutex};
+        const auto memoized = parsed.find(slot);
+        if(memoized != parsed.end())
+            return memoized->second;
+    }
+
+    // Parsed outside of the lock. If another thread has got here first, its record is kept.
+    auto record = std::shared_ptr<DbRecord>{new DbRecord{problem}};
+    if(!ParseRecord(slot, *record))
+        record = nullptr;
+
+    const std::unique_lock<std::shared_timed_mutex> lock{parsed_mutex};
+    return parsed.emplace(slot, std::move(record)).first->second;
+}
+
+static void LogUnreadable(const std::string& path, bool warn_if_unreadable)
+{
+    const auto log_level = (warn_if_unreadable && !MIOPEN_DISABLE_SYSDB) ? LoggingLevel::Warning
+                                                                         : LoggingLevel::Info;
+    MIOPEN_LOG(log_level, "File is unreadable: " << path);
+}
+
+/// Maps the file into memory. Falls back to reading it if mapping fails. The returned bytes
+/// are kept alive by the storage.
+static boost::string_view
+MapFile(const std::string& path, bool warn_if_unreadable, std::shared_ptr<const void>& storage)
+{
+    boost::system::error_code ec;
+    const auto size = boost::filesystem::file_size(path, ec);
+
+    if(ec)
+    {
+        LogUnreadable(path, warn_if_unreadable);
+        return {};
+    }
+
+    if(size == 0)
+        return {};
+
+    try
+    {
+        using namespace boost::interprocess;
+        const file_mapping mapping(path.c_str(), read_only);
+        const auto region = std::make_shared<const mapped_region>(
+            mapping, read_only, 0, static_cast<std::size_t>(size));
+        storage = region;
+        return {static_cast<const char*>(region->get_address()), region->get_size()};
+    }
+    catch(const boost::interprocess::interprocess_exception& ex)
+    {
+        MIOPEN_LOG_I("Unable to map " << path << ", reading it instead: " << ex.what());
+    }
+
+    auto file = std::ifstream{path, std::ios::binary};
+    if(!file)
+    {
+        LogUnreadable(path, warn_if_unreadable);
+        return {};
+    }
+
+    const auto buffer = std::make_shared<const std::string>(std::istreambuf_iterator<char>{file},
+                                                            std::istreambuf_iterator<char>{});
+    storage = buffer;
+    return *buffer;
+}
+
+void ReadonlyRamDb::ParseAndLoadDb(boost::string_view contents, const std::string& path)
+{
+    if(binary_db::IsBinary(contents))
+    {
+        try
+        {
+            binary.emplace(contents);
+            MIOPEN_LOG_I2("Loaded " << binary->Size() << " records of binary db " << path);
+        }
+        catch(const Exception& ex)
+        {
+            MIOPEN_LOG_E("Unable to load " << path << ": " << ex.what());
+            binary = boost::none;
+        }
         return;
     }
 
-    auto line   = std::string{};
-    auto n_line = 0;
+    const auto data = contents.data();
+    const auto size = contents.size();
 
-    while(std::getline(input_stream, line))
+    // Keep the table at most half full to have short probe sequences.
+    const auto lines = static_cast<std::size_t>(std::count(data, data + size, '\n')) + 1;
+    auto capacity    = std::size_t{16};
+    while(capacity < lines * 2)
+        capacity *= 2;
+    cache.assign(capacity, CacheItem{});
+
+    auto n_line       = 0;
+    std::size_t begin = 0;
+
+    while(begin < size)
     {
+        const auto eol =
+            static_cast<const char*>(std::memchr(data + begin, '\n', size - begin));
+        const auto end  = eol == nullptr ? size : static_cast<std::size_t>(eol - data);
+        const auto line = contents.substr(begin, end - begin);
+        begin           = end + 1;
         ++n_line;
 
         if(line.empty())
             continue;
 
         const auto key_size = line.find('=');
-        const bool is_key   = (key_size != std::string::npos && key_size != 0);
+        const bool is_key   = (key_size != boost::string_view::npos && key_size != 0);
 
         if(!is_key)
         {
@@ -115,11 +336,16 @@ void ReadonlyRamDb::ParseAndLoadDb(std::istream& input_stream,
             continue;
         }
 
-        const auto key      = line.substr(0, key_size);
-        const auto contents = line.substr(key_size + 1);
-
-        cache.emplace(key, CacheItem{n_line, contents});
+        auto item    = CacheItem{};
+        item.key     = line.substr(0, key_size);
+        item.content = line.substr(key_size + 1);
+        item.line    = n_line;
+        Insert(item);
     }
+
+    MIOPEN_LOG_I2("Indexed " << records_count << " records of " << path << ", index size: "
+                             << cache.size() * sizeof(CacheItem) / 1024
+                             << " KiB");
 }
 
 void ReadonlyRamDb::Prefetch(const std::string& path, bool warn_if_unreadable)
@@ -138,15 +364,15 @@ void ReadonlyRamDb::Prefetch(const std::string& path, bool warn_if_unreadable)
 
             const auto& p = it_p->second;
             ptrdiff_t sz  = p.second - p.first;
-            MIOPEN_LOG_I2("Loading In Memory file: " << filepath);
-            auto input_stream = std::stringstream(std::string(p.first, sz));
-            ParseAndLoadDb(input_stream, path, warn_if_unreadable);
+            MIOPEN_LOG_I2("Using In Memory file: " << filepath);
+            // Embedded data lives as long as the library, so it is indexed in place.
+            ParseAndLoadDb({p.first, static_cast<std::size_t>(sz)}, path);
 #endif
         }
         else
         {
-            auto input_stream = std::ifstream{path};
-            ParseAndLoadDb(input_stream, path, warn_if_unreadable);
+            const auto contents = MapFile(path, warn_if_unreadable, storage);
+            ParseAndLoadDb(contents, path);
         }
 
     });
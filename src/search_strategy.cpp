@@ -0,0 +1,381 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/search_strategy.hpp>
+
+#include <miopen/env.hpp>
+#include <miopen/logger.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <numeric>
+#include <ostream>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_TUNING_STRATEGY)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_TUNING_MAX_TRIALS)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_TUNING_MAX_TIME)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_TUNING_PATIENCE)
+
+namespace miopen {
+namespace solver {
+
+namespace {
+
+const char* ToCString(const SearchStrategy strategy)
+{
+    switch(strategy)
+    {
+    case SearchStrategy::Exhaustive: return "EXHAUSTIVE";
+    case SearchStrategy::Random: return "RANDOM";
+    case SearchStrategy::SuccessiveHalving: return "HALVING";
+    case SearchStrategy::Annealing: return "ANNEALING";
+    }
+    return "<Unknown>";
+}
+
+class Search
+{
+    public:
+    Search(const SearchBudget& budget_, SearchEvaluator& evaluator_, const TimingPolicy& policy_)
+        : budget(budget_),
+          evaluator(evaluator_),
+          policy(policy_),
+          start(std::chrono::steady_clock::now())
+    {
+    }
+
+    const SearchBudget& GetBudget() const { return budget; }
+    const SearchResult& GetResult() const { return result; }
+
+    bool IsOver() const
+    {
+        if(budget.max_trials != 0 && result.n_trials >= budget.max_trials)
+            return true;
+        if(budget.patience != 0 && n_not_improved >= budget.patience)
+            return true;
+        return budget.max_time.count() != 0 &&
+               std::chrono::steady_clock::now() - start >= budget.max_time;
+    }
+
+    /// Number of configs Random and Annealing measure.
+    std::size_t GetTrials(std::size_t n_configs) const
+    {
+        if(budget.max_trials != 0)
+            return std::min(n_configs, budget.max_trials);
+        return std::max(n_configs / 10, std::min<std::size_t>(n_configs, 100));
+    }
+
+    void Prepare(const std::vector<std::size_t>& indices) { evaluator.Prepare(indices); }
+
+    /// Times the config with the policy. A config whose first run is clearly worse than the
+    /// best one is not run again and cannot become the best. Returns the time or infinity if
+    /// the config has failed.
+    float Trial(std::size_t index)
+    {
+        auto timing          = TimingResult{};
+        const auto is_failed = !evaluator.Time(index, policy, result.best_time, timing);
+        auto improved        = false;
+
+        if(!is_failed)
+        {
+            MIOPEN_LOG_I2('#' << index << ' ' << timing.statistic << " of " << timing.runs
+                              << " runs: "
+                              << timing.time
+                              << ", variance: "
+                              << timing.variance);
+            result.is_passed = true;
+            improved         = Update(index, timing.time);
+        }
+
+        return Record(index, is_failed, timing.time, improved);
+    }
+
+    /// Runs the config `runs` times and returns the average time or infinity if the config
+    /// has failed.
+    float Measure(std::size_t index, std::size_t runs)
+    {
+        auto time            = 0.0f;
+        const auto is_failed = !evaluator.Run(index, runs, time);
+        auto improved        = false;
+
+        if(!is_failed)
+        {
+            time /= runs;
+            result.is_passed = true;
+            improved         = Update(index, time);
+        }
+
+        return Record(index, is_failed, time, improved);
+    }
+
+    void SetBest(std::size_t index, float time)
+    {
+        result.best      = index;
+        result.best_time = time;
+    }
+
+    private:
+    const SearchBudget& budget;
+    SearchEvaluator& evaluator;
+    const TimingPolicy& policy;
+    std::chrono::steady_clock::time_point start;
+    SearchResult result;
+    std::size_t n_not_improved = 0;
+
+    bool Update(std::size_t index, float time)
+    {
+        if(time >= result.best_time)
+        {
+            MIOPEN_LOG_I2("Time is not better: " << time << " >= " << result.best_time);
+            return false;
+        }
+        MIOPEN_LOG_I('#' << index << ' ' << time << " < " << result.best_time);
+        SetBest(index, time);
+        return true;
+    }
+
+    float Record(std::size_t index, bool is_failed, float time, bool improved)
+    {
+        ++result.n_trials;
+        if(is_failed)
+        {
+            MIOPEN_LOG_E('#' << index << " Failed");
+            ++result.n_failed;
+        }
+        n_not_improved = improved ? 0 : n_not_improved + 1;
+        evaluator.OnTrial(index, is_failed, is_failed ? 0.0f : time, result);
+        return is_failed ? std::numeric_limits<float>::infinity() : time;
+    }
+};
+
+std::vector<std::size_t> GetIndices(std::size_t n_configs)
+{
+    auto indices = std::vector<std::size_t>(n_configs);
+    std::iota(indices.begin(), indices.end(), 0);
+    return indices;
+}
+
+void SearchExhaustive(Search& search, std::size_t n_configs)
+{
+    auto indices = GetIndices(n_configs);
+    if(search.GetBudget().max_trials != 0 && search.GetBudget().max_trials < n_configs)
+        indices.resize(search.GetBudget().max_trials);
+
+    search.Prepare(indices);
+    for(const auto index : indices)
+    {
+        if(search.IsOver())
+            break;
+        search.Trial(index);
+    }
+}
+
+void SearchRandom(Search& search, std::size_t n_configs, std::mt19937& rng)
+{
+    auto indices = GetIndices(n_configs);
+    std::shuffle(indices.begin(), indices.end(), rng);
+    indices.resize(search.GetTrials(n_configs));
+
+    search.Prepare(indices);
+    for(const auto index : indices)
+    {
+        if(search.IsOver())
+            break;
+        search.Trial(index);
+    }
+}
+
+void SearchSuccessiveHalving(Search& search, std::size_t n_configs, std::mt19937& rng)
+{
+    // The rungs take about twice as many trials as there are configs in the first one.
+    const auto max_trials = search.GetBudget().max_trials;
+    auto candidates       = GetIndices(n_configs);
+    std::shuffle(candidates.begin(), candidates.end(), rng);
+    if(max_trials != 0)
+        candidates.resize(std::min(n_configs, std::max<std::size_t>(max_trials / 2, 1)));
+
+    search.Prepare(candidates);
+    for(std::size_t runs = 1;; runs *= 2)
+    {
+        auto measured = std::vector<std::pair<float, std::size_t>>{};
+        auto is_over  = false;
+
+        for(const auto index : candidates)
+        {
+            is_over = search.IsOver();
+            if(is_over)
+                break;
+            const auto time = search.Measure(index, runs);
+            if(std::isfinite(time))
+                measured.emplace_back(time, index);
+        }
+
+        if(measured.empty())
+            return;
+
+        std::sort(measured.begin(), measured.end());
+        if(measured.size() == 1 || is_over)
+        {
+            // The survivor has been measured with the most runs, which is more accurate than
+            // a lucky single run in the first rung.
+            search.SetBest(measured.front().second, measured.front().first);
+            return;
+        }
+
+        candidates.clear();
+        for(std::size_t i = 0; i < (measured.size() + 1) / 2; ++i)
+            candidates.push_back(measured[i].second);
+    }
+}
+
+void SearchAnnealing(Search& search, std::size_t n_configs, std::mt19937& rng)
+{
+    const auto n_trials   = search.GetTrials(n_configs);
+    const auto max_radius = std::max<std::size_t>(n_configs / 8, 1);
+    const auto cooling    = std::pow(0.01, 1.0 / static_cast<double>(n_trials));
+    auto temperature      = 1.0;
+    auto any_config       = std::uniform_int_distribution<std::size_t>{0, n_configs - 1};
+    auto probability      = std::uniform_real_distribution<double>{0.0, 1.0};
+    auto times            = std::unordered_map<std::size_t, float>{};
+
+    // The walk decides on the next config only after the current one is measured, so the configs
+    // are prepared one at a time. Preparing the whole neighbourhood would build far more configs
+    // than the walk visits while the radius is large.
+    auto current = any_config(rng);
+    search.Prepare({current});
+    auto current_time = search.Trial(current);
+    times.emplace(current, current_time);
+
+    // Revisiting known configs does not take trials, so limit the walk as well.
+    for(std::size_t step = 0; step < 10 * n_trials && times.size() < n_trials; ++step)
+    {
+        if(search.IsOver())
+            break;
+
+        const auto radius = std::max<std::size_t>(
+            static_cast<std::size_t>(static_cast<double>(max_radius) * temperature), 1);
+        const auto offset = std::uniform_int_distribution<std::size_t>{1, radius}(rng);
+        const auto next   = probability(rng) < 0.5
+                              ? (current >= offset ? current - offset : 0)
+                              : std::min(current + offset, n_configs - 1);
+        if(next == current)
+            continue;
+
+        auto next_time   = std::numeric_limits<float>::infinity();
+        const auto known = times.find(next);
+        if(known != times.end())
+        {
+            next_time = known->second;
+        }
+        else
+        {
+            search.Prepare({next});
+            next_time = search.Trial(next);
+            times.emplace(next, next_time);
+            temperature *= cooling;
+        }
+
+        // Accepts a slower config with the probability that decreases with the temperature
+        // and the relative slowdown.
+        const auto accept =
+            next_time < current_time ||
+            (std::isfinite(next_time) &&
+             probability(rng) <
+                 std::exp(-(next_time - current_time) / (current_time * temperature)));
+        if(accept)
+        {
+            current      = next;
+            current_time = next_time;
+        }
+    }
+}
+
+} // namespace
+
+std::ostream& operator<<(std::ostream& os, const SearchStrategy strategy)
+{
+    return os << ToCString(strategy);
+}
+
+SearchStrategy GetSearchStrategy(const SearchStrategy solver_default)
+{
+    const char* const p_asciz = miopen::GetStringEnv(MIOPEN_DEBUG_TUNING_STRATEGY{});
+    if(p_asciz == nullptr || *p_asciz == '\0')
+        return solver_default;
+    std::string str = p_asciz;
+    for(auto& c : str)
+        c = toupper(static_cast<unsigned char>(c));
+    for(const auto strategy : {SearchStrategy::Exhaustive,
+                               SearchStrategy::Random,
+                               SearchStrategy::SuccessiveHalving,
+                               SearchStrategy::Annealing})
+    {
+        if(str == ToCString(strategy))
+            return strategy;
+    }
+    MIOPEN_LOG_NQE("Wrong MIOPEN_DEBUG_TUNING_STRATEGY, using " << solver_default << '.');
+    return solver_default;
+}
+
+SearchBudget SearchBudget::FromEnv()
+{
+    auto budget       = SearchBudget{};
+    budget.max_trials = miopen::Value(MIOPEN_DEBUG_TUNING_MAX_TRIALS{});
+    budget.max_time   = std::chrono::seconds{miopen::Value(MIOPEN_DEBUG_TUNING_MAX_TIME{})};
+    budget.patience   = miopen::Value(MIOPEN_DEBUG_TUNING_PATIENCE{});
+    return budget;
+}
+
+SearchResult RunSearch(const SearchStrategy strategy,
+                       const SearchBudget& budget,
+                       const std::size_t n_configs,
+                       SearchEvaluator& evaluator,
+                       const TimingPolicy& policy)
+{
+    auto search = Search{budget, evaluator, policy};
+    if(n_configs == 0)
+        return search.GetResult();
+
+    // Fixed seed keeps tuning results reproducible.
+    auto rng = std::mt19937{}; // NOLINT (cert-msc32-c, cert-msc51-cpp)
+
+    switch(strategy)
+    {
+    case SearchStrategy::Exhaustive: SearchExhaustive(search, n_configs); break;
+    case SearchStrategy::Random: SearchRandom(search, n_configs, rng); break;
+    case SearchStrategy::SuccessiveHalving: SearchSuccessiveHalving(search, n_configs, rng); break;
+    case SearchStrategy::Annealing: SearchAnnealing(search, n_configs, rng); break;
+    }
+    return search.GetResult();
+}
+
+} // namespace solver
+} // namespace miopen
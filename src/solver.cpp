@@ -33,10 +33,13 @@
 #include <miopen/par_for.hpp>
 #include <miopen/stringutils.hpp>
 #include <miopen/any_solver.hpp>
+#include <miopen/binary_cache.hpp>
 #include <miopen/timer.hpp>
 
 #include <boost/range/adaptor/transformed.hpp>
 #include <ostream>
+#include <set>
+#include <utility>
 
 namespace miopen {
 namespace solver {
@@ -58,34 +61,50 @@ std::vector<Program> PrecompileKernels(const Handle& h, const std::vector<Kernel
 {
     CompileTimer ct;
     std::vector<Program> programs(kernels.size());
+    // The built binaries are saved into the kernel cache at once.
+    BinaryCacheBatch binaries;
 
     // clang-format off
     par_for_strided(kernels.size(),
                     max_threads{Value(MIOPEN_COMPILE_PARALLEL_LEVEL{}, 20)},
                     [&](auto i) {
+                        const BinaryCacheBatch::Scope scope{binaries};
                         const KernelInfo& k = kernels[i];
                         programs[i]         = h.LoadProgram(k.kernel_file, k.comp_options, false, "");
                     });
     // clang-format on
+    binaries.Store();
     ct.Log("PrecompileKernels");
     return programs;
 }
 
-void PrecompileSolutions(const Handle& h, const std::vector<const ConvSolution*>& sols)
+std::vector<KernelInfo> GetKernelsToBuild(const std::vector<const ConvSolution*>& sols,
+                                          const std::function<bool(const KernelInfo&)>& is_built)
 {
-    // Find all kernels that need to be compiled from the solutions
     std::vector<KernelInfo> kernels;
+    std::set<std::pair<std::string, std::string>> seen;
     for(auto&& sol : sols)
     {
         if(!sol->Succeeded())
             continue;
         for(auto&& kernel : sol->construction_params)
         {
-            if(h.HasProgram(kernel.kernel_file, kernel.comp_options))
+            if(!seen.emplace(kernel.kernel_file, kernel.comp_options).second)
+                continue;
+            if(is_built(kernel))
                 continue;
             kernels.push_back(kernel);
         }
     }
+    return kernels;
+}
+
+void PrecompileSolutions(const Handle& h, const std::vector<const ConvSolution*>& sols)
+{
+    // Find all kernels that need to be compiled from the solutions
+    const auto kernels = GetKernelsToBuild(sols, [&](const KernelInfo& kernel) {
+        return h.HasProgram(kernel.kernel_file, kernel.comp_options);
+    });
 
     // Precompile the kernels in parallel, but dont add them to the cache
     std::vector<Program> programs = PrecompileKernels(h, kernels);
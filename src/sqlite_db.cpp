@@ -51,6 +51,7 @@
 #include <mutex>
 #include <shared_mutex>
 #include <string>
+#include <unordered_map>
 
 extern "C" {
 int miopen_sqlite3_memvfs_init(sqlite3* db, char** pzErrMsg, const sqlite3_api_routines* pApi);
@@ -176,6 +177,11 @@ class SQLite::impl
 
     sqlite3_ptr ptrDb = nullptr;
     bool isValid;
+    std::recursive_mutex transaction_mutex;
+    int transaction_depth = 0;
+    std::mutex statements_mutex;
+    // Declared after ptrDb so the statements are finalized before the connection is closed.
+    std::unordered_multimap<std::string, SQLite::Statement> statements;
 };
 
 static int find_callback(void* _res, int argc, char** argv, char** azColName)
@@ -344,9 +350,8 @@ int64_t SQLite::Statement::ColumnInt64(int idx)
 
 int SQLite::Statement::BindText(int idx, const std::string& txt)
 {
-    sqlite3_bind_text(
+    return sqlite3_bind_text(
         pImpl->ptrStmt.get(), idx, txt.data(), txt.size(), SQLITE_TRANSIENT); // NOLINT
-    return 0;
 }
 int SQLite::Statement::BindBlob(int idx, const std::string& blob)
 {
@@ -361,6 +366,89 @@ int SQLite::Statement::BindInt64(int idx, const int64_t num)
     return 0;
 }
 
+void SQLite::Statement::Reset()
+{
+    sqlite3_reset(pImpl->ptrStmt.get());
+    sqlite3_clear_bindings(pImpl->ptrStmt.get());
+}
+
+SQLite::Statement SQLite::AcquireStatement(const std::string& query) const
+{
+    {
+        std::lock_guard<std::mutex> lock(pImpl->statements_mutex);
+        const auto it = pImpl->statements.find(query);
+        if(it != pImpl->statements.end())
+        {
+            auto stmt = std::move(it->second);
+            pImpl->statements.erase(it);
+            return stmt;
+        }
+    }
+    return Statement{*this, query};
+}
+
+void SQLite::ReleaseStatement(const std::string& query, Statement&& stmt) const
+{
+    stmt.Reset();
+    std::lock_guard<std::mutex> lock(pImpl->statements_mutex);
+    pImpl->statements.emplace(query, std::move(stmt));
+}
+
+SQLite::CachedStatement::CachedStatement(const SQLite& sql_, const std::string& query_)
+    : sql(sql_), query(query_), stmt(sql.AcquireStatement(query))
+{
+}
+
+SQLite::CachedStatement::CachedStatement(const SQLite& sql_,
+                                         const std::string& query_,
+                                         const std::vector<std::string>& vals)
+    : CachedStatement(sql_, query_)
+{
+    int cnt = 1;
+    for(auto& kinder : vals)
+    {
+        if(stmt.BindText(cnt++, kinder) != SQLITE_OK)
+            MIOPEN_THROW(miopenStatusInternalError, sql.ErrorMessage());
+    }
+    MIOPEN_LOG_I2("[" << JoinStrings(vals, ",") << "]");
+}
+
+SQLite::CachedStatement::~CachedStatement() { sql.ReleaseStatement(query, std::move(stmt)); }
+
+SQLite::Transaction::Transaction(const SQLite& sql_)
+    : sql(sql_),
+      lock(sql.pImpl->transaction_mutex),
+      outermost(sql.pImpl->transaction_depth == 0)
+{
+    if(outermost)
+        sql.Exec("BEGIN IMMEDIATE;");
+    ++sql.pImpl->transaction_depth;
+}
+
+SQLite::Transaction::~Transaction()
+{
+    --sql.pImpl->transaction_depth;
+    if(!outermost || finished)
+        return;
+
+    try
+    {
+        sql.Exec("ROLLBACK;");
+    }
+    catch(const Exception& ex)
+    {
+        MIOPEN_LOG_E("Failed to roll back a transaction: " << ex.what());
+    }
+}
+
+void SQLite::Transaction::Commit()
+{
+    if(!outermost || finished)
+        return;
+    sql.Exec("COMMIT;");
+    finished = true;
+}
+
 SQLitePerfDb::SQLitePerfDb(const std::string& filename_,
                            bool is_system,
                            const std::string& arch_,
@@ -426,6 +514,10 @@ SQLitePerfDb::SQLitePerfDb(const std::string& filename_,
                 sql.Exec(create_perfdb_sql);
             }
         }
+        // Lookups are done by config, which is not the leading column of idx_perf_db. Older user
+        // databases get the index upon opening as well.
+        sql.Exec("CREATE INDEX IF NOT EXISTS `idx_perf_db_config` "
+                 "ON perf_db(config, arch, num_cu);");
         MIOPEN_LOG_T("Database created successfully");
     }
     // Check fields for the tables
@@ -0,0 +1,178 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/thread_pool.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+
+namespace miopen {
+
+struct ThreadPool::Job
+{
+    Job(std::size_t n_,
+        std::size_t chunk_,
+        const std::function<void(std::size_t, std::size_t)>& f_)
+        : n(n_), chunk(chunk_), f(f_)
+    {
+    }
+
+    const std::size_t n;
+    const std::size_t chunk;
+    // Only used while there are unclaimed chunks, which the submitting thread waits for.
+    const std::function<void(std::size_t, std::size_t)>& f;
+
+    std::atomic<std::size_t> next{0};
+    std::atomic<bool> failed{false};
+
+    std::mutex mutex;
+    std::condition_variable done;
+    std::size_t finished = 0;
+    std::exception_ptr error;
+
+    void Work()
+    {
+        for(;;)
+        {
+            const auto begin = next.fetch_add(chunk);
+            if(begin >= n)
+                return;
+            const auto end = std::min(n, begin + chunk);
+
+            if(!failed)
+            {
+                try
+                {
+                    f(begin, end);
+                }
+                catch(...)
+                {
+                    const std::lock_guard<std::mutex> lock{mutex};
+                    if(!error)
+                        error = std::current_exception();
+                    failed = true;
+                }
+            }
+
+            const std::lock_guard<std::mutex> lock{mutex};
+            finished += end - begin;
+            if(finished == n)
+                done.notify_all();
+        }
+    }
+};
+
+ThreadPool& ThreadPool::Instance()
+{
+    // Never destroyed: workers may still be running when static objects are destroyed, and
+    // exit() may even be called by one of them.
+    // NOLINTNEXTLINE (cppcoreguidelines-owning-memory)
+    static auto* const instance = new ThreadPool{};
+    return *instance;
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        const std::lock_guard<std::mutex> lock{mutex};
+        stopping = true;
+    }
+    has_work.notify_all();
+    for(auto& worker : workers)
+        worker.join();
+}
+
+void ThreadPool::ParallelFor(std::size_t n,
+                             std::size_t threads,
+                             std::size_t chunk,
+                             const std::function<void(std::size_t, std::size_t)>& f)
+{
+    if(n == 0)
+        return;
+    chunk   = std::max<std::size_t>(chunk, 1);
+    threads = std::min({threads, (n + chunk - 1) / chunk, max_workers + 1});
+
+    if(threads <= 1)
+    {
+        f(0, n);
+        return;
+    }
+
+    Reserve(threads - 1);
+
+    const auto job = std::make_shared<Job>(n, chunk, f);
+    {
+        const std::lock_guard<std::mutex> lock{mutex};
+        queue.insert(queue.end(), threads - 1, job);
+    }
+    if(threads == 2)
+        has_work.notify_one();
+    else
+        has_work.notify_all();
+
+    job->Work();
+
+    {
+        std::unique_lock<std::mutex> lock{job->mutex};
+        job->done.wait(lock, [&]() { return job->finished == n; });
+    }
+
+    if(job->error)
+        std::rethrow_exception(job->error);
+}
+
+std::size_t ThreadPool::Size() const
+{
+    const std::lock_guard<std::mutex> lock{mutex};
+    return workers.size();
+}
+
+void ThreadPool::Reserve(std::size_t count)
+{
+    const std::lock_guard<std::mutex> lock{mutex};
+    while(workers.size() < std::min(count, max_workers))
+        workers.emplace_back([this]() { WorkerLoop(); });
+}
+
+void ThreadPool::WorkerLoop()
+{
+    for(;;)
+    {
+        std::shared_ptr<Job> job;
+        {
+            std::unique_lock<std::mutex> lock{mutex};
+            has_work.wait(lock, [&]() { return stopping || !queue.empty(); });
+            if(stopping)
+                return;
+            job = std::move(queue.front());
+            queue.pop_front();
+        }
+        // Tickets of already completed jobs return immediately.
+        job->Work();
+    }
+}
+
+} // namespace miopen
@@ -0,0 +1,163 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/timing_policy.hpp>
+
+#include <miopen/env.hpp>
+#include <miopen/logger.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <numeric>
+#include <ostream>
+#include <string>
+#include <vector>
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_TIMING_WARMUP)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_TIMING_REPEATS)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_TIMING_STATISTIC)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_TIMING_EARLY_EXIT)
+
+namespace miopen {
+
+namespace {
+
+TimingStatistic GetStatisticFromEnv(const TimingStatistic fallback)
+{
+    const char* const p_asciz = miopen::GetStringEnv(MIOPEN_DEBUG_TIMING_STATISTIC{});
+    if(p_asciz == nullptr || *p_asciz == '\0')
+        return fallback;
+    std::string str = p_asciz;
+    for(auto& c : str)
+        c = toupper(static_cast<unsigned char>(c));
+    for(const auto statistic :
+        {TimingStatistic::Min, TimingStatistic::Median, TimingStatistic::TrimmedMean})
+    {
+        if(str == ToCString(statistic))
+            return statistic;
+    }
+    MIOPEN_LOG_NQE("Wrong MIOPEN_DEBUG_TIMING_STATISTIC, using " << fallback << '.');
+    return fallback;
+}
+
+/// Sorts the samples.
+float Compute(const TimingStatistic statistic, std::vector<float>& samples)
+{
+    std::sort(samples.begin(), samples.end());
+    const auto n = samples.size();
+
+    switch(statistic)
+    {
+    case TimingStatistic::Min: return samples.front();
+    case TimingStatistic::Median:
+        return n % 2 != 0 ? samples[n / 2] : (samples[n / 2 - 1] + samples[n / 2]) / 2;
+    case TimingStatistic::TrimmedMean:
+    {
+        const auto trimmed = n / 4;
+        const auto first   = samples.begin() + trimmed;
+        const auto last    = samples.end() - trimmed;
+        return std::accumulate(first, last, 0.0f) / static_cast<float>(last - first);
+    }
+    }
+    return samples.front();
+}
+
+float Variance(const std::vector<float>& samples)
+{
+    if(samples.size() < 2)
+        return 0.0f;
+    const auto n    = static_cast<float>(samples.size());
+    const auto mean = std::accumulate(samples.begin(), samples.end(), 0.0f) / n;
+    auto sum        = 0.0f;
+    for(const auto sample : samples)
+        sum += (sample - mean) * (sample - mean);
+    return sum / (n - 1);
+}
+
+} // namespace
+
+const char* ToCString(const TimingStatistic statistic)
+{
+    switch(statistic)
+    {
+    case TimingStatistic::Min: return "MIN";
+    case TimingStatistic::Median: return "MEDIAN";
+    case TimingStatistic::TrimmedMean: return "TRIMMED_MEAN";
+    }
+    return "<Unknown>";
+}
+
+std::ostream& operator<<(std::ostream& os, const TimingStatistic statistic)
+{
+    return os << ToCString(statistic);
+}
+
+TimingPolicy TimingPolicy::FromEnv()
+{
+    auto policy       = TimingPolicy{};
+    policy.warmup     = miopen::Value(MIOPEN_DEBUG_TIMING_WARMUP{}, policy.warmup);
+    policy.repeats    = miopen::Value(MIOPEN_DEBUG_TIMING_REPEATS{}, policy.repeats);
+    policy.statistic  = GetStatisticFromEnv(policy.statistic);
+    policy.early_exit = miopen::Value(MIOPEN_DEBUG_TIMING_EARLY_EXIT{}, 105) / 100.0f;
+    return policy;
+}
+
+bool MeasureTime(const TimingPolicy& policy,
+                 const float best,
+                 const std::function<bool(float&)>& run,
+                 TimingResult& result)
+{
+    auto time = 0.0f;
+    for(std::size_t i = 0; i < policy.warmup; ++i)
+    {
+        if(!run(time))
+            return false;
+    }
+
+    const auto repeats = std::max<std::size_t>(policy.repeats, 1);
+    auto samples       = std::vector<float>{};
+    samples.reserve(repeats);
+
+    while(samples.size() < repeats)
+    {
+        if(!run(time))
+            return false;
+        samples.push_back(time);
+
+        if(samples.size() == 1 && policy.early_exit > 0.0f && time / best >= policy.early_exit)
+        {
+            MIOPEN_LOG_I2("Early exit: " << time << " / " << best << " = " << (time / best));
+            break;
+        }
+    }
+
+    result.variance  = Variance(samples);
+    result.runs      = samples.size();
+    result.statistic = policy.statistic;
+    result.time      = Compute(policy.statistic, samples);
+    return true;
+}
+
+} // namespace miopen
@@ -25,6 +25,7 @@
  *******************************************************************************/
 
 #include <miopen/tmp_dir.hpp>
+#include <miopen/compiler_pool.hpp>
 #include <miopen/env.hpp>
 #include <boost/filesystem.hpp>
 #include <miopen/errors.hpp>
@@ -59,6 +60,16 @@ void TmpDir::Execute(std::string exe, std::string args) const
     {
         MIOPEN_LOG_I2(this->path.string());
     }
+    // The command runs without a shell unless it needs one.
+    auto command = exec::Command{};
+    if(exec::ParseCommand(exe + " " + args, command))
+    {
+        command.dir = this->path.string();
+        MIOPEN_LOG_I2(exe + " " + args);
+        if(CompilerPool::GetDefault().Run(command) != 0)
+            MIOPEN_THROW("Can't execute " + exe + " " + args);
+        return;
+    }
     std::string cd  = "cd " + this->path.string() + "; ";
     std::string cmd = cd + exe + " " + args; // + " > /dev/null";
     SystemCmd(cmd);
@@ -0,0 +1,282 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/tuning_checkpoint.hpp>
+
+#include <miopen/db_path.hpp>
+#include <miopen/env.hpp>
+#include <miopen/logger.hpp>
+#include <miopen/md5.hpp>
+
+#include <boost/filesystem/operations.hpp>
+
+#include <sstream>
+#include <tuple>
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_TUNING_CHECKPOINT)
+
+namespace miopen {
+namespace solver {
+
+TuningCheckpoint::TuningCheckpoint(boost::filesystem::path path_) : path(std::move(path_))
+{
+    if(path.empty())
+        return;
+
+    std::ifstream in(path.string());
+    if(!in)
+        return;
+
+    auto line = std::string{};
+    auto n    = 0;
+    while(std::getline(in, line))
+    {
+        ++n;
+        std::istringstream ss(line);
+        auto kind = std::string{};
+        ss >> kind;
+
+        if(kind == "run" || kind == "trial")
+        {
+            auto runs    = trial;
+            auto outcome = std::string{};
+            auto config  = std::string{};
+            if(kind == "run")
+                ss >> runs;
+            ss >> outcome >> std::ws;
+            std::getline(ss, config);
+            if(!ss.fail() && (runs != trial) == (kind == "run") && !config.empty())
+            {
+                if(outcome == "fail")
+                {
+                    measurements[{config, runs}] = {true, 0.0f};
+                    continue;
+                }
+                std::istringstream time_ss(outcome);
+                auto time = 0.0f;
+                if(time_ss >> time && time_ss.eof())
+                {
+                    measurements[{config, runs}] = {false, time};
+                    continue;
+                }
+            }
+        }
+        else if(kind == "best")
+        {
+            auto time   = 0.0f;
+            auto config = std::string{};
+            ss >> time >> std::ws;
+            std::getline(ss, config);
+            if(!ss.fail() && !config.empty())
+            {
+                best_config = config;
+                best_time   = time;
+                continue;
+            }
+        }
+
+        // A line may be truncated if the process has been killed while writing it.
+        MIOPEN_LOG_W("Skipping malformed line " << n << " of " << path.string());
+    }
+}
+
+boost::filesystem::path TuningCheckpoint::GetPath(const std::string& db_basename,
+                                                  const std::string& solver,
+                                                  const std::string& problem)
+{
+#if MIOPEN_DISABLE_USERDB
+    std::ignore = db_basename;
+    std::ignore = solver;
+    std::ignore = problem;
+    return {};
+#else
+    if(miopen::IsDisabled(MIOPEN_DEBUG_TUNING_CHECKPOINT{}) || GetUserDbPath().empty())
+        return {};
+    return boost::filesystem::path(GetUserDbPath()) /
+           (db_basename + "." + solver + "." + md5(problem).substr(0, 16) + ".tuning.txt");
+#endif
+}
+
+bool TuningCheckpoint::Find(const std::string& config,
+                            std::size_t runs,
+                            bool& failed,
+                            float& time) const
+{
+    const auto it = measurements.find({config, runs});
+    if(it == measurements.end())
+        return false;
+    failed = it->second.failed;
+    time   = it->second.time;
+    return true;
+}
+
+bool TuningCheckpoint::GetBest(std::string& config, float& time) const
+{
+    if(best_config.empty())
+        return false;
+    config = best_config;
+    time   = best_time;
+    return true;
+}
+
+void TuningCheckpoint::Record(const std::string& config,
+                              std::size_t runs,
+                              bool failed,
+                              float time)
+{
+    measurements[{config, runs}] = {failed, failed ? 0.0f : time};
+
+    std::ostringstream ss;
+    ss.precision(std::numeric_limits<float>::max_digits10);
+    if(runs == trial)
+        ss << "trial ";
+    else
+        ss << "run " << runs << ' ';
+    if(failed)
+        ss << "fail";
+    else
+        ss << time;
+    ss << ' ' << config;
+    Append(ss.str());
+}
+
+void TuningCheckpoint::RecordBest(const std::string& config, float time)
+{
+    best_config = config;
+    best_time   = time;
+
+    std::ostringstream ss;
+    ss.precision(std::numeric_limits<float>::max_digits10);
+    ss << "best " << time << ' ' << config;
+    Append(ss.str());
+}
+
+void TuningCheckpoint::Remove()
+{
+    if(!IsEnabled())
+        return;
+    file.close();
+    auto ec = boost::system::error_code{};
+    boost::filesystem::remove(path, ec);
+    if(ec)
+        MIOPEN_LOG_W("Unable to remove " << path.string() << ": " << ec.message());
+}
+
+void TuningCheckpoint::Append(const std::string& line)
+{
+    if(!IsEnabled())
+        return;
+
+    if(!file.is_open())
+    {
+        auto ec = boost::system::error_code{};
+        if(path.has_parent_path())
+            boost::filesystem::create_directories(path.parent_path(), ec);
+        file.open(path.string(), std::ios::app);
+        if(!file)
+        {
+            MIOPEN_LOG_W("Unable to write tuning checkpoint " << path.string());
+            path.clear();
+            return;
+        }
+    }
+
+    // Flush each record, so everything measured before an interruption survives it.
+    file << line << std::endl;
+}
+
+CheckpointedSearchEvaluator::CheckpointedSearchEvaluator(
+    SearchEvaluator& inner_,
+    TuningCheckpoint& checkpoint_,
+    std::function<std::string(std::size_t)> get_config_)
+    : inner(inner_), checkpoint(checkpoint_), get_config(std::move(get_config_))
+{
+}
+
+void CheckpointedSearchEvaluator::Prepare(const std::vector<std::size_t>& indices)
+{
+    auto failed = false;
+    auto time   = 0.0f;
+    auto left   = std::vector<std::size_t>{};
+    for(const auto index : indices)
+    {
+        const auto config = get_config(index);
+        if(!checkpoint.Find(config, TuningCheckpoint::trial, failed, time) &&
+           !checkpoint.Find(config, 1, failed, time))
+            left.push_back(index);
+    }
+    if(!left.empty())
+        inner.Prepare(left);
+}
+
+bool CheckpointedSearchEvaluator::Run(std::size_t index, std::size_t runs, float& time)
+{
+    const auto config = get_config(index);
+    auto failed       = false;
+    if(checkpoint.Find(config, runs, failed, time))
+    {
+        ++replayed;
+        return !failed;
+    }
+
+    failed = !inner.Run(index, runs, time);
+    checkpoint.Record(config, runs, failed, time);
+    return !failed;
+}
+
+bool CheckpointedSearchEvaluator::Time(std::size_t index,
+                                       const TimingPolicy& policy,
+                                       float best,
+                                       TimingResult& result)
+{
+    // Only the time is kept, the search does not use the rest of the result.
+    const auto config = get_config(index);
+    auto failed       = false;
+    if(checkpoint.Find(config, TuningCheckpoint::trial, failed, result.time))
+    {
+        ++replayed;
+        return !failed;
+    }
+
+    failed = !inner.Time(index, policy, best, result);
+    checkpoint.Record(config, TuningCheckpoint::trial, failed, result.time);
+    return !failed;
+}
+
+void CheckpointedSearchEvaluator::OnTrial(std::size_t index,
+                                          bool failed,
+                                          float time,
+                                          const SearchResult& progress)
+{
+    if(progress.is_passed && progress.best_time < recorded_best)
+    {
+        recorded_best = progress.best_time;
+        checkpoint.RecordBest(get_config(progress.best), progress.best_time);
+    }
+    inner.OnTrial(index, failed, time, progress);
+}
+
+} // namespace solver
+} // namespace miopen
@@ -0,0 +1,299 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/warmup_plan.hpp>
+
+#include <miopen/convolution.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/logger.hpp>
+#include <miopen/tensor.hpp>
+#include <miopen/tensor_layout.hpp>
+
+#include <map>
+#include <sstream>
+
+namespace miopen {
+
+static const char* GetDriverOperation(miopenDataType_t type)
+{
+    switch(type)
+    {
+    case miopenHalf: return "convfp16";
+    case miopenBFloat16: return "convbfp16";
+    case miopenInt8:
+    case miopenInt8x4: return "convint8";
+    case miopenFloat:
+    case miopenInt32:
+    case miopenDouble: break;
+    }
+    return "conv";
+}
+
+std::ostream& operator<<(std::ostream& os, const DriverConvCommand& command)
+{
+    const auto& in  = command.in_lens;
+    const auto& wei = command.wei_lens;
+    const auto k    = command.mode == miopenTranspose ? wei[1] * command.group_count : wei[0];
+    os << GetDriverOperation(command.type) << " -n " << in[0] << " -c " << in[1];
+    if(command.GetSpatialDimension() == 3)
+    {
+        os << " --in_d " << in[2] << " -H " << in[3] << " -W " << in[4] << " -k " << k
+           << " --fil_d " << wei[2] << " -y " << wei[3] << " -x " << wei[4] << " --pad_d "
+           << command.pads[0] << " -p " << command.pads[1] << " -q " << command.pads[2]
+           << " --conv_stride_d " << command.strides[0] << " -u " << command.strides[1]
+           << " -v " << command.strides[2] << " --dilation_d " << command.dilations[0] << " -l "
+           << command.dilations[1] << " -j " << command.dilations[2] << " --spatial_dim 3";
+    }
+    else
+    {
+        os << " -H " << in[2] << " -W " << in[3] << " -k " << k << " -y " << wei[2]
+           << " -x " << wei[3] << " -p " << command.pads[0] << " -q " << command.pads[1]
+           << " -u " << command.strides[0] << " -v " << command.strides[1] << " -l "
+           << command.dilations[0] << " -j " << command.dilations[1];
+    }
+    if(!command.in_layout.empty())
+        os << " --in_layout " << command.in_layout;
+    if(!command.fil_layout.empty())
+        os << " --fil_layout " << command.fil_layout;
+    if(!command.out_layout.empty())
+        os << " --out_layout " << command.out_layout;
+    os << " -m " << (command.mode == miopenTranspose ? "trans" : "conv") << " -g "
+       << command.group_count << " -F " << command.directions << " -t 1";
+    if(command.type == miopenInt8x4)
+        os << " -Z 1";
+    return os;
+}
+
+static bool ParseInt(const std::string& str, int& value)
+{
+    std::istringstream ss(str);
+    return (ss >> value) && ss.eof();
+}
+
+bool ParseDriverConvCommand(const std::string& line, DriverConvCommand& command)
+{
+    static const std::string driver = "MIOpenDriver ";
+    const auto begin                = line.find(driver);
+    if(begin == std::string::npos)
+        return false;
+
+    // In the JSON format the command is at the end of a string value.
+    auto text        = line.substr(begin + driver.size());
+    const auto quote = text.find('"');
+    if(quote != std::string::npos)
+        text.resize(quote);
+
+    std::istringstream ss(text);
+    auto operation = std::string{};
+    auto result    = DriverConvCommand{};
+    ss >> operation;
+    if(operation == "conv")
+        result.type = miopenFloat;
+    else if(operation == "convfp16")
+        result.type = miopenHalf;
+    else if(operation == "convbfp16")
+        result.type = miopenBFloat16;
+    else if(operation == "convint8")
+        result.type = miopenInt8;
+    else
+        return false;
+
+    // All the flags logged by LogCmdConvolution() have values.
+    auto args = std::map<std::string, std::string>{};
+    auto name = std::string{};
+    while(ss >> name)
+    {
+        auto value = std::string{};
+        if(name.size() < 2 || name[0] != '-' || !(ss >> value))
+            return false;
+        args[name] = value;
+    }
+
+    const auto get = [&](const char* flag, int default_value, int& value) {
+        const auto arg = args.find(flag);
+        if(arg == args.end())
+        {
+            value = default_value;
+            return default_value >= 0;
+        }
+        return ParseInt(arg->second, value);
+    };
+    const auto get_str = [&](const char* flag) {
+        const auto arg = args.find(flag);
+        return arg == args.end() ? std::string{} : arg->second;
+    };
+
+    auto spatial_dim = 0;
+    if(!get("--spatial_dim", 2, spatial_dim) || (spatial_dim != 2 && spatial_dim != 3))
+        return false;
+
+    auto n = 0, c = 0, h = 0, w = 0, k = 0, y = 0, x = 0;
+    auto pad_h = 0, pad_w = 0, stride_h = 0, stride_w = 0, dilation_h = 0, dilation_w = 0;
+    if(!get("-n", -1, n) || !get("-c", -1, c) || !get("-H", -1, h) || !get("-W", -1, w) ||
+       !get("-k", -1, k) || !get("-y", -1, y) || !get("-x", -1, x) || !get("-p", 0, pad_h) ||
+       !get("-q", 0, pad_w) || !get("-u", 1, stride_h) || !get("-v", 1, stride_w) ||
+       !get("-l", 1, dilation_h) || !get("-j", 1, dilation_w) ||
+       !get("-g", 1, result.group_count) || !get("-F", 0, result.directions))
+        return false;
+    if(result.group_count < 1 || c % result.group_count != 0 || k % result.group_count != 0 ||
+       result.directions < 0 || result.directions > 7)
+        return false;
+
+    const auto mode = get_str("-m");
+    if(mode == "trans")
+        result.mode = miopenTranspose;
+    else if(!mode.empty() && mode != "conv")
+        return false;
+
+    // Same as the driver: for the transposed convolution -k is the number of output channels
+    // and the filter is laid out as {c, k / g}.
+    result.in_lens = {n, c, h, w};
+    if(result.mode == miopenTranspose)
+        result.wei_lens = {c, k / result.group_count, y, x};
+    else
+        result.wei_lens = {k, c / result.group_count, y, x};
+    result.pads      = {pad_h, pad_w};
+    result.strides   = {stride_h, stride_w};
+    result.dilations = {dilation_h, dilation_w};
+
+    if(spatial_dim == 3)
+    {
+        auto d = 0, z = 0, pad_d = 0, stride_d = 0, dilation_d = 0;
+        if(!get("--in_d", -1, d) || !get("--fil_d", -1, z) || !get("--pad_d", 0, pad_d) ||
+           !get("--conv_stride_d", 1, stride_d) || !get("--dilation_d", 1, dilation_d))
+            return false;
+        result.in_lens.insert(result.in_lens.begin() + 2, d);
+        result.wei_lens.insert(result.wei_lens.begin() + 2, z);
+        result.pads.insert(result.pads.begin(), pad_d);
+        result.strides.insert(result.strides.begin(), stride_d);
+        result.dilations.insert(result.dilations.begin(), dilation_d);
+    }
+
+    auto vectorized = 0;
+    if(!get("-Z", 0, vectorized))
+        return false;
+    if(vectorized == 1 && result.type == miopenInt8)
+        result.type = miopenInt8x4;
+
+    result.in_layout  = get_str("--in_layout");
+    result.fil_layout = get_str("--fil_layout");
+    result.out_layout = get_str("--out_layout");
+
+    command = result;
+    return true;
+}
+
+static TensorDescriptor
+MakeTensor(miopenDataType_t type, const std::vector<int>& lens, const std::string& layout)
+{
+    if(layout.empty())
+        return {type, lens};
+    auto strides = std::vector<int>{};
+    tensor_layout_to_strides(lens, tensor_layout_get_default(lens.size()), layout, strides);
+    return {type, lens, strides};
+}
+
+std::size_t WarmupPlan::AddLog(std::istream& log)
+{
+    auto added   = std::size_t{0};
+    auto line    = std::string{};
+    auto command = DriverConvCommand{};
+    while(std::getline(log, line))
+    {
+        if(ParseDriverConvCommand(line, command))
+            added += Add(command);
+    }
+    return added;
+}
+
+std::size_t WarmupPlan::Add(const DriverConvCommand& command)
+{
+    ++n_commands;
+
+    TensorDescriptor x, w, y;
+    auto conv = ConvolutionDescriptor{};
+    try
+    {
+        const auto spatial_dim = command.GetSpatialDimension();
+
+        conv = ConvolutionDescriptor{static_cast<std::size_t>(spatial_dim),
+                                     command.mode,
+                                     miopenPaddingDefault,
+                                     command.pads,
+                                     command.strides,
+                                     command.dilations,
+                                     std::vector<int>(spatial_dim, 0),
+                                     command.group_count};
+
+        x = MakeTensor(command.type, command.in_lens, command.in_layout);
+        w = MakeTensor(command.type, command.wei_lens, command.fil_layout);
+
+        const auto is_int8  = command.type == miopenInt8 || command.type == miopenInt8x4;
+        const auto y_type   = is_int8 ? miopenFloat : command.type;
+        const auto y_layout = command.out_layout.empty()
+                                  ? tensor_layout_get_default(command.in_lens.size())
+                                  : command.out_layout;
+        y = conv.GetForwardOutputTensorWithLayout(x, w, y_layout, y_type);
+    }
+    catch(const Exception& ex)
+    {
+        MIOPEN_LOG_W("Skipping " << command << ": " << ex.what());
+        ++n_invalid;
+        return 0;
+    }
+
+    // Transposed convolutions are implemented by the opposite direction, with the input and
+    // the output swapped, the same way as in convolution_api.cpp.
+    const auto transposed = command.mode == miopenTranspose;
+    const auto& in        = transposed ? y : x;
+    const auto& out       = transposed ? x : y;
+
+    auto added = std::size_t{0};
+    for(const auto mask : {1, 2, 4})
+    {
+        if(command.directions != 0 && (command.directions & mask) == 0)
+            continue;
+
+        const auto direction = mask == 4 ? conv::Direction::BackwardWeights
+                               : (mask == 1) != transposed ? conv::Direction::Forward
+                                                           : conv::Direction::BackwardData;
+
+        auto problem = WarmupProblem{command, ProblemDescription{in, w, out, conv, direction}};
+        problem.command.directions = mask;
+
+        std::ostringstream key;
+        key << problem.problem;
+        if(!keys.insert(key.str()).second)
+        {
+            ++n_duplicates;
+            continue;
+        }
+        problems.push_back(std::move(problem));
+        ++added;
+    }
+    return added;
+}
+
+} // namespace miopen
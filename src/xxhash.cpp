@@ -0,0 +1,134 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/xxhash.hpp>
+
+#include <cstring>
+
+namespace miopen {
+namespace {
+constexpr std::uint64_t Prime1 = 0x9E3779B185EBCA87ULL;
+constexpr std::uint64_t Prime2 = 0xC2B2AE3D27D4EB4FULL;
+constexpr std::uint64_t Prime3 = 0x165667B19E3779F9ULL;
+constexpr std::uint64_t Prime4 = 0x85EBCA77C2B2AE63ULL;
+constexpr std::uint64_t Prime5 = 0x27D4EB2F165667C5ULL;
+
+inline std::uint64_t Rotl(std::uint64_t x, int r) { return (x << r) | (x >> (64 - r)); }
+
+// The reference implementation reads little-endian words, which matches every host MIOpen runs
+// on, so plain unaligned loads are enough.
+inline std::uint64_t Read64(const unsigned char* p)
+{
+    std::uint64_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+inline std::uint32_t Read32(const unsigned char* p)
+{
+    std::uint32_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+inline std::uint64_t Round(std::uint64_t acc, std::uint64_t input)
+{
+    acc += input * Prime2;
+    acc = Rotl(acc, 31);
+    return acc * Prime1;
+}
+
+inline std::uint64_t MergeRound(std::uint64_t acc, std::uint64_t val)
+{
+    acc ^= Round(0, val);
+    return acc * Prime1 + Prime4;
+}
+} // namespace
+
+std::uint64_t xxhash64(const void* data, std::size_t size, std::uint64_t seed)
+{
+    auto p         = static_cast<const unsigned char*>(data);
+    const auto end = p + size;
+    std::uint64_t h;
+
+    if(size >= 32)
+    {
+        const auto limit = end - 32;
+        auto v1          = seed + Prime1 + Prime2;
+        auto v2          = seed + Prime2;
+        auto v3          = seed;
+        auto v4          = seed - Prime1;
+        do
+        {
+            v1 = Round(v1, Read64(p));
+            v2 = Round(v2, Read64(p + 8));
+            v3 = Round(v3, Read64(p + 16));
+            v4 = Round(v4, Read64(p + 24));
+            p += 32;
+        } while(p <= limit);
+
+        h = Rotl(v1, 1) + Rotl(v2, 7) + Rotl(v3, 12) + Rotl(v4, 18);
+        h = MergeRound(h, v1);
+        h = MergeRound(h, v2);
+        h = MergeRound(h, v3);
+        h = MergeRound(h, v4);
+    }
+    else
+    {
+        h = seed + Prime5;
+    }
+
+    h += size;
+
+    for(; p + 8 <= end; p += 8)
+        h = Rotl(h ^ Round(0, Read64(p)), 27) * Prime1 + Prime4;
+    if(p + 4 <= end)
+    {
+        h ^= static_cast<std::uint64_t>(Read32(p)) * Prime1;
+        h = Rotl(h, 23) * Prime2 + Prime3;
+        p += 4;
+    }
+    for(; p < end; ++p)
+        h = Rotl(h ^ (*p * Prime5), 11) * Prime1;
+
+    h ^= h >> 33;
+    h *= Prime2;
+    h ^= h >> 29;
+    h *= Prime3;
+    h ^= h >> 32;
+    return h;
+}
+
+std::string xxhash64(const std::string& s)
+{
+    static const char digits[] = "0123456789abcdef";
+    auto h                     = xxhash64(s.data(), s.size());
+    std::string result(16, '0');
+    for(auto i = 16; i > 0; --i, h >>= 4)
+        result[i - 1] = digits[h & 0xf];
+    return result;
+}
+
+} // namespace miopen
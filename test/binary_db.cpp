@@ -0,0 +1,182 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/binary_db.hpp>
+#include <miopen/db_record.hpp>
+#include <miopen/readonlyramdb.hpp>
+#include <miopen/temp_file.hpp>
+
+#include "test.hpp"
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include <string>
+
+namespace miopen {
+boost::optional<std::string>& testing_find_db_path_override();
+} // namespace miopen
+
+static std::string ReadFile(const std::string& path)
+{
+    std::ifstream file(path, std::ios::binary);
+    return {std::istreambuf_iterator<char>{file}, {}};
+}
+
+static std::string ToBinary(const std::string& text)
+{
+    auto input  = std::istringstream{text};
+    auto output = std::ostringstream{};
+    miopen::binary_db::TextToBinary(input, output, "test");
+    return output.str();
+}
+
+static void WriteFile(const std::string& path, const std::string& contents)
+{
+    std::ofstream(path, std::ios::binary) << contents;
+}
+
+struct RawValues
+{
+    std::string str;
+    bool Deserialize(const std::string& s)
+    {
+        str = s;
+        return true;
+    }
+};
+
+static std::string GetValues(const miopen::ReadonlyRamDb& db,
+                             const std::string& key,
+                             const std::string& id)
+{
+    const auto record = db.FindRecord(key);
+    if(!record)
+        return "<none>";
+    auto values = RawValues{};
+    return record->GetValues(id, values) ? values.str : "<no id>";
+}
+
+void check_round_trip()
+{
+    const auto text = std::string{
+        "b-key=miopenConvolutionFwdAlgoDirect:ConvOclDirectFwd,0.1,0,miopenConvolutionFwd"
+        "AlgoDirect,<unused>;miopenConvolutionFwdAlgoGEMM:gemm,0.2,64,GEMM,<unused>\n"
+        "\n"
+        "ill-formed line\n"
+        "a-key=miopenConvolutionFwdAlgoGEMM:gemm,0.3,0,GEMM,<unused>;"
+        "miopenConvolutionFwdAlgoGEMM:duplicate\n"
+        "b-key=miopenConvolutionFwdAlgoGEMM:not the first occurrence\n"
+        "c-key=\n"};
+
+    const auto binary = ToBinary(text);
+    EXPECT(miopen::binary_db::IsBinary(binary));
+    EXPECT(!miopen::binary_db::IsBinary(text));
+
+    const auto reader = miopen::binary_db::Reader{binary};
+    EXPECT_EQUAL(reader.Size(), 3u);
+    EXPECT(reader.Key(0) == "a-key");
+    EXPECT(!reader.Find("missing-key"));
+    EXPECT(!reader.Find("a-key-which-is-longer-than-any"));
+
+    auto values    = miopen::binary_db::Reader::Values{};
+    const auto idx = reader.Find("b-key");
+    EXPECT(idx);
+    EXPECT(reader.Read(*idx, values));
+    EXPECT_EQUAL(values.size(), 2u);
+    EXPECT(values[1].first == "miopenConvolutionFwdAlgoGEMM");
+    EXPECT(values[1].second == "gemm,0.2,64,GEMM,<unused>");
+    EXPECT(reader.Read(*reader.Find("c-key"), values));
+    EXPECT(values.empty());
+
+    // Text produced from the binary form has to convert back to the same bytes.
+    auto back = std::ostringstream{};
+    miopen::binary_db::BinaryToText(binary, back);
+    EXPECT(ToBinary(back.str()) == binary);
+
+    // Both forms have to give the same answers through ReadonlyRamDb.
+    miopen::TempFile text_file("miopen.tests.binary_db");
+    miopen::TempFile binary_file("miopen.tests.binary_db");
+    WriteFile(text_file, text);
+    WriteFile(binary_file, binary);
+
+    const auto& text_db   = miopen::ReadonlyRamDb::GetCached(text_file, false);
+    const auto& binary_db = miopen::ReadonlyRamDb::GetCached(binary_file, false);
+
+    for(const auto key : {"a-key", "b-key", "c-key", "missing-key"})
+    {
+        for(const auto id : {"miopenConvolutionFwdAlgoDirect", "miopenConvolutionFwdAlgoGEMM"})
+            EXPECT_EQUAL(GetValues(text_db, key, id), GetValues(binary_db, key, id));
+    }
+
+    EXPECT_EQUAL(GetValues(binary_db, "a-key", "miopenConvolutionFwdAlgoGEMM"),
+                 "gemm,0.3,0,GEMM,<unused>");
+    EXPECT_EQUAL(GetValues(binary_db, "c-key", "miopenConvolutionFwdAlgoGEMM"), "<none>");
+
+    CHECK(throws([&]() { miopen::binary_db::Reader{text}; }));
+    CHECK(throws([&]() { miopen::binary_db::Reader{binary.substr(0, 30)}; }));
+}
+
+void check_load_time()
+{
+    constexpr auto records_count = 50000;
+
+    auto text = std::ostringstream{};
+    for(auto i = 0; i < records_count; ++i)
+    {
+        text << "64-" << i << "-28-28-3x3-192-28-28-" << i % 8
+             << "-1x1-1x1-1x1-0-NCHW-FP32-F=miopenConvolutionFwdAlgoDirect:ConvOclDirectFwd,"
+             << i << ",0,miopenConvolutionFwdAlgoDirect,<unused>;miopenConvolutionFwdAlgoGEMM:"
+             << "gemm," << i << ",1024,miopenConvolutionFwdAlgoGEMM,<unused>\n";
+    }
+
+    miopen::TempFile text_file("miopen.tests.binary_db");
+    miopen::TempFile binary_file("miopen.tests.binary_db");
+    WriteFile(text_file, text.str());
+    WriteFile(binary_file, ToBinary(text.str()));
+
+    const auto measure = [](const std::string& path) {
+        const auto start = std::chrono::steady_clock::now();
+        const auto& db   = miopen::ReadonlyRamDb::GetCached(path, false);
+        EXPECT(db.FindRecord(std::string{"64-7-28-28-3x3-192-28-28-7-1x1-1x1-1x1-0-NCHW-FP32-F"}));
+        const auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::milli>(end - start).count();
+    };
+
+    const auto text_ms   = measure(text_file);
+    const auto binary_ms = measure(binary_file);
+
+    std::cout << records_count << " records, load and first lookup, ms: text " << text_ms
+              << " (" << ReadFile(text_file).size() << " bytes), binary " << binary_ms << " ("
+              << ReadFile(binary_file).size() << " bytes)" << std::endl;
+}
+
+int main()
+{
+    check_round_trip();
+    check_load_time();
+}
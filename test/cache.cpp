@@ -26,7 +26,9 @@
 
 #include <miopen/binary_cache.hpp>
 #include <miopen/kern_db.hpp>
+#include <miopen/lz.hpp>
 #include <miopen/temp_file.hpp>
+#include <miopen/xxhash.hpp>
 
 #include <miopen/md5.hpp>
 #include "test.hpp"
@@ -84,6 +86,137 @@ void check_bz2_decompress()
     EXPECT(decompressed_str == miopen::decompress(compressed_str, orig_str.size() + 10));
 }
 
+void check_lz()
+{
+    bool success = false;
+    EXPECT(miopen::lz_compress("", 1, &success).empty());
+    EXPECT(!success);
+    EXPECT(miopen::lz_decompress("", 0).empty());
+
+    // Random text over a small alphabet with runs of repeated bytes and words.
+    std::string orig_str;
+    while(orig_str.size() < 65536)
+    {
+        orig_str += random_string(GET_RAND() % 16);
+        orig_str += std::string(GET_RAND() % 64, 'x');
+        orig_str += "kernel_arg";
+    }
+
+    for(auto level : {1, 4, 9})
+    {
+        const auto compressed_str = miopen::lz_compress(orig_str, level, &success);
+        EXPECT(success);
+        EXPECT(compressed_str.size() < orig_str.size());
+        EXPECT(miopen::lz_decompress(compressed_str, orig_str.size()) == orig_str);
+        CHECK(throws([&]() { miopen::lz_decompress(compressed_str, orig_str.size() - 1); }));
+        CHECK(throws([&]() { miopen::lz_decompress(compressed_str, orig_str.size() + 1); }));
+        CHECK(throws([&]() {
+            miopen::lz_decompress(compressed_str.substr(0, compressed_str.size() / 2),
+                                  orig_str.size());
+        }));
+    }
+
+    // Incompressible data is returned as is.
+    std::string noise(4096, 0);
+    std::generate(noise.begin(), noise.end(), []() { return static_cast<char>(GET_RAND()); });
+    EXPECT(miopen::lz_compress(noise, 1, &success) == noise);
+    EXPECT(!success);
+}
+
+void check_xxhash()
+{
+    EXPECT(miopen::xxhash64(std::string{}) == "ef46db3751d8e999");
+    EXPECT(miopen::xxhash64(std::string{"a"}) == "d24ec4f1a98c6e5b");
+    EXPECT(miopen::xxhash64(std::string{"Nobody inspects the spammish repetition"}) ==
+           "fbcea83c8a378bf1");
+}
+
+void check_kern_db_codecs()
+{
+    EXPECT(miopen::KernDbCodec::Parse("lz")->ToString() == "lz:1");
+    EXPECT(miopen::KernDbCodec::Parse("BZ2")->ToString() == "bz2:9");
+    EXPECT(miopen::KernDbCodec::Parse("Lz:7")->ToString() == "lz:7");
+    EXPECT(miopen::KernDbCodec::Parse("none")->ToString() == "none");
+    EXPECT(!miopen::KernDbCodec::Parse("zstd"));
+    EXPECT(!miopen::KernDbCodec::Parse("lz:"));
+    EXPECT(!miopen::KernDbCodec::Parse("lz:10"));
+
+    miopen::TempFile temp_file("tmp-kerndb");
+    std::vector<miopen::KernelConfig> cfgs;
+    for(const auto codec_name : {"none", "bz2:1", "lz:1", "lz:9"})
+    {
+        miopen::KernelConfig cfg;
+        cfg.kernel_name = codec_name;
+        cfg.kernel_args = random_string(64);
+        cfg.kernel_blob = random_string(1024) + std::string(4096, '\0') + random_string(1024);
+
+        miopen::KernDb db(
+            std::string(temp_file), false, "gfx906", 60, *miopen::KernDbCodec::Parse(codec_name));
+        CHECK(db.StoreRecordUnsafe(cfg));
+        cfgs.push_back(cfg);
+    }
+
+    // Every row carries its own codec, so any instance reads all of them.
+    miopen::KernDb db(std::string(temp_file), false, "gfx906", 60);
+    for(const auto& cfg : cfgs)
+    {
+        const auto readout = db.FindRecordUnsafe(cfg);
+        CHECK(readout);
+        CHECK(readout.get() == cfg.kernel_blob);
+    }
+}
+
+void check_kern_db_legacy()
+{
+    // Rows stored before the codec was recorded are bzip2-compressed and checksummed with md5.
+    miopen::KernelConfig compressed_cfg{"compressed", "args", std::string(8192, 'a')};
+    miopen::KernelConfig raw_cfg{"raw", "args", random_string(64)};
+    const auto create_legacy_db = [&](const std::string& path) {
+        miopen::SQLite sql{path, false};
+        sql.Exec("CREATE TABLE `kern_db` (`id` INTEGER PRIMARY KEY ASC"
+                 ",`kernel_name` TEXT NOT NULL,`kernel_args` TEXT NOT NULL"
+                 ",`kernel_blob` BLOB NOT NULL,`kernel_hash` TEXT NOT NULL"
+                 ",`uncompressed_size` INT NOT NULL);"
+                 "CREATE UNIQUE INDEX `idx_kern_db` ON kern_db(kernel_name, kernel_args);");
+        miopen::SQLite::Statement stmt{sql,
+                                       "INSERT INTO kern_db(kernel_name, kernel_args, kernel_blob, "
+                                       "kernel_hash, uncompressed_size) VALUES(?, ?, ?, ?, ?);"};
+        const auto insert = [&](const miopen::KernelConfig& cfg, bool compressed) {
+            stmt.BindText(1, cfg.kernel_name);
+            stmt.BindText(2, cfg.kernel_args);
+            stmt.BindBlob(3, compressed ? miopen::compress(cfg.kernel_blob) : cfg.kernel_blob);
+            stmt.BindText(4, miopen::md5(cfg.kernel_blob));
+            stmt.BindInt64(5, compressed ? cfg.kernel_blob.size() : 0);
+            CHECK(stmt.Step(sql) == SQLITE_DONE);
+            stmt.Reset();
+        };
+        insert(compressed_cfg, true);
+        insert(raw_cfg, false);
+    };
+
+    for(const auto is_system : {false, true})
+    {
+        miopen::TempFile temp_file("tmp-kerndb");
+        create_legacy_db(std::string(temp_file));
+
+        miopen::KernDb db(std::string(temp_file), is_system, "gfx906", 60);
+        for(const auto& cfg : {compressed_cfg, raw_cfg})
+        {
+            const auto readout = db.FindRecordUnsafe(cfg);
+            CHECK(readout);
+            CHECK(readout.get() == cfg.kernel_blob);
+        }
+
+        if(!is_system)
+        {
+            // The user database is upgraded in place to take the new rows.
+            miopen::KernelConfig new_cfg{"new", "args", std::string(8192, 'b')};
+            CHECK(db.StoreRecordUnsafe(new_cfg));
+            CHECK(db.FindRecordUnsafe(new_cfg).get() == new_cfg.kernel_blob);
+        }
+    }
+}
+
 void check_kern_db()
 {
     miopen::KernelConfig cfg0;
@@ -153,6 +286,10 @@ int main()
 #if MIOPEN_ENABLE_SQLITE
     check_bz2_compress();
     check_bz2_decompress();
+    check_lz();
+    check_xxhash();
     check_kern_db();
+    check_kern_db_codecs();
+    check_kern_db_legacy();
 #endif
 }
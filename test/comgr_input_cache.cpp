@@ -0,0 +1,208 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include "test.hpp"
+#include "driver.hpp"
+#include <miopen/comgr_input_cache.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace miopen {
+namespace tests {
+
+/// Keeps the data objects in a map instead of comgr.
+class FakeBackend : public comgr::InputBackend
+{
+    public:
+    Handle
+    Create(Kind kind, const std::string& name, const char* content, std::size_t size) override
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if(name == fail_on)
+            throw std::runtime_error("Can't create " + name);
+        const auto prefix = kind == Kind::PrecompiledHeader ? "pch:" : "";
+        const auto handle = next++;
+        data[handle]      = prefix + name + ":" + std::string(content, size);
+        ++created;
+        return handle;
+    }
+
+    void Release(Handle handle) override
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        EXPECT_EQUAL(data.erase(handle), 1u);
+    }
+
+    std::string Get(Handle handle) const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        const auto found = data.find(handle);
+        return found == data.end() ? "released" : found->second;
+    }
+
+    std::size_t GetLive() const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return data.size();
+    }
+
+    std::size_t created = 0;
+    std::string fail_on;
+
+    private:
+    mutable std::mutex mutex;
+    std::map<Handle, std::string> data;
+    Handle next = 1;
+};
+
+struct ComgrInputCacheTestDriver : test_driver
+{
+    void run() const
+    {
+        CheckSharing();
+        CheckConcurrent();
+        CheckFailure();
+    }
+
+    private:
+    static comgr::InputCache::Files ListFiles()
+    {
+        static const std::string header = "#define X 1";
+        static const std::string pch    = "binary";
+        return {{comgr::InputBackend::Kind::Include, "x.h", header.data(), header.size()},
+                {comgr::InputBackend::Kind::PrecompiledHeader, "hip.pch", pch.data(), pch.size()}};
+    }
+
+    static void CheckSharing()
+    {
+        const auto backend = std::make_shared<FakeBackend>();
+        auto listed        = 0;
+        const auto list    = [&]() {
+            ++listed;
+            return ListFiles();
+        };
+
+        auto held = std::shared_ptr<const comgr::InputSet>{};
+        {
+            comgr::InputCache cache{backend};
+            const auto first = cache.Get("hip", list);
+            EXPECT_EQUAL(first->GetHandles().size(), 2u);
+            EXPECT_EQUAL(backend->Get(first->GetHandles()[0]), "x.h:#define X 1");
+            EXPECT_EQUAL(backend->Get(first->GetHandles()[1]), "pch:hip.pch:binary");
+
+            // The same objects for the next builds, other ones for another key.
+            EXPECT(cache.Get("hip", list) == first);
+            EXPECT(cache.Get("hip+pch", list) != first);
+            EXPECT_EQUAL(listed, 2);
+            EXPECT_EQUAL(backend->created, 4u);
+            EXPECT_EQUAL(cache.GetStats().hits, 1u);
+            EXPECT_EQUAL(cache.GetStats().misses, 2u);
+            EXPECT(cache.GetStats().prepare_ms >= 0.0f);
+
+            // A build which still uses the inputs keeps them after they are dropped.
+            held = cache.Get("hip", list);
+            cache.Clear();
+            EXPECT_EQUAL(backend->GetLive(), 2u);
+            EXPECT(cache.Get("hip", list) != held);
+            EXPECT_EQUAL(listed, 3);
+        }
+        // The cache has released its own.
+        EXPECT_EQUAL(backend->GetLive(), 2u);
+        const auto handle = held->GetHandles()[0];
+        held.reset();
+        EXPECT_EQUAL(backend->GetLive(), 0u);
+        EXPECT_EQUAL(backend->Get(handle), "released");
+    }
+
+    static void CheckConcurrent()
+    {
+        const auto backend = std::make_shared<FakeBackend>();
+        comgr::InputCache cache{backend};
+        std::atomic<int> listed{0};
+
+        const auto n_threads = 8;
+        auto results         = std::vector<std::shared_ptr<const comgr::InputSet>>(n_threads);
+        auto threads         = std::vector<std::thread>{};
+        for(auto i = 0; i < n_threads; ++i)
+        {
+            threads.emplace_back([&, i]() {
+                results[i] = cache.Get("hip", [&]() {
+                    ++listed;
+                    // Lets the other threads come while the inputs are being created.
+                    std::this_thread::sleep_for(std::chrono::milliseconds{50});
+                    return ListFiles();
+                });
+            });
+        }
+        for(auto& thread : threads)
+            thread.join();
+
+        EXPECT_EQUAL(listed.load(), 1);
+        EXPECT_EQUAL(backend->created, 2u);
+        for(const auto& result : results)
+            EXPECT(result == results[0]);
+        EXPECT_EQUAL(cache.GetStats().misses, 1u);
+        EXPECT_EQUAL(cache.GetStats().hits, n_threads - 1u);
+    }
+
+    static void CheckFailure()
+    {
+        const auto backend = std::make_shared<FakeBackend>();
+        comgr::InputCache cache{backend};
+
+        backend->fail_on = "hip.pch";
+        auto thrown      = false;
+        try
+        {
+            cache.Get("hip", ListFiles);
+        }
+        catch(const std::runtime_error&)
+        {
+            thrown = true;
+        }
+        EXPECT(thrown);
+        // The objects created before the failure are released, the next request tries again.
+        EXPECT_EQUAL(backend->GetLive(), 0u);
+        backend->fail_on.clear();
+        EXPECT_EQUAL(cache.Get("hip", ListFiles)->GetHandles().size(), 2u);
+        EXPECT_EQUAL(cache.GetStats().misses, 2u);
+    }
+};
+
+} // namespace tests
+} // namespace miopen
+
+int main(int argc, const char** argv)
+{
+    test_drive<miopen::tests::ComgrInputCacheTestDriver>(argc, argv);
+}
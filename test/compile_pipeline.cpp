@@ -0,0 +1,170 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include "test.hpp"
+#include "driver.hpp"
+#include <miopen/compile_pipeline.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <numeric>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace miopen {
+namespace tests {
+
+/// Builds take a while, like compilations; the finishing steps record the configs.
+struct SyntheticBuild
+{
+    std::chrono::milliseconds delay{0};
+    std::atomic<std::size_t> n_built{0};
+    std::mutex mutex;
+    std::set<std::size_t> built;
+    std::vector<std::size_t> finished;
+    std::set<std::thread::id> finished_on;
+
+    CompilePipeline::Finish operator()(std::size_t index)
+    {
+        std::this_thread::sleep_for(delay);
+        if(index == 13)
+            throw std::runtime_error("Compilation failed");
+        ++n_built;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            built.insert(index);
+        }
+        return [this, index]() {
+            finished.push_back(index);
+            finished_on.insert(std::this_thread::get_id());
+        };
+    }
+};
+
+std::vector<std::size_t> GetIndices(std::size_t n)
+{
+    auto indices = std::vector<std::size_t>(n);
+    std::iota(indices.begin(), indices.end(), 0);
+    return indices;
+}
+
+struct CompilePipelineTestDriver : test_driver
+{
+    void run() const
+    {
+        {
+            // Measurements start as soon as the first config is built.
+            const std::size_t n_configs = 40;
+            SyntheticBuild build;
+            build.delay = std::chrono::milliseconds{5};
+            CompilePipeline pipeline{std::ref(build), 4, 8};
+            pipeline.Schedule(GetIndices(n_configs));
+
+            EXPECT(pipeline.Wait(0));
+            EXPECT(build.n_built < n_configs);
+
+            auto n_failed = 0;
+            for(std::size_t i = 1; i < n_configs; ++i)
+            {
+                try
+                {
+                    EXPECT(pipeline.Wait(i));
+                }
+                catch(const std::runtime_error&)
+                {
+                    EXPECT_EQUAL(i, 13u);
+                    ++n_failed;
+                }
+            }
+            EXPECT_EQUAL(n_failed, 1);
+            EXPECT_EQUAL(build.finished.size(), n_configs - 1);
+            EXPECT(std::is_sorted(build.finished.begin(), build.finished.end()));
+            EXPECT_EQUAL(build.finished_on.size(), 1u);
+            EXPECT(build.finished_on.count(std::this_thread::get_id()) == 1);
+            EXPECT_EQUAL(pipeline.GetBuilt(), n_configs);
+            EXPECT(!pipeline.Wait(0));
+            EXPECT(!pipeline.Wait(n_configs));
+        }
+
+        {
+            // The search ends early, the configs it has not got to are mostly not built.
+            const std::size_t n_configs = 1000;
+            SyntheticBuild build;
+            build.delay = std::chrono::milliseconds{1};
+            CompilePipeline pipeline{std::ref(build), 4, 8};
+            pipeline.Schedule(GetIndices(n_configs));
+            for(std::size_t i = 0; i < 10; ++i)
+                EXPECT(pipeline.Wait(i));
+            pipeline.Cancel();
+            EXPECT(pipeline.GetBuilt() <= 10 + 8 + 4);
+            EXPECT(pipeline.GetCancelled() >= n_configs - 10 - 8 - 4);
+        }
+
+        {
+            // A new schedule drops the configs not started, and keeps the built ones.
+            SyntheticBuild build;
+            CompilePipeline pipeline{std::ref(build), 2, 4};
+            pipeline.Schedule(GetIndices(100));
+            EXPECT(pipeline.Wait(0));
+            pipeline.Schedule({50, 3, 60});
+            EXPECT(pipeline.Wait(60));
+            EXPECT(pipeline.Wait(50));
+            EXPECT(pipeline.Wait(3));
+            EXPECT(!pipeline.Wait(1));
+            EXPECT(!pipeline.Wait(99));
+            pipeline.Cancel();
+            EXPECT(build.finished == (std::vector<std::size_t>{0, 60, 50, 3}));
+        }
+
+        {
+            SyntheticBuild build;
+            CompilePipeline pipeline{std::ref(build), 3, 1};
+            pipeline.Schedule(GetIndices(30));
+            pipeline.Drain();
+            EXPECT_EQUAL(build.built.size(), 29u);
+            EXPECT(build.finished.empty());
+            EXPECT(!pipeline.Wait(0));
+        }
+
+        {
+            SyntheticBuild build;
+            CompilePipeline pipeline{std::ref(build), 0, 8};
+            pipeline.Schedule(GetIndices(10));
+            EXPECT(!pipeline.Wait(0));
+            EXPECT_EQUAL(build.n_built, 0u);
+        }
+    }
+};
+
+} // namespace tests
+} // namespace miopen
+
+int main(int argc, const char** argn)
+{
+    test_drive<miopen::tests::CompilePipelineTestDriver>(argc, argn);
+}
@@ -0,0 +1,270 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include "test.hpp"
+#include "driver.hpp"
+#include <miopen/compiler_pool.hpp>
+#include <miopen/exec_utils.hpp>
+#include <miopen/tmp_dir.hpp>
+
+#include <boost/filesystem.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+namespace miopen {
+namespace tests {
+
+static std::string ReadFile(const boost::filesystem::path& path)
+{
+    std::ifstream file(path.string());
+    std::stringstream ss;
+    ss << file.rdbuf();
+    return ss.str();
+}
+
+static void WriteFile(const boost::filesystem::path& path, const std::string& content)
+{
+    std::ofstream file(path.string());
+    file << content;
+}
+
+/// The "compiler" of the test: copies the input to the output and appends $STUB_SUFFIX. Also
+/// writes to <output>.jobs how many stubs are running in the directory, and to <output>.parent
+/// the process which has started it.
+static int StubCompiler(const std::string& input, const std::string& output)
+{
+    const auto mark = output + ".running";
+    WriteFile(mark, {});
+    auto jobs = 0;
+    for(const auto& entry : boost::filesystem::directory_iterator{"."})
+        if(entry.path().extension() == ".running")
+            ++jobs;
+    std::this_thread::sleep_for(std::chrono::milliseconds{20});
+
+    auto status = 0;
+    if(boost::filesystem::exists(input))
+    {
+        const auto suffix = std::getenv("STUB_SUFFIX");
+        WriteFile(output, ReadFile(input) + (suffix != nullptr ? suffix : ""));
+        WriteFile(output + ".jobs", std::to_string(jobs));
+        WriteFile(output + ".parent", std::to_string(getppid()));
+        std::cout << "copied " << input << std::endl;
+    }
+    else
+    {
+        status = 2;
+    }
+    boost::filesystem::remove(mark);
+    return status;
+}
+
+struct CompilerPoolTestDriver : test_driver
+{
+    void run() const
+    {
+        CheckParse();
+        CheckSpawn();
+        CheckPool(false);
+        CheckPool(true);
+    }
+
+    private:
+    static std::string Self() { return boost::filesystem::read_symlink("/proc/self/exe").string(); }
+
+    static void CheckParse()
+    {
+        auto command = exec::Command{};
+        EXPECT(exec::ParseCommand(
+            R"( KMOPTLLC="-mattr=+a --b=0" clang -c 'a b.cpp' -o a\ b.o 1>/dev/null 2>&1)",
+            command));
+        EXPECT(command.env == std::vector<std::string>({"KMOPTLLC=-mattr=+a --b=0"}));
+        EXPECT(command.args == std::vector<std::string>({"clang", "-c", "a b.cpp", "-o", "a b.o"}));
+        EXPECT_EQUAL(command.redirects.size(), 2u);
+        EXPECT_EQUAL(command.redirects[0].fd, 1);
+        EXPECT_EQUAL(command.redirects[0].path, "/dev/null");
+        EXPECT_EQUAL(command.redirects[1].fd, 2);
+        EXPECT(command.redirects[1].path.empty());
+        EXPECT_EQUAL(command.redirects[1].target_fd, 1);
+
+        // Only the leading assignments are variables.
+        EXPECT(exec::ParseCommand("A=1 clang -DB=2 2> err.txt", command));
+        EXPECT(command.env == std::vector<std::string>({"A=1"}));
+        EXPECT(command.args == std::vector<std::string>({"clang", "-DB=2"}));
+        EXPECT_EQUAL(command.redirects.size(), 1u);
+        EXPECT_EQUAL(command.redirects[0].fd, 2);
+        EXPECT_EQUAL(command.redirects[0].path, "err.txt");
+
+        for(const auto line : {"a | b",
+                               "a; b",
+                               "a && b",
+                               "a $HOME",
+                               "a \"$HOME\"",
+                               "a < in.txt",
+                               "a >> log.txt",
+                               "a >",
+                               "a 'b",
+                               "A=1",
+                               ""})
+        {
+            if(exec::ParseCommand(line, command))
+            {
+                std::cerr << "Parsed: " << line << std::endl;
+                EXPECT(false);
+            }
+        }
+    }
+
+    static void CheckSpawn()
+    {
+        const auto self = Self();
+        const TmpDir dir{"compiler_pool"};
+        WriteFile(dir.path / "in.txt", "kernel");
+
+        auto command = exec::Command{};
+        command.dir  = dir.path.string();
+        command.env  = {"STUB_SUFFIX=!"};
+        command.args = {self, "--stub-compiler", "in.txt", "out.txt"};
+        command.redirects.push_back({1, "log.txt"});
+        EXPECT_EQUAL(exec::Spawn(command), 0);
+        EXPECT_EQUAL(ReadFile(dir.path / "out.txt"), "kernel!");
+        EXPECT_EQUAL(ReadFile(dir.path / "log.txt"), "copied in.txt\n");
+
+        command.args = {self, "--stub-compiler", "missing.txt", "out.txt"};
+        EXPECT_EQUAL(exec::Spawn(command), 2);
+        command.args = {(dir.path / "missing").string()};
+        EXPECT_EQUAL(exec::Spawn(command), 127);
+        command.args = {"./in.txt"};
+        EXPECT_EQUAL(exec::Spawn(command), 127);
+        // Found in PATH.
+        command.args = {"true"};
+        EXPECT_EQUAL(exec::Spawn(command), 0);
+
+        // Same as before, through the wrappers.
+        auto out = std::ostringstream{};
+        EXPECT_EQUAL(exec::Run(self + " --stub-compiler " + (dir.path / "in.txt").string() + " " +
+                                   (dir.path / "run.txt").string(),
+                               nullptr,
+                               &out),
+                     0);
+        EXPECT_EQUAL(out.str(), "copied " + (dir.path / "in.txt").string() + "\n");
+        dir.Execute(self, "--stub-compiler in.txt execute.txt >/dev/null");
+        EXPECT_EQUAL(ReadFile(dir.path / "execute.txt"), "kernel");
+        auto thrown = false;
+        try
+        {
+            dir.Execute(self, "--stub-compiler missing.txt execute.txt");
+        }
+        catch(const Exception&)
+        {
+            thrown = true;
+        }
+        EXPECT(thrown);
+    }
+
+    static void CheckPool(bool use_workers)
+    {
+        const TmpDir dir{"compiler_pool"};
+        const auto self      = Self();
+        const auto jobs      = std::size_t{2};
+        const auto builds    = std::size_t{8};
+        const auto n_threads = std::size_t{4};
+        WriteFile(dir.path / "in.txt", "kernel");
+
+        auto worker = std::vector<std::string>{};
+        if(use_workers)
+            worker = {self, "--compiler-worker"};
+        CompilerPool pool{jobs, worker};
+
+        auto statuses = std::vector<int>(builds, -1);
+        auto threads  = std::vector<std::thread>{};
+        for(auto t = std::size_t{0}; t < n_threads; ++t)
+        {
+            threads.emplace_back([&, t]() {
+                for(auto i = t; i < builds; i += n_threads)
+                {
+                    auto command = exec::Command{};
+                    command.dir  = dir.path.string();
+                    command.env  = {"STUB_SUFFIX=" + std::to_string(i)};
+                    command.args = {
+                        self, "--stub-compiler", "in.txt", "out" + std::to_string(i) + ".txt"};
+                    command.redirects.push_back({1, "/dev/null"});
+                    statuses[i] = pool.Run(command);
+                }
+            });
+        }
+        for(auto& thread : threads)
+            thread.join();
+
+        for(auto i = std::size_t{0}; i < builds; ++i)
+        {
+            const auto out = dir.path / ("out" + std::to_string(i) + ".txt");
+            EXPECT_EQUAL(statuses[i], 0);
+            EXPECT_EQUAL(ReadFile(out), "kernel" + std::to_string(i));
+            EXPECT(std::stoul(ReadFile(out.string() + ".jobs")) <= jobs);
+            // Started by a worker, or by this process itself.
+            const auto parent = std::stoi(ReadFile(out.string() + ".parent"));
+            EXPECT_EQUAL(parent != getpid(), use_workers);
+        }
+        EXPECT_EQUAL(pool.GetBuildCount(), builds);
+        EXPECT(pool.GetMaxTimeMs() > 0.0f);
+        EXPECT(pool.GetTotalTimeMs() >= pool.GetMaxTimeMs());
+
+        const auto workers = pool.GetWorkerCount();
+        if(use_workers)
+            EXPECT(workers >= 1 && workers <= jobs);
+        else
+            EXPECT_EQUAL(workers, 0u);
+
+        // A failed build does not stop the worker.
+        auto command = exec::Command{};
+        command.dir  = dir.path.string();
+        command.args = {self, "--stub-compiler", "missing.txt", "out.txt"};
+        EXPECT_EQUAL(pool.Run(command), 2);
+        EXPECT_EQUAL(pool.GetWorkerCount(), workers);
+        EXPECT_EQUAL(pool.GetBuildCount(), builds + 1);
+    }
+};
+
+} // namespace tests
+} // namespace miopen
+
+int main(int argc, const char** argv)
+{
+    const auto mode = std::string{argc > 1 ? argv[1] : ""};
+    if(mode == "--stub-compiler" && argc == 4)
+        return miopen::tests::StubCompiler(argv[2], argv[3]);
+    if(mode == "--compiler-worker")
+        return miopen::CompilerWorkerMain();
+    test_drive<miopen::tests::CompilerPoolTestDriver>(argc, argv);
+}
@@ -0,0 +1,185 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include "test.hpp"
+#include "driver.hpp"
+#include <miopen/conv/find_batch.hpp>
+#include <miopen/conv_solution.hpp>
+
+#include <set>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace miopen {
+namespace tests {
+
+using solver::ConvSolution;
+using solver::KernelInfo;
+
+/// Network configs of the convolutions of a ResNet-50 like network: the blocks of a stage
+/// repeat the same layers, so only a few of the 53 problems are unique.
+static std::vector<std::string> GetNetworkKeys()
+{
+    // (bottleneck channels, output channels, spatial size, blocks) of a stage
+    const auto stages = std::vector<std::tuple<int, int, int, int>>{
+        {64, 256, 56, 3}, {128, 512, 28, 4}, {256, 1024, 14, 6}, {512, 2048, 7, 3}};
+
+    std::vector<std::string> keys;
+    const auto add = [&](int c, int k, int hw, int fil, int stride) {
+        keys.push_back(std::to_string(c) + "x" + std::to_string(hw) + "x" + std::to_string(hw) +
+                       "x" + std::to_string(fil) + "x" + std::to_string(fil) + "x" +
+                       std::to_string(k) + "-s" + std::to_string(stride) + "-FP32-F");
+    };
+
+    add(3, 64, 224, 7, 2);
+    auto in_channels = 64;
+    for(const auto& stage : stages)
+    {
+        const auto mid    = std::get<0>(stage);
+        const auto out    = std::get<1>(stage);
+        const auto hw     = std::get<2>(stage);
+        const auto blocks = std::get<3>(stage);
+        for(auto block = 0; block < blocks; ++block)
+        {
+            add(block == 0 ? in_channels : out, mid, hw, 1, 1);
+            add(mid, mid, hw, 3, 1);
+            add(mid, out, hw, 1, 1);
+            if(block == 0)
+                add(in_channels, out, hw, 1, 1);
+        }
+        in_channels = out;
+    }
+    return keys;
+}
+
+static ConvSolution MakeSolution(std::vector<std::pair<std::string, std::string>> kernels,
+                                 miopenStatus_t status = miopenStatusSuccess)
+{
+    auto solution = ConvSolution{status};
+    for(const auto& kernel : kernels)
+    {
+        auto info         = KernelInfo{};
+        info.kernel_file  = kernel.first;
+        info.comp_options = kernel.second;
+        info.kernel_name  = kernel.first + "_main";
+        solution.construction_params.push_back(info);
+    }
+    return solution;
+}
+
+struct ConvFindBatchTestDriver : test_driver
+{
+    void run() const
+    {
+        CheckGrouping();
+        CheckKernelsToBuild();
+    }
+
+    private:
+    static void CheckGrouping()
+    {
+        EXPECT(GroupFindRequests({}).empty());
+
+        const auto keys   = GetNetworkKeys();
+        const auto groups = GroupFindRequests(keys);
+
+        EXPECT_EQUAL(keys.size(), 53u);
+        EXPECT_EQUAL(groups.size(), std::set<std::string>(keys.begin(), keys.end()).size());
+        EXPECT(groups.size() < keys.size());
+
+        auto covered = std::set<std::size_t>{};
+        auto leaders = std::set<std::string>{};
+        for(std::size_t g = 0; g < groups.size(); ++g)
+        {
+            const auto& group = groups[g];
+            EXPECT(!group.empty());
+            EXPECT(leaders.insert(keys[group.front()]).second);
+            // Groups are ordered by their first request.
+            if(g > 0)
+                EXPECT(groups[g - 1].front() < group.front());
+            for(std::size_t i = 0; i < group.size(); ++i)
+            {
+                EXPECT_EQUAL(keys[group[i]], keys[group.front()]);
+                EXPECT(covered.insert(group[i]).second);
+                if(i > 0)
+                    EXPECT(group[i - 1] < group[i]);
+            }
+        }
+        EXPECT_EQUAL(covered.size(), keys.size());
+
+        // The first request of each group is the first one with its key.
+        for(const auto& group : groups)
+            for(std::size_t i = 0; i < group.front(); ++i)
+                EXPECT(keys[i] != keys[group.front()]);
+    }
+
+    static void CheckKernelsToBuild()
+    {
+        // Two layers share the same direct kernel, a failed solution has no kernels to build,
+        // and one of the kernels is already in the program cache.
+        const auto layer1 = std::vector<ConvSolution>{
+            MakeSolution({{"direct.cl", "-DA=1"}, {"reduce.cl", ""}}),
+            MakeSolution({{"wino.s", "-mcpu=gfx900"}}),
+            MakeSolution({{"fft.cl", ""}}, miopenStatusUnknownError)};
+        const auto layer2 = std::vector<ConvSolution>{MakeSolution({{"direct.cl", "-DA=1"}}),
+                                                      MakeSolution({{"direct.cl", "-DA=2"}}),
+                                                      MakeSolution({{"built.cl", ""}})};
+
+        auto solutions = std::vector<const ConvSolution*>{};
+        for(const auto& s : layer1)
+            solutions.push_back(&s);
+        for(const auto& s : layer2)
+            solutions.push_back(&s);
+
+        auto n_checked      = 0;
+        const auto is_built = [&](const KernelInfo& kernel) {
+            ++n_checked;
+            return kernel.kernel_file == "built.cl";
+        };
+        const auto kernels = solver::GetKernelsToBuild(solutions, is_built);
+
+        auto names = std::vector<std::string>{};
+        for(const auto& kernel : kernels)
+            names.push_back(kernel.kernel_file + " " + kernel.comp_options);
+        EXPECT_EQUAL(names.size(), 4u);
+        EXPECT_EQUAL(names[0], "direct.cl -DA=1");
+        EXPECT_EQUAL(names[1], "reduce.cl ");
+        EXPECT_EQUAL(names[2], "wino.s -mcpu=gfx900");
+        EXPECT_EQUAL(names[3], "direct.cl -DA=2");
+        // The program cache is queried once per unique kernel.
+        EXPECT_EQUAL(n_checked, 5);
+
+        EXPECT(solver::GetKernelsToBuild({}, is_built).empty());
+    }
+};
+
+} // namespace tests
+} // namespace miopen
+
+int main(int argc, const char** argn)
+{
+    test_drive<miopen::tests::ConvFindBatchTestDriver>(argc, argn);
+}
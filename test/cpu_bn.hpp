@@ -0,0 +1,468 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_CPU_BN_HPP
+#define GUARD_CPU_BN_HPP
+
+#include <miopen/par_for.hpp>
+
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+// Host batch normalization references shared by the driver and the tests.
+//
+// The tensors are packed N x C x spatial, spatial being D*H*W (or H*W). The spatial mode keeps
+// one mean/variance/scale/bias per channel, the per-activation mode one per C x spatial element.
+// The channels are processed in parallel and the images are walked in contiguous rows, so that
+// the inner loops have unit stride. The statistics are accumulated in Tacc with Welford's
+// update, merged row by row (Chan et al.) in the spatial mode.
+//
+// The statistics pointers marked optional may be nullptr.
+
+namespace cpu_bn_detail {
+
+template <class Tacc>
+struct moments
+{
+    Tacc count = 0;
+    Tacc mean  = 0;
+    Tacc m2    = 0;
+
+    template <class T>
+    void add_row(const T* x, std::size_t size)
+    {
+        Tacc sum = 0;
+        for(std::size_t i = 0; i < size; ++i)
+            sum += static_cast<Tacc>(x[i]);
+        const Tacc row_count = static_cast<Tacc>(size);
+        const Tacc row_mean  = sum / row_count;
+        Tacc row_m2          = 0;
+        for(std::size_t i = 0; i < size; ++i)
+        {
+            const Tacc d = static_cast<Tacc>(x[i]) - row_mean;
+            row_m2 += d * d;
+        }
+
+        const Tacc total = count + row_count;
+        const Tacc delta = row_mean - mean;
+        mean += delta * row_count / total;
+        m2 += row_m2 + delta * delta * count * row_count / total;
+        count = total;
+    }
+
+    Tacc variance() const { return m2 / count; }
+};
+
+/// Mean and biased variance of channel c over the images.
+template <class Tacc, class Tin>
+moments<Tacc>
+spatial_moments(std::size_t n, std::size_t c, std::size_t spatial, const Tin* x, std::size_t ch)
+{
+    moments<Tacc> m;
+    for(std::size_t image = 0; image < n; ++image)
+        m.add_row(x + (image * c + ch) * spatial, spatial);
+    return m;
+}
+
+/// Means and biased variances of the spatial positions of channel ch over the images.
+template <class Tacc, class Tin>
+void per_activation_moments(std::size_t n,
+                            std::size_t c,
+                            std::size_t spatial,
+                            const Tin* x,
+                            std::size_t ch,
+                            std::vector<Tacc>& mean,
+                            std::vector<Tacc>& variance)
+{
+    mean.assign(spatial, Tacc(0));
+    variance.assign(spatial, Tacc(0));
+    for(std::size_t image = 0; image < n; ++image)
+    {
+        const Tin* row    = x + (image * c + ch) * spatial;
+        const Tacc weight = Tacc(1) / static_cast<Tacc>(image + 1);
+        for(std::size_t s = 0; s < spatial; ++s)
+        {
+            const Tacc v = static_cast<Tacc>(row[s]);
+            const Tacc d = v - mean[s];
+            mean[s] += d * weight;
+            variance[s] += d * (v - mean[s]);
+        }
+    }
+    for(std::size_t s = 0; s < spatial; ++s)
+        variance[s] /= static_cast<Tacc>(n);
+}
+
+template <class Tacc>
+Tacc inv_std(Tacc variance, double epsilon)
+{
+    return Tacc(1) / std::sqrt(variance + static_cast<Tacc>(epsilon));
+}
+
+/// Exponential moving average of the mean and of the unbiased variance over count samples.
+template <class Tacc, class Tstat>
+void update_running(Tstat* running_mean,
+                    Tstat* running_var,
+                    std::size_t i,
+                    Tacc mean,
+                    Tacc variance,
+                    std::size_t count,
+                    double exp_avg_factor)
+{
+    const auto factor = static_cast<Tacc>(exp_avg_factor);
+    const auto adjusted =
+        count == 1 ? variance
+                   : static_cast<Tacc>(count) / static_cast<Tacc>(count - 1) * variance;
+    if(running_mean != nullptr)
+    {
+        running_mean[i] = static_cast<Tstat>((Tacc(1) - factor) *
+                                                 static_cast<Tacc>(running_mean[i]) +
+                                             factor * mean);
+    }
+    if(running_var != nullptr)
+    {
+        running_var[i] = static_cast<Tstat>(
+            (Tacc(1) - factor) * static_cast<Tacc>(running_var[i]) + factor * adjusted);
+    }
+}
+
+} // namespace cpu_bn_detail
+
+/// y = scale * (x - mean) / sqrt(var + epsilon) + bias, with the statistics of the batch.
+/// Optionally saves the mean and the inverse standard deviation and updates the running ones.
+template <class Tacc = double, class Tin, class Tout, class Tparam, class Tstat>
+void cpu_bn_spatial_forward_train(std::size_t n,
+                                  std::size_t c,
+                                  std::size_t spatial,
+                                  const Tin* x,
+                                  Tout* y,
+                                  const Tparam* scale,
+                                  const Tparam* bias,
+                                  double epsilon,
+                                  double exp_avg_factor,
+                                  Tstat* save_mean,
+                                  Tstat* save_inv_var,
+                                  Tstat* running_mean,
+                                  Tstat* running_var)
+{
+    miopen::par_for(c, miopen::min_grain{1}, [&](std::size_t ch) {
+        const auto m   = cpu_bn_detail::spatial_moments<Tacc>(n, c, spatial, x, ch);
+        const auto inv = cpu_bn_detail::inv_std(m.variance(), epsilon);
+        if(save_mean != nullptr)
+            save_mean[ch] = static_cast<Tstat>(m.mean);
+        if(save_inv_var != nullptr)
+            save_inv_var[ch] = static_cast<Tstat>(inv);
+        cpu_bn_detail::update_running(
+            running_mean, running_var, ch, m.mean, m.variance(), n * spatial, exp_avg_factor);
+
+        const auto a = static_cast<Tacc>(scale[ch]) * inv;
+        const auto b = static_cast<Tacc>(bias[ch]);
+        for(std::size_t image = 0; image < n; ++image)
+        {
+            const auto offset = (image * c + ch) * spatial;
+            for(std::size_t s = 0; s < spatial; ++s)
+            {
+                const auto xc = static_cast<Tacc>(x[offset + s]) - m.mean;
+                y[offset + s] = static_cast<Tout>(a * xc + b);
+            }
+        }
+    });
+}
+
+/// Inference with the estimated mean and variance, or with the statistics of the batch when
+/// estimated_mean is nullptr.
+template <class Tacc = double, class Tin, class Tout, class Tparam, class Tstat>
+void cpu_bn_spatial_forward_infer(std::size_t n,
+                                  std::size_t c,
+                                  std::size_t spatial,
+                                  const Tin* x,
+                                  Tout* y,
+                                  const Tparam* scale,
+                                  const Tparam* bias,
+                                  double epsilon,
+                                  const Tstat* estimated_mean,
+                                  const Tstat* estimated_var)
+{
+    miopen::par_for(c, miopen::min_grain{1}, [&](std::size_t ch) {
+        Tacc mean     = 0;
+        Tacc variance = 0;
+        if(estimated_mean != nullptr)
+        {
+            mean     = static_cast<Tacc>(estimated_mean[ch]);
+            variance = static_cast<Tacc>(estimated_var[ch]);
+        }
+        else
+        {
+            const auto m = cpu_bn_detail::spatial_moments<Tacc>(n, c, spatial, x, ch);
+            mean         = m.mean;
+            variance     = m.variance();
+        }
+
+        const auto a = static_cast<Tacc>(scale[ch]) * cpu_bn_detail::inv_std(variance, epsilon);
+        const auto b = static_cast<Tacc>(bias[ch]);
+        for(std::size_t image = 0; image < n; ++image)
+        {
+            const auto offset = (image * c + ch) * spatial;
+            for(std::size_t s = 0; s < spatial; ++s)
+            {
+                const auto xc = static_cast<Tacc>(x[offset + s]) - mean;
+                y[offset + s] = static_cast<Tout>(a * xc + b);
+            }
+        }
+    });
+}
+
+/// Gradients of the training forward pass. Uses the saved mean and inverse standard deviation,
+/// or recomputes them when saved_mean is nullptr. dscale and dbias are overwritten.
+template <class Tacc = double, class Tin, class Tout, class Tparam, class Tgrad, class Tstat>
+void cpu_bn_spatial_backward(std::size_t n,
+                             std::size_t c,
+                             std::size_t spatial,
+                             const Tin* x,
+                             const Tin* dy,
+                             Tout* dx,
+                             const Tparam* scale,
+                             Tgrad* dscale,
+                             Tgrad* dbias,
+                             double epsilon,
+                             const Tstat* saved_mean,
+                             const Tstat* saved_inv_var)
+{
+    const auto nhw = static_cast<Tacc>(n * spatial);
+    miopen::par_for(c, miopen::min_grain{1}, [&](std::size_t ch) {
+        Tacc mean = 0;
+        Tacc inv  = 0;
+        if(saved_mean != nullptr)
+        {
+            mean = static_cast<Tacc>(saved_mean[ch]);
+            inv  = static_cast<Tacc>(saved_inv_var[ch]);
+        }
+        else
+        {
+            const auto m = cpu_bn_detail::spatial_moments<Tacc>(n, c, spatial, x, ch);
+            mean         = m.mean;
+            inv          = cpu_bn_detail::inv_std(m.variance(), epsilon);
+        }
+
+        Tacc sum_dy      = 0;
+        Tacc sum_dy_xhat = 0;
+        for(std::size_t image = 0; image < n; ++image)
+        {
+            const auto offset = (image * c + ch) * spatial;
+            for(std::size_t s = 0; s < spatial; ++s)
+            {
+                const auto g = static_cast<Tacc>(dy[offset + s]);
+                sum_dy += g;
+                sum_dy_xhat += (static_cast<Tacc>(x[offset + s]) - mean) * inv * g;
+            }
+        }
+        dbias[ch]  = static_cast<Tgrad>(sum_dy);
+        dscale[ch] = static_cast<Tgrad>(sum_dy_xhat);
+
+        // dx = scale * inv / NHW * (NHW * dy - sum(dy) - xhat * sum(dy * xhat))
+        const auto k = static_cast<Tacc>(scale[ch]) * inv / nhw;
+        for(std::size_t image = 0; image < n; ++image)
+        {
+            const auto offset = (image * c + ch) * spatial;
+            for(std::size_t s = 0; s < spatial; ++s)
+            {
+                const auto xhat = (static_cast<Tacc>(x[offset + s]) - mean) * inv;
+                dx[offset + s]  = static_cast<Tout>(
+                    k * (nhw * static_cast<Tacc>(dy[offset + s]) - sum_dy - xhat * sum_dy_xhat));
+            }
+        }
+    });
+}
+
+/// Per-activation counterpart of cpu_bn_spatial_forward_train: the statistics and parameters
+/// are C x spatial.
+template <class Tacc = double, class Tin, class Tout, class Tparam, class Tstat>
+void cpu_bn_per_activation_forward_train(std::size_t n,
+                                         std::size_t c,
+                                         std::size_t spatial,
+                                         const Tin* x,
+                                         Tout* y,
+                                         const Tparam* scale,
+                                         const Tparam* bias,
+                                         double epsilon,
+                                         double exp_avg_factor,
+                                         Tstat* save_mean,
+                                         Tstat* save_inv_var,
+                                         Tstat* running_mean,
+                                         Tstat* running_var)
+{
+    miopen::par_for(c, miopen::min_grain{1}, [&](std::size_t ch) {
+        std::vector<Tacc> mean;
+        std::vector<Tacc> variance;
+        cpu_bn_detail::per_activation_moments(n, c, spatial, x, ch, mean, variance);
+
+        std::vector<Tacc> a(spatial);
+        std::vector<Tacc> b(spatial);
+        for(std::size_t s = 0; s < spatial; ++s)
+        {
+            const auto i   = ch * spatial + s;
+            const auto inv = cpu_bn_detail::inv_std(variance[s], epsilon);
+            if(save_mean != nullptr)
+                save_mean[i] = static_cast<Tstat>(mean[s]);
+            if(save_inv_var != nullptr)
+                save_inv_var[i] = static_cast<Tstat>(inv);
+            cpu_bn_detail::update_running(
+                running_mean, running_var, i, mean[s], variance[s], n, exp_avg_factor);
+            a[s] = static_cast<Tacc>(scale[i]) * inv;
+            b[s] = static_cast<Tacc>(bias[i]);
+        }
+
+        for(std::size_t image = 0; image < n; ++image)
+        {
+            const auto offset = (image * c + ch) * spatial;
+            for(std::size_t s = 0; s < spatial; ++s)
+            {
+                const auto xc = static_cast<Tacc>(x[offset + s]) - mean[s];
+                y[offset + s] = static_cast<Tout>(a[s] * xc + b[s]);
+            }
+        }
+    });
+}
+
+/// Per-activation counterpart of cpu_bn_spatial_forward_infer.
+template <class Tacc = double, class Tin, class Tout, class Tparam, class Tstat>
+void cpu_bn_per_activation_forward_infer(std::size_t n,
+                                         std::size_t c,
+                                         std::size_t spatial,
+                                         const Tin* x,
+                                         Tout* y,
+                                         const Tparam* scale,
+                                         const Tparam* bias,
+                                         double epsilon,
+                                         const Tstat* estimated_mean,
+                                         const Tstat* estimated_var)
+{
+    miopen::par_for(c, miopen::min_grain{1}, [&](std::size_t ch) {
+        std::vector<Tacc> mean(spatial);
+        std::vector<Tacc> variance(spatial);
+        if(estimated_mean != nullptr)
+        {
+            for(std::size_t s = 0; s < spatial; ++s)
+            {
+                mean[s]     = static_cast<Tacc>(estimated_mean[ch * spatial + s]);
+                variance[s] = static_cast<Tacc>(estimated_var[ch * spatial + s]);
+            }
+        }
+        else
+        {
+            cpu_bn_detail::per_activation_moments(n, c, spatial, x, ch, mean, variance);
+        }
+
+        std::vector<Tacc> a(spatial);
+        std::vector<Tacc> b(spatial);
+        for(std::size_t s = 0; s < spatial; ++s)
+        {
+            const auto i = ch * spatial + s;
+            a[s] = static_cast<Tacc>(scale[i]) * cpu_bn_detail::inv_std(variance[s], epsilon);
+            b[s] = static_cast<Tacc>(bias[i]);
+        }
+
+        for(std::size_t image = 0; image < n; ++image)
+        {
+            const auto offset = (image * c + ch) * spatial;
+            for(std::size_t s = 0; s < spatial; ++s)
+            {
+                const auto xc = static_cast<Tacc>(x[offset + s]) - mean[s];
+                y[offset + s] = static_cast<Tout>(a[s] * xc + b[s]);
+            }
+        }
+    });
+}
+
+/// Per-activation counterpart of cpu_bn_spatial_backward.
+template <class Tacc = double, class Tin, class Tout, class Tparam, class Tgrad, class Tstat>
+void cpu_bn_per_activation_backward(std::size_t n,
+                                    std::size_t c,
+                                    std::size_t spatial,
+                                    const Tin* x,
+                                    const Tin* dy,
+                                    Tout* dx,
+                                    const Tparam* scale,
+                                    Tgrad* dscale,
+                                    Tgrad* dbias,
+                                    double epsilon,
+                                    const Tstat* saved_mean,
+                                    const Tstat* saved_inv_var)
+{
+    const auto count = static_cast<Tacc>(n);
+    miopen::par_for(c, miopen::min_grain{1}, [&](std::size_t ch) {
+        std::vector<Tacc> mean(spatial);
+        std::vector<Tacc> inv(spatial);
+        if(saved_mean != nullptr)
+        {
+            for(std::size_t s = 0; s < spatial; ++s)
+            {
+                mean[s] = static_cast<Tacc>(saved_mean[ch * spatial + s]);
+                inv[s]  = static_cast<Tacc>(saved_inv_var[ch * spatial + s]);
+            }
+        }
+        else
+        {
+            cpu_bn_detail::per_activation_moments(n, c, spatial, x, ch, mean, inv);
+            for(auto& v : inv)
+                v = cpu_bn_detail::inv_std(v, epsilon);
+        }
+
+        std::vector<Tacc> sum_dy(spatial, Tacc(0));
+        std::vector<Tacc> sum_dy_xhat(spatial, Tacc(0));
+        for(std::size_t image = 0; image < n; ++image)
+        {
+            const auto offset = (image * c + ch) * spatial;
+            for(std::size_t s = 0; s < spatial; ++s)
+            {
+                const auto g = static_cast<Tacc>(dy[offset + s]);
+                sum_dy[s] += g;
+                sum_dy_xhat[s] += (static_cast<Tacc>(x[offset + s]) - mean[s]) * inv[s] * g;
+            }
+        }
+
+        for(std::size_t s = 0; s < spatial; ++s)
+        {
+            dbias[ch * spatial + s]  = static_cast<Tgrad>(sum_dy[s]);
+            dscale[ch * spatial + s] = static_cast<Tgrad>(sum_dy_xhat[s]);
+        }
+
+        // dx = scale * inv / N * (N * dy - sum(dy) - xhat * sum(dy * xhat))
+        for(std::size_t image = 0; image < n; ++image)
+        {
+            const auto offset = (image * c + ch) * spatial;
+            for(std::size_t s = 0; s < spatial; ++s)
+            {
+                const auto k    = static_cast<Tacc>(scale[ch * spatial + s]) * inv[s] / count;
+                const auto xhat = (static_cast<Tacc>(x[offset + s]) - mean[s]) * inv[s];
+                const auto g    = static_cast<Tacc>(dy[offset + s]);
+                dx[offset + s] =
+                    static_cast<Tout>(k * (count * g - sum_dy[s] - xhat * sum_dy_xhat[s]));
+            }
+        }
+    });
+}
+
+#endif
@@ -36,6 +36,7 @@
 #include <miopen/tensor.hpp>
 #include <utility>
 
+#include "cpu_gemm.hpp"
 #include "tensor_holder.hpp"
 #include <miopen/stringutils.hpp>
 #include <miopen/functional.hpp>
@@ -294,6 +295,342 @@ void cpu_convolution_backward_weight_impl(const tensor<Tin>& in,
     });
 }
 
+/// Shape of a convolution problem for the im2col + GEMM implementations below, with the
+/// offsets of the spatial positions of the (possibly non-packed) tensors.
+template <std::size_t ConvDim>
+struct cpu_convolution_gemm_problem
+{
+    cpu_im2col_geometry<ConvDim> geometry;
+    std::size_t n;
+    std::size_t groups;
+    std::size_t c_per_group;
+    std::size_t k_per_group;
+    std::size_t in_size;
+    std::size_t col_rows;
+    std::size_t out_size;
+    std::vector<std::size_t> in_offsets;
+    std::vector<std::size_t> out_offsets;
+    std::array<std::size_t, 2> in_strides;
+    std::array<std::size_t, 2> out_strides;
+    std::size_t images_per_chunk;
+
+    template <class Range>
+    cpu_convolution_gemm_problem(const miopen::TensorDescriptor& in,
+                                 const miopen::TensorDescriptor& wei,
+                                 const miopen::TensorDescriptor& out,
+                                 const Range& pads,
+                                 const Range& strides,
+                                 const Range& dilations,
+                                 std::size_t group_count)
+    {
+        for(std::size_t i = 0; i < ConvDim; ++i)
+        {
+            geometry.in_lens[i]     = in.GetLengths()[i + 2];
+            geometry.kernel_lens[i] = wei.GetLengths()[i + 2];
+            geometry.out_lens[i]    = out.GetLengths()[i + 2];
+            geometry.pads[i]        = pads[i];
+            geometry.strides[i]     = strides[i];
+            geometry.dilations[i]   = dilations[i];
+        }
+        n           = out.GetLengths()[0];
+        groups      = group_count;
+        c_per_group = wei.GetLengths()[1];
+        k_per_group = wei.GetLengths()[0] / group_count;
+        col_rows    = c_per_group * geometry.kernel_size();
+        out_size    = geometry.out_size();
+        in_offsets  = spatial_offsets(in);
+        out_offsets = spatial_offsets(out);
+        in_size     = in_offsets.size();
+        in_strides  = {{in.GetStrides()[0], in.GetStrides()[1]}};
+        out_strides = {{out.GetStrides()[0], out.GetStrides()[1]}};
+
+        // Bounds the column matrix to about 16M elements.
+        const std::size_t budget = std::size_t{1} << 24;
+        images_per_chunk =
+            std::max<std::size_t>(1, budget / std::max<std::size_t>(1, col_rows * out_size));
+        images_per_chunk = std::min(images_per_chunk, n);
+    }
+
+    std::size_t in_index(std::size_t image, std::size_t c, std::size_t in_pos) const
+    {
+        return image * in_strides[0] + c * in_strides[1] + in_offsets[in_pos];
+    }
+
+    std::size_t out_index(std::size_t image, std::size_t k, std::size_t out_pos) const
+    {
+        return image * out_strides[0] + k * out_strides[1] + out_offsets[out_pos];
+    }
+
+    /// Gathers the weights of the group as a k_per_group x col_rows matrix.
+    template <class T>
+    std::vector<T> pack_weights(const tensor<T>& wei, std::size_t group) const
+    {
+        std::vector<T> packed(k_per_group * col_rows);
+        const auto offsets     = spatial_offsets(wei.desc);
+        const auto kernel_size = geometry.kernel_size();
+        for(std::size_t k = 0; k < k_per_group; ++k)
+        {
+            for(std::size_t c = 0; c < c_per_group; ++c)
+            {
+                const auto base = (group * k_per_group + k) * wei.desc.GetStrides()[0] +
+                                  c * wei.desc.GetStrides()[1];
+                for(std::size_t pos = 0; pos < kernel_size; ++pos)
+                    packed[(k * c_per_group + c) * kernel_size + pos] =
+                        wei.data[base + offsets[pos]];
+            }
+        }
+        return packed;
+    }
+
+    /// Offsets of the spatial positions of the tensor, in the order of its packed indices.
+    static std::vector<std::size_t> spatial_offsets(const miopen::TensorDescriptor& desc)
+    {
+        std::vector<std::size_t> offsets{0};
+        for(std::size_t i = 0; i < ConvDim; ++i)
+        {
+            std::vector<std::size_t> next;
+            next.reserve(offsets.size() * desc.GetLengths()[i + 2]);
+            for(auto offset : offsets)
+            {
+                for(std::size_t x = 0; x < desc.GetLengths()[i + 2]; ++x)
+                    next.push_back(offset + x * desc.GetStrides()[i + 2]);
+            }
+            offsets = std::move(next);
+        }
+        return offsets;
+    }
+};
+
+/// Same result as cpu_convolution_forward_impl, computed per group and chunk of images as the
+/// product of the weights and the im2col of the input.
+template <std::size_t ConvDim,
+          typename Tacc = double,
+          typename Tin,
+          typename Twei,
+          typename Tout,
+          typename Range>
+void cpu_convolution_forward_gemm_impl(const tensor<Tin>& in,
+                                       const tensor<Twei>& wei,
+                                       tensor<Tout>& out,
+                                       const Range& pads,
+                                       const Range& strides,
+                                       const Range& dilations,
+                                       std::size_t group_count)
+{
+    static_assert(ConvDim > 0, "wrong! convolution dim should be larger than 0");
+    const cpu_convolution_gemm_problem<ConvDim> p{
+        in.desc, wei.desc, out.desc, pads, strides, dilations, group_count};
+
+    std::vector<Tin> col(p.col_rows * p.images_per_chunk * p.out_size);
+    std::vector<Tacc> result(p.k_per_group * p.images_per_chunk * p.out_size);
+
+    for(std::size_t group = 0; group < p.groups; ++group)
+    {
+        const auto w = p.pack_weights(wei, group);
+        for(std::size_t n0 = 0; n0 < p.n; n0 += p.images_per_chunk)
+        {
+            const auto images = std::min(p.images_per_chunk, p.n - n0);
+            const auto cols   = images * p.out_size;
+
+            cpu_im2col(p.geometry,
+                       images,
+                       p.c_per_group,
+                       [&](std::size_t image, std::size_t c, std::size_t in_pos) {
+                           const auto in_c = group * p.c_per_group + c;
+                           return in.data[p.in_index(n0 + image, in_c, in_pos)];
+                       },
+                       col.data(),
+                       cols);
+            cpu_gemm<Tacc>(false,
+                           false,
+                           p.k_per_group,
+                           cols,
+                           p.col_rows,
+                           Tacc(1),
+                           w.data(),
+                           p.col_rows,
+                           col.data(),
+                           cols,
+                           Tacc(0),
+                           result.data(),
+                           cols);
+
+            miopen::par_for(p.k_per_group, miopen::min_grain{1}, [&](std::size_t k) {
+                for(std::size_t image = 0; image < images; ++image)
+                {
+                    for(std::size_t pos = 0; pos < p.out_size; ++pos)
+                    {
+                        out.data[p.out_index(n0 + image, group * p.k_per_group + k, pos)] =
+                            static_cast<Tout>(result[k * cols + image * p.out_size + pos]);
+                    }
+                }
+            });
+        }
+    }
+}
+
+/// Same result as cpu_convolution_backward_data_impl: the col2im of the product of the
+/// transposed weights and the output gradients.
+template <std::size_t ConvDim,
+          typename Tacc = double,
+          typename Tin,
+          typename Twei,
+          typename Tout,
+          typename Range>
+void cpu_convolution_backward_data_gemm_impl(tensor<Tin>& in,
+                                             const tensor<Twei>& wei,
+                                             const tensor<Tout>& out,
+                                             const Range& pads,
+                                             const Range& strides,
+                                             const Range& dilations,
+                                             std::size_t group_count)
+{
+    static_assert(ConvDim > 0, "wrong! convolution dim should be larger than 0");
+    const cpu_convolution_gemm_problem<ConvDim> p{
+        in.desc, wei.desc, out.desc, pads, strides, dilations, group_count};
+
+    std::vector<Tout> dy(p.k_per_group * p.images_per_chunk * p.out_size);
+    std::vector<Tacc> col(p.col_rows * p.images_per_chunk * p.out_size);
+    std::vector<Tacc> dx(p.images_per_chunk * p.c_per_group * p.in_size);
+
+    for(std::size_t group = 0; group < p.groups; ++group)
+    {
+        const auto w = p.pack_weights(wei, group);
+        for(std::size_t n0 = 0; n0 < p.n; n0 += p.images_per_chunk)
+        {
+            const auto images = std::min(p.images_per_chunk, p.n - n0);
+            const auto cols   = images * p.out_size;
+
+            miopen::par_for(p.k_per_group, miopen::min_grain{1}, [&](std::size_t k) {
+                for(std::size_t image = 0; image < images; ++image)
+                {
+                    for(std::size_t pos = 0; pos < p.out_size; ++pos)
+                    {
+                        dy[k * cols + image * p.out_size + pos] =
+                            out.data[p.out_index(n0 + image, group * p.k_per_group + k, pos)];
+                    }
+                }
+            });
+            cpu_gemm<Tacc>(true,
+                           false,
+                           p.col_rows,
+                           cols,
+                           p.k_per_group,
+                           Tacc(1),
+                           w.data(),
+                           p.col_rows,
+                           dy.data(),
+                           cols,
+                           Tacc(0),
+                           col.data(),
+                           cols);
+
+            std::fill(dx.begin(), dx.end(), Tacc(0));
+            cpu_col2im(p.geometry,
+                       images,
+                       p.c_per_group,
+                       col.data(),
+                       cols,
+                       [&](std::size_t image, std::size_t c, std::size_t in_pos, Tacc value) {
+                           dx[(image * p.c_per_group + c) * p.in_size + in_pos] += value;
+                       });
+
+            miopen::par_for(p.c_per_group, miopen::min_grain{1}, [&](std::size_t c) {
+                for(std::size_t image = 0; image < images; ++image)
+                {
+                    for(std::size_t pos = 0; pos < p.in_size; ++pos)
+                    {
+                        in.data[p.in_index(n0 + image, group * p.c_per_group + c, pos)] =
+                            static_cast<Tin>(dx[(image * p.c_per_group + c) * p.in_size + pos]);
+                    }
+                }
+            });
+        }
+    }
+}
+
+/// Same result as cpu_convolution_backward_weight_impl: the product of the output gradients
+/// and the transposed im2col of the input, summed over the chunks of images.
+template <std::size_t ConvDim,
+          typename Tacc = double,
+          typename Tin,
+          typename Twei,
+          typename Tout,
+          typename Range>
+void cpu_convolution_backward_weight_gemm_impl(const tensor<Tin>& in,
+                                               tensor<Twei>& wei,
+                                               const tensor<Tout>& out,
+                                               const Range& pads,
+                                               const Range& strides,
+                                               const Range& dilations,
+                                               std::size_t group_count)
+{
+    static_assert(ConvDim > 0, "wrong! convolution dim should be larger than 0");
+    const cpu_convolution_gemm_problem<ConvDim> p{
+        in.desc, wei.desc, out.desc, pads, strides, dilations, group_count};
+
+    std::vector<Tout> dy(p.k_per_group * p.images_per_chunk * p.out_size);
+    std::vector<Tin> col(p.col_rows * p.images_per_chunk * p.out_size);
+    std::vector<Tacc> dw(p.k_per_group * p.col_rows);
+
+    const auto kernel_size = p.geometry.kernel_size();
+    const auto wei_offsets = p.spatial_offsets(wei.desc);
+
+    for(std::size_t group = 0; group < p.groups; ++group)
+    {
+        for(std::size_t n0 = 0; n0 < p.n; n0 += p.images_per_chunk)
+        {
+            const auto images = std::min(p.images_per_chunk, p.n - n0);
+            const auto cols   = images * p.out_size;
+
+            miopen::par_for(p.k_per_group, miopen::min_grain{1}, [&](std::size_t k) {
+                for(std::size_t image = 0; image < images; ++image)
+                {
+                    for(std::size_t pos = 0; pos < p.out_size; ++pos)
+                    {
+                        dy[k * cols + image * p.out_size + pos] =
+                            out.data[p.out_index(n0 + image, group * p.k_per_group + k, pos)];
+                    }
+                }
+            });
+            cpu_im2col(p.geometry,
+                       images,
+                       p.c_per_group,
+                       [&](std::size_t image, std::size_t c, std::size_t in_pos) {
+                           const auto in_c = group * p.c_per_group + c;
+                           return in.data[p.in_index(n0 + image, in_c, in_pos)];
+                       },
+                       col.data(),
+                       cols);
+            cpu_gemm<Tacc>(false,
+                           true,
+                           p.k_per_group,
+                           p.col_rows,
+                           cols,
+                           Tacc(1),
+                           dy.data(),
+                           cols,
+                           col.data(),
+                           cols,
+                           n0 == 0 ? Tacc(0) : Tacc(1),
+                           dw.data(),
+                           p.col_rows);
+        }
+
+        miopen::par_for(p.k_per_group, miopen::min_grain{1}, [&](std::size_t k) {
+            const auto k_base = (group * p.k_per_group + k) * wei.desc.GetStrides()[0];
+            for(std::size_t c = 0; c < p.c_per_group; ++c)
+            {
+                for(std::size_t pos = 0; pos < kernel_size; ++pos)
+                {
+                    wei.data[k_base + c * wei.desc.GetStrides()[1] + wei_offsets[pos]] =
+                        static_cast<Twei>(dw[k * p.col_rows + c * kernel_size + pos]);
+                }
+            }
+        });
+    }
+}
+
 template <typename Tin, typename Twei, typename Tout, typename Range>
 void cpu_convolution_forward(std::size_t spatial_dim,
                              const tensor<Tin>& in,
@@ -308,22 +645,26 @@ void cpu_convolution_forward(std::size_t spatial_dim,
     {
     case 1:
     {
-        cpu_convolution_forward_impl<1>(in, wei, out, pads, strides, dilations, group_count);
+        cpu_convolution_forward_gemm_impl<1>(
+            in, wei, out, pads, strides, dilations, group_count);
         break;
     }
     case 2:
     {
-        cpu_convolution_forward_impl<2>(in, wei, out, pads, strides, dilations, group_count);
+        cpu_convolution_forward_gemm_impl<2>(
+            in, wei, out, pads, strides, dilations, group_count);
         break;
     }
     case 3:
     {
-        cpu_convolution_forward_impl<3>(in, wei, out, pads, strides, dilations, group_count);
+        cpu_convolution_forward_gemm_impl<3>(
+            in, wei, out, pads, strides, dilations, group_count);
         break;
     }
     case 4:
     {
-        cpu_convolution_forward_impl<4>(in, wei, out, pads, strides, dilations, group_count);
+        cpu_convolution_forward_gemm_impl<4>(
+            in, wei, out, pads, strides, dilations, group_count);
         break;
     }
     default: { MIOPEN_THROW("not belong to any case");
@@ -345,22 +686,26 @@ void cpu_convolution_backward_data(std::size_t spatial_dim,
     {
     case 1:
     {
-        cpu_convolution_backward_data_impl<1>(in, wei, out, pads, strides, dilations, group_count);
+        cpu_convolution_backward_data_gemm_impl<1>(
+            in, wei, out, pads, strides, dilations, group_count);
         break;
     }
     case 2:
     {
-        cpu_convolution_backward_data_impl<2>(in, wei, out, pads, strides, dilations, group_count);
+        cpu_convolution_backward_data_gemm_impl<2>(
+            in, wei, out, pads, strides, dilations, group_count);
         break;
     }
     case 3:
     {
-        cpu_convolution_backward_data_impl<3>(in, wei, out, pads, strides, dilations, group_count);
+        cpu_convolution_backward_data_gemm_impl<3>(
+            in, wei, out, pads, strides, dilations, group_count);
         break;
     }
     case 4:
     {
-        cpu_convolution_backward_data_impl<4>(in, wei, out, pads, strides, dilations, group_count);
+        cpu_convolution_backward_data_gemm_impl<4>(
+            in, wei, out, pads, strides, dilations, group_count);
         break;
     }
     default: { MIOPEN_THROW("not belong to any case");
@@ -382,25 +727,25 @@ void cpu_convolution_backward_weight(std::size_t spatial_dim,
     {
     case 1:
     {
-        cpu_convolution_backward_weight_impl<1>(
+        cpu_convolution_backward_weight_gemm_impl<1>(
             in, wei, out, pads, strides, dilations, group_count);
         break;
     }
     case 2:
     {
-        cpu_convolution_backward_weight_impl<2>(
+        cpu_convolution_backward_weight_gemm_impl<2>(
             in, wei, out, pads, strides, dilations, group_count);
         break;
     }
     case 3:
     {
-        cpu_convolution_backward_weight_impl<3>(
+        cpu_convolution_backward_weight_gemm_impl<3>(
             in, wei, out, pads, strides, dilations, group_count);
         break;
     }
     case 4:
     {
-        cpu_convolution_backward_weight_impl<4>(
+        cpu_convolution_backward_weight_gemm_impl<4>(
             in, wei, out, pads, strides, dilations, group_count);
         break;
     }
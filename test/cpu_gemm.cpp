@@ -0,0 +1,193 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include "serialize.hpp"
+#include "tensor_holder.hpp"
+#include "cpu_conv.hpp"
+#include "cpu_gemm.hpp"
+#include "random.hpp"
+#include "test.hpp"
+#include "verify.hpp"
+
+#include <miopen/bfloat16.hpp>
+
+#include <half.hpp>
+#include <vector>
+
+float random_value() { return float(GET_RAND() % 2001 - 1000) / 1000.0f; }
+
+template <class T>
+std::vector<T> random_matrix(std::size_t size)
+{
+    std::vector<T> r(size);
+    std::generate(r.begin(), r.end(), [] { return T(random_value()); });
+    return r;
+}
+
+void check_gemm(bool transpose_a, bool transpose_b, std::size_t m, std::size_t n, std::size_t k)
+{
+    const std::size_t pad = 3;
+    const auto lda        = (transpose_a ? m : k) + pad;
+    const auto ldb        = (transpose_b ? k : n) + pad;
+    const auto ldc        = n + pad;
+    const auto a          = random_matrix<float>((transpose_a ? k : m) * lda);
+    const auto b          = random_matrix<float>((transpose_b ? n : k) * ldb);
+    const auto c_init     = random_matrix<float>(m * ldc);
+    const double alpha    = 0.5;
+    const double beta     = -2.0;
+
+    std::vector<double> expected(m * ldc);
+    for(std::size_t i = 0; i < m; ++i)
+    {
+        for(std::size_t j = 0; j < n; ++j)
+        {
+            double acc = 0;
+            for(std::size_t p = 0; p < k; ++p)
+            {
+                acc += double(transpose_a ? a[p * lda + i] : a[i * lda + p]) *
+                       double(transpose_b ? b[j * ldb + p] : b[p * ldb + j]);
+            }
+            expected[i * ldc + j] = alpha * acc + beta * c_init[i * ldc + j];
+        }
+    }
+
+    auto c = c_init;
+    cpu_gemm<double>(transpose_a,
+                     transpose_b,
+                     m,
+                     n,
+                     k,
+                     alpha,
+                     a.data(),
+                     lda,
+                     b.data(),
+                     ldb,
+                     beta,
+                     c.data(),
+                     ldc);
+    for(std::size_t i = 0; i < m; ++i)
+    {
+        for(std::size_t j = 0; j < n; ++j)
+            EXPECT(std::abs(c[i * ldc + j] - expected[i * ldc + j]) < 1e-4);
+        // The padding is not written.
+        for(std::size_t j = n; j < ldc; ++j)
+            EXPECT(c[i * ldc + j] == c_init[i * ldc + j]);
+    }
+}
+
+template <class T>
+void check_convolution(std::vector<int> in_lens,
+                       std::vector<int> wei_lens,
+                       std::vector<int> pads,
+                       std::vector<int> strides,
+                       std::vector<int> dilations,
+                       std::size_t group_count,
+                       double tolerance)
+{
+    const std::size_t dim = pads.size();
+    std::vector<int> out_lens{in_lens[0], wei_lens[0]};
+    for(std::size_t i = 0; i < dim; ++i)
+    {
+        out_lens.push_back((in_lens[i + 2] + 2 * pads[i] - dilations[i] * (wei_lens[i + 2] - 1) -
+                            1) / strides[i] +
+                           1);
+    }
+
+    auto gen = [](auto...) { return random_value(); };
+    auto in  = tensor<T>{in_lens}.generate(gen);
+    auto wei = tensor<T>{wei_lens}.generate(gen);
+    auto out = tensor<T>{out_lens}.generate(gen);
+
+    auto check = [&](const tensor<T>& naive, const tensor<T>& gemm) {
+        const auto error = miopen::rms_range(naive.data, gemm.data);
+        EXPECT(error < tolerance);
+    };
+
+    auto out_naive = out;
+    auto out_gemm  = out;
+    auto in_naive  = in;
+    auto in_gemm   = in;
+    auto wei_naive = wei;
+    auto wei_gemm  = wei;
+    if(dim == 2)
+    {
+        cpu_convolution_forward_impl<2>(in, wei, out_naive, pads, strides, dilations, group_count);
+        cpu_convolution_forward_gemm_impl<2>(
+            in, wei, out_gemm, pads, strides, dilations, group_count);
+        cpu_convolution_backward_data_impl<2>(
+            in_naive, wei, out, pads, strides, dilations, group_count);
+        cpu_convolution_backward_data_gemm_impl<2>(
+            in_gemm, wei, out, pads, strides, dilations, group_count);
+        cpu_convolution_backward_weight_impl<2>(
+            in, wei_naive, out, pads, strides, dilations, group_count);
+        cpu_convolution_backward_weight_gemm_impl<2>(
+            in, wei_gemm, out, pads, strides, dilations, group_count);
+    }
+    else
+    {
+        cpu_convolution_forward_impl<3>(in, wei, out_naive, pads, strides, dilations, group_count);
+        cpu_convolution_forward_gemm_impl<3>(
+            in, wei, out_gemm, pads, strides, dilations, group_count);
+        cpu_convolution_backward_data_impl<3>(
+            in_naive, wei, out, pads, strides, dilations, group_count);
+        cpu_convolution_backward_data_gemm_impl<3>(
+            in_gemm, wei, out, pads, strides, dilations, group_count);
+        cpu_convolution_backward_weight_impl<3>(
+            in, wei_naive, out, pads, strides, dilations, group_count);
+        cpu_convolution_backward_weight_gemm_impl<3>(
+            in, wei_gemm, out, pads, strides, dilations, group_count);
+    }
+    check(out_naive, out_gemm);
+    check(in_naive, in_gemm);
+    check(wei_naive, wei_gemm);
+}
+
+template <class T>
+void check_convolutions(double tolerance)
+{
+    check_convolution<T>({2, 8, 9, 11}, {16, 8, 3, 3}, {1, 1}, {1, 1}, {1, 1}, 1, tolerance);
+    check_convolution<T>({3, 6, 13, 10}, {9, 2, 3, 5}, {0, 2}, {2, 1}, {1, 2}, 3, tolerance);
+    check_convolution<T>({1, 4, 7, 7}, {4, 1, 1, 1}, {0, 0}, {3, 3}, {1, 1}, 4, tolerance);
+    check_convolution<T>(
+        {2, 4, 5, 6, 7}, {6, 4, 3, 1, 3}, {1, 0, 1}, {1, 2, 2}, {1, 1, 1}, 1, tolerance);
+}
+
+int main()
+{
+    for(auto transpose_a : {false, true})
+    {
+        for(auto transpose_b : {false, true})
+        {
+            check_gemm(transpose_a, transpose_b, 1, 1, 1);
+            check_gemm(transpose_a, transpose_b, 7, 5, 3);
+            check_gemm(transpose_a, transpose_b, 67, 259, 300);
+            check_gemm(transpose_a, transpose_b, 130, 17, 513);
+        }
+    }
+
+    check_convolutions<float>(1e-6);
+    check_convolutions<half_float::half>(1e-3);
+    check_convolutions<bfloat16>(1e-2);
+}
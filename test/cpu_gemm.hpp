@@ -0,0 +1,253 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_CPU_GEMM_HPP
+#define GUARD_CPU_GEMM_HPP
+
+#include <miopen/par_for.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <numeric>
+#include <vector>
+
+namespace cpu_gemm_detail {
+
+// Tiles of C computed by one task, and the depth of the blocks of A and B packed for them.
+constexpr std::size_t tile_m = 64;
+constexpr std::size_t tile_n = 256;
+constexpr std::size_t tile_k = 256;
+
+/// c[i][j] += a[i][p] * b[p][j] for Rows rows at once, so that each row of b loaded is used
+/// Rows times. The innermost loop runs over contiguous rows and vectorizes.
+template <std::size_t Rows, class T>
+void multiply_rows(const T* a, std::size_t k, const T* b, std::size_t n, T* c)
+{
+    for(std::size_t p = 0; p < k; ++p)
+    {
+        std::array<T, Rows> x;
+        for(std::size_t r = 0; r < Rows; ++r)
+            x[r] = a[r * k + p];
+        const T* b_row = b + p * n;
+        for(std::size_t r = 0; r < Rows; ++r)
+        {
+            T* c_row = c + r * n;
+            for(std::size_t j = 0; j < n; ++j)
+                c_row[j] += x[r] * b_row[j];
+        }
+    }
+}
+
+} // namespace cpu_gemm_detail
+
+/// Host GEMM for the verification of the convolutions and RNNs:
+/// C = alpha * op(A) * op(B) + beta * C, where op(A) is m x k and op(B) is k x n.
+///
+/// The matrices are row-major with the leading dimensions lda, ldb and ldc; a transposed A is
+/// stored as k x m and a transposed B as n x k. The products are summed in Tacc whatever the
+/// element types are, and C is not read when beta is 0. Tiles of C are computed in parallel,
+/// each from blocks of A and B converted to Tacc and packed contiguously.
+template <class Tacc, class TA, class TB, class TC>
+void cpu_gemm(bool transpose_a,
+              bool transpose_b,
+              std::size_t m,
+              std::size_t n,
+              std::size_t k,
+              Tacc alpha,
+              const TA* a,
+              std::size_t lda,
+              const TB* b,
+              std::size_t ldb,
+              Tacc beta,
+              TC* c,
+              std::size_t ldc)
+{
+    using namespace cpu_gemm_detail;
+    const auto tiles_m = (m + tile_m - 1) / tile_m;
+    const auto tiles_n = (n + tile_n - 1) / tile_n;
+
+    miopen::par_for(tiles_m * tiles_n, miopen::min_grain{1}, [&](std::size_t tile) {
+        const auto i0 = tile / tiles_n * tile_m;
+        const auto j0 = tile % tiles_n * tile_n;
+        const auto mt = std::min(tile_m, m - i0);
+        const auto nt = std::min(tile_n, n - j0);
+
+        std::vector<Tacc> a_pack(mt * tile_k);
+        std::vector<Tacc> b_pack(tile_k * nt);
+        std::vector<Tacc> c_tile(mt * nt, Tacc(0));
+
+        for(std::size_t p0 = 0; p0 < k; p0 += tile_k)
+        {
+            const auto kt = std::min(tile_k, k - p0);
+            for(std::size_t i = 0; i < mt; ++i)
+            {
+                for(std::size_t p = 0; p < kt; ++p)
+                {
+                    a_pack[i * kt + p] = static_cast<Tacc>(
+                        transpose_a ? a[(p0 + p) * lda + i0 + i] : a[(i0 + i) * lda + p0 + p]);
+                }
+            }
+            for(std::size_t p = 0; p < kt; ++p)
+            {
+                for(std::size_t j = 0; j < nt; ++j)
+                {
+                    b_pack[p * nt + j] = static_cast<Tacc>(
+                        transpose_b ? b[(j0 + j) * ldb + p0 + p] : b[(p0 + p) * ldb + j0 + j]);
+                }
+            }
+
+            std::size_t i = 0;
+            for(; i + 4 <= mt; i += 4)
+                multiply_rows<4>(&a_pack[i * kt], kt, b_pack.data(), nt, &c_tile[i * nt]);
+            for(; i < mt; ++i)
+                multiply_rows<1>(&a_pack[i * kt], kt, b_pack.data(), nt, &c_tile[i * nt]);
+        }
+
+        for(std::size_t i = 0; i < mt; ++i)
+        {
+            TC* c_row = c + (i0 + i) * ldc + j0;
+            for(std::size_t j = 0; j < nt; ++j)
+            {
+                const auto value = alpha * c_tile[i * nt + j];
+                c_row[j]         = static_cast<TC>(
+                    beta == Tacc(0) ? value : value + beta * static_cast<Tacc>(c_row[j]));
+            }
+        }
+    });
+}
+
+/// Positions of the convolution window for the im2col and col2im below.
+///
+/// The column matrix has a row per input channel of a group and kernel position, and a column
+/// per image and output position: (c * kernel + kernel_pos) x (image * output + output_pos).
+template <std::size_t ConvDim>
+struct cpu_im2col_geometry
+{
+    std::array<std::size_t, ConvDim> in_lens;
+    std::array<std::size_t, ConvDim> kernel_lens;
+    std::array<std::size_t, ConvDim> out_lens;
+    std::array<std::ptrdiff_t, ConvDim> pads;
+    std::array<std::ptrdiff_t, ConvDim> strides;
+    std::array<std::ptrdiff_t, ConvDim> dilations;
+
+    std::size_t kernel_size() const { return product(kernel_lens); }
+    std::size_t out_size() const { return product(out_lens); }
+
+    /// Calls f(output_pos, in_pos) for every output position of the kernel position,
+    /// in_pos being negative where the window is out of the input.
+    template <class F>
+    void for_each_output(std::size_t kernel_pos, F f) const
+    {
+        std::array<std::ptrdiff_t, ConvDim> k{};
+        for(auto d = ConvDim; d > 0; --d)
+        {
+            k[d - 1] = kernel_pos % kernel_lens[d - 1];
+            kernel_pos /= kernel_lens[d - 1];
+        }
+
+        std::array<std::size_t, ConvDim> o{};
+        const auto size = out_size();
+        for(std::size_t output_pos = 0; output_pos < size; ++output_pos)
+        {
+            std::ptrdiff_t in_pos = 0;
+            for(std::size_t d = 0; d < ConvDim; ++d)
+            {
+                const auto x = static_cast<std::ptrdiff_t>(o[d]) * strides[d] +
+                               k[d] * dilations[d] - pads[d];
+                if(in_pos < 0 || x < 0 || x >= static_cast<std::ptrdiff_t>(in_lens[d]))
+                    in_pos = -1;
+                else
+                    in_pos = in_pos * static_cast<std::ptrdiff_t>(in_lens[d]) + x;
+            }
+            f(output_pos, in_pos);
+
+            for(auto d = ConvDim; d > 0 && ++o[d - 1] == out_lens[d - 1]; --d)
+                o[d - 1] = 0;
+        }
+    }
+
+    private:
+    template <class Range>
+    static std::size_t product(const Range& r)
+    {
+        return std::accumulate(
+            r.begin(), r.end(), std::size_t{1}, std::multiplies<std::size_t>());
+    }
+};
+
+/// Unfolds the images into the column matrix col with ld columns. The images are read through
+/// get(image, c, in_pos), in_pos indexing the packed spatial positions.
+template <std::size_t ConvDim, class T, class Get>
+void cpu_im2col(const cpu_im2col_geometry<ConvDim>& geometry,
+                std::size_t images,
+                std::size_t channels,
+                Get get,
+                T* col,
+                std::size_t ld)
+{
+    const auto kernel_size = geometry.kernel_size();
+    const auto out_size    = geometry.out_size();
+    miopen::par_for(channels * kernel_size, miopen::min_grain{1}, [&](std::size_t row) {
+        const auto c = row / kernel_size;
+        geometry.for_each_output(row % kernel_size, [&](std::size_t output_pos, auto in_pos) {
+            for(std::size_t image = 0; image < images; ++image)
+            {
+                col[row * ld + image * out_size + output_pos] =
+                    in_pos < 0 ? T(0) : static_cast<T>(get(image, c, in_pos));
+            }
+        });
+    });
+}
+
+/// Folds the column matrix col with ld columns back into the images, summing the overlapping
+/// windows. add(image, c, in_pos, value) is called for the channels in parallel, but for each
+/// channel from a single thread.
+template <std::size_t ConvDim, class T, class Add>
+void cpu_col2im(const cpu_im2col_geometry<ConvDim>& geometry,
+                std::size_t images,
+                std::size_t channels,
+                const T* col,
+                std::size_t ld,
+                Add add)
+{
+    const auto kernel_size = geometry.kernel_size();
+    const auto out_size    = geometry.out_size();
+    miopen::par_for(channels, miopen::min_grain{1}, [&](std::size_t c) {
+        for(std::size_t kernel_pos = 0; kernel_pos < kernel_size; ++kernel_pos)
+        {
+            const auto row = c * kernel_size + kernel_pos;
+            geometry.for_each_output(kernel_pos, [&](std::size_t output_pos, auto in_pos) {
+                if(in_pos < 0)
+                    return;
+                for(std::size_t image = 0; image < images; ++image)
+                    add(image, c, in_pos, col[row * ld + image * out_size + output_pos]);
+            });
+        }
+    });
+}
+
+#endif
@@ -0,0 +1,117 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include "cpu_xorwow.hpp"
+#include "test.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <vector>
+
+// One state at a time, as the kernel does it.
+void mat_vec(const unsigned int* matrix, unsigned int* vector)
+{
+    unsigned int result[XORWOW_DIM] = {0};
+    for(unsigned int i = 0; i < XORWOW_DIM; i++)
+    {
+        for(unsigned int j = 0; j < XORWOW_BITS; j++)
+        {
+            if(bool(vector[i] & (1U << j)))
+            {
+                std::transform(result,
+                               result + XORWOW_DIM,
+                               matrix + (XORWOW_DIM * (i * XORWOW_BITS + j)),
+                               result,
+                               std::bit_xor<unsigned int>{});
+            }
+        }
+    }
+    std::copy(std::begin(result), std::end(result), vector);
+}
+
+void xorwow_skipahead(unsigned long long skp,
+                      prngStates* state,
+                      const unsigned int skipahead_mat[XORWOW_PRECALC_MATRICES_NUM]
+                                                      [XORWOW_PRECALC_MATRICES_SZ])
+{
+    for(unsigned int mat_idx = 0; bool(skp); mat_idx++)
+    {
+        for(unsigned int i = 0; i < static_cast<unsigned int>(skp & XORWOW_JUMP_LOG2_MASK); i++)
+            mat_vec(skipahead_mat[mat_idx], &(state->x));
+        skp >>= XORWOW_JUMP_LOG2;
+    }
+}
+
+void xorwow_lite_init(prngStates* state,
+                      unsigned long long seed,
+                      unsigned long long subsequence,
+                      unsigned long long offset)
+{
+    *state = cpu_xorwow_detail::seeded_state(seed);
+    xorwow_skipahead(subsequence, state, precalc_xorwow_skipahead_sequence_matrices);
+    xorwow_skipahead(offset, state, precalc_xorwow_skipahead_matrices);
+    state->d += static_cast<unsigned int>(offset) * 362437;
+}
+
+void check_init_states(std::size_t states_num, unsigned long long seed, unsigned long long offset)
+{
+    std::vector<prngStates> expected(states_num);
+    for(std::size_t gid = 0; gid < states_num; gid++)
+        xorwow_lite_init(&expected[gid], seed, gid, offset);
+
+    // one extra state checks that nothing is written past states_num
+    std::vector<prngStates> states(states_num + 1);
+    auto& guard = states.back();
+    guard.x     = 1;
+    guard.y     = 2;
+    guard.z     = 3;
+    guard.w     = 4;
+    guard.v     = 5;
+    guard.d     = 6;
+    cpu_xorwow_init_states(states.data(), states_num, seed, offset);
+
+    for(std::size_t gid = 0; gid < states_num; gid++)
+    {
+        EXPECT(states[gid].x == expected[gid].x);
+        EXPECT(states[gid].y == expected[gid].y);
+        EXPECT(states[gid].z == expected[gid].z);
+        EXPECT(states[gid].w == expected[gid].w);
+        EXPECT(states[gid].v == expected[gid].v);
+        EXPECT(states[gid].d == expected[gid].d);
+    }
+    EXPECT(guard.x == 1 && guard.y == 2 && guard.z == 3 && guard.w == 4 && guard.v == 5 &&
+          guard.d == 6);
+}
+
+int main()
+{
+    check_init_states(1, 0, 0);
+    check_init_states(7, 0x1234567890abcdefULL, 0);
+    check_init_states(513, 42, 0);
+    check_init_states(MAX_PRNG_STATE, 0, 0);
+    check_init_states(1000, 7, 3);
+    check_init_states(100, 0xffffffffffffffffULL, 0x123456789abULL);
+}
@@ -0,0 +1,197 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_CPU_XORWOW_HPP
+#define GUARD_CPU_XORWOW_HPP
+
+#include <miopen/dropout.hpp>
+#include <miopen/par_for.hpp>
+#include <miopen/precalc_xorwow_skipahead_matrices.hpp>
+#include <miopen/precalc_xorwow_skipahead_sequence_matrices.hpp>
+
+#include <algorithm>
+#include <cstddef>
+
+// Host emulation of the xorwow state initialization done by the InitKernelState kernel, shared
+// by the driver and the tests.
+//
+// Skipping ahead is a product of the 160-bit xorshift state by the precalculated GF(2) matrices.
+// The states are processed in groups of lanes stored lane-minor, so that every matrix row is
+// applied to all the lanes at once under a per-lane bit mask, without branches. Each group of
+// lanes is skipped ahead only once, to the first subsequence of its chunk; the following
+// subsequences are reached with a single product by the one subsequence jump matrix. All the
+// powers of the xorwow transition matrix commute, so the states are bit-exact with the kernel.
+
+namespace cpu_xorwow_detail {
+
+static_assert(XORWOW_PRECALC_MATRICES_NUM * XORWOW_JUMP_LOG2 >= 64,
+              "the precalculated matrices must cover 64-bit skips");
+
+constexpr std::size_t lanes = 8;
+constexpr std::size_t steps = 64;
+
+struct lane_states
+{
+    unsigned int v[XORWOW_DIM][lanes];
+};
+
+// multiply the states of the enabled lanes (all bits set in enable) by the 32-bit-unit matrix
+inline void mat_vec(const unsigned int* matrix, lane_states& states, const unsigned int* enable)
+{
+    lane_states result = {};
+    for(unsigned int i = 0; i < XORWOW_DIM; i++)
+    {
+        for(unsigned int j = 0; j < XORWOW_BITS; j++)
+        {
+            const unsigned int* row = matrix + XORWOW_DIM * (i * XORWOW_BITS + j);
+            unsigned int bit[lanes];
+            for(std::size_t l = 0; l < lanes; l++)
+                bit[l] = 0U - ((states.v[i][l] >> j) & 1U);
+            for(unsigned int k = 0; k < XORWOW_DIM; k++)
+            {
+                for(std::size_t l = 0; l < lanes; l++)
+                    result.v[k][l] ^= row[k] & bit[l];
+            }
+        }
+    }
+    for(unsigned int k = 0; k < XORWOW_DIM; k++)
+    {
+        for(std::size_t l = 0; l < lanes; l++)
+            states.v[k][l] = (result.v[k][l] & enable[l]) | (states.v[k][l] & ~enable[l]);
+    }
+}
+
+// skip each lane ahead by its own skp, like xorwow_skipahead does for one state
+inline void skipahead(const unsigned long long* skp,
+                      lane_states& states,
+                      const unsigned int skipahead_mat[XORWOW_PRECALC_MATRICES_NUM]
+                                                      [XORWOW_PRECALC_MATRICES_SZ])
+{
+    for(unsigned int mat_idx = 0; mat_idx < XORWOW_PRECALC_MATRICES_NUM; mat_idx++)
+    {
+        const unsigned int shift = mat_idx * XORWOW_JUMP_LOG2;
+        unsigned int digit[lanes];
+        unsigned long long rest = 0;
+        for(std::size_t l = 0; l < lanes; l++)
+        {
+            digit[l] = static_cast<unsigned int>(skp[l] >> shift) & XORWOW_JUMP_LOG2_MASK;
+            rest |= skp[l] >> shift;
+        }
+        if(rest == 0)
+            break;
+
+        for(unsigned int r = 0; r < XORWOW_JUMP_LOG2_MASK; r++)
+        {
+            unsigned int enable[lanes];
+            unsigned int any = 0;
+            for(std::size_t l = 0; l < lanes; l++)
+            {
+                enable[l] = digit[l] > r ? ~0U : 0U;
+                any |= enable[l];
+            }
+            if(any != 0)
+                mat_vec(skipahead_mat[mat_idx], states, enable);
+        }
+    }
+}
+
+// xorwow_lite_init before skipping ahead: the state only depends on the seed
+inline prngStates seeded_state(unsigned long long seed)
+{
+    prngStates state;
+    state.x = 123456789;
+    state.y = 362436069;
+    state.z = 521288629;
+    state.w = 88675123;
+    state.v = 5783321;
+    state.d = 6615241;
+
+    // Adopt constants choice of rocRAND (https://github.com/ROCmSoftwarePlatform/rocRAND)
+    const unsigned int s0 = static_cast<unsigned int>(seed) ^ 0x2c7f967fU;
+    const unsigned int s1 = static_cast<unsigned int>(seed >> 32) ^ 0xa03697cbU;
+    const unsigned int t0 = 1228688033 * s0;
+    const unsigned int t1 = 2073658381 * s1;
+    state.x += t0;
+    state.y ^= t0;
+    state.z += t1;
+    state.w ^= t1;
+    state.v += t0;
+    state.d += t1 + t0;
+    return state;
+}
+
+} // namespace cpu_xorwow_detail
+
+// Sets states[gid] to xorwow_lite_init(seed, gid, offset) for every gid < states_num, which is
+// what the InitKernelState kernel computes with offset 0.
+inline void cpu_xorwow_init_states(prngStates* states,
+                                   std::size_t states_num,
+                                   unsigned long long seed,
+                                   unsigned long long offset = 0)
+{
+    using namespace cpu_xorwow_detail;
+
+    const auto seeded  = seeded_state(seed);
+    const auto chunk   = lanes * steps;
+    const auto weyl    = seeded.d + static_cast<unsigned int>(offset) * 362437;
+    unsigned int all[lanes];
+    std::fill(std::begin(all), std::end(all), ~0U);
+
+    miopen::par_for((states_num + chunk - 1) / chunk, miopen::min_grain{1}, [&](std::size_t c) {
+        const std::size_t first = c * chunk;
+
+        lane_states group;
+        unsigned long long subsequence[lanes];
+        unsigned long long offsets[lanes];
+        for(std::size_t l = 0; l < lanes; l++)
+        {
+            const unsigned int* p = &(seeded.x);
+            for(unsigned int k = 0; k < XORWOW_DIM; k++)
+                group.v[k][l] = p[k];
+            subsequence[l] = first + l * steps;
+            offsets[l]     = offset;
+        }
+        skipahead(subsequence, group, precalc_xorwow_skipahead_sequence_matrices);
+        skipahead(offsets, group, precalc_xorwow_skipahead_matrices);
+
+        for(std::size_t s = 0; s < steps; s++)
+        {
+            for(std::size_t l = 0; l < lanes; l++)
+            {
+                const std::size_t gid = first + l * steps + s;
+                if(gid >= states_num)
+                    continue;
+                unsigned int* p = &(states[gid].x);
+                for(unsigned int k = 0; k < XORWOW_DIM; k++)
+                    p[k] = group.v[k][l];
+                states[gid].d = weyl;
+            }
+            if(s + 1 < steps && first + s + 1 < states_num)
+                mat_vec(precalc_xorwow_skipahead_sequence_matrices[0], group, all);
+        }
+    });
+}
+
+#endif
@@ -0,0 +1,136 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include "test.hpp"
+#include "driver.hpp"
+#include <miopen/tensor_op_key.hpp>
+#include <miopen/tensor_ops.hpp>
+
+#include <array>
+#include <numeric>
+#include <vector>
+
+namespace miopen {
+namespace tests {
+
+template <class Lengths, class Strides>
+static std::vector<std::size_t> GetOffsets(const Lengths& lens, const Strides& strides)
+{
+    std::vector<std::size_t> offsets{0};
+    for(std::size_t i = 0; i < lens.size(); ++i)
+    {
+        std::vector<std::size_t> next;
+        for(const auto offset : offsets)
+            for(std::size_t j = 0; j < lens[i]; ++j)
+                next.push_back(offset + j * strides[i]);
+        offsets = std::move(next);
+    }
+    return offsets;
+}
+
+// Strides of a tensor placed inside a larger one, so it is not packed.
+static std::vector<std::size_t> GetStrides(const std::vector<std::size_t>& lens,
+                                           const std::vector<std::size_t>& padding)
+{
+    std::vector<std::size_t> strides(lens.size());
+    std::size_t stride = 1;
+    for(auto i = lens.size(); i-- > 0;)
+    {
+        strides[i] = stride;
+        stride *= lens[i] + padding[i];
+    }
+    return strides;
+}
+
+struct FlatTensorTestDriver : test_driver
+{
+    void run() const
+    {
+        const auto shapes = std::vector<std::vector<std::size_t>>{
+            {7}, {4, 5}, {2, 1, 3}, {1, 1, 1}, {2, 3, 4, 5}, {3, 1, 4, 1, 2}, {2, 2, 2, 2, 2, 2}};
+        const auto paddings = std::vector<std::vector<std::size_t>>{
+            {0, 0, 0, 0, 0, 0}, {0, 0, 0, 0, 0, 1}, {0, 1, 0, 1, 0, 0}, {1, 0, 1, 0, 1, 0}};
+
+        for(const auto& lens : shapes)
+        {
+            for(const auto& x_padding : paddings)
+            {
+                const auto x = TensorDescriptor{miopenFloat, lens, GetStrides(lens, x_padding)};
+
+                const auto x_flat = GetFlatTensor(x);
+                EXPECT_EQUAL(x_flat.GetType(), miopenFloat);
+                EXPECT_EQUAL(x_flat.GetElementSize(), x.GetElementSize());
+                EXPECT_EQUAL(x_flat.IsPacked(), x.IsPacked());
+                EXPECT(x_flat.GetSize() <= static_cast<std::size_t>(x.GetSize()));
+                EXPECT(GetOffsets(x_flat.GetLengths(), x_flat.GetStrides()) ==
+                       GetOffsets(x.GetLengths(), x.GetStrides()));
+
+                for(const auto& y_padding : paddings)
+                {
+                    const auto y =
+                        TensorDescriptor{miopenHalf, lens, GetStrides(lens, y_padding)};
+
+                    const auto flat = GetConsistentFlatTensors(x, y);
+                    EXPECT_EQUAL(flat[1].GetType(), miopenHalf);
+                    EXPECT(flat[0].GetLengths() == flat[1].GetLengths());
+                    EXPECT(GetOffsets(flat[0].GetLengths(), flat[0].GetStrides()) ==
+                           GetOffsets(x.GetLengths(), x.GetStrides()));
+                    EXPECT(GetOffsets(flat[1].GetLengths(), flat[1].GetStrides()) ==
+                           GetOffsets(y.GetLengths(), y.GetStrides()));
+                }
+            }
+        }
+
+        // Six dimensions which can not be merged do not fit.
+        const auto lens  = std::vector<std::size_t>{2, 2, 2, 2, 2, 2};
+        const auto fancy = TensorDescriptor{miopenFloat, lens, {243, 81, 27, 9, 3, 1}};
+        EXPECT(throws([&] { GetFlatTensor(fancy); }));
+
+        auto key = TensorOpKey{"set"};
+        key.Add(miopenFloat).AddRange(std::array<std::size_t, 3>{{64, 3, 224}});
+        EXPECT_EQUAL(key.ToString(), "set 1 64 3 224");
+
+        auto same = TensorOpKey{"set"};
+        same.Add(1).Add(64).Add(3).Add(224);
+        EXPECT(key == same);
+        EXPECT_EQUAL(key.GetHash(), same.GetHash());
+
+        auto other_op = TensorOpKey{"scale"};
+        other_op.Add(1).Add(64).Add(3).Add(224);
+        EXPECT(key != other_op);
+
+        auto shorter = TensorOpKey{"set"};
+        shorter.Add(1).Add(64).Add(3);
+        EXPECT(key != shorter);
+    }
+};
+
+} // namespace tests
+} // namespace miopen
+
+int main(int argc, const char** argn)
+{
+    test_drive<miopen::tests::FlatTensorTestDriver>(argc, argn);
+}
@@ -0,0 +1,152 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/hip_build_utils.hpp>
+#include <miopen/kernel.hpp>
+#include <miopen/target_properties.hpp>
+#include <miopen/tmp_dir.hpp>
+#include <miopen/write_file.hpp>
+
+#include "test.hpp"
+
+#include <boost/optional.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+
+static std::string ReadFile(const boost::filesystem::path& path)
+{
+    std::ifstream file(path.string(), std::ios::binary);
+    return {std::istreambuf_iterator<char>{file}, {}};
+}
+
+void check_contents()
+{
+    const auto& dir = miopen::GetHipKernelIncDir();
+    EXPECT(boost::filesystem::is_directory(dir));
+    EXPECT(&dir == &miopen::GetHipKernelIncDir());
+
+    for(const auto& inc_file : miopen::GetHipKernelIncList())
+        EXPECT(ReadFile(dir / inc_file) == miopen::GetKernelInc(inc_file));
+}
+
+/// The compiler of the test: resolves the quoted includes of the source against the -I dirs,
+/// reads them as a compiler would and writes the number of resolved includes to the output.
+/// Everything else on the command line is ignored.
+int stub_compiler(int argc, const char** argv)
+{
+    auto inc_dirs = std::vector<boost::filesystem::path>{};
+    auto input    = std::string{};
+    auto output   = std::string{};
+    for(auto i = 2; i < argc; ++i)
+    {
+        const auto arg = std::string{argv[i]};
+        if(arg == "-o" && i + 1 < argc)
+            output = argv[++i];
+        else if(arg.compare(0, 2, "-I") == 0 && arg.size() > 2)
+            inc_dirs.emplace_back(arg.substr(2));
+        else if(!arg.empty() && arg[0] != '-')
+            input = arg;
+    }
+    if(input.empty() || output.empty() || !boost::filesystem::exists(input))
+        return 1;
+
+    auto resolved = 0;
+    std::istringstream source(ReadFile(input));
+    for(std::string line; std::getline(source, line);)
+    {
+        const auto prefix = std::string{"#include \""};
+        if(line.compare(0, prefix.size(), prefix) != 0)
+            continue;
+        const auto name = line.substr(prefix.size(), line.find('"', prefix.size()) - prefix.size());
+        for(const auto& dir : inc_dirs)
+        {
+            if(boost::filesystem::exists(dir / name))
+            {
+                ReadFile(dir / name);
+                ++resolved;
+                break;
+            }
+        }
+    }
+    std::ofstream(output) << resolved;
+    return 0;
+}
+
+/// Times HIP builds through the stub compiler: with the includes written into a fresh tmp dir of
+/// each build, as it was done before, and with the includes shared by all the builds.
+void check_build_time()
+{
+    constexpr auto builds = 20;
+
+    auto src = std::string{};
+    for(const auto& inc_file : miopen::GetHipKernelIncList())
+        src += "#include \"" + inc_file + "\"\n";
+    const auto target   = miopen::TargetProperties{};
+    const auto includes = std::to_string(miopen::GetHipKernelIncList().size());
+
+    const auto measure = [&](bool write_includes) {
+        const auto start = std::chrono::steady_clock::now();
+        for(auto i = 0; i < builds; ++i)
+        {
+            boost::optional<miopen::TmpDir> tmp_dir{"test-hip-inc"};
+            if(write_includes)
+            {
+                for(const auto& inc_file : miopen::GetHipKernelIncList())
+                    miopen::WriteFile(miopen::GetKernelInc(inc_file), tmp_dir->path / inc_file);
+            }
+            const auto binary = miopen::HipBuild(tmp_dir, "kernel.cpp", src, "", target);
+            EXPECT(ReadFile(binary) == includes);
+        }
+        const auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::milli>(end - start).count() / builds;
+    };
+
+    // The first build of the process writes the shared dir, let it happen before timing.
+    EXPECT(!miopen::GetHipKernelIncDir().empty());
+    const auto fresh_ms  = measure(true);
+    const auto shared_ms = measure(false);
+
+    std::cout << includes << " includes, " << builds << " builds, ms per build: fresh dir "
+              << fresh_ms << ", shared dir " << shared_ms << std::endl;
+}
+
+int main(int argc, const char** argv)
+{
+    if(argc > 1 && std::string{argv[1]} == "--stub-compiler")
+        return stub_compiler(argc, argv);
+
+    // Has to be set before the first build, as the environment is read once.
+    const auto self = boost::filesystem::read_symlink("/proc/self/exe").string();
+    setenv("MIOPEN_DEBUG_HIP_COMPILER", (self + " --stub-compiler").c_str(), 1); // NOLINT
+    check_contents();
+    check_build_time();
+}
@@ -0,0 +1,201 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include "test.hpp"
+#include "driver.hpp"
+#include "get_handle.hpp"
+#include <miopen/conv/context.hpp>
+#include <miopen/conv/immed_cache.hpp>
+#include <miopen/convolution.hpp>
+#include <miopen/env.hpp>
+#include <miopen/solver.hpp>
+#include <miopen/tensor.hpp>
+#include <miopen/tmp_dir.hpp>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_CONV_IMMED_CACHE)
+
+namespace miopen {
+namespace tests {
+
+using Solutions = conv::ImmedSolutionsCache::Solutions;
+
+static bool Equal(const Solutions& left, const Solutions& right)
+{
+    return std::equal(left.begin(),
+                      left.end(),
+                      right.begin(),
+                      right.end(),
+                      [](const miopenConvSolution_t& l, const miopenConvSolution_t& r) {
+                          return l.time == r.time && l.workspace_size == r.workspace_size &&
+                                 l.solution_id == r.solution_id && l.algorithm == r.algorithm;
+                      });
+}
+
+static std::vector<solver::Id> GetSolverIds(std::size_t count)
+{
+    auto ids = solver::GetSolversByPrimitive(solver::Primitive::Convolution);
+    ids.resize(count);
+    return ids;
+}
+
+static Solutions MakeSolutions()
+{
+    // Equal times make sure that the order does not come from sorting.
+    const auto ids = GetSolverIds(3);
+    return {
+        {2.0f, 0, ids[2].Value(), ids[2].GetAlgo()},
+        {2.0f, 256, ids[0].Value(), ids[0].GetAlgo()},
+        {-1.0f, 0, ids[1].Value(), ids[1].GetAlgo()},
+    };
+}
+
+struct ImmedCacheTestDriver : test_driver
+{
+    void run() const
+    {
+        CheckKey();
+        CheckEviction();
+        CheckDiskRoundTrip();
+        CheckRepeatedQueries();
+    }
+
+    private:
+    static ConvolutionContext MakeContext(std::size_t channels)
+    {
+        const auto conv = ConvolutionDescriptor{{1, 1}};
+        const auto x    = TensorDescriptor{miopenFloat, {1, channels, 16, 16}};
+        const auto w    = TensorDescriptor{miopenFloat, {8, channels, 3, 3}};
+        const auto y    = conv.GetForwardOutputTensor(x, w);
+        return ConvolutionContext{x, w, y, conv, conv::Direction::Forward};
+    }
+
+    static void CheckKey()
+    {
+        const auto ctx   = MakeContext(8);
+        const auto other = MakeContext(16);
+        const auto key   = conv::GetImmedCacheKey(ctx, ctx, 'F', "gfx900_64", 0x1f);
+
+        EXPECT_EQUAL(key, conv::GetImmedCacheKey(ctx, ctx, 'F', "gfx900_64", 0x1f));
+        EXPECT(key != conv::GetImmedCacheKey(other, other, 'F', "gfx900_64", 0x1f));
+        EXPECT(key != conv::GetImmedCacheKey(ctx, ctx, 'F', "gfx906_60", 0x1f));
+        EXPECT(key != conv::GetImmedCacheKey(ctx, ctx, 'F', "gfx900_64", 0x1d));
+        EXPECT(key != conv::GetImmedCacheKey(ctx, ctx, 'D', "gfx900_64", 0x1f));
+    }
+
+    static void CheckEviction()
+    {
+        conv::ImmedSolutionsCache cache{8};
+        const auto solutions = MakeSolutions();
+        for(auto i = 0; i < 8; ++i)
+            cache.Store(std::to_string(i), solutions);
+
+        auto found = Solutions{};
+        EXPECT(cache.Find("0", found));
+        EXPECT(Equal(found, solutions));
+
+        // Only the least recently used entry is dropped, not the whole cache.
+        cache.Store("8", solutions);
+        EXPECT_EQUAL(cache.Size(), 8u);
+        EXPECT_EQUAL(cache.GetStats().evictions, 1u);
+        EXPECT(cache.Find("0", found));
+        EXPECT(!cache.Find("1", found));
+        EXPECT(cache.Find("8", found));
+        EXPECT_EQUAL(cache.GetStats().hits, 3u);
+        EXPECT_EQUAL(cache.GetStats().misses, 1u);
+    }
+
+    static void CheckDiskRoundTrip()
+    {
+        const TmpDir dir{"immed_cache"};
+        const auto path      = (dir.path / "gfx900_64.uidb.txt").string();
+        const auto solutions = MakeSolutions();
+
+        auto loaded = Solutions{};
+        EXPECT(!conv::LoadImmedSolutions(path, "key", loaded));
+        EXPECT(conv::StoreImmedSolutions(path, "key", solutions));
+        EXPECT(conv::LoadImmedSolutions(path, "key", loaded));
+        EXPECT(Equal(loaded, solutions));
+        EXPECT(!conv::LoadImmedSolutions(path, "other", loaded));
+    }
+
+    /// Runs the immediate mode queries on the device. When the cache is disabled with
+    /// MIOPEN_DEBUG_CONV_IMMED_CACHE=0 (see test_immed_cache_disabled), it must not be used.
+    static void CheckRepeatedQueries()
+    {
+        auto&& handle        = get_handle();
+        const auto conv      = ConvolutionDescriptor{{1, 1}};
+        const auto x         = TensorDescriptor{miopenFloat, {1, 8, 16, 16}};
+        const auto w         = TensorDescriptor{miopenFloat, {8, 8, 3, 3}};
+        const auto y         = conv.GetForwardOutputTensor(x, w);
+        const auto& cache    = conv::ImmedSolutionsCache::Instance();
+        const auto use_cache = !miopen::IsDisabled(MIOPEN_DEBUG_CONV_IMMED_CACHE{});
+
+        const auto query = [&]() {
+            auto solutions = Solutions(conv.GetForwardSolutionCount(handle, w, x, y));
+            auto count     = std::size_t{0};
+            conv.GetForwardSolutions(
+                handle, w, x, y, solutions.size(), &count, solutions.data(), nullptr);
+            solutions.resize(count);
+            return solutions;
+        };
+
+        const auto first  = query();
+        const auto before = cache.GetStats();
+        const auto second = query();
+        const auto after  = cache.GetStats();
+
+        EXPECT(!first.empty());
+        EXPECT(Equal(second, first));
+        for(std::size_t i = 1; i < first.size(); ++i)
+        {
+            if(first[i].time > 0)
+                EXPECT(first[i - 1].time > 0 && first[i - 1].time <= first[i].time);
+        }
+
+        // The second round is served from the cache without scanning the solvers again.
+        EXPECT_EQUAL(after.misses, before.misses);
+        if(use_cache)
+        {
+            EXPECT(after.hits > before.hits);
+        }
+        else
+        {
+            EXPECT_EQUAL(after.hits, before.hits);
+            EXPECT_EQUAL(cache.Size(), 0u);
+        }
+    }
+};
+
+} // namespace tests
+} // namespace miopen
+
+int main(int argc, const char** argv)
+{
+    test_drive<miopen::tests::ImmedCacheTestDriver>(argc, argv);
+}
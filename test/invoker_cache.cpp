@@ -0,0 +1,138 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include "test.hpp"
+#include "driver.hpp"
+#include <miopen/invoker_cache.hpp>
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace miopen {
+namespace tests {
+
+/// Invoker that tells which one it is.
+struct TaggedInvoker
+{
+    std::size_t tag;
+    void operator()(const Handle&, const AnyInvokeParams&) const {}
+};
+
+std::size_t GetTag(const boost::optional<const Invoker&>& invoker)
+{
+    if(!invoker)
+        return 0;
+    const auto tagged = invoker->target<TaggedInvoker>();
+    return tagged == nullptr ? 0 : tagged->tag;
+}
+
+NetworkConfig GetConfig(std::size_t i)
+{
+    return NetworkConfig{"64-28-28-3x3x" + std::to_string(i) + "-0x0-1x1-1x1-0-NCHW-FP32-F"};
+}
+
+struct InvokerCacheTestDriver : test_driver
+{
+    void run() const
+    {
+        const auto& solvers = solver::GetSolversByPrimitive(solver::Primitive::Convolution);
+        const auto solver_a = solvers.at(0);
+        const auto solver_b = solvers.at(1);
+        const auto algo_a   = AlgorithmName{solver_a.GetAlgo(conv::Direction::Forward)};
+
+        {
+            InvokerCache cache;
+            const auto config = GetConfig(0);
+            EXPECT(!cache.Get(config, solver_a));
+            EXPECT(!cache.GetFound1_0(config, algo_a));
+            EXPECT(throws([&]() { cache.SetAsFound1_0(config, algo_a, solver_a); }));
+            EXPECT(throws([&]() { cache.Register(config, solver::Id{}, TaggedInvoker{1}); }));
+
+            cache.Register(config, solver_a, TaggedInvoker{1});
+            cache.Register(config, solver_b, TaggedInvoker{2});
+            // The invoker registered first is kept.
+            cache.Register(config, solver_a, TaggedInvoker{3});
+            EXPECT_EQUAL(GetTag(cache.Get(config, solver_a)), 1u);
+            EXPECT_EQUAL(GetTag(cache.Get(config, solver_b)), 2u);
+            EXPECT(!cache.Get(GetConfig(1), solver_a));
+
+            cache.SetAsFound1_0(config, algo_a, solver_a);
+            EXPECT_EQUAL(GetTag(cache.GetFound1_0(config, algo_a)), 1u);
+            cache.SetAsFound1_0(config, algo_a, solver_b);
+            EXPECT_EQUAL(GetTag(cache.GetFound1_0(config, algo_a)), 2u);
+            EXPECT(!cache.GetFound1_0(GetConfig(1), algo_a));
+        }
+
+        {
+            // Many more entries than the initial table has buckets, with readers checking the
+            // entries published so far while the writer adds the rest.
+            constexpr std::size_t n = 2000;
+            InvokerCache cache;
+            std::atomic<std::size_t> published{0};
+            std::atomic<std::size_t> mismatches{0};
+            std::vector<std::thread> readers;
+            for(auto t = 0; t < 3; ++t)
+            {
+                readers.emplace_back([&]() {
+                    while(published.load() < n)
+                    {
+                        const auto upto = published.load();
+                        for(std::size_t i = 0; i < upto; ++i)
+                        {
+                            const auto config = GetConfig(i);
+                            if(GetTag(cache.Get(config, solver_a)) != i + 1 ||
+                               GetTag(cache.GetFound1_0(config, algo_a)) != i + 1)
+                                ++mismatches;
+                        }
+                    }
+                });
+            }
+
+            for(std::size_t i = 0; i < n; ++i)
+            {
+                const auto config = GetConfig(i);
+                cache.Register(config, solver_a, TaggedInvoker{i + 1});
+                cache.SetAsFound1_0(config, algo_a, solver_a);
+                ++published;
+            }
+            for(auto& reader : readers)
+                reader.join();
+
+            EXPECT_EQUAL(mismatches.load(), 0u);
+            for(std::size_t i = 0; i < n; ++i)
+                EXPECT_EQUAL(GetTag(cache.Get(GetConfig(i), solver_a)), i + 1);
+        }
+    }
+};
+
+} // namespace tests
+} // namespace miopen
+
+int main(int argc, const char** argn)
+{
+    test_drive<miopen::tests::InvokerCacheTestDriver>(argc, argn);
+}
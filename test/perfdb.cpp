@@ -29,7 +29,9 @@
 
 #include <miopen/db.hpp>
 #include <miopen/db_record.hpp>
+#include <miopen/db_record_cache.hpp>
 #include <miopen/lock_file.hpp>
+#include <miopen/readonlyramdb.hpp>
 #include <miopen/temp_file.hpp>
 
 #include <boost/filesystem/operations.hpp>
@@ -37,6 +39,7 @@
 #include <boost/optional.hpp>
 
 #include <array>
+#include <chrono>
 #include <cstdio>
 #include <cstdlib>
 #include <fstream>
@@ -533,6 +536,215 @@ class DbParallelTest : public DbTest
     }
 };
 
+class DbReadonlyRamTest : public DbTest
+{
+    public:
+    void Run() const
+    {
+        std::cout << "Testing readonly ram db..." << std::endl;
+
+        const auto other_key = TestData(10, 20);
+        const auto dup_value = TestData(30, 40);
+
+        ResetDb();
+        RawWrite(temp_file, key(), common_data());
+        std::ofstream(temp_file, std::ios::app) << "ill-formed line" << std::endl
+                                                << std::endl
+                                                << other_key.x << ',' << other_key.y << '='
+                                                << id2() << ':' << value2().x << ','
+                                                << value2().y << std::endl
+                                                << key().x << ',' << key().y << '=' << id0()
+                                                << ':' << dup_value.x << ',' << dup_value.y;
+
+        const auto& db = ReadonlyRamDb::GetCached(temp_file, false);
+        EXPECT(&db == &ReadonlyRamDb::GetCached(temp_file, false));
+
+        // The first occurrence of a key wins; repeated lookups return memoized records.
+        for(auto i = 0; i < 2; ++i)
+        {
+            const auto record = db.FindRecord(key());
+            EXPECT(record);
+            EXPECT_EQUAL(record->GetKey(), DbRecord(key()).GetKey());
+
+            TestData read;
+            for(const auto& id_value : common_data())
+            {
+                EXPECT(record->GetValues(id_value.first, read));
+                EXPECT_EQUAL(id_value.second, read);
+            }
+
+            EXPECT(db.Load(other_key, id2(), read));
+            EXPECT_EQUAL(read, value2());
+            EXPECT(!db.Load(other_key, id0(), read));
+            EXPECT(!db.FindRecord(TestData(100, 200)));
+        }
+
+        TempFile empty_file("miopen.tests.perfdb");
+        EXPECT(!ReadonlyRamDb::GetCached(empty_file, false).FindRecord(key()));
+    }
+};
+
+class DbIndexedOperationsTest : public DbTest
+{
+    public:
+    void Run() const
+    {
+        std::cout << "Testing indexed db operations..." << std::endl;
+
+        ResetDb();
+        RawWrite(temp_file, key(), common_data());
+
+        {
+            PlainTextDb db(temp_file, false, true);
+            ValidateSingleEntry(key(), common_data(), db);
+
+            const auto other_key = TestData(10, 20);
+            EXPECT(db.Update(other_key, id2(), value2()));
+            EXPECT(db.Remove(key(), id0()));
+
+            TestData read;
+            EXPECT(!db.Load(key(), id0(), read));
+            EXPECT(db.Load(key(), id1(), read));
+            EXPECT_EQUAL(read, value1());
+            EXPECT(db.Load(other_key, id2(), read));
+            EXPECT_EQUAL(read, value2());
+
+            EXPECT(db.RemoveRecord(other_key));
+            EXPECT(!db.FindRecord(other_key));
+        }
+
+        {
+            // Changes made by other instances have to be visible through a fresh index.
+            PlainTextDb db(temp_file, false, true);
+            EXPECT(db.Update(key(), id0(), value0()));
+            ValidateSingleEntry(key(), common_data(), PlainTextDb(temp_file, false, true));
+        }
+
+        // Appended updates leave stale lines which have to be compacted eventually.
+        {
+            PlainTextDb db(temp_file, false, true);
+            for(auto i = 0; i < 2048; ++i)
+                EXPECT(db.Update(key(), id2(), TestData(i, i)));
+        }
+
+        const auto file_size = boost::filesystem::file_size(temp_file.Path());
+        EXPECT(file_size < 16 * 1024);
+
+        const std::array<std::pair<const std::string, TestData>, 3> data{{
+            {id0(), value0()}, {id1(), value1()}, {id2(), TestData(2047, 2047)},
+        }};
+
+        ValidateSingleEntry(key(), data, PlainTextDb(temp_file, false, true));
+    }
+};
+
+class DbMixedModesTest : public DbTest
+{
+    public:
+    void Run() const
+    {
+        std::cout << "Testing db shared by indexed and default modes..." << std::endl;
+
+        ResetDb();
+        RawWrite(temp_file, key(), common_data());
+
+        const auto other_key = TestData(10, 20);
+        {
+            PlainTextDb db(temp_file, false, true);
+            EXPECT(db.Update(key(), id2(), TestData(7, 7)));
+            EXPECT(db.Update(other_key, id1(), value1()));
+            EXPECT(db.RemoveRecord(other_key));
+        }
+
+        {
+            std::ifstream file(temp_file);
+            std::string marker;
+            std::getline(file, marker);
+            EXPECT_EQUAL(marker, "#miopen-text-db=indexed");
+        }
+
+        // The default mode has to see the latest values and no removed keys.
+        {
+            PlainTextDb db(temp_file, false, false);
+            EXPECT(!db.FindRecord(other_key));
+
+            TestData read;
+            EXPECT(db.Load(key(), id2(), read));
+            EXPECT_EQUAL(read, TestData(7, 7));
+            EXPECT(db.Update(other_key, id0(), value0()));
+            EXPECT(db.Remove(key(), id1()));
+            EXPECT(!db.Load(key(), id1(), read));
+            EXPECT(db.Load(other_key, id0(), read));
+            EXPECT_EQUAL(read, value0());
+        }
+
+        // Updates made by the default mode have to be visible in the indexed one.
+        {
+            PlainTextDb db(temp_file, false, true);
+            TestData read;
+            EXPECT(!db.Load(key(), id1(), read));
+            EXPECT(db.Load(key(), id0(), read));
+            EXPECT_EQUAL(read, value0());
+            EXPECT(db.Load(key(), id2(), read));
+            EXPECT_EQUAL(read, TestData(7, 7));
+            EXPECT(db.Load(other_key, id0(), read));
+            EXPECT_EQUAL(read, value0());
+
+            EXPECT(db.RemoveRecord(other_key));
+            EXPECT(!PlainTextDb(temp_file, false, false).FindRecord(other_key));
+        }
+    }
+};
+
+class DbIndexedLookupBenchmark : public DbTest
+{
+    public:
+    void Run() const
+    {
+        std::cout << "Benchmarking db lookups with and without index..." << std::endl;
+
+        constexpr auto records_count = 100000;
+        constexpr auto scan_lookups  = 16;
+
+        ResetDb();
+        {
+            std::ofstream file(temp_file);
+            for(auto i = 0; i < records_count; ++i)
+                file << i << ',' << i << '=' << id0() << ':' << i << ',' << -i << std::endl;
+        }
+
+        Random rnd(42);
+        auto keys = std::vector<int>{};
+        keys.reserve(records_count);
+        for(auto i = 0; i < records_count; ++i)
+            keys.push_back(static_cast<int>(rnd.Next() % records_count));
+
+        const auto measure = [&](bool indexed, int lookups) {
+            PlainTextDb db(temp_file, false, indexed);
+            const auto start = std::chrono::steady_clock::now();
+
+            for(auto i = 0; i < lookups; ++i)
+            {
+                const auto k = keys[i];
+                TestData read;
+                EXPECT(db.Load(TestData(k, k), id0(), read));
+                EXPECT_EQUAL(read, TestData(k, -k));
+            }
+
+            const auto end = std::chrono::steady_clock::now();
+            return std::chrono::duration<double, std::micro>(end - start).count() / lookups;
+        };
+
+        const auto scan         = measure(false, scan_lookups);
+        const auto index_build  = measure(true, 1);
+        const auto index_lookup = measure(true, records_count);
+
+        std::cout << records_count << " records, us per lookup: scan " << scan << ", indexed "
+                  << index_lookup << " (first lookup incl. index build " << index_build << ")"
+                  << std::endl;
+    }
+};
+
 class DBMultiThreadedTestWork
 {
     public:
@@ -1191,6 +1403,82 @@ class DbMultiFileOperationsTest : public DbMultiFileTest
     }
 };
 
+class DbMultiFileCacheTest : public DbMultiFileTest
+{
+    public:
+    void Run() const
+    {
+        std::cout << "Testing multifile db record cache..." << std::endl;
+
+        auto& cache = DbRecordCache::Instance();
+        if(!cache.IsEnabled())
+            return;
+
+        ResetDb();
+        RawWrite(temp_file, key(), common_data());
+        cache.Clear();
+
+        using Db = MultiFileDb<PlainTextDb, PlainTextDb, true>;
+
+        {
+            Db db(temp_file, user_db_path);
+            ValidateSingleEntry(key(), common_data(), db);
+            EXPECT(!db.FindRecord(TestData(100, 200)));
+            EXPECT_EQUAL(cache.GetStats().misses, 2u);
+
+            TestData read;
+            EXPECT(db.Load(key(), id1(), read));
+            EXPECT_EQUAL(read, value1());
+            EXPECT(!db.Load(key(), id2(), read));
+            EXPECT(!db.FindRecord(TestData(100, 200)));
+            EXPECT_EQUAL(cache.GetStats().hits, 3u);
+            EXPECT_EQUAL(cache.GetStats().misses, 2u);
+        }
+
+        // Writes of this process have to be visible at once.
+        {
+            Db db(temp_file, user_db_path);
+            EXPECT(db.Update(key(), id1(), value2()));
+
+            TestData read;
+            EXPECT(db.Load(key(), id1(), read));
+            EXPECT_EQUAL(read, value2());
+        }
+
+        // So have to be changes of the files made bypassing MultiFileDb.
+        {
+            PlainTextDb user_db(user_db_path);
+            EXPECT(user_db.Update(key(), id1(), value0()));
+
+            TestData read;
+            EXPECT(Db(temp_file, user_db_path).Load(key(), id1(), read));
+            EXPECT_EQUAL(read, value0());
+        }
+
+        // Concurrent readers of a cached record neither miss nor wait on the db file locks.
+        const auto misses = cache.GetStats().misses;
+        auto threads      = std::vector<std::thread>{};
+
+        for(auto i = 0; i < 8; ++i)
+        {
+            threads.emplace_back([&]() {
+                Db db(temp_file, user_db_path);
+                for(auto j = 0; j < 1000; ++j)
+                {
+                    TestData read;
+                    EXPECT(db.Load(key(), id0(), read));
+                    EXPECT_EQUAL(read, value0());
+                }
+            });
+        }
+
+        for(auto& thread : threads)
+            thread.join();
+
+        EXPECT_EQUAL(cache.GetStats().misses, misses);
+    }
+};
+
 class DbMultiFileMultiThreadedReadTest : public DbMultiFileTest
 {
     public:
@@ -1312,6 +1600,10 @@ struct PerfDbDriver : test_driver
         DbWriteTest().Run();
         DbOperationsTest().Run();
         DbParallelTest().Run();
+        DbReadonlyRamTest().Run();
+        DbIndexedOperationsTest().Run();
+        DbMixedModesTest().Run();
+        DbIndexedLookupBenchmark().Run();
 
         DbMultiThreadedReadTest().Run();
         DbMultiProcessReadTest().Run();
@@ -1322,6 +1614,7 @@ struct PerfDbDriver : test_driver
         DbMultiFileReadTest<false>().Run();
         DbMultiFileWriteTest().Run();
         DbMultiFileOperationsTest().Run();
+        DbMultiFileCacheTest().Run();
         DbMultiFileMultiThreadedReadTest().Run();
         DbMultiFileMultiThreadedTest().Run();
 #endif
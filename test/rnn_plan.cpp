@@ -0,0 +1,208 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include "test.hpp"
+#include "driver.hpp"
+#include "get_handle.hpp"
+#include <miopen/env.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/rnn.hpp>
+#include <miopen/rnn_plan.hpp>
+
+#include <utility>
+#include <vector>
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_RNN_PLAN_CACHE)
+
+namespace miopen {
+namespace tests {
+
+using Launches = std::vector<std::pair<std::size_t, ConstData_t>>;
+
+static RNNDescriptor MakeRNN(int hsize)
+{
+    return {hsize,
+            1,
+            miopenLSTM,
+            miopenRNNlinear,
+            miopenRNNunidirection,
+            miopenRNNwithBias,
+            miopenRNNdefault,
+            miopenFloat};
+}
+
+static RNNPlanBindings Bind(std::vector<ConstData_t> buffers)
+{
+    auto bindings    = RNNPlanBindings{};
+    bindings.buffers = std::move(buffers);
+    return bindings;
+}
+
+struct RNNPlanTestDriver : test_driver
+{
+    void run() const
+    {
+        CheckKey();
+        CheckReplay();
+    }
+
+    private:
+    static std::vector<Allocator::ManageDataPtr> MakeBuffers(const Handle& handle, int count)
+    {
+        auto buffers = std::vector<Allocator::ManageDataPtr>{};
+        for(auto i = 0; i < count; ++i)
+            buffers.push_back(handle.Create(sizeof(float)));
+        return buffers;
+    }
+
+    // The buffers are laid out as in RNNDescriptor::RNNForwardInference():
+    // x, hx, cx, w, y, hy, cy, workSpace.
+    void CheckKey() const
+    {
+        auto&& handle    = get_handle();
+        const auto rnn   = MakeRNN(16);
+        const auto a     = MakeBuffers(handle, 8);
+        const auto b     = MakeBuffers(handle, 8);
+        const auto get_a = [&](int i) -> ConstData_t { return a[i].get(); };
+        const auto get_b = [&](int i) -> ConstData_t { return b[i].get(); };
+
+        const auto make_key = [&](std::vector<ConstData_t> buffers) {
+            auto key = RNNPlanKey{rnn, 'I', 4};
+            key.Add(Bind(std::move(buffers)));
+            return key;
+        };
+
+        const auto key = make_key(
+            {get_a(0), get_a(1), get_a(2), get_a(3), get_a(4), get_a(5), get_a(6), get_a(7)});
+
+        // Other buffers with the same pattern share the plan.
+        EXPECT(key == make_key({get_b(0),
+                                get_b(1),
+                                get_b(2),
+                                get_b(3),
+                                get_b(4),
+                                get_b(5),
+                                get_b(6),
+                                get_b(7)}));
+
+        // hx == nullptr
+        EXPECT(!(key == make_key({get_a(0),
+                                  nullptr,
+                                  get_a(2),
+                                  get_a(3),
+                                  get_a(4),
+                                  get_a(5),
+                                  get_a(6),
+                                  get_a(7)})));
+
+        // y aliases workSpace
+        EXPECT(!(key == make_key({get_a(0),
+                                  get_a(1),
+                                  get_a(2),
+                                  get_a(3),
+                                  get_a(7),
+                                  get_a(5),
+                                  get_a(6),
+                                  get_a(7)})));
+
+        // The key differs by the descriptor too.
+        auto other = RNNPlanKey{MakeRNN(32), 'I', 4};
+        other.Add(Bind(
+            {get_a(0), get_a(1), get_a(2), get_a(3), get_a(4), get_a(5), get_a(6), get_a(7)}));
+        EXPECT(!(key == other));
+    }
+
+    // Records a launch per non-null buffer, on the slot of the buffer, and checks that the calls
+    // after the first one replay the same launches on the buffers bound to them.
+    void CheckReplay() const
+    {
+        auto&& handle        = get_handle();
+        const auto use_cache = !miopen::IsDisabled(MIOPEN_DEBUG_RNN_PLAN_CACHE{});
+        const auto rnn       = MakeRNN(24);
+        const auto a         = MakeBuffers(handle, 3);
+        const auto b         = MakeBuffers(handle, 3);
+
+        auto launches   = Launches{};
+        auto recordings = 0;
+
+        const auto call = [&](std::vector<ConstData_t> buffers) {
+            const auto bindings = Bind(std::move(buffers));
+            auto key            = RNNPlanKey{rnn, 'I', 1};
+            key.Add(bindings);
+
+            launches.clear();
+            RunRNNPlan(handle, key, bindings, [&](RNNPlanRecorder& recorder) {
+                ++recordings;
+                for(std::size_t i = 0; i < bindings.buffers.size(); ++i)
+                {
+                    if(bindings.buffers[i] == nullptr)
+                        continue;
+                    const auto slot = recorder.Slot(bindings.buffers[i]);
+                    recorder.Record([&launches, i, slot](
+                        Handle&, const RNNPlanBindings& bound, float&) {
+                        launches.emplace_back(i, bound.buffers[slot]);
+                    });
+                }
+            });
+        };
+
+        call({a[0].get(), a[1].get(), a[2].get()});
+        EXPECT_EQUAL(recordings, 1);
+        EXPECT(launches == (Launches{{0, a[0].get()}, {1, a[1].get()}, {2, a[2].get()}}));
+
+        call({b[0].get(), b[1].get(), b[2].get()});
+        EXPECT_EQUAL(recordings, use_cache ? 1 : 2);
+        EXPECT(launches == (Launches{{0, b[0].get()}, {1, b[1].get()}, {2, b[2].get()}}));
+
+        // A null buffer selects other launches, so it gets a plan of its own.
+        call({a[0].get(), nullptr, a[2].get()});
+        EXPECT_EQUAL(recordings, use_cache ? 2 : 3);
+        EXPECT(launches == (Launches{{0, a[0].get()}, {2, a[2].get()}}));
+
+        call({b[0].get(), nullptr, b[2].get()});
+        EXPECT_EQUAL(recordings, use_cache ? 2 : 4);
+        EXPECT(launches == (Launches{{0, b[0].get()}, {2, b[2].get()}}));
+
+        // Aliased buffers are bound through the slot of the first one.
+        call({a[0].get(), a[0].get(), a[2].get()});
+        EXPECT_EQUAL(recordings, use_cache ? 3 : 5);
+        call({b[1].get(), b[1].get(), b[2].get()});
+        EXPECT_EQUAL(recordings, use_cache ? 3 : 6);
+        EXPECT(launches == (Launches{{0, b[1].get()}, {1, b[1].get()}, {2, b[2].get()}}));
+
+        // Buffers which are not aliased must not replay the plan of the aliased ones.
+        call({b[0].get(), b[1].get(), b[2].get()});
+        EXPECT_EQUAL(recordings, use_cache ? 3 : 7);
+        EXPECT(launches == (Launches{{0, b[0].get()}, {1, b[1].get()}, {2, b[2].get()}}));
+    }
+};
+
+} // namespace tests
+} // namespace miopen
+
+int main(int argc, const char** argv)
+{
+    test_drive<miopen::tests::RNNPlanTestDriver>(argc, argv);
+}
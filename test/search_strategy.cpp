@@ -0,0 +1,189 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include "test.hpp"
+#include "driver.hpp"
+#include <miopen/search_strategy.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <set>
+#include <thread>
+
+namespace miopen {
+namespace tests {
+
+using solver::SearchBudget;
+using solver::SearchEvaluator;
+using solver::SearchResult;
+using solver::SearchStrategy;
+
+/// Replaces the invokers with a cost model. Negative costs denote failing configs.
+class SyntheticEvaluator : public SearchEvaluator
+{
+    public:
+    explicit SyntheticEvaluator(std::function<float(std::size_t)> cost_) : cost(std::move(cost_))
+    {
+    }
+
+    std::set<std::size_t> prepared;
+    std::set<std::size_t> measured;
+    std::chrono::milliseconds delay{0};
+
+    void Prepare(const std::vector<std::size_t>& indices) override
+    {
+        prepared.insert(indices.begin(), indices.end());
+    }
+
+    bool Run(std::size_t index, std::size_t runs, float& time) override
+    {
+        // Every strategy has to prepare (i.e. compile) a config before it is timed.
+        EXPECT(prepared.count(index) != 0);
+        std::this_thread::sleep_for(delay);
+        measured.insert(index);
+        if(cost(index) < 0)
+            return false;
+        time = cost(index) * runs;
+        return true;
+    }
+
+    float GetBestMeasured() const
+    {
+        auto best = std::numeric_limits<float>::max();
+        for(const auto index : measured)
+            if(cost(index) >= 0)
+                best = std::min(best, cost(index));
+        return best;
+    }
+
+    private:
+    std::function<float(std::size_t)> cost;
+};
+
+struct SearchStrategyTestDriver : test_driver
+{
+    void run() const
+    {
+        const std::size_t n_configs = 1000;
+        const auto valley           = [](std::size_t i) {
+            if(i % 97 == 0)
+                return -1.0f;
+            return 1.0f + std::abs(static_cast<float>(i) - 700.0f);
+        };
+
+        {
+            auto evaluator    = SyntheticEvaluator{valley};
+            const auto result = Search(SearchStrategy::Exhaustive, {}, n_configs, evaluator);
+            EXPECT(result.is_passed);
+            EXPECT_EQUAL(result.best, 700u);
+            EXPECT_EQUAL(result.best_time, 1.0f);
+            EXPECT_EQUAL(result.n_trials, n_configs);
+            EXPECT_EQUAL(result.n_failed, 11u);
+            EXPECT_EQUAL(evaluator.prepared.size(), n_configs);
+        }
+
+        for(const auto strategy : {SearchStrategy::Random,
+                                   SearchStrategy::SuccessiveHalving,
+                                   SearchStrategy::Annealing})
+        {
+            auto budget       = SearchBudget{};
+            budget.max_trials = 50;
+            auto evaluator    = SyntheticEvaluator{valley};
+            const auto result = Search(strategy, budget, n_configs, evaluator);
+            EXPECT(result.is_passed);
+            EXPECT(result.n_trials <= budget.max_trials);
+            EXPECT(evaluator.measured.size() <= budget.max_trials);
+            EXPECT_EQUAL(valley(result.best), evaluator.GetBestMeasured());
+            EXPECT_EQUAL(result.best_time, valley(result.best));
+        }
+
+        {
+            // All configs in the first rung, the best one survives.
+            auto evaluator    = SyntheticEvaluator{valley};
+            const auto result = Search(SearchStrategy::SuccessiveHalving, {}, n_configs, evaluator);
+            EXPECT_EQUAL(result.best, 700u);
+            EXPECT(result.n_trials < 2 * n_configs);
+        }
+
+        {
+            // The walk finds the bottom of a smooth valley much faster than the random search.
+            auto evaluator    = SyntheticEvaluator{valley};
+            const auto result = Search(SearchStrategy::Annealing, {}, n_configs, evaluator);
+            EXPECT(result.n_trials <= 100);
+            EXPECT(result.best_time <= 5.0f);
+        }
+
+        {
+            auto budget     = SearchBudget{};
+            budget.patience = 5;
+            auto evaluator  = SyntheticEvaluator{[](std::size_t i) { return 1.0f + i; }};
+            const auto result = Search(SearchStrategy::Exhaustive, budget, n_configs, evaluator);
+            EXPECT_EQUAL(result.best, 0u);
+            EXPECT_EQUAL(result.n_trials, 6u);
+        }
+
+        {
+            auto budget     = SearchBudget{};
+            budget.max_time = std::chrono::milliseconds{1};
+            auto evaluator  = SyntheticEvaluator{valley};
+            evaluator.delay = std::chrono::milliseconds{2};
+            const auto result = Search(SearchStrategy::Exhaustive, budget, n_configs, evaluator);
+            EXPECT_EQUAL(result.n_trials, 1u);
+        }
+
+        {
+            auto evaluator    = SyntheticEvaluator{[](std::size_t) { return -1.0f; }};
+            const auto result = Search(SearchStrategy::Random, {}, n_configs, evaluator);
+            EXPECT(!result.is_passed);
+            EXPECT_EQUAL(result.n_failed, result.n_trials);
+        }
+
+        {
+            auto evaluator    = SyntheticEvaluator{valley};
+            const auto result = Search(SearchStrategy::Annealing, {}, 0, evaluator);
+            EXPECT(!result.is_passed);
+            EXPECT_EQUAL(result.n_trials, 0u);
+        }
+    }
+
+    private:
+    static SearchResult Search(SearchStrategy strategy,
+                               const SearchBudget& budget,
+                               std::size_t n_configs,
+                               SearchEvaluator& evaluator)
+    {
+        return solver::RunSearch(strategy, budget, n_configs, evaluator);
+    }
+};
+
+} // namespace tests
+} // namespace miopen
+
+int main(int argc, const char** argn)
+{
+    test_drive<miopen::tests::SearchStrategyTestDriver>(argc, argn);
+}
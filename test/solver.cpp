@@ -120,11 +120,14 @@ class SearchableTestSolver : public solver::SolverBase<ConvolutionContext>
 // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
 int SearchableTestSolver::_serches_done = 0;
 
-static solver::ConvSolution FindSolution(const ConvolutionContext& ctx, const std::string& db_path)
+static solver::ConvSolution FindSolution(const ConvolutionContext& ctx,
+                                         const std::string& db_path,
+                                         std::size_t eval_threads)
 {
     PlainTextDb db(db_path);
 
-    const auto solvers = solver::SolverContainer<TrivialTestSolver, SearchableTestSolver>{};
+    auto solvers         = solver::SolverContainer<TrivialTestSolver, SearchableTestSolver>{};
+    solvers.eval_threads = eval_threads;
 
     return solvers.SearchForAllSolutions(ctx, db, {}, 1).front();
 }
@@ -184,10 +187,14 @@ class SolverTest
         ctx.SetStream(&get_handle());
         context_filler(ctx);
 
-        const auto sol = FindSolution(ctx, db_path);
+        // Concurrent evaluation of solvers must not change the result.
+        for(const auto eval_threads : {1, 4})
+        {
+            const auto sol = FindSolution(ctx, db_path, eval_threads);
 
-        EXPECT_OP(sol.construction_params.size(), >, 0);
-        EXPECT_EQUAL(sol.construction_params[0].kernel_file, expected_kernel);
+            EXPECT_OP(sol.construction_params.size(), >, 0u);
+            EXPECT_EQUAL(sol.construction_params[0].kernel_file, expected_kernel);
+        }
     }
 };
 } // namespace tests
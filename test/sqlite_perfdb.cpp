@@ -40,11 +40,13 @@
 #include <boost/thread.hpp>
 
 #include <array>
+#include <chrono>
 #include <cstdio>
 #include <cstdlib>
 #include <fstream>
 #include <mutex>
 #include <random>
+#include <stdexcept>
 #include <string>
 #include <thread>
 #include <vector>
@@ -463,6 +465,135 @@ class DbOperationsTest : public DbTest
     }
 };
 
+class DbTransactionTest : public DbTest
+{
+    public:
+    void Run() const
+    {
+        std::cout << "Testing db transactions..." << std::endl;
+
+        ResetDb();
+        const ProblemData p0(1);
+        const ProblemData p1(2);
+        SQLitePerfDb db(std::string(temp_file), false, "gfx906", 64);
+
+        {
+            SQLite::Transaction transaction{db.sql};
+            EXPECT(db.Update(p0, id0(), value0()));
+            {
+                // Nested transactions are merged into the outer one.
+                SQLite::Transaction nested{db.sql};
+                EXPECT(db.Update(p1, id1(), value1()));
+                nested.Commit();
+            }
+            // Not committed, has to be rolled back.
+        }
+
+        EXPECT(!db.FindRecord(p0));
+        EXPECT(!db.FindRecord(p1));
+
+        {
+            SQLite::Transaction transaction{db.sql};
+            EXPECT(db.Update(p0, id0(), value0()));
+            EXPECT(db.Update(p1, id1(), value1()));
+            transaction.Commit();
+        }
+
+        SolverData read;
+        EXPECT(db.Load(p0, id0(), read));
+        EXPECT_EQUAL(read, value0());
+        EXPECT(db.Load(p1, id1(), read));
+        EXPECT_EQUAL(read, value1());
+
+        const ProblemData p2(3);
+        try
+        {
+            db.Batch([&]() {
+                EXPECT(db.Update(p2, id0(), value0()));
+                throw std::runtime_error("Interrupted batch");
+            });
+        }
+        catch(const std::runtime_error&)
+        {
+        }
+
+        // An interrupted batch is rolled back.
+        EXPECT(!db.FindRecord(p2));
+
+        // Batches of a multi-file db are written into the user db.
+        DbTimer<MultiFileDb<SQLitePerfDb, SQLitePerfDb, true>> multi_db{
+            "", std::string(temp_file), "gfx906", 64};
+        multi_db.Batch([&]() { EXPECT(multi_db.Update(p2, id0(), value0())); });
+        EXPECT(db.Load(p2, id0(), read));
+        EXPECT_EQUAL(read, value0());
+    }
+};
+
+class DbBenchmark : public DbTest
+{
+    public:
+    void Run() const
+    {
+        std::cout << "Benchmarking db lookups and updates..." << std::endl;
+
+        constexpr auto records_count = 1000;
+        ResetDb();
+        SQLitePerfDb db(std::string(temp_file), false, "gfx906", 64);
+
+        const auto measure = [](auto&& func) {
+            const auto start = std::chrono::steady_clock::now();
+            func();
+            const auto end = std::chrono::steady_clock::now();
+            return std::chrono::duration<double>(end - start).count();
+        };
+
+        const auto update_time = measure([&]() {
+            for(auto i = 0; i < records_count / 10; ++i)
+                EXPECT(db.Update(ProblemData(i), id0(), value0()));
+        });
+
+        const auto batched_update_time = measure([&]() {
+            SQLite::Transaction transaction{db.sql};
+            for(auto i = records_count / 10; i < records_count; ++i)
+                EXPECT(db.Update(ProblemData(i), id0(), value0()));
+            transaction.Commit();
+        });
+
+        // Statement prepared on every call with inlined arch and num_cu, as done before the
+        // statement cache was introduced.
+        const auto uncached_lookup_time = measure([&]() {
+            for(auto i = 0; i < records_count; ++i)
+            {
+                const auto p = ProblemData(i);
+                std::string clause;
+                std::vector<std::string> values;
+                std::tie(clause, values) = p.WhereClause();
+                const auto query = "SELECT solver, params FROM perf_db INNER JOIN " +
+                                   p.table_name() + " ON perf_db.config = " + p.table_name() +
+                                   ".id WHERE ( " + clause + " ) AND (arch = 'gfx906' ) " +
+                                   "AND (num_cu = '64');";
+                auto stmt = SQLite::Statement{db.sql, query, values};
+                EXPECT(stmt.Step(db.sql) == SQLITE_ROW);
+            }
+        });
+
+        const auto cached_lookup_time = measure([&]() {
+            for(auto i = 0; i < records_count; ++i)
+            {
+                auto p = ProblemData(i);
+                EXPECT(db.FindRecord(p));
+            }
+        });
+
+        std::cout << "Updates/sec: " << (records_count / 10) / update_time
+                  << ", batched: " << (records_count - records_count / 10) / batched_update_time
+                  << std::endl;
+        std::cout << "Lookups/sec: " << records_count / uncached_lookup_time
+                  << ", with statement cache: " << records_count / cached_lookup_time
+                  << std::endl;
+    }
+};
+
 class DbParallelTest : public DbTest
 {
     public:
@@ -1260,6 +1391,8 @@ struct PerfDbDriver : test_driver
         }
         DbFindTest().Run();
         DbOperationsTest().Run();
+        DbTransactionTest().Run();
+        DbBenchmark().Run();
         DbParallelTest().Run();
         DbMultiThreadedTest().Run();
         DbMultiThreadedReadTest().Run();
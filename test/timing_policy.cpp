@@ -0,0 +1,187 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include "test.hpp"
+#include "driver.hpp"
+#include <miopen/perf_field.hpp>
+#include <miopen/timing_policy.hpp>
+
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace miopen {
+namespace tests {
+
+/// Replaces Handle::GetKernelTime() with the given times of consecutive launches.
+class SyntheticTimer
+{
+    public:
+    explicit SyntheticTimer(std::vector<float> times_) : times(std::move(times_)) {}
+
+    std::size_t launches = 0;
+    std::size_t fail_at  = std::numeric_limits<std::size_t>::max();
+
+    bool operator()(float& time)
+    {
+        if(launches == fail_at)
+            return false;
+        time = times.at(launches++);
+        return true;
+    }
+
+    private:
+    std::vector<float> times;
+};
+
+struct TimingPolicyTestDriver : test_driver
+{
+    void run() const
+    {
+        const auto no_best = std::numeric_limits<float>::max();
+        // The warm-up launch is the slow first one, the 4th measured one is an outlier.
+        const auto times = std::vector<float>{100.0f, 3.0f, 1.0f, 2.0f, 50.0f, 2.0f};
+
+        auto policy       = TimingPolicy{};
+        policy.warmup     = 1;
+        policy.repeats    = 5;
+        policy.early_exit = 0.0f;
+
+        {
+            policy.statistic = TimingStatistic::Median;
+            auto timer       = SyntheticTimer{times};
+            auto result      = TimingResult{};
+            EXPECT(MeasureTime(policy, no_best, std::ref(timer), result));
+            EXPECT_EQUAL(timer.launches, 6u);
+            EXPECT_EQUAL(result.runs, 5u);
+            EXPECT_EQUAL(result.time, 2.0f);
+            EXPECT(result.statistic == TimingStatistic::Median);
+
+            // The sample variance of 3, 1, 2, 50, 2.
+            const auto mean     = 58.0f / 5;
+            const auto variance = ((3 - mean) * (3 - mean) + (1 - mean) * (1 - mean) +
+                                   2 * (2 - mean) * (2 - mean) + (50 - mean) * (50 - mean)) /
+                                  4;
+            EXPECT(std::abs(result.variance - variance) < 1e-3f);
+        }
+
+        {
+            policy.statistic = TimingStatistic::Min;
+            auto result      = TimingResult{};
+            EXPECT(MeasureTime(policy, no_best, SyntheticTimer{times}, result));
+            EXPECT_EQUAL(result.time, 1.0f);
+        }
+
+        {
+            // Without the fastest and the slowest of the 5 runs.
+            policy.statistic = TimingStatistic::TrimmedMean;
+            auto result      = TimingResult{};
+            EXPECT(MeasureTime(policy, no_best, SyntheticTimer{times}, result));
+            EXPECT(std::abs(result.time - 7.0f / 3) < 1e-6f);
+        }
+
+        {
+            policy.statistic = TimingStatistic::Median;
+            policy.repeats   = 4;
+            auto result      = TimingResult{};
+            EXPECT(MeasureTime(policy, no_best, SyntheticTimer{times}, result));
+            EXPECT_EQUAL(result.time, 2.5f);
+            policy.repeats = 5;
+        }
+
+        {
+            policy.early_exit = 1.05f;
+            auto timer        = SyntheticTimer{times};
+            auto result       = TimingResult{};
+            EXPECT(MeasureTime(policy, 2.0f, std::ref(timer), result));
+            EXPECT_EQUAL(timer.launches, 2u);
+            EXPECT_EQUAL(result.runs, 1u);
+            EXPECT_EQUAL(result.time, 3.0f);
+            EXPECT_EQUAL(result.variance, 0.0f);
+
+            // Not clearly worse.
+            timer = SyntheticTimer{times};
+            EXPECT(MeasureTime(policy, 2.9f, std::ref(timer), result));
+            EXPECT_EQUAL(result.runs, 5u);
+            policy.early_exit = 0.0f;
+        }
+
+        {
+            auto timer    = SyntheticTimer{times};
+            timer.fail_at = 3;
+            auto result   = TimingResult{};
+            EXPECT(!MeasureTime(policy, no_best, std::ref(timer), result));
+            EXPECT_EQUAL(timer.launches, 3u);
+        }
+
+        {
+            policy.warmup  = 0;
+            policy.repeats = 0;
+            auto result    = TimingResult{};
+            EXPECT(MeasureTime(policy, no_best, SyntheticTimer{times}, result));
+            EXPECT_EQUAL(result.runs, 1u);
+            EXPECT_EQUAL(result.time, 100.0f);
+        }
+
+        {
+            const auto data = FindDbData{"ConvSolver",
+                                         0.5f,
+                                         128,
+                                         FindDbKCacheKey::MakeUnused("fwd"),
+                                         "MEDIAN",
+                                         0.25f};
+            std::ostringstream ss;
+            data.Serialize(ss);
+
+            auto read = FindDbData{};
+            EXPECT(read.Deserialize(ss.str()));
+            EXPECT_EQUAL(read.solver_id, "ConvSolver");
+            EXPECT_EQUAL(read.time, 0.5f);
+            EXPECT_EQUAL(read.workspace, 128u);
+            EXPECT_EQUAL(read.statistic, "MEDIAN");
+            EXPECT_EQUAL(read.variance, 0.25f);
+
+            // Records of older versions do not have the timing statistics.
+            auto legacy = FindDbData{};
+            EXPECT(legacy.Deserialize("ConvSolver,0.5,128,fwd,<unused>"));
+            EXPECT_EQUAL(legacy.time, 0.5f);
+            EXPECT_EQUAL(legacy.statistic, "MIN");
+            EXPECT_EQUAL(legacy.variance, -1.0f);
+            EXPECT(!legacy.Deserialize("ConvSolver,0.5"));
+        }
+    }
+};
+
+} // namespace tests
+} // namespace miopen
+
+int main(int argc, const char** argn)
+{
+    test_drive<miopen::tests::TimingPolicyTestDriver>(argc, argn);
+}
@@ -0,0 +1,232 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include "test.hpp"
+#include "driver.hpp"
+#include <miopen/tmp_dir.hpp>
+#include <miopen/tuning_checkpoint.hpp>
+
+#include <boost/filesystem/operations.hpp>
+
+#include <cmath>
+#include <fstream>
+#include <set>
+#include <string>
+#include <utility>
+
+namespace miopen {
+namespace tests {
+
+using solver::CheckpointedSearchEvaluator;
+using solver::SearchBudget;
+using solver::SearchEvaluator;
+using solver::SearchResult;
+using solver::SearchStrategy;
+using solver::TuningCheckpoint;
+
+struct Interrupted
+{
+};
+
+/// Replaces the invokers with a cost model and simulates the job being killed
+/// after the given number of measurements.
+class InterruptedEvaluator : public SearchEvaluator
+{
+    public:
+    explicit InterruptedEvaluator(std::size_t runs_left_) : runs_left(runs_left_) {}
+
+    std::set<std::size_t> prepared;
+    std::set<std::pair<std::size_t, std::size_t>> measured;
+    std::size_t n_runs = 0; ///< Measurements, i.e. trials and the runs outside of them.
+
+    static float Cost(std::size_t i)
+    {
+        if(i % 97 == 0)
+            return -1.0f;
+        return 1.0f + std::abs(static_cast<float>(i) - 700.0f);
+    }
+
+    void Prepare(const std::vector<std::size_t>& indices) override
+    {
+        prepared.insert(indices.begin(), indices.end());
+    }
+
+    bool Run(std::size_t index, std::size_t runs, float& time) override
+    {
+        if(!in_trial)
+            Interrupt();
+        measured.insert({index, runs});
+        if(Cost(index) < 0)
+            return false;
+        time = Cost(index) * runs;
+        return true;
+    }
+
+    /// The runs of a trial are counted as one measurement, so the job is killed between
+    /// trials and the halves of the search add up to the uninterrupted one.
+    bool Time(std::size_t index,
+              const TimingPolicy& policy,
+              float best,
+              TimingResult& result) override
+    {
+        Interrupt();
+        in_trial      = true;
+        const auto ok = SearchEvaluator::Time(index, policy, best, result);
+        in_trial      = false;
+        return ok;
+    }
+
+    private:
+    std::size_t runs_left;
+    bool in_trial = false;
+
+    void Interrupt()
+    {
+        if(runs_left-- == 0)
+            throw Interrupted{};
+        ++n_runs;
+    }
+};
+
+struct TuningCheckpointTestDriver : test_driver
+{
+    void run() const
+    {
+        const TmpDir tmp_dir{"test-tuning-checkpoint"};
+        const auto key = [](std::size_t index) { return "cfg" + std::to_string(index); };
+
+        {
+            const auto path = tmp_dir.path / "records.tuning.txt";
+            {
+                auto checkpoint = TuningCheckpoint{path};
+                EXPECT_EQUAL(checkpoint.GetSize(), 0u);
+                checkpoint.Record("a,1", 1, false, 0.125f);
+                checkpoint.Record("a,1", 4, false, 0.5f);
+                checkpoint.Record("b,2", 1, true, 3.0f);
+                checkpoint.Record("c,3", TuningCheckpoint::trial, false, 0.25f);
+                checkpoint.RecordBest("a,1", 0.125f);
+            }
+            {
+                // Simulate the process being killed in the middle of a write.
+                std::ofstream file(path.string(), std::ios::app);
+                file << "run 1 0.2";
+            }
+
+            auto checkpoint = TuningCheckpoint{path};
+            EXPECT_EQUAL(checkpoint.GetSize(), 4u);
+
+            auto failed = true;
+            auto time   = 0.0f;
+            EXPECT(checkpoint.Find("a,1", 4, failed, time));
+            EXPECT(!failed);
+            EXPECT_EQUAL(time, 0.5f);
+            EXPECT(checkpoint.Find("b,2", 1, failed, time));
+            EXPECT(failed);
+            EXPECT(!checkpoint.Find("b,2", 4, failed, time));
+            EXPECT(checkpoint.Find("c,3", TuningCheckpoint::trial, failed, time));
+            EXPECT(!failed);
+            EXPECT_EQUAL(time, 0.25f);
+            EXPECT(!checkpoint.Find("c,3", 1, failed, time));
+
+            auto best = std::string{};
+            EXPECT(checkpoint.GetBest(best, time));
+            EXPECT_EQUAL(best, "a,1");
+            EXPECT_EQUAL(time, 0.125f);
+
+            checkpoint.Remove();
+            EXPECT(!boost::filesystem::exists(path));
+        }
+
+        {
+            auto checkpoint = TuningCheckpoint{{}};
+            checkpoint.Record("a,1", 1, false, 1.0f);
+            checkpoint.Remove();
+            EXPECT(!checkpoint.IsEnabled());
+        }
+
+        for(const auto strategy : {SearchStrategy::Exhaustive,
+                                   SearchStrategy::Random,
+                                   SearchStrategy::SuccessiveHalving,
+                                   SearchStrategy::Annealing})
+        {
+            const std::size_t n_configs = 1000;
+            auto budget                 = SearchBudget{};
+            budget.max_trials           = 200;
+
+            auto uninterrupted    = InterruptedEvaluator{std::numeric_limits<std::size_t>::max()};
+            const auto expected   = solver::RunSearch(strategy, budget, n_configs, uninterrupted);
+            const auto n_runs     = uninterrupted.n_runs;
+            const auto path       = tmp_dir.path / "search.tuning.txt";
+
+            auto first = InterruptedEvaluator{n_runs / 2};
+            {
+                auto checkpoint   = TuningCheckpoint{path};
+                auto checkpointed = CheckpointedSearchEvaluator{first, checkpoint, key};
+                auto interrupted  = false;
+                try
+                {
+                    solver::RunSearch(strategy, budget, n_configs, checkpointed);
+                }
+                catch(const Interrupted&)
+                {
+                    interrupted = true;
+                }
+                EXPECT(interrupted);
+            }
+
+            auto checkpoint = TuningCheckpoint{path};
+            EXPECT(checkpoint.GetSize() != 0);
+            auto partial_best = std::string{};
+            auto partial_time = 0.0f;
+            EXPECT(checkpoint.GetBest(partial_best, partial_time));
+            EXPECT(partial_time >= expected.best_time);
+
+            auto second       = InterruptedEvaluator{std::numeric_limits<std::size_t>::max()};
+            auto checkpointed = CheckpointedSearchEvaluator{second, checkpoint, key};
+            const auto result = solver::RunSearch(strategy, budget, n_configs, checkpointed);
+            checkpoint.Remove();
+
+            EXPECT(checkpointed.GetReplayed() != 0);
+            for(const auto& measurement : second.measured)
+                EXPECT(first.measured.count(measurement) == 0);
+            for(const auto index : second.prepared)
+                EXPECT(first.measured.count({index, 1}) == 0);
+            EXPECT_EQUAL(first.n_runs + second.n_runs, n_runs);
+            EXPECT_EQUAL(result.is_passed, expected.is_passed);
+            EXPECT_EQUAL(result.best, expected.best);
+            EXPECT_EQUAL(result.best_time, expected.best_time);
+            EXPECT_EQUAL(result.n_trials, expected.n_trials);
+            EXPECT_EQUAL(result.n_failed, expected.n_failed);
+        }
+    }
+};
+
+} // namespace tests
+} // namespace miopen
+
+int main(int argc, const char** argn)
+{
+    test_drive<miopen::tests::TuningCheckpointTestDriver>(argc, argn);
+}
@@ -0,0 +1,159 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include "test.hpp"
+#include "driver.hpp"
+#include <miopen/warmup_plan.hpp>
+
+#include <sstream>
+#include <string>
+
+namespace miopen {
+namespace tests {
+
+struct WarmupPlanTestDriver : test_driver
+{
+    void run() const
+    {
+        CheckParse();
+        CheckPlan();
+    }
+
+    private:
+    static void CheckParse()
+    {
+        auto command = DriverConvCommand{};
+
+        EXPECT(!ParseDriverConvCommand("MIOpen(HIP): Info [Find] requestAlgoCount = 1", command));
+        EXPECT(!ParseDriverConvCommand("./bin/MIOpenDriver pool -n 1", command));
+        // Missing or malformed values.
+        EXPECT(!ParseDriverConvCommand("./bin/MIOpenDriver conv -n 1 -c 3 -H 8 -W 8", command));
+        EXPECT(!ParseDriverConvCommand(
+            "./bin/MIOpenDriver conv -n 1 -c 3 -H 8 -W 8 -k 4 -y 3 -x 3q", command));
+        EXPECT(!ParseDriverConvCommand(
+            "./bin/MIOpenDriver conv -n 1 -c 3 -H 8 -W 8 -k 4 -y 3 -x 3 -g 2", command));
+
+        const auto text = "MIOpen(HIP): Command [LogCmdConvolution] ./bin/MIOpenDriver convfp16 "
+                          "-n 32 -c 64 -H 56 -W 56 -k 128 -y 3 -x 3 -p 1 -q 1 -u 2 -v 2 -l 1 -j 1 "
+                          "--in_layout NHWC --fil_layout NHWC --out_layout NHWC -m conv -g 1 -F 1 "
+                          "-t 1";
+        EXPECT(ParseDriverConvCommand(text, command));
+        EXPECT(command.type == miopenHalf);
+        EXPECT(command.in_lens == std::vector<int>({32, 64, 56, 56}));
+        EXPECT(command.wei_lens == std::vector<int>({128, 64, 3, 3}));
+        EXPECT(command.pads == std::vector<int>({1, 1}));
+        EXPECT(command.strides == std::vector<int>({2, 2}));
+        EXPECT(command.dilations == std::vector<int>({1, 1}));
+        EXPECT_EQUAL(command.in_layout, "NHWC");
+        EXPECT_EQUAL(command.directions, 1);
+
+        // The printed command is parsed back to the same one.
+        auto printed = std::ostringstream{};
+        printed << "./bin/MIOpenDriver " << command;
+        auto reparsed = DriverConvCommand{};
+        EXPECT(ParseDriverConvCommand(printed.str(), reparsed));
+        auto reprinted = std::ostringstream{};
+        reprinted << "./bin/MIOpenDriver " << reparsed;
+        EXPECT_EQUAL(printed.str(), reprinted.str());
+
+        const auto json = R"({"time_us":1,"pid":2,"tid":3,"level":"Info","kind":"command",)"
+                          R"("function":"LogCmdConvolution","message":"./bin/MIOpenDriver )"
+                          R"(convint8 -n 1 -c 8 --in_d 4 -H 6 -W 6 -k 16 --fil_d 1 -y 1 -x 1 )"
+                          R"(--pad_d 0 -p 0 -q 0 --conv_stride_d 1 -u 1 -v 1 --dilation_d 1 -l 1 )"
+                          R"(-j 1 --spatial_dim 3 -m trans -g 2 -F 4 -t 1 -Z 1"})";
+        EXPECT(ParseDriverConvCommand(json, command));
+        EXPECT(command.type == miopenInt8x4);
+        EXPECT_EQUAL(command.GetSpatialDimension(), 3);
+        EXPECT(command.in_lens == std::vector<int>({1, 8, 4, 6, 6}));
+        EXPECT(command.wei_lens == std::vector<int>({8, 8, 1, 1, 1}));
+        EXPECT(command.mode == miopenTranspose);
+        EXPECT_EQUAL(command.group_count, 2);
+        EXPECT_EQUAL(command.directions, 4);
+    }
+
+    static void CheckPlan()
+    {
+        const auto conv = std::string{"./bin/MIOpenDriver conv -n 4 -c 16 -H 14 -W 14 -k 32 -y 3 "
+                                      "-x 3 -p 1 -q 1 -u 1 -v 1 -l 1 -j 1 -m conv -g 1"};
+        const auto trans = std::string{"./bin/MIOpenDriver conv -n 4 -c 32 -H 14 -W 14 -k 16 "
+                                       "-y 3 -x 3 -p 1 -q 1 -u 1 -v 1 -l 1 -j 1 -m trans -g 1"};
+
+        auto log = std::istringstream{
+            // Find, then Run of the same layer, then the immediate mode calls.
+            "MIOpen(HIP): Command [LogCmdConvolution] " + conv + " -F 1 -t 1\n" +
+            "MIOpen(HIP): Info [FindConvFwdAlgorithm] requestAlgoCount = 1\n" +
+            "MIOpen(HIP): Command [LogCmdConvolution] " + conv + " -F 1 -t 1\n" +
+            "MIOpen(HIP): Command [LogCmdConvolution] " + conv + " -F 1 -t 1 -S 0\n" +
+            // All three directions, the forward one is known already.
+            conv + " -F 0 -t 1\n" +
+            // Not a valid problem: the convolution descriptor rejects the zero stride.
+            "./bin/MIOpenDriver conv -n 1 -c 1 -H 2 -W 2 -k 1 -y 1 -x 1 -u 0 -v 0 -F 1\n" +
+            // The transposed forward convolution from 32 to 16 channels is the backward data
+            // convolution of the first layer, so it needs no warm-up of its own.
+            trans + " -F 1 -t 1\n" +
+            // With 8 output channels it is a new one.
+            "./bin/MIOpenDriver conv -n 4 -c 32 -H 14 -W 14 -k 8 -y 3 -x 3 -p 1 -q 1 -u 1 -v 1 "
+            "-l 1 -j 1 -m trans -g 1 -F 1 -t 1\n"};
+
+        auto plan = WarmupPlan{};
+        EXPECT_EQUAL(plan.AddLog(log), 4u);
+        EXPECT_EQUAL(plan.GetCommandCount(), 7u);
+        EXPECT_EQUAL(plan.GetDuplicateCount(), 4u);
+        EXPECT_EQUAL(plan.GetInvalidCount(), 1u);
+
+        const auto& problems = plan.GetProblems();
+        EXPECT_EQUAL(problems.size(), 4u);
+        EXPECT(problems[0].problem.direction.IsForward());
+        EXPECT(problems[1].problem.direction.IsBackwardData());
+        EXPECT(problems[2].problem.direction.IsBackwardWrW());
+        EXPECT(problems[3].problem.direction.IsBackwardData());
+        EXPECT_EQUAL(problems[0].command.directions, 1);
+        EXPECT_EQUAL(problems[1].command.directions, 2);
+        EXPECT_EQUAL(problems[2].command.directions, 4);
+        EXPECT_EQUAL(problems[3].command.directions, 1);
+
+        // The backward data problem reads the 32 channel gradient and writes the 16 channel one.
+        EXPECT_EQUAL(problems[1].problem.conv_problem.GetInChannels(), 32u);
+        EXPECT_EQUAL(problems[1].problem.conv_problem.GetOutChannels(), 16u);
+        EXPECT_EQUAL(problems[3].problem.conv_problem.GetInChannels(), 32u);
+        EXPECT_EQUAL(problems[3].problem.conv_problem.GetOutChannels(), 8u);
+
+        // Adding the same log again adds nothing.
+        auto printed = std::ostringstream{};
+        for(const auto& problem : problems)
+            printed << "./bin/MIOpenDriver " << problem.command << "\n";
+        auto again = std::istringstream{printed.str()};
+        EXPECT_EQUAL(plan.AddLog(again), 0u);
+        EXPECT_EQUAL(plan.GetDuplicateCount(), 8u);
+    }
+};
+
+} // namespace tests
+} // namespace miopen
+
+int main(int argc, const char** argn)
+{
+    test_drive<miopen::tests::WarmupPlanTestDriver>(argc, argn);
+}
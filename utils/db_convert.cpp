@@ -0,0 +1,101 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/binary_db.hpp>
+#include <miopen/errors.hpp>
+
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include <string>
+
+static void PrintUsage(const char* name)
+{
+    std::cerr << "Usage: " << name << " <input> <output>" << std::endl
+              << "Converts a text find-db or perf-db (*.fdb.txt, *.pdb.txt) to the binary form "
+                 "and vice versa. The direction is detected from the input."
+              << std::endl
+              << "MIOpen loads binary find-db files only; a binary perf-db is not read at run "
+                 "time."
+              << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    if(argc != 3)
+    {
+        PrintUsage(argv[0]);
+        return 1;
+    }
+
+    const std::string input_path  = argv[1];
+    const std::string output_path = argv[2];
+
+    std::ifstream input(input_path, std::ios::binary);
+    if(!input)
+    {
+        std::cerr << "Unable to open " << input_path << std::endl;
+        return 1;
+    }
+
+    const auto contents = std::string{std::istreambuf_iterator<char>{input}, {}};
+    std::ofstream output(output_path, std::ios::binary | std::ios::trunc);
+    if(!output)
+    {
+        std::cerr << "Unable to create " << output_path << std::endl;
+        return 1;
+    }
+
+    try
+    {
+        if(miopen::binary_db::IsBinary(contents))
+        {
+            miopen::binary_db::BinaryToText(contents, output);
+            std::cout << "Converted " << input_path << " to text form" << std::endl;
+        }
+        else
+        {
+            auto text       = std::istringstream{contents};
+            const auto size = miopen::binary_db::TextToBinary(text, output, input_path);
+            std::cout << "Converted " << size << " records of " << input_path << " to binary form"
+                      << std::endl;
+        }
+    }
+    catch(const miopen::Exception& ex)
+    {
+        std::cerr << ex.what() << std::endl;
+        return 1;
+    }
+
+    output.close();
+    if(!output)
+    {
+        std::cerr << "Failed to write " << output_path << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
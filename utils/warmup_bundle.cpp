@@ -0,0 +1,381 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/solver.hpp>
+
+#include <miopen/any_solver.hpp>
+#include <miopen/conv/find_batch.hpp>
+#include <miopen/conv_solution.hpp>
+#include <miopen/convolution.hpp>
+#include <miopen/db.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/mlo_internal.hpp>
+#include <miopen/solver_id.hpp>
+#include <miopen/tensor.hpp>
+#include <miopen/timer.hpp>
+#include <miopen/warmup_plan.hpp>
+
+#include <boost/filesystem.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+static void PrintUsage(const char* name)
+{
+    std::cerr << "Usage: " << name << " [--plan] [--find] [--tune] <bundle> <log>..." << std::endl
+              << "Compiles the kernels of all applicable solvers for the convolutions recorded "
+                 "with MIOPEN_ENABLE_LOGGING_CMD=1 into the <bundle> directory. A <log> of '-' "
+                 "is read from the standard input."
+              << std::endl
+              << "  --plan  Only print the deduplicated problems. No GPU is used." << std::endl
+              << "  --find  Also run Find to populate the find-db of the bundle." << std::endl
+              << "  --tune  Run Find with the exhaustive search to populate the perf-db too."
+              << std::endl
+              << "The bundle is used by pointing MIOPEN_USER_DB_PATH and MIOPEN_CUSTOM_CACHE_DIR "
+                 "to a writable copy of it."
+              << std::endl;
+}
+
+/// The tensors in the order of the Find calls of the problem direction.
+static const miopen::TensorDescriptor& GetX(const miopen::ProblemDescription& problem)
+{
+    const auto& conv_problem = problem.conv_problem;
+    return conv_problem.GetDirection() == miopen::conv::Direction::Forward
+               ? conv_problem.GetIn()
+               : conv_problem.GetOut();
+}
+
+static const miopen::TensorDescriptor& GetY(const miopen::ProblemDescription& problem)
+{
+    const auto& conv_problem = problem.conv_problem;
+    return conv_problem.GetDirection() == miopen::conv::Direction::Forward
+               ? conv_problem.GetOut()
+               : conv_problem.GetIn();
+}
+
+static std::size_t GetBytes(const miopen::TensorDescriptor& desc)
+{
+    return desc.GetElementSpace() * miopen::GetTypeSize(desc.GetType());
+}
+
+/// Builds the kernels of all the applicable solvers of all the problems in one parallel batch.
+/// Returns the number of the compiled kernels.
+static std::size_t Precompile(miopen::Handle& handle, const miopen::WarmupPlan& plan)
+{
+    const auto& solvers =
+        miopen::solver::GetSolversByPrimitive(miopen::solver::Primitive::Convolution);
+
+    std::vector<miopen::solver::ConvSolution> solutions;
+    for(const auto& problem : plan.GetProblems())
+    {
+        auto ctx = miopen::ConvolutionContext{problem.problem};
+        ctx.SetStream(&handle);
+        ctx.DetectRocm();
+        ctx.SetupFloats();
+        auto db = miopen::GetDb(ctx);
+
+        for(const auto& id : solvers)
+        {
+            try
+            {
+                const auto solver = id.GetSolver();
+                if(!solver.IsApplicable(ctx))
+                    continue;
+                auto solution = solver.FindSolution(ctx, db, {});
+                if(solution.Succeeded())
+                    solutions.push_back(std::move(solution));
+            }
+            catch(const miopen::Exception& ex)
+            {
+                std::cerr << "Warning: " << id.ToString() << " for " << problem.command << ": "
+                          << ex.what() << std::endl;
+            }
+        }
+    }
+
+    std::vector<const miopen::solver::ConvSolution*> pointers;
+    for(const auto& solution : solutions)
+        pointers.push_back(&solution);
+
+    const auto kernels =
+        miopen::solver::GetKernelsToBuild(pointers, [&](const miopen::solver::KernelInfo& k) {
+            return handle.HasProgram(k.kernel_file, k.comp_options);
+        });
+    miopen::solver::PrecompileSolutions(handle, pointers);
+    return kernels.size();
+}
+
+/// Runs Find for all the problems: the forward ones in one batch, the rest one by one.
+/// The problems run one after another, so they share the buffers.
+static void Find(miopen::Handle& handle, const miopen::WarmupPlan& plan, bool exhaustive)
+{
+    const auto& problems = plan.GetProblems();
+
+    auto x_size         = std::size_t{1};
+    auto w_size         = std::size_t{1};
+    auto y_size         = std::size_t{1};
+    auto workspace_size = std::size_t{0};
+    for(const auto& problem : problems)
+    {
+        const auto& conv_problem = problem.problem.conv_problem;
+        const auto& conv         = conv_problem.GetConv();
+        const auto& x            = GetX(problem.problem);
+        const auto& w            = conv_problem.GetWeights();
+        const auto& y            = GetY(problem.problem);
+
+        x_size = std::max(x_size, GetBytes(x));
+        w_size = std::max(w_size, GetBytes(w));
+        y_size = std::max(y_size, GetBytes(y));
+
+        switch(conv_problem.GetDirection())
+        {
+        case miopen::conv::Direction::Forward:
+            workspace_size =
+                std::max(workspace_size, conv.ForwardGetWorkSpaceSize(handle, w, x, y));
+            break;
+        case miopen::conv::Direction::BackwardData:
+            workspace_size =
+                std::max(workspace_size, conv.BackwardDataGetWorkSpaceSize(handle, w, y, x));
+            break;
+        case miopen::conv::Direction::BackwardWeights:
+            workspace_size =
+                std::max(workspace_size, conv.BackwardWeightsGetWorkSpaceSize(handle, y, x, w));
+            break;
+        }
+    }
+
+    auto x_buf         = handle.Create(x_size);
+    auto w_buf         = handle.Create(w_size);
+    auto y_buf         = handle.Create(y_size);
+    auto workspace_buf = handle.Create(std::max<std::size_t>(workspace_size, 1));
+
+    const auto n_algos = 8;
+    auto returned      = std::vector<int>(problems.size());
+    auto results       = std::vector<miopenConvAlgoPerf_t>(problems.size() * n_algos);
+    auto forward       = std::vector<miopen::ConvFwdFindRequest>{};
+
+    for(std::size_t i = 0; i < problems.size(); ++i)
+    {
+        const auto& problem      = problems[i];
+        const auto& conv_problem = problem.problem.conv_problem;
+        const auto& conv         = conv_problem.GetConv();
+        const auto& x            = GetX(problem.problem);
+        const auto& w            = conv_problem.GetWeights();
+        const auto& y            = GetY(problem.problem);
+        const auto perf          = &results[i * n_algos];
+
+        try
+        {
+            switch(conv_problem.GetDirection())
+            {
+            case miopen::conv::Direction::Forward: {
+                auto request              = miopen::ConvFwdFindRequest{};
+                request.conv              = &conv;
+                request.xDesc             = &x;
+                request.x                 = x_buf.get();
+                request.wDesc             = &w;
+                request.w                 = w_buf.get();
+                request.yDesc             = &y;
+                request.y                 = y_buf.get();
+                request.workSpace         = workspace_buf.get();
+                request.workSpaceSize     = workspace_size;
+                request.requestAlgoCount  = n_algos;
+                request.returnedAlgoCount = &returned[i];
+                request.perfResults       = perf;
+                forward.push_back(request);
+                break;
+            }
+            case miopen::conv::Direction::BackwardData:
+                conv.FindConvBwdDataAlgorithm(handle,
+                                              y,
+                                              y_buf.get(),
+                                              w,
+                                              w_buf.get(),
+                                              x,
+                                              x_buf.get(),
+                                              n_algos,
+                                              &returned[i],
+                                              perf,
+                                              workspace_buf.get(),
+                                              workspace_size,
+                                              exhaustive);
+                break;
+            case miopen::conv::Direction::BackwardWeights:
+                conv.FindConvBwdWeightsAlgorithm(handle,
+                                                 y,
+                                                 y_buf.get(),
+                                                 x,
+                                                 x_buf.get(),
+                                                 w,
+                                                 w_buf.get(),
+                                                 n_algos,
+                                                 &returned[i],
+                                                 perf,
+                                                 workspace_buf.get(),
+                                                 workspace_size,
+                                                 exhaustive);
+                break;
+            }
+        }
+        catch(const miopen::Exception& ex)
+        {
+            std::cerr << "Warning: Find failed for " << problem.command << ": " << ex.what()
+                      << std::endl;
+        }
+    }
+
+    try
+    {
+        miopen::FindConvFwdAlgorithmBatch(handle, forward, exhaustive);
+    }
+    catch(const miopen::Exception& ex)
+    {
+        // Find the rest one by one, the problems found so far are in the find-db already.
+        std::cerr << "Warning: batched Find failed: " << ex.what() << std::endl;
+        for(const auto& request : forward)
+        {
+            try
+            {
+                miopen::FindConvFwdAlgorithmBatch(handle, {request}, exhaustive);
+            }
+            catch(const miopen::Exception& ex2)
+            {
+                std::cerr << "Warning: Find failed: " << ex2.what() << std::endl;
+            }
+        }
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    auto plan_only  = false;
+    auto find       = false;
+    auto exhaustive = false;
+    auto paths      = std::vector<std::string>{};
+    for(auto i = 1; i < argc; ++i)
+    {
+        const auto arg = std::string{argv[i]};
+        if(arg == "--plan")
+            plan_only = true;
+        else if(arg == "--find")
+            find = true;
+        else if(arg == "--tune")
+            find = exhaustive = true;
+        else if(arg.size() > 2 && arg.compare(0, 2, "--") == 0)
+        {
+            PrintUsage(argv[0]);
+            return 1;
+        }
+        else
+            paths.push_back(arg);
+    }
+    if(paths.size() < 2)
+    {
+        PrintUsage(argv[0]);
+        return 1;
+    }
+
+    auto plan = miopen::WarmupPlan{};
+    for(auto i = std::size_t{1}; i < paths.size(); ++i)
+    {
+        if(paths[i] == "-")
+        {
+            plan.AddLog(std::cin);
+            continue;
+        }
+        std::ifstream log(paths[i]);
+        if(!log)
+        {
+            std::cerr << "Unable to open " << paths[i] << std::endl;
+            return 1;
+        }
+        plan.AddLog(log);
+    }
+
+    std::cout << "Commands: " << plan.GetCommandCount()
+              << ", problems: " << plan.GetProblems().size()
+              << ", duplicates: " << plan.GetDuplicateCount()
+              << ", invalid: " << plan.GetInvalidCount() << std::endl;
+
+    if(plan_only)
+    {
+        for(const auto& problem : plan.GetProblems())
+            std::cout << "./bin/MIOpenDriver " << problem.command << std::endl;
+        return 0;
+    }
+
+    // The dbs and the kernel cache of the library are redirected to the bundle before the
+    // first use, so all of them end up there with their usual file names.
+    const auto bundle = boost::filesystem::absolute(paths[0]);
+    boost::filesystem::create_directories(bundle);
+    setenv("MIOPEN_USER_DB_PATH", bundle.string().c_str(), 1);
+    setenv("MIOPEN_CUSTOM_CACHE_DIR", bundle.string().c_str(), 1);
+
+    // The bundle records its problems in the form this tool reads, so it can be regenerated
+    // for another device or library version.
+    {
+        std::ofstream commands((bundle / "warmup_commands.txt").string(), std::ios::trunc);
+        for(const auto& problem : plan.GetProblems())
+            commands << "./bin/MIOpenDriver " << problem.command << std::endl;
+    }
+
+    try
+    {
+        auto handle = miopen::Handle{};
+
+        miopen::Timer timer;
+        timer.start();
+        const auto n_kernels = Precompile(handle, plan);
+        std::cout << "Compiled " << n_kernels << " kernels in " << timer.elapsed_ms() << " ms"
+                  << std::endl;
+
+        if(find)
+        {
+            timer.start();
+            Find(handle, plan, exhaustive);
+            std::cout << "Found " << plan.GetProblems().size() << " problems in "
+                      << timer.elapsed_ms() << " ms" << std::endl;
+        }
+    }
+    catch(const miopen::Exception& ex)
+    {
+        std::cerr << ex.what() << std::endl;
+        return 1;
+    }
+
+    for(const auto& entry : boost::filesystem::directory_iterator(bundle))
+    {
+        if(boost::filesystem::is_regular_file(entry.path()))
+            std::cout << entry.path().filename().string() << ": "
+                      << boost::filesystem::file_size(entry.path()) << " bytes" << std::endl;
+    }
+
+    return 0;
+}